@@ -1,8 +1,25 @@
 # fast multipole things
-option(ENABLE_FMM_FFT "Enable FFT accelerated FMM" OFF)
+option(ENABLE_FMM_FFT "Enable FFT accelerated FMM (requires FFTW)" OFF)
 if(ENABLE_FMM_FFT)
-    message(WARNING "FMM_FFT NOT YET SUPPORTED using cmake")
-    #set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DVTK")
+    message(STATUS "FMM_FFT Enabled")
+    find_library(FFTW_LIB fftw3
+      HINTS $ENV{FFTW_LIBDIR}
+      )
+    find_library(FFTWF_LIB fftw3f
+      HINTS $ENV{FFTW_LIBDIR}
+      )
+    find_path(FFTW_INCDIR fftw3.h
+      HINTS $ENV{FFTW_INCDIR}
+      )
+
+    if(NOT FFTW_LIB OR NOT FFTWF_LIB OR NOT FFTW_INCDIR)
+        message(FATAL_ERROR "FFTW (fftw3, fftw3f) not found. Set FFTW_LIBDIR and FFTW_INCDIR or disable ENABLE_FMM_FFT.")
+    endif()
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DFMM_FFT -DFFTW")
+
+    include_directories(SYSTEM ${FFTW_INCDIR})
 else()
     message(STATUS "FMM_FFT Disabled")
-endif()
\ No newline at end of file
+    unset(FFTW_LIB CACHE)
+    unset(FFTWF_LIB CACHE)
+endif()
@@ -4,6 +4,7 @@
 #include <sstream>
 #include <cmath>
 #include <cstdint>
+#include <vector>
 
 #include "Domain.h"
 
@@ -172,20 +173,6 @@ void Domain::calculateGlobalValues(
 	// of m_Ukin, m_Upot and Pressure had to be moved from Thermostat / upd_F
 	// to this point
 
-	/* FIXME stuff for the ensemble class */
-	domainDecomp->collCommInit(2, 654);
-	domainDecomp->collCommAppendDouble(Upot);
-	domainDecomp->collCommAppendDouble(Virial);
-	domainDecomp->collCommAllreduceSumAllowPrevious();
-	Upot = domainDecomp->collCommGetDouble();
-	Virial = domainDecomp->collCommGetDouble();
-	domainDecomp->collCommFinalize();
-
-	// Process 0 has to add the dipole correction:
-	// m_UpotCorr and m_VirialCorr already contain constant (internal) dipole correction
-	_globalUpot = Upot + _UpotCorr;
-	_globalVirial = Virial + _VirialCorr;
-
 	/*
 	 * thermostat ID 0 represents the entire system
 	 */
@@ -207,27 +194,47 @@ void Domain::calculateGlobalValues(
 			this->_local2KERot[0] += this->_local2KERot[thermit->first];
 		}
 	}
-	int thermid = 0;
-	for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++, thermid++)
+
+	// Upot, the virial and the sums of all thermostats are reduced with a single collective.
+	/* FIXME stuff for the ensemble class */
+	domainDecomp->collCommInit(2 + 4 * _universalThermostatN.size(), 654);
+	domainDecomp->collCommAppendDouble(Upot);
+	domainDecomp->collCommAppendDouble(Virial);
+	for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++)
 	{
-		// number of molecules on the local process. After the reduce operation
-		// num_molecules will contain the global number of molecules
-		unsigned long numMolecules = _localThermostatN[thermit->first];
-		double summv2 = _local2KETrans[thermit->first];
 		unsigned long rotDOF = _localRotationalDOF[thermit->first];
-		double sumIw2 = (rotDOF > 0)? _local2KERot[thermit->first]: 0.0;
-
-		domainDecomp->collCommInit(4, 12+thermid);
-		domainDecomp->collCommAppendDouble(summv2);
-		domainDecomp->collCommAppendDouble(sumIw2);
-		domainDecomp->collCommAppendUnsLong(numMolecules);
+		domainDecomp->collCommAppendDouble(_local2KETrans[thermit->first]);
+		domainDecomp->collCommAppendDouble((rotDOF > 0)? _local2KERot[thermit->first]: 0.0);
+		domainDecomp->collCommAppendUnsLong(_localThermostatN[thermit->first]);
 		domainDecomp->collCommAppendUnsLong(rotDOF);
-		domainDecomp->collCommAllreduceSumAllowPrevious();
-		_globalsummv2 = domainDecomp->collCommGetDouble();
-		_globalsumIw2 = domainDecomp->collCommGetDouble();
-		numMolecules = domainDecomp->collCommGetUnsLong();
-		rotDOF = domainDecomp->collCommGetUnsLong();
-		domainDecomp->collCommFinalize();
+	}
+	domainDecomp->collCommAllreduceSumAllowPrevious();
+	Upot = domainDecomp->collCommGetDouble();
+	Virial = domainDecomp->collCommGetDouble();
+	const size_t numThermostats = _universalThermostatN.size();
+	std::vector<double> globalSummv2(numThermostats), globalSumIw2(numThermostats);
+	std::vector<unsigned long> globalNumMolecules(numThermostats), globalRotDOF(numThermostats);
+	for (size_t thermid = 0; thermid < numThermostats; thermid++) {
+		globalSummv2[thermid] = domainDecomp->collCommGetDouble();
+		globalSumIw2[thermid] = domainDecomp->collCommGetDouble();
+		globalNumMolecules[thermid] = domainDecomp->collCommGetUnsLong();
+		globalRotDOF[thermid] = domainDecomp->collCommGetUnsLong();
+	}
+	domainDecomp->collCommFinalize();
+
+	// Process 0 has to add the dipole correction:
+	// m_UpotCorr and m_VirialCorr already contain constant (internal) dipole correction
+	_globalUpot = Upot + _UpotCorr;
+	_globalVirial = Virial + _VirialCorr;
+
+	int thermid = 0;
+	for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++, thermid++)
+	{
+		// global number of molecules and sums of the thermostat
+		unsigned long numMolecules = globalNumMolecules[thermid];
+		unsigned long rotDOF = globalRotDOF[thermid];
+		_globalsummv2 = globalSummv2[thermid];
+		_globalsumIw2 = globalSumIw2[thermid];
 		Log::global_log->debug() << "[ thermostat ID " << thermit->first << "]\tN = " << numMolecules << "\trotDOF = " << rotDOF
 			<< "\tmv2 = " <<  _globalsummv2 << "\tIw2 = " << _globalsumIw2 << std::endl;
 
@@ -70,7 +70,15 @@ void log_program_build_info() {
 	get_precision_info(info_str);
 	Log::global_log->info() << "	Precision:	" << info_str << std::endl;
 	get_intrinsics_info(info_str);
-	Log::global_log->info() << "	Intrinsics:	" << info_str << std::endl;
+	Log::global_log->info() << "	Intrinsics:	" << info_str << " (fixed at compile time)" << std::endl;
+	const std::string compiledIntrinsics(info_str);
+	const int cpuIntrinsics = check_cpu_intrinsics(info_str);
+	Log::global_log->info() << "	CPU supports:	" << info_str << std::endl;
+	// unsupported intrinsics are rejected by exit_on_unsupported_cpu_intrinsics() before main
+	if (cpuIntrinsics > 0) {
+		Log::global_log->warning() << "This CPU supports " << info_str << ", but the executable was compiled for "
+				<< compiledIntrinsics << " intrinsics. Configuring with a wider VECTOR_INSTRUCTIONS may be faster." << std::endl;
+	}
 	get_rmm_normal_info(info_str);
 	Log::global_log->info() << "	RMM/normal:	" << info_str << std::endl;
 	get_openmp_info(info_str);
@@ -41,6 +41,7 @@
 #include "integrators/Integrator.h"
 #include "integrators/Leapfrog.h"
 #include "integrators/LeapfrogRMM.h"
+#include "integrators/LeapfrogRESPA.h"
 
 #include "plugins/PluginBase.h"
 #include "plugins/PluginFactory.h"
@@ -51,6 +52,7 @@
 
 #include "io/ASCIIReader.h"
 #include "io/BinaryReader.h"
+#include "io/BlockedCheckpointReader.h"
 #include "io/CubicGridGeneratorInternal.h"
 #include "io/MemoryProfiler.h"
 #include "io/Mkesfera.h"
@@ -172,13 +174,17 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 		std::string integratorType;
 		xmlconfig.getNodeValue("@type", integratorType);
 		Log::global_log->info() << "Integrator type: " << integratorType << std::endl;
-		if(integratorType == "Leapfrog") {
+		if(integratorType == "Leapfrog" || integratorType == "LeapfrogRESPA") {
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 			std::ostringstream error_message;
 			error_message << "The reduced memory mode (RMM) requires the LeapfrogRMM integrator." << std::endl;
 			MARDYN_EXIT(error_message.str());
 #endif
-			_integrator = new Leapfrog();
+			if (integratorType == "Leapfrog") {
+				_integrator = new Leapfrog();
+			} else {
+				_integrator = new LeapfrogRESPA();
+			}
 		} else if (integratorType == "LeapfrogRMM") {
 			_integrator = new LeapfrogRMM();
 		} else {
@@ -443,9 +449,6 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 				if (_domainDecomposition->hasGlobalInvalidBoundary()) {
 					MARDYN_EXIT("Invalid boundary type! Please check the config file");
 				}
-				if(_overlappingP2P && _domainDecomposition->hasGlobalNonPeriodicBoundary()) {
-					MARDYN_EXIT("Non-periodic boundaries not supported with overlappingP2P enabled! Exiting...");
-				}
 				Log::global_log->info() << "Boundary conditions: x - " <<  BoundaryUtils::convertBoundaryToString(xBoundary)
 					<< " y - " << BoundaryUtils::convertBoundaryToString(yBoundary)
 					<< " z - " << BoundaryUtils::convertBoundaryToString(zBoundary) << std::endl;
@@ -670,6 +673,11 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 			double timestepLength = 0.005;  // <-- TODO: should be removed from parameter list
 			_inputReader->readPhaseSpaceHeader(_domain, timestepLength);
 		}
+		else if (pspfiletype == "blocked") {
+			_inputReader = new BlockedCheckpointReader();
+			_inputReader->readXML(xmlconfig);
+			_inputReader->readPhaseSpaceHeader(_domain, 0.);
+		}
 #ifdef ENABLE_ADIOS2
         else if (pspfiletype == "adios2") {
 			_inputReader = new Adios2Reader();
@@ -844,6 +852,16 @@ void Simulation::updateForces() {
 	} // end pragma omp parallel
 }
 
+void Simulation::calculateSlowForces(unsigned long simstep) {
+	const double factor = _integrator->getSlowForceFactor(simstep);
+	if (factor == 0.0) {
+		// the long range correction keeps its energy and virial corrections from the last evaluation
+		return;
+	}
+	_longRangeCorrection->setForceFactor(factor);
+	_longRangeCorrection->calculateLongRange();
+}
+
 void Simulation::prepare_start() {
 	Log::global_log->info() << "Initializing simulation" << std::endl;
 
@@ -921,8 +939,15 @@ void Simulation::prepare_start() {
 		error_message << "No _longRangeCorrection set!" << std::endl;
 		MARDYN_EXIT(error_message.str());
 	}
-	// longRangeCorrection is a site-wise force plugin, so we have to call it before updateForces()
-	_longRangeCorrection->calculateLongRange();
+	// the slow forces are site-wise forces, so we have to calculate them before updateForces()
+	calculateSlowForces(_initSimulation);
+
+	// the FMM adds site-wise forces on the charges as well, its far field is a slow force
+	if (_FMM != nullptr) {
+		Log::global_log->info() << "Performing initial FMM force calculation" << std::endl;
+		_FMM->setFarFieldFactor(_integrator->getSlowForceFactor(_initSimulation));
+		_FMM->computeElectrostatics(_moleculeContainer);
+	}
 
 	// Update forces in molecules so they can be exchanged - future
 	updateForces();
@@ -932,6 +957,20 @@ void Simulation::prepare_start() {
 		_domainDecomposition->exchangeForces(_moleculeContainer, _domain);
 	}
 
+#ifdef ENABLE_MPI
+	// the traversal is known after the initial force calculation, all processes have to agree on overlapping
+	if (_overlappingP2P) {
+		int supported = _domainDecomposition->getNonBlockingStageCount() > 0
+						and _moleculeContainer->supportsInnerOuterTraversal();
+		MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &supported, 1, MPI_INT, MPI_MIN, _domainDecomposition->getCommunicator()));
+		if (not supported) {
+			Log::global_log->info() << "Overlapping p2p communication is not supported by the decomposition or the "
+									   "traversal, using blocking communication." << std::endl;
+			_overlappingP2P = false;
+		}
+	}
+#endif
+
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 	// now set vcp1clj_wr_cellProcessor::_dtInvm back.
 	vcp1clj_wr_cellProcessor->setDtInvm(dt_inv_m);
@@ -941,11 +980,6 @@ void Simulation::prepare_start() {
 	global_simulation->timers()->reset("SIMULATION_FORCE_CALCULATION");
 	++_loopCompTimeSteps;
 
-	if (_FMM != nullptr) {
-		Log::global_log->info() << "Performing initial FMM force calculation" << std::endl;
-		_FMM->computeElectrostatics(_moleculeContainer);
-	}
-
 	/** Init TemperatureControl beta_trans, beta_rot log-files, register as observer if plugin DistControl is in use. */
 	if(nullptr != _temperatureControl)
 		_temperatureControl->prepare_start();  // Has to be called before plugin initialization (see below): plugin->init(...)
@@ -1045,6 +1079,9 @@ void Simulation::preSimLoopSteps()
 	global_simulation->timers()->setOutputString("COMMUNICATION_PARTNER_INIT_SEND", "initSend() took:");
 	global_simulation->timers()->setOutputString("COMMUNICATION_PARTNER_TEST_RECV", "testRecv() took:");
 	global_simulation->timers()->setOutputString("SIMULATION_BOUNDARY_TREATMENT", "Enforcing boundary conditions took:");
+	global_simulation->timers()->setOutputString("SIMULATION_OVERLAP_COMPUTATION", "Force calculation overlapped with communication took:");
+	global_simulation->timers()->setOutputString("SIMULATION_OVERLAP_COMMUNICATION", "Non-overlapped p2p communication took:");
+	global_simulation->timers()->setOutputString("SIMULATION_OVERLAP_LEAVING_EXCHANGE", "Blocking exchange of the leaving particles before the overlapped stages took:");
 
 	// all timers except the ioTimer measure inside the main loop
 
@@ -1130,7 +1167,8 @@ void Simulation::simulateOneTimestep()
 
 
 #if defined(ENABLE_MPI)
-	bool overlapCommComp = _overlappingP2P;
+	// auto-tuning may have changed the traversal, it is the same on all processes
+	bool overlapCommComp = _overlappingP2P and _moleculeContainer->supportsInnerOuterTraversal();
 #else
 	bool overlapCommComp = false;
 #endif
@@ -1171,8 +1209,15 @@ void Simulation::simulateOneTimestep()
 			global_simulation->timers()->stop(plugin->getPluginName());
 		}
 
-	// longRangeCorrection is a site-wise force plugin, so we have to call it before updateForces()
-	_longRangeCorrection->calculateLongRange();
+	// the slow forces are site-wise forces, so we have to calculate them before updateForces()
+	calculateSlowForces(_simstep);
+
+	// the FMM adds site-wise forces on the charges as well, its far field is a slow force
+	if (_FMM != nullptr) {
+		Log::global_log->debug() << "Performing FMM calculation" << std::endl;
+		_FMM->setFarFieldFactor(_integrator->getSlowForceFactor(_simstep));
+		_FMM->computeElectrostatics(_moleculeContainer);
+	}
 
 	// Update forces in molecules so they can be exchanged
 	updateForces();
@@ -1192,12 +1237,6 @@ void Simulation::simulateOneTimestep()
 
 	global_simulation->timers()->start("SIMULATION_COMPUTATION");
 
-
-	if (_FMM != nullptr) {
-		Log::global_log->debug() << "Performing FMM calculation" << std::endl;
-		_FMM->computeElectrostatics(_moleculeContainer);
-	}
-
 		//afterForces Plugin Call
 		Log::global_log -> debug() << "[AFTER FORCES] Performing AfterForces plugin call" << std::endl;
 		for (auto plugin : _plugins) {
@@ -1291,6 +1330,9 @@ void Simulation::simulateOneTimestep()
 	global_simulation->timers()->stop("SIMULATION_COMPUTATION");
 	global_simulation->timers()->start("SIMULATION_PER_STEP_IO");
 
+	// complete the plugin reductions of the previous step, which overlapped with the force calculation
+	_pluginReduction.wait(_domainDecomposition);
+
 	// CALL ALL PLUGIN ENDSTEP METHODS
 	pluginEndStepCall(_simstep);
 
@@ -1340,6 +1382,8 @@ void Simulation::postSimLoopSteps()
         _domain->writeCheckpoint(cpfile, _moleculeContainer, _domainDecomposition, _simulationTime, false);
     }
 
+	_pluginReduction.wait(_domainDecomposition);
+
 	Log::global_log->info() << "Finish plugins" << std::endl;
 	for (auto plugin : _plugins) {
 		global_simulation->timers()->start(plugin->getPluginName());
@@ -1349,6 +1393,17 @@ void Simulation::postSimLoopSteps()
 	global_simulation->timers()->getTimer("SIMULATION_FINAL_IO")->stop();
 
 	Log::global_log->info() << "Timing information:" << std::endl;
+	const double overlapComputation = global_simulation->timers()->getTime("SIMULATION_OVERLAP_COMPUTATION");
+	// the blocking exchange of the leaving particles is part of the communication timer, but can not be hidden
+	const double leavingExchange = global_simulation->timers()->getTime("SIMULATION_OVERLAP_LEAVING_EXCHANGE");
+	const double overlapCommunication =
+		global_simulation->timers()->getTime("SIMULATION_OVERLAP_COMMUNICATION") - leavingExchange;
+	if (overlapComputation + overlapCommunication > 0.) {
+		Log::global_log->info() << "Overlapping p2p communication: the inner cells filled "
+								<< 100. * overlapComputation / (overlapComputation + overlapCommunication)
+								<< " % of the non-blocking halo exchanges, the blocking exchange of the leaving "
+								   "particles took " << leavingExchange << " s" << std::endl;
+	}
 	global_simulation->timers()->printTimers();
 	global_simulation->timers()->resetTimers();
 	if(getMemoryProfiler()) {
@@ -1375,6 +1430,8 @@ void Simulation::pluginEndStepCall(unsigned long simstep) {
 		plugin->endStep(_moleculeContainer, _domainDecomposition, _domain, simstep);
 		global_simulation->timers()->stop(plugin->getPluginName());
 	}
+	// post the reduction of all sampling data registered by the plugins
+	_pluginReduction.start(_domainDecomposition);
 
 
 	if (_domain->thermostatWarning())
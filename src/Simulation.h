@@ -5,6 +5,7 @@
 #include <any>
 
 #include "io/TimerProfiler.h"
+#include "parallel/PluginReduction.h"
 #include "thermostats/VelocityScalingThermostat.h"
 #include "utils/FixedSizeQueue.h"
 #include "utils/FunctionWrapper.h"
@@ -75,6 +76,9 @@ private:
 	Simulation& operator=(Simulation &simulation);
 	void updateForces();
 
+	//! @brief Calculates the slow forces (long range correction) on the sites, weighted by the integrator.
+	void calculateSlowForces(unsigned long simstep);
+
 public:
 	/** Instantiate simulation object */
 	Simulation();
@@ -441,6 +445,13 @@ public:
 		return &_plugins;
 	}
 
+	/** @brief Shared reduction of the sampling data of plugins.
+	 * Started after the endStep() of all plugins, completed in the next time step after the force calculation.
+	 */
+	PluginReduction& getPluginReduction() {
+		return _pluginReduction;
+	}
+
 	/** Global energy log */
 	void initGlobalEnergyLog();
 	void writeGlobalEnergyLog(const double& globalUpot, const double& globalT, const double& globalPressure);
@@ -478,13 +489,19 @@ private:
 	/**
 	 * Specifies whether to use overlapping p2p (peer-to-peer) communication or not.
 	 * If false: overlapping is only performed for unpacking and packing of particles.
-	 * If true: overlapping of the leaving and halo particle exchange with the actual force calculation is performed.
+	 * If true: overlapping of the halo particle exchange with the force calculation of the inner cells is performed,
+	 * the leaving particles are still exchanged blocking before. Falls back to false, if the domain decomposition or
+	 * the traversal can not split the force calculation into inner and outer cells.
+	 * Default: true.
 	 */
-	bool _overlappingP2P {false};
+	bool _overlappingP2P {true};
 
 	/** List of plugins to use */
 	std::list<PluginBase*> _plugins;
 
+	/** Aggregated reduction of the plugin sampling data, see PluginReduction */
+	PluginReduction _pluginReduction;
+
 	/** Map of all call backs.
 	 * The key is the name of the callback.
 	 * Each element contains a std::function object.
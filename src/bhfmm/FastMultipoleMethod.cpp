@@ -14,6 +14,7 @@
 #include "bhfmm/containers/UniformPseudoParticleContainer.h"
 #include "bhfmm/containers/AdaptivePseudoParticleContainer.h"
 #include "utils/xmlfileUnits.h"
+#include "parallel/DomainDecompBase.h"
 
 namespace bhfmm {
 
@@ -38,8 +39,16 @@ void FastMultipoleMethod::readXML(XMLfileUnits& xmlconfig) {
 
 	xmlconfig.getNodeValue("adaptiveContainer", _adaptive);
 	if (_adaptive) {
-		Log::global_log->warning() << "FastMultipoleMethod: adaptiveContainer is not debugged yet and certainly delivers WRONG results!" << std::endl;
-		Log::global_log->warning() << "Unless you are in the process of debugging this container, please stop the simulation and restart with the uniform one" << std::endl;
+		xmlconfig.getNodeValue("adaptiveThreshold", _adaptiveThreshold);
+		if (_adaptiveThreshold < 1) {
+			std::ostringstream error_message;
+			error_message << "FastMultipoleMethod: adaptiveThreshold has to be at least 1." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		Log::global_log->info() << "FastMultipoleMethod: AdaptivePseudoParticleContainer selected, at most "
+								<< _adaptiveThreshold << " charges per leaf" << std::endl;
+		Log::global_log->warning() << "FastMultipoleMethod: adaptiveContainer is experimental, prefer the uniform one "
+								   << "for production runs" << std::endl;
 	} else {
 		Log::global_log->info() << "FastMultipoleMethod: UniformPseudoParticleSelected " << std::endl;
 	}
@@ -53,11 +62,12 @@ void FastMultipoleMethod::readXML(XMLfileUnits& xmlconfig) {
 }
 
 void FastMultipoleMethod::setParameters(unsigned LJSubdivisionFactor,
-		int orderOfExpansions, bool periodic, bool adaptive) {
+		int orderOfExpansions, bool periodic, bool adaptive, int adaptiveThreshold) {
 	_LJCellSubdivisionFactor = LJSubdivisionFactor;
 	_order = orderOfExpansions;
 	_periodic = periodic;
 	_adaptive = adaptive;
+	_adaptiveThreshold = adaptiveThreshold;
 }
 
 void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
@@ -106,16 +116,14 @@ void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
 #endif
 
 	} else {
-		// TODO: Debugging in Progress!
-#if defined(ENABLE_MPI)
-		std::ostringstream error_message;
-		error_message << "MPI in combination with adaptive is not supported yet" << std::endl;
-		MARDYN_EXIT(error_message.str());
-#endif
-		//int threshold = 100;
+		// the tree only covers the charges of this process, there are no locally essential trees
+		if (global_simulation->domainDecomposition().getNumProcs() > 1) {
+			std::ostringstream error_message;
+			error_message << "FastMultipoleMethod: the adaptive container supports only one process" << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
 		_pseudoParticleContainer = new AdaptivePseudoParticleContainer(
-				globalDomainLength, _order, LJCellLength,
-				_LJCellSubdivisionFactor, _periodic);
+				globalDomainLength, _adaptiveThreshold, _order, _periodic);
 	}
 
 	_P2MProcessor = new P2MCellProcessor(_pseudoParticleContainer);
@@ -125,9 +133,27 @@ void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
 }
 
 void FastMultipoleMethod::computeElectrostatics(ParticleContainer* ljContainer) {
+#ifdef QUICKSCHED
+	if (_farFieldFactor != 1.0) {
+		std::ostringstream error_message;
+		error_message << "FastMultipoleMethod: multiple time stepping is not supported with QUICKSCHED" << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+#endif
+	Domain* domain = global_simulation->getDomain();
+
 	// build
 	_pseudoParticleContainer->build(ljContainer);
 
+	if (_farFieldFactor == 0.0) {
+		// P2P only, the far field energy and virial are kept from the last evaluation
+		_pseudoParticleContainer->nearFieldPass(_P2PProcessor);
+		domain->setLocalUpot(domain->getLocalUpot() + _farFieldUpot);
+		domain->setLocalVirial(domain->getLocalVirial() + _farFieldVirial);
+		return;
+	}
+	_pseudoParticleContainer->setFarFieldFactor(_farFieldFactor);
+
 	// clear expansions
 	_pseudoParticleContainer->clear();
 
@@ -148,15 +174,15 @@ void FastMultipoleMethod::computeElectrostatics(ParticleContainer* ljContainer)
 #else
     // P2M, M2P
 	_pseudoParticleContainer->upwardPass(_P2MProcessor);
-	if (_adaptive) {
-		_P2PProcessor->initTraversal();
-	}
 	// M2L, P2P
 	_pseudoParticleContainer->horizontalPass(_P2PProcessor);
-	// L2L, L2P
+	// L2L, L2P, the only far field contributions to energy and virial
+	const double upot = domain->getLocalUpot();
+	const double virial = domain->getLocalVirial();
 	_pseudoParticleContainer->downwardPass(_L2PProcessor);
+	_farFieldUpot = domain->getLocalUpot() - upot;
+	_farFieldVirial = domain->getLocalVirial() - virial;
 #endif
-
 }
 
 void FastMultipoleMethod::printTimers() {
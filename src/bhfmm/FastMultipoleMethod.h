@@ -57,19 +57,34 @@ public:
 	   <electrostatic type="FastMultipoleMethod">
 		 <orderOfExpansions>UNSIGNED INTEGER</orderOfExpansions>
 		 <LJCellSubdivisionFactor>INTEGER</LJCellSubdivisionFactor>
+		 <adaptiveContainer>BOOL</adaptiveContainer>  <!-- octree refined by the number of charges, one process only (default: false) -->
+		 <adaptiveThreshold>INTEGER</adaptiveThreshold>  <!-- maximum number of charges in a leaf of the adaptive tree (default: 64) -->
+		 <systemIsPeriodic>BOOL</systemIsPeriodic>
 	   </electrostatic>
 	   \endcode
 	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 	void setParameters(unsigned LJSubdivisionFactor, int orderOfExpansions,
-			bool periodic = true, bool adaptive = false);
+			bool periodic = true, bool adaptive = false, int adaptiveThreshold = 64);
 
 	void init(double globalDomainLength[3], double bBoxMin[3],
 			double bBoxMax[3], double LJCellLength[3], ParticleContainer* ljContainer);
 
+	/**
+	 * @brief Computes the electrostatic forces on the charges, which are added to the site forces of the molecules.
+	 * @details The molecules have to calculate their total force and torque (calcFM()) afterwards.
+	 */
 	void computeElectrostatics(ParticleContainer * ljContainer);
 
+	/**
+	 * @brief Weight of the far field forces (multiple time stepping).
+	 * @details The near field (P2P) is evaluated in every time step. The far field (M2L, L2P) is only evaluated with
+	 * a non-zero weight and its forces are multiplied with it. With weight 0, the far field energy and virial of the
+	 * last evaluation are added instead.
+	 */
+	void setFarFieldFactor(double factor) { _farFieldFactor = factor; }
+
 	void printTimers();
 
 	enum taskType {
@@ -92,8 +107,14 @@ private:
 	int _order;
 	unsigned _LJCellSubdivisionFactor;
 	bool _adaptive;
+	int _adaptiveThreshold{64};
 	bool _periodic;
 
+	double _farFieldFactor{1.0};
+	//! local energy and virial of the last far field evaluation
+	double _farFieldUpot{0.0};
+	double _farFieldVirial{0.0};
+
 	PseudoParticleContainer * _pseudoParticleContainer;
 
 	VectorizedChargeP2PCellProcessor *_P2PProcessor;
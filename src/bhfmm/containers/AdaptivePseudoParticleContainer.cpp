@@ -1,231 +1,542 @@
 #include "AdaptivePseudoParticleContainer.h"
+#include "Simulation.h"
+#include "Domain.h"
 #include "particleContainer/ParticleContainer.h"
 #include "molecules/Molecule.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+
+#include <algorithm>
+#include <array>
 
 namespace bhfmm {
 
-const int split_target = 0, split_source = 1, split_internal = 3, NO_WORK = 5,
-		M2L = 6, P2P = 7, PUSH = 8, POP = 9;
+//! nodes are not subdivided beyond this level, even if they hold more charges than the threshold
+const int maxTreeDepth = 20;
 
-const double epsilon = 0.001;
+//! two nodes are well separated, if the sum of their radii is at most this fraction of the distance of their centers
+const double separationRatio = 0.9;
 
-const bool debug = false;
+AdaptivePseudoParticleContainer::AdaptivePseudoParticleContainer(double domainLength[3], int threshold,
+		int orderOfExpansions, bool periodic) :
+		PseudoParticleContainer(orderOfExpansions), _periodicBC(periodic), _threshold(threshold),
+		_domainLength(domainLength), _domain(global_simulation->getDomain()), _numLeaves(0),
+		_maxDepth(0) {
+	mardyn_assert(_threshold > 0);
+
+	_images.push_back(Vector3<double>(0.0));
+	if (_periodicBC) {
+		for (int z = -1; z <= 1; z++) {
+			for (int y = -1; y <= 1; y++) {
+				for (int x = -1; x <= 1; x++) {
+					if (x == 0 and y == 0 and z == 0) {
+						continue;
+					}
+					_images.push_back(Vector3<double>(x * _domainLength[0], y * _domainLength[1], z * _domainLength[2]));
+				}
+			}
+		}
+	}
+
+#ifdef FMM_FFT
+	// the transfer functions assume cubic cells, hence equal nodes are cubes only in a cubic domain
+	const bool cubic = _domainLength[0] == _domainLength[1] and _domainLength[0] == _domainLength[2];
+	FFTSettings::autoSetting(_maxOrd);
+	FFTSettings::USE_2WAY_M2L = false;
+	_useFFT = cubic and FFTSettings::issetFFTAcceleration();
+	if (_useFFT) {
+		FFTSettings::printCurrentOptions();
+		_FFTAcceleration = FFTFactory::getFFTAccelerationAPI(_maxOrd);
+		_FFT_TM = FFTFactory::getTransferFunctionManagerAPI(_maxOrd, _FFTAcceleration);
+	} else {
+		if (not cubic) {
+			Log::global_log->warning() << "AdaptivePseudoParticleContainer: FFT acceleration requires a cubic domain, "
+									   << "using the direct M2L" << std::endl;
+		}
+		_FFTAcceleration = NULL;
+		_FFT_TM = NULL;
+	}
+#endif  /* FMM_FFT */
+}
+
+AdaptivePseudoParticleContainer::~AdaptivePseudoParticleContainer() {
+#ifdef FMM_FFT
+	if (_useFFT) {
+		delete _FFT_TM;
+		delete _FFTAcceleration;
+	}
+#endif  /* FMM_FFT */
+}
 
 void AdaptivePseudoParticleContainer::clear() {
-	//TODO FastMultipoleMethod.cpp calls this before computation
-	//_Cells.removeAllParticles();
-	//delete root;
-	//delete halo_node;
+	for (size_t n = 0; n < _nodes.size(); n++) {
+		_mpCells[n].multipole.clear();
+		_mpCells[n].local.clear();
+	}
 }
 
 void AdaptivePseudoParticleContainer::build(ParticleContainer* pc) {
-	double lowBound[3] = { 0.0, 0.0, 0.0 };
-	double highBound[3] = { _domainLength[0], _domainLength[1], _domainLength[2]};
+	collectCharges(pc);
+	buildTree();
+	traverse();
+}
+
+void AdaptivePseudoParticleContainer::collectCharges(ParticleContainer* pc) {
+	_localCharges.clear();
+	_r.clear();
+	_q.clear();
+	_moleculeR.clear();
+	_moleculeID.clear();
+	for (auto m = pc->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		for (unsigned j = 0; j < m->numCharges(); j++) {
+			const std::array<double, 3> d = m->charge_d(j);
+			const Charge& charge = static_cast<const Charge&>(m->component()->charge(j));
+			for (int k = 0; k < 3; k++) {
+				_r.push_back(m->r(k) + d[k]);
+				_moleculeR.push_back(m->r(k));
+			}
+			_q.push_back(charge.q());
+			_moleculeID.push_back(m->getID());
+			_localCharges.push_back(std::make_pair(&(*m), j));
+		}
+	}
+}
+
+void AdaptivePseudoParticleContainer::buildTree() {
+	const size_t numCharges = _q.size();
+	std::vector<size_t> order(numCharges);
+	for (size_t i = 0; i < numCharges; i++) {
+		order[i] = i;
+	}
 
+	_nodes.clear();
+	_leaves.clear();
+	_maxDepth = 0;
+
+	Node root;
+	root.halfSize = _domainLength * 0.5;
+	root.center = root.halfSize;
+	root.level = 0;
+	root.begin = 0;
+	root.end = numCharges;
+	root.parent = -1;
+	_nodes.push_back(root);
+	// the subdivision works on a copy of the positions, so that the charges can be permuted afterwards
+	const std::vector<double> positions(_r);
+	subdivide(0, order, positions);
+	_numLeaves = _leaves.size();
+
+	// permute the charges into tree order
+	_treeToLocal = order;
+	const std::vector<double> q(_q), moleculeR(_moleculeR);
+	const std::vector<unsigned long> moleculeID(_moleculeID);
+	for (size_t i = 0; i < numCharges; i++) {
+		const size_t g = order[i];
+		for (int k = 0; k < 3; k++) {
+			_r[3 * i + k] = positions[3 * g + k];
+			_moleculeR[3 * i + k] = moleculeR[3 * g + k];
+		}
+		_q[i] = q[g];
+		_moleculeID[i] = moleculeID[g];
+	}
 
-	for (auto tM = pc->iterator(ParticleIterator::ALL_CELLS); tM.isValid(); ++tM) {
-		if (tM->inBox(lowBound, highBound)) {
-			_particles.push_back(&(*tM));
+	// radii enclosing all charges, children are stored after their parents
+	for (size_t n = _nodes.size(); n-- > 0;) {
+		Node& node = _nodes[n];
+		double radius = node.halfSize.L2Norm();
+		if (node.isLeaf()) {
+			for (size_t i = node.begin; i < node.end; i++) {
+				const Vector3<double> r(_r[3 * i], _r[3 * i + 1], _r[3 * i + 2]);
+				radius = std::max(radius, (r - node.center).L2Norm());
+			}
+		} else {
+			for (size_t c = node.firstChild; c < node.firstChild + node.numChildren; c++) {
+				radius = std::max(radius, (_nodes[c].center - node.center).L2Norm() + _nodes[c].radius);
+			}
 		}
+		node.radius = radius;
 	}
 
-	Vector3<double> ctr = _domainLength * 0.5;
+	// the expansions are kept, only new nodes are allocated
+	if (_mpCells.size() < _nodes.size()) {
+		_mpCells.resize(_nodes.size(), MpCell(_maxOrd));
+	}
+	for (size_t n = 0; n < _nodes.size(); n++) {
+		_mpCells[n].occ = _nodes[n].end - _nodes[n].begin;
+		_mpCells[n].multipole.setCenter(_nodes[n].center);
+		_mpCells[n].multipole.setRadius(_nodes[n].radius);
+		_mpCells[n].local.setCenter(_nodes[n].center);
+		_mpCells[n].local.setRadius(_nodes[n].radius);
+	}
+}
 
-	if (_threshold == 0) {
-		int depth = log2(
-				(_domainLength[0] / _cellLength[0]) * _subdivisionFactor);
-		root = new DttNode(_particles, _threshold, ctr, _domainLength, _maxOrd,
-				depth);
-	} else {
-		root = new DttNode(_particles, _threshold, ctr, _domainLength, _maxOrd,
-				0);
+void AdaptivePseudoParticleContainer::subdivide(int node, std::vector<size_t>& order,
+		const std::vector<double>& positions) {
+	const size_t begin = _nodes[node].begin, end = _nodes[node].end;
+	const int level = _nodes[node].level;
+	_maxDepth = std::max(_maxDepth, level);
+	_nodes[node].leafBegin = _leaves.size();
+
+	if (end - begin <= static_cast<size_t>(_threshold) or level >= maxTreeDepth) {
+		_nodes[node].firstChild = 0;
+		_nodes[node].numChildren = 0;
+		_leaves.push_back(node);
+		_nodes[node].leafEnd = _leaves.size();
+		return;
 	}
 
-	TargetSourceTupel tst;
-	tst.source = root;
-	tst.target = root;
-	bhfmm::Vector3<double> shift;
-	for (int i = 0; i < 3; i++) {
-		shift[i] = 0.0;
+	// sort the charges into the octants, charges outside of the box belong to the nearest octant
+	const Vector3<double> center = _nodes[node].center;
+	std::vector<int> octant(end - begin);
+	std::array<size_t, 9> octantBegin;
+	octantBegin.fill(0);
+	for (size_t i = begin; i < end; i++) {
+		const size_t g = order[i];
+		int o = 0;
+		for (int k = 0; k < 3; k++) {
+			if (positions[3 * g + k] >= center[k]) {
+				o |= 1 << k;
+			}
+		}
+		octant[i - begin] = o;
+		octantBegin[o + 1]++;
 	}
-	tst.shift = shift;
-	stack.push_back(tst);
+	for (int o = 0; o < 8; o++) {
+		octantBegin[o + 1] += octantBegin[o];
+	}
+	std::vector<size_t> sorted(end - begin);
+	std::array<size_t, 8> position;
+	std::copy(octantBegin.begin(), octantBegin.begin() + 8, position.begin());
+	for (size_t i = begin; i < end; i++) {
+		sorted[position[octant[i - begin]]++] = order[i];
+	}
+	std::copy(sorted.begin(), sorted.end(), order.begin() + begin);
 
-	if (_periodicBC) {
-		buildHaloTrees();
+	// allocate the non-empty children contiguously
+	const size_t firstChild = _nodes.size();
+	for (int o = 0; o < 8; o++) {
+		if (octantBegin[o] == octantBegin[o + 1]) {
+			continue;
+		}
+		Node child;
+		child.halfSize = _nodes[node].halfSize * 0.5;
+		for (int k = 0; k < 3; k++) {
+			child.center[k] = center[k] + (((o >> k) & 1) ? child.halfSize[k] : -child.halfSize[k]);
+		}
+		child.level = level + 1;
+		child.begin = begin + octantBegin[o];
+		child.end = begin + octantBegin[o + 1];
+		child.parent = node;
+		_nodes.push_back(child);
+	}
+	_nodes[node].firstChild = firstChild;
+	_nodes[node].numChildren = _nodes.size() - firstChild;
+
+	for (size_t c = firstChild; c < firstChild + _nodes[node].numChildren; c++) {
+		subdivide(c, order, positions);
 	}
+	_nodes[node].leafEnd = _leaves.size();
 }
 
-void AdaptivePseudoParticleContainer::upwardPass(P2MCellProcessor* /*cp*/) {
-	root->upwardPass();
+bool AdaptivePseudoParticleContainer::isWellSeparated(int target, int source, const Vector3<double>& shift) const {
+	const double distance = (_nodes[source].center + shift - _nodes[target].center).L2Norm();
+	return _nodes[target].radius + _nodes[source].radius <= separationRatio * distance;
 }
 
-void AdaptivePseudoParticleContainer::horizontalPass(
-		VectorizedChargeP2PCellProcessor* cp) {
-	// M2l and P2P
-	vc_p2p_cp = cp;
-	while (stack.size() > 0) {
-		work_on_stack();
+void AdaptivePseudoParticleContainer::traverse() {
+	_m2lLists.resize(_nodes.size());
+	_p2pLists.resize(_nodes.size());
+	for (size_t n = 0; n < _nodes.size(); n++) {
+		_m2lLists[n].clear();
+		_p2pLists[n].clear();
 	}
-}
 
-void AdaptivePseudoParticleContainer::downwardPass(L2PCellProcessor* /*cp*/) {
-	// L2L and L2P
-	root->downwardPass();
-}
-
-void AdaptivePseudoParticleContainer::buildHaloTrees() {
-	int root_depth = root->getMaxDepth();
-	double ctr[3] = { _domainLength[0] / 2, _domainLength[1] / 2,
-			_domainLength[2] / 2 };
-
-	bhfmm::Vector3<double> shift;
-	halo_node = new DttNode(_particles, _threshold, ctr, _domainLength,
-			_maxOrd, root_depth, true);
-	TargetSourceTupel tst;
-	tst.target = root;
-	tst.source = halo_node;
-
-	for (int x = -1; x <= 1; x++) {
-		shift[0] = _domainLength[0] * (double) x;
-		for (int y = -1; y <= 1; y++) {
-			shift[1] = _domainLength[1] * (double) y;
-			for (int z = -1; z <= 1; z++) {
-				if (x == 0 && y == 0 && z == 0)
-					continue;
+	// dual tree traversal, the lists are one-sided: every node collects all of its sources
+	struct Pair {
+		int target, source, image;
+	};
+	std::vector<Pair> stack;
+	for (size_t i = 0; i < _images.size(); i++) {
+		stack.push_back(Pair{0, 0, static_cast<int>(i)});
+	}
+	while (not stack.empty()) {
+		const Pair pair = stack.back();
+		stack.pop_back();
+		const Node& target = _nodes[pair.target];
+		const Node& source = _nodes[pair.source];
 
-				shift[2] = _domainLength[2] * (double) z;
-				tst.shift = shift;
-				stack.push_back(tst);
+		if (pair.target == pair.source and pair.image == 0) {
+			if (target.isLeaf()) {
+				_p2pLists[pair.target].push_back(Interaction{pair.source, 0});
+			} else {
+				for (size_t t = target.firstChild; t < target.firstChild + target.numChildren; t++) {
+					for (size_t s = target.firstChild; s < target.firstChild + target.numChildren; s++) {
+						stack.push_back(Pair{static_cast<int>(t), static_cast<int>(s), 0});
+					}
+				}
+			}
+		} else if (isWellSeparated(pair.target, pair.source, _images[pair.image])) {
+			_m2lLists[pair.target].push_back(Interaction{pair.source, pair.image});
+		} else if (target.isLeaf() and source.isLeaf()) {
+			_p2pLists[pair.target].push_back(Interaction{pair.source, pair.image});
+		} else if (target.isLeaf() or (not source.isLeaf() and source.radius > target.radius)) {
+			for (size_t s = source.firstChild; s < source.firstChild + source.numChildren; s++) {
+				stack.push_back(Pair{pair.target, static_cast<int>(s), pair.image});
+			}
+		} else {
+			for (size_t t = target.firstChild; t < target.firstChild + target.numChildren; t++) {
+				stack.push_back(Pair{static_cast<int>(t), pair.source, pair.image});
 			}
 		}
 	}
 }
 
-void AdaptivePseudoParticleContainer::print_stack_op(int op,
-		DttNode * /*t*/, DttNode * /*s*/) {
-	if (!debug) {
-		return;
+void AdaptivePseudoParticleContainer::upwardPass(P2MCellProcessor* /*cp*/) {
+	// P2M
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (size_t l = 0; l < _numLeaves; l++) {
+		const Node& leaf = _nodes[_leaves[l]];
+		MpCell& cell = _mpCells[_leaves[l]];
+		for (size_t i = leaf.begin; i < leaf.end; i++) {
+			cell.multipole.addSource(Vector3<double>(_r[3 * i], _r[3 * i + 1], _r[3 * i + 2]), _q[i]);
+		}
 	}
-	switch (op) {
-	case NO_WORK:
-		std::cout << "		--NO WORK--" << std::endl;
-		break;
-	case M2L:
-		std::cout << "		--M2L--";
-		break;
-	case P2P:
-		std::cout << "		--P2P--" << std::endl;
-		break;
-	case PUSH:
-		std::cout << "    --PUSH--" << std::endl;
-		break;
-	case POP:
-		std::cout << "    --POP--" << std::endl;
-		break;
-	}
-}
-
-void AdaptivePseudoParticleContainer::push_on_stack(DttNode * trg,
-		DttNode * src, Vector3<double> shift, int split = split_target) {
-	std::vector<DttNode*> *src_chs = new std::vector<DttNode*>();
-	std::vector<DttNode*> *trg_chs = new std::vector<DttNode*>();
-
-	TargetSourceTupel tst;
-	tst.shift = shift;
-	switch (split) {
-	case split_target:
-		if (trg->get_children(*trg_chs)) {
-			tst.source = src;
-			for (unsigned int i = 0; i < trg_chs->size(); i++) {
-				tst.target = (*trg_chs)[i];
-				if (tst.target->isEmpty()) {
-					print_stack_op(NO_WORK, tst.target, tst.source);
-					continue;
+
+	// M2M, children are stored after their parents
+	for (size_t n = _nodes.size(); n-- > 0;) {
+		const Node& node = _nodes[n];
+		for (size_t c = node.firstChild; c < node.firstChild + node.numChildren; c++) {
+			_mpCells[n].multipole.addMultipoleParticle(_mpCells[c].multipole);
+		}
+	}
+}
+
+#ifdef FMM_FFT
+bool AdaptivePseudoParticleContainer::getFFTOffset(int target, const Interaction& interaction, int offset[3]) const {
+	if (not _useFFT or _nodes[target].level != _nodes[interaction.source].level) {
+		return false;
+	}
+	const Vector3<double> distance = _nodes[interaction.source].center + _images[interaction.image]
+			- _nodes[target].center;
+	const double cellWidth = 2.0 * _nodes[target].halfSize[0];
+	for (int k = 0; k < 3; k++) {
+		offset[k] = static_cast<int>(rint(distance[k] / cellWidth));
+		// the memoized transfer functions cover the offsets within the neighbourhood of the parent
+		if (FFTSettings::USE_TFMANAGER_UNIFORMGRID and std::abs(offset[k]) > 3) {
+			return false;
+		}
+	}
+	return true;
+}
+#endif  /* FMM_FFT */
+
+void AdaptivePseudoParticleContainer::m2l(int target) {
+	MpCell& cell = _mpCells[target];
+#ifdef FMM_FFT
+	const double base_unit = 2.0 / sqrt(3);
+	const double radius = _nodes[target].halfSize.L2Norm();
+	bool initialized = false;
+	FFTAccelerableExpansion& targetExpansion = static_cast<bhfmm::SHLocalParticle&>(cell.local).getExpansion();
+#endif  /* FMM_FFT */
+	for (const Interaction& interaction : _m2lLists[target]) {
+		MpCell& source = _mpCells[interaction.source];
+#ifdef FMM_FFT
+		int offset[3];
+		if (getFFTOffset(target, interaction, offset)) {
+			if (not initialized) {
+				_FFTAcceleration->FFT_initialize_Target(targetExpansion);
+				initialized = true;
+			}
+			FFTAccelerableExpansion& sourceExpansion =
+					static_cast<bhfmm::SHMultipoleParticle&>(source.multipole).getExpansion();
+			FFTDataContainer* tf = _FFT_TM->getTransferFunction(offset[0], offset[1], offset[2], base_unit,
+					base_unit, base_unit);
+			if (FFTSettings::USE_ORDER_REDUCTION) {
+				const int M2L_order = FFTOrderReduction::getM2LOrder(offset[0], offset[1], offset[2], _maxOrd);
+				if (FFTSettings::USE_VECTORIZATION) {
+					static_cast<FFTAccelerationAPI_full*>(_FFTAcceleration)->FFT_M2L_OrderReduction_vec(
+							sourceExpansion, targetExpansion, tf, M2L_order);
+				} else {
+					static_cast<FFTAccelerationAPI_full*>(_FFTAcceleration)->FFT_M2L_OrderReduction(
+							sourceExpansion, targetExpansion, tf, M2L_order);
 				}
-				print_stack_op(PUSH, tst.target, tst.source);
-				stack.push_back(tst);
+			} else if (FFTSettings::USE_VECTORIZATION) {
+				_FFTAcceleration->FFT_M2L_vec(sourceExpansion, targetExpansion, tf);
+			} else {
+				_FFTAcceleration->FFT_M2L(sourceExpansion, targetExpansion, tf);
 			}
-		} else {
-			print_stack_op(P2P);
-			trg->p2p(src->getLeafParticleCells(), vc_p2p_cp, shift);
-		}
-		break;
-	case split_source:
-		if (src->get_children(*src_chs)) {
-			tst.target = trg;
-			for (unsigned int i = 0; i < src_chs->size(); i++) {
-				tst.source = (*src_chs)[i];
-				if (tst.source->isEmpty()) {
-					print_stack_op(NO_WORK, tst.target, tst.source);
+			if (not FFTSettings::USE_TFMANAGER_UNIFORMGRID) {
+				delete tf; //free useless memory
+			}
+			continue;
+		}
+#endif  /* FMM_FFT */
+		cell.local.addMultipoleParticle(source.multipole, _images[interaction.image]);
+	}
+#ifdef FMM_FFT
+	if (initialized) {
+		_FFTAcceleration->FFT_finalize_Target(targetExpansion, radius);
+	}
+#endif  /* FMM_FFT */
+}
+
+void AdaptivePseudoParticleContainer::p2p(int target, double& uSum, double& virialSum) {
+	const Node& node = _nodes[target];
+	for (size_t i = node.begin; i < node.end; i++) {
+		double f[3] = {0.0, 0.0, 0.0};
+		double V[3] = {0.0, 0.0, 0.0};
+		for (const Interaction& interaction : _p2pLists[target]) {
+			const Node& source = _nodes[interaction.source];
+			const Vector3<double>& shift = _images[interaction.image];
+			for (size_t j = source.begin; j < source.end; j++) {
+				// no interactions within a molecule
+				if (interaction.image == 0 and _moleculeID[i] == _moleculeID[j]) {
 					continue;
 				}
-				print_stack_op(PUSH, tst.target, tst.source);
-				stack.push_back(tst);
-			}
-		} else {
-			print_stack_op(P2P);
-			trg->p2p(src->getLeafParticleCells(), vc_p2p_cp, shift);
-		}
-		break;
-	case split_internal:
-		if (trg->get_children(*trg_chs)) {
-			mardyn_assert(src->get_children(*src_chs));
-			for (unsigned int i = 0; i < trg_chs->size(); i++) {
-				for (unsigned int j = i; j < trg_chs->size(); j++) {
-					tst.target = (*trg_chs)[i];
-					tst.source = (*trg_chs)[j];
-					if (tst.target->isEmpty() or tst.source->isEmpty()) {
-						print_stack_op(NO_WORK, tst.target, tst.source);
-						continue;
-					}
-					print_stack_op(PUSH, tst.target, tst.source);
-					stack.push_back(tst);
+				double d[3], m_d[3];
+				for (int k = 0; k < 3; k++) {
+					d[k] = _r[3 * i + k] - _r[3 * j + k] - shift[k];
+					m_d[k] = _moleculeR[3 * i + k] - _moleculeR[3 * j + k] - shift[k];
 				}
+				const double dr2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+				const double dr2_inv = 1.0 / dr2;
+				const double upot = _q[i] * _q[j] * sqrt(dr2_inv);
+				const double fac = upot * dr2_inv;
+				// every pair is visited from both sides
+				for (int k = 0; k < 3; k++) {
+					f[k] += d[k] * fac;
+					V[k] += 0.5 * m_d[k] * d[k] * fac;
+					virialSum += 0.5 * m_d[k] * d[k] * fac;
+				}
+				uSum += 0.5 * upot;
 			}
-		} else {
-			print_stack_op(P2P);
-			trg->p2p(vc_p2p_cp);
 		}
-		break;
-	default:
-		break;
+		for (int k = 0; k < 3; k++) {
+			_f[3 * i + k] += f[k];
+			_V[3 * i + k] += V[k];
+		}
 	}
-	delete src_chs;
-	delete trg_chs;
 }
 
-void AdaptivePseudoParticleContainer::work_on_stack() {
-	TargetSourceTupel tst = stack.back();
-	stack.pop_back();
-	print_stack_op(POP, tst.target, tst.source);
+void AdaptivePseudoParticleContainer::horizontalPass(VectorizedChargeP2PCellProcessor* /*cp*/) {
+	_f.assign(3 * _q.size(), 0.0);
+	_V.assign(3 * _q.size(), 0.0);
 
-	double comp_r = tst.target->getMpCell().local.getRadius()
-			- tst.source->getMpCell().multipole.getRadius();
+#ifdef FMM_FFT
+	if (_useFFT) {
+		// transform the sources of all FFT accelerated M2L operations once
+		std::vector<char> isFFTSource(_nodes.size(), 0);
+		for (size_t target = 0; target < _nodes.size(); target++) {
+			int offset[3];
+			for (const Interaction& interaction : _m2lLists[target]) {
+				if (getFFTOffset(target, interaction, offset)) {
+					isFFTSource[interaction.source] = 1;
+				}
+			}
+		}
+		#if defined(_OPENMP)
+		#pragma omp parallel for schedule(dynamic)
+		#endif
+		for (size_t n = 0; n < _nodes.size(); n++) {
+			if (isFFTSource[n]) {
+				FFTAccelerableExpansion& source =
+						static_cast<bhfmm::SHMultipoleParticle&>(_mpCells[n].multipole).getExpansion();
+				_FFTAcceleration->FFT_initialize_Source(source, _nodes[n].halfSize.L2Norm());
+			}
+		}
+	}
+#endif  /* FMM_FFT */
 
-	//TODO: hardcoded cells of equal size
-	bool sameSize = std::abs(comp_r) <= epsilon;
+	// M2L, P2P
+	double uSum = 0.0;
+	double virialSum = 0.0;
+	const int numNodes = _nodes.size();
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic) reduction(+:uSum, virialSum)
+	#endif
+	for (int n = 0; n < numNodes; n++) {
+		m2l(n);
+		if (_nodes[n].isLeaf()) {
+			p2p(n, uSum, virialSum);
+		}
+	}
+	_domain->setLocalUpot(uSum + _domain->getLocalUpot());
+	_domain->setLocalVirial(virialSum + _domain->getLocalVirial());
+}
 
-	double dist = (tst.target->getCenter() - (tst.source->getCenter() + tst.shift)).L2Norm();
+void AdaptivePseudoParticleContainer::nearFieldPass(VectorizedChargeP2PCellProcessor* /*cp*/) {
+	_f.assign(3 * _q.size(), 0.0);
+	_V.assign(3 * _q.size(), 0.0);
 
-	if (dist > epsilon) {
-//		TODO: assuming cubic cells
-		if (((tst.target->getSize(0) + tst.source->getSize(0)) / dist < 1 + epsilon) and sameSize) {
-			print_stack_op(M2L);
-			tst.target->m2l(tst.source->getMpCell().multipole, tst.shift);
-			if (tst.shift[0] == 0.0 && tst.shift[1] == 0.0
-					&& tst.shift[2] == 0.0) {
-				tst.source->m2l(tst.target->getMpCell().multipole, tst.shift);
-			}
-		} else if (comp_r < -epsilon) {
-			push_on_stack(tst.target, tst.source, tst.shift, split_source);
-		} else {
-			push_on_stack(tst.target, tst.source, tst.shift, split_target);
+	// P2P
+	double uSum = 0.0;
+	double virialSum = 0.0;
+	const int numLeaves = _numLeaves;
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic) reduction(+:uSum, virialSum)
+	#endif
+	for (int l = 0; l < numLeaves; l++) {
+		p2p(_leaves[l], uSum, virialSum);
+	}
+	_domain->setLocalUpot(uSum + _domain->getLocalUpot());
+	_domain->setLocalVirial(virialSum + _domain->getLocalVirial());
+
+	addForces();
+}
+
+void AdaptivePseudoParticleContainer::l2p(int target, double& uSum, double& virialSum) {
+	const Node& node = _nodes[target];
+	const SHLocalParticle& local = _mpCells[target].local;
+	double u = 0.0;
+	Vector3<double> f_vec3;
+	for (size_t i = node.begin; i < node.end; i++) {
+		const Vector3<double> dr(_r[3 * i], _r[3 * i + 1], _r[3 * i + 2]);
+		local.actOnTarget(dr, _q[i], u, f_vec3);
+		double virial = 0.0;
+		for (int k = 0; k < 3; k++) {
+			_f[3 * i + k] += _farFieldFactor * f_vec3[k];
+			virial += -f_vec3[k] * dr[k];
 		}
-	} else {
-		push_on_stack(tst.target, tst.source, tst.shift, split_internal);
+		uSum += 0.5 * u;
+		virialSum += 0.5 * virial;
 	}
 }
 
-} //namespace bhfmm
+void AdaptivePseudoParticleContainer::downwardPass(L2PCellProcessor* /*cp*/) {
+	// L2L, parents are stored before their children
+	for (size_t n = 1; n < _nodes.size(); n++) {
+		_mpCells[_nodes[n].parent].local.actOnLocalParticle(_mpCells[n].local);
+	}
+
+	// L2P
+	double uSum = 0.0;
+	double virialSum = 0.0;
+	const int numLeaves = _numLeaves;
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic) reduction(+:uSum, virialSum)
+	#endif
+	for (int l = 0; l < numLeaves; l++) {
+		l2p(_leaves[l], uSum, virialSum);
+	}
+	_domain->setLocalUpot(uSum + _domain->getLocalUpot());
+	_domain->setLocalVirial(virialSum + _domain->getLocalVirial());
+
+	addForces();
+}
+
+void AdaptivePseudoParticleContainer::addForces() {
+	for (size_t i = 0; i < _q.size(); i++) {
+		const std::pair<Molecule*, unsigned>& charge = _localCharges[_treeToLocal[i]];
+		charge.first->Fchargeadd(charge.second, &_f[3 * i]);
+		charge.first->Viadd(&_V[3 * i]);
+	}
+}
 
+void AdaptivePseudoParticleContainer::printTimers() {
+	Log::global_log->info() << "AdaptivePseudoParticleContainer: " << _numLeaves << " leaves, " << _nodes.size()
+							<< " nodes, depth " << _maxDepth << std::endl;
+}
+
+} //namespace bhfmm
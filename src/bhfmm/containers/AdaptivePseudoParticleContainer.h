@@ -3,51 +3,59 @@
 
 #include "bhfmm/utils/Vector3.h"
 #include "PseudoParticleContainer.h"
-#include "DttNode.h"
 #include "bhfmm/cellProcessors/VectorizedChargeP2PCellProcessor.h"
 
+#ifdef FMM_FFT
+#include "bhfmm/fft/FFTAccelerationAPI.h"
+#include "bhfmm/fft/FFTAccelerationAPI_extensions.h"
+#include "bhfmm/fft/FFTSettings.h"
+#include "bhfmm/fft/FFTFactory.h"
+#include "bhfmm/fft/FFTOrderReduction.h"
+#include "bhfmm/fft/TransferFunctionManagerAPI.h"
+#endif /* FMM_FFT */
+
 #include <vector>
 #include <cmath>
 #include <math.h>
 #include <stdlib.h>
 
-
+class Domain;
+#include "molecules/MoleculeForwardDeclaration.h"
 
 namespace bhfmm {
 
-typedef struct {
-	DttNode *target, *source;
-	Vector3<double> shift;
-} TargetSourceTupel;
-
+/**
+ * @brief Adaptive FMM container: octree refined by the number of charges, traversed with a dual tree traversal.
+ *
+ * In every time step, the tree is built anew over the domain. A node is subdivided as long as it holds more than
+ * threshold charges. The dual tree traversal (27 periodic images of the root if periodic) builds the M2L and P2P
+ * interaction lists of every node.
+ *
+ * M2L operations between nodes of equal size use the FFT acceleration, if MarDyn is compiled with FMM_FFT (cmake
+ * option ENABLE_FMM_FFT) and the domain is cubic.
+ *
+ * @note Experimental: runs on one process only (FastMultipoleMethod stops with more processes, there are no locally
+ * essential trees), and the P2P interactions are evaluated with a scalar loop.
+ */
 class AdaptivePseudoParticleContainer: public PseudoParticleContainer {
 public:
-	AdaptivePseudoParticleContainer(double domainLength[3], int threshold,
-			int orderOfExpansions, bool periodic = true) :
-			PseudoParticleContainer(orderOfExpansions), _periodicBC(periodic), _threshold(
-					threshold), root(0), halo_node(0), _domainLength(
-					domainLength), _subdivisionFactor(0) {
-		mardyn_assert(_threshold > 0);
-	}
+	/**
+	 * @param domainLength global domain length
+	 * @param threshold maximum number of charges in a leaf
+	 * @param orderOfExpansions order of the multipole and local expansions
+	 * @param periodic whether the 26 periodic images of the domain are considered
+	 */
+	AdaptivePseudoParticleContainer(double domainLength[3], int threshold, int orderOfExpansions,
+			bool periodic = true);
 
-	AdaptivePseudoParticleContainer(double domainLength[3],
-			int orderOfExpansions, double cellLength[3], int subdivisionFactor,
-			bool periodic) :
-			PseudoParticleContainer(orderOfExpansions), _periodicBC(periodic), _threshold(
-					0), root(0), _domainLength(domainLength), _cellLength(
-					cellLength), _subdivisionFactor(subdivisionFactor) {
-	}
-
-	~AdaptivePseudoParticleContainer() {
-		delete root;
-	}
-	;
+	~AdaptivePseudoParticleContainer();
 
 	void clear();
 	void build(ParticleContainer* pc);
 	void upwardPass(P2MCellProcessor * cp);
 	void horizontalPass(VectorizedChargeP2PCellProcessor * cp);
 	void downwardPass(L2PCellProcessor *cp);
+	void nearFieldPass(VectorizedChargeP2PCellProcessor * cp);
 
 	void processMultipole(ParticleCellPointers& /*cell*/) {
 	}
@@ -55,28 +63,94 @@ public:
 	}
 	void processTree() {
 	}
-	void printTimers() {
+	void printTimers();
+
+	//! @return number of leaves of the current tree
+	size_t getNumLeaves() const {
+		return _numLeaves;
+	}
+
+	//! @return number of nodes of the current tree
+	size_t getNumNodes() const {
+		return _nodes.size();
 	}
-	;
 
 private:
-	bool _periodicBC;
+	struct Node {
+		Vector3<double> center;
+		Vector3<double> halfSize;
+		//! radius of the sphere around center containing all charges (charges may lie outside of the box)
+		double radius;
+		int level;
+		//! charges [begin, end) in tree order
+		size_t begin, end;
+		//! leaves [leafBegin, leafEnd) in tree order
+		size_t leafBegin, leafEnd;
+		//! children are stored in [firstChild, firstChild + numChildren)
+		size_t firstChild;
+		int numChildren;
+		int parent;
+
+		bool isLeaf() const {
+			return numChildren == 0;
+		}
+	};
+
+	struct Interaction {
+		int source;
+		int image;
+	};
 
-	VectorizedChargeP2PCellProcessor * vc_p2p_cp;
-	std::vector<Molecule *> _particles;
+	bool _periodicBC;
 	int _threshold;
-	std::vector<TargetSourceTupel> stack;
-	DttNode *root, *halo_node;
-	Vector3<double> _domainLength, _cellLength;
-	int _subdivisionFactor;
-
-	void buildHaloTrees();
-	void work_on_stack();
-	void push_on_stack(DttNode * trg, DttNode * src,
-			Vector3<double> shift, int split);
-	void print_stack_op(int op, DttNode * t = NULL,
-			DttNode * s = NULL);
-
+	Vector3<double> _domainLength;
+	Domain* _domain;
+
+	//! the tree: root at index 0, the children of a node are stored contiguously after their parent
+	std::vector<Node> _nodes;
+	//! expansions of the nodes, reused between time steps
+	std::vector<MpCell> _mpCells;
+	size_t _numLeaves;
+	//! node index of every leaf
+	std::vector<int> _leaves;
+	//! M2L sources and P2P sources of every node
+	std::vector<std::vector<Interaction> > _m2lLists, _p2pLists;
+	//! shift of the periodic images, image 0 is the domain itself
+	std::vector<Vector3<double> > _images;
+
+	//! charges in tree order
+	std::vector<double> _r, _q, _moleculeR;
+	std::vector<unsigned long> _moleculeID;
+	//! index of the charge in tree order -> index in _localCharges
+	std::vector<size_t> _treeToLocal;
+	//! charges: molecule and index of the charge in the molecule
+	std::vector<std::pair<Molecule*, unsigned> > _localCharges;
+	//! force and virial of every charge in tree order
+	std::vector<double> _f, _V;
+
+	int _maxDepth;
+
+#ifdef FMM_FFT
+	bool _useFFT;
+	TransferFunctionManagerAPI* _FFT_TM;
+	FFTAccelerationAPI* _FFTAcceleration;
+#endif  /* FMM_FFT */
+
+	void collectCharges(ParticleContainer* pc);
+	void buildTree();
+	void subdivide(int node, std::vector<size_t>& order, const std::vector<double>& positions);
+	void traverse();
+	bool isWellSeparated(int target, int source, const Vector3<double>& shift) const;
+
+	void m2l(int target);
+	void p2p(int target, double& uSum, double& virialSum);
+	void l2p(int target, double& uSum, double& virialSum);
+	void addForces();
+
+#ifdef FMM_FFT
+	//! @return whether the interaction uses the FFT acceleration, offset in cells between source and target
+	bool getFFTOffset(int target, const Interaction& interaction, int offset[3]) const;
+#endif  /* FMM_FFT */
 };
 //AdaptivePseudoParticleContainer
 
@@ -55,6 +55,13 @@ public:
 	virtual void upwardPass(P2MCellProcessor * cp) = 0;
 	virtual void horizontalPass(VectorizedChargeP2PCellProcessor * cp) = 0;
 	virtual void downwardPass(L2PCellProcessor *cp) = 0;
+	//! @brief Evaluates only the near field (P2P), for time steps without far field (multiple time stepping).
+	virtual void nearFieldPass(VectorizedChargeP2PCellProcessor * cp) = 0;
+
+	//! @brief weight of the far field forces (L2P) on the charges, energy and virial are not weighted
+	void setFarFieldFactor(double factor) {
+		_farFieldFactor = factor;
+	}
 
 	// P2M
 	virtual void processMultipole(ParticleCellPointers& cell) = 0;
@@ -69,6 +76,7 @@ public:
 
 protected:
 	int _maxOrd;
+	double _farFieldFactor{1.0};
 
 };
 
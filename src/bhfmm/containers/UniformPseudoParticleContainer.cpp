@@ -1665,6 +1665,13 @@ int UniformPseudoParticleContainer::busyWaiting(){
 #endif
 }
 
+void UniformPseudoParticleContainer::nearFieldPass(VectorizedChargeP2PCellProcessor* cp) {
+	// P2P
+	_leafContainer->traverseCellPairs(*cp);
+
+	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_FMM_COMPLETE");
+}
+
 void UniformPseudoParticleContainer::downwardPass(L2PCellProcessor* cp) {
 	// L2L
 	int curCellsEdge=1;
@@ -3323,6 +3330,9 @@ void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell)
 			P_xxSum += 0.5 * -f[0] * dr[0];
 			P_yySum += 0.5 * -f[1] * dr[1];
 			P_zzSum += 0.5 * -f[2] * dr[2];
+			for (int k = 0; k < 3; k++) {
+				f[k] *= _farFieldFactor;
+			}
 			molecule1.Fchargeadd(j, f);
 			uSum += 0.5 * u;
 			virialSum += 0.5 * virial;
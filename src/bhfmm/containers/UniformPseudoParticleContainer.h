@@ -54,6 +54,7 @@ public:
 	void upwardPass(P2MCellProcessor * cp);
 	void horizontalPass(VectorizedChargeP2PCellProcessor * cp);
 	void downwardPass(L2PCellProcessor *cp);
+	void nearFieldPass(VectorizedChargeP2PCellProcessor * cp);
 
 	// P2M
 	void processMultipole(ParticleCellPointers& cell);
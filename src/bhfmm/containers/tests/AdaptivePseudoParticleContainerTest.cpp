@@ -0,0 +1,112 @@
+/*
+ * AdaptivePseudoParticleContainerTest.cpp
+ */
+
+#include "bhfmm/containers/tests/AdaptivePseudoParticleContainerTest.h"
+#include "bhfmm/containers/AdaptivePseudoParticleContainer.h"
+#include "bhfmm/FastMultipoleMethod.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "molecules/Molecule.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(AdaptivePseudoParticleContainerTest);
+
+AdaptivePseudoParticleContainerTest::AdaptivePseudoParticleContainerTest() {
+}
+
+AdaptivePseudoParticleContainerTest::~AdaptivePseudoParticleContainerTest() {
+}
+
+void AdaptivePseudoParticleContainerTest::testRefinementByCount() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "AdaptivePseudoParticleContainerTest::testRefinementByCount()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+	double globalDomainLength[3] = {8., 8., 8.};
+	ParticleContainer * container = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", 1.0);
+
+	// the two close charges are separated on level 2, the third one is alone on level 1
+	bhfmm::AdaptivePseudoParticleContainer fine(globalDomainLength, 1, 2, true);
+	fine.build(container);
+	ASSERT_EQUAL(static_cast<size_t>(3), fine.getNumLeaves());
+	ASSERT_EQUAL(static_cast<size_t>(5), fine.getNumNodes());
+
+	bhfmm::AdaptivePseudoParticleContainer coarse(globalDomainLength, 3, 2, true);
+	coarse.build(container);
+	ASSERT_EQUAL(static_cast<size_t>(1), coarse.getNumLeaves());
+	ASSERT_EQUAL(static_cast<size_t>(1), coarse.getNumNodes());
+
+	delete container;
+}
+
+void AdaptivePseudoParticleContainerTest::compareWithDirectSum(bool periodic) {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "AdaptivePseudoParticleContainerTest::compareWithDirectSum()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+	double globalDomainLength[3] = {8., 8., 8.};
+	double bBoxMin[3] = {0., 0., 0.};
+	double bBoxMax[3] = {8., 8., 8.};
+	double LJCellLength[3] = {1., 1., 1.};
+	ParticleContainer * container = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", 1.0);
+
+	// one charge per leaf, so that all operators are used
+	bhfmm::FastMultipoleMethod adaptive;
+	adaptive.setParameters(1, 16, periodic, true, 1);
+	adaptive.init(globalDomainLength, bBoxMin, bBoxMax, LJCellLength, container);
+	adaptive.computeElectrostatics(container);
+
+	std::vector<std::array<double, 3> > positions;
+	std::vector<double> charges;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		positions.push_back({m->r(0), m->r(1), m->r(2)});
+		charges.push_back(m->component()->charge(0).q());
+	}
+
+	const int images = periodic ? 1 : 0;
+	size_t i = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m, ++i) {
+		double f[3] = {0.0, 0.0, 0.0};
+		for (size_t j = 0; j < positions.size(); j++) {
+			for (int x = -images; x <= images; x++) {
+				for (int y = -images; y <= images; y++) {
+					for (int z = -images; z <= images; z++) {
+						if (i == j and x == 0 and y == 0 and z == 0) {
+							continue;
+						}
+						const int shift[3] = {x, y, z};
+						double d[3];
+						double dr2 = 0.0;
+						for (int k = 0; k < 3; k++) {
+							d[k] = positions[i][k] - positions[j][k] - shift[k] * globalDomainLength[k];
+							dr2 += d[k] * d[k];
+						}
+						for (int k = 0; k < 3; k++) {
+							f[k] += charges[i] * charges[j] * d[k] / (dr2 * sqrt(dr2));
+						}
+					}
+				}
+			}
+		}
+		ASSERT_DOUBLES_EQUAL_MSG("Force component x should be equal", f[0], m->F(0), 1e-4);
+		ASSERT_DOUBLES_EQUAL_MSG("Force component y should be equal", f[1], m->F(1), 1e-4);
+		ASSERT_DOUBLES_EQUAL_MSG("Force component z should be equal", f[2], m->F(2), 1e-4);
+	}
+
+	delete container;
+}
+
+void AdaptivePseudoParticleContainerTest::testForces() {
+	compareWithDirectSum(true);
+}
+
+void AdaptivePseudoParticleContainerTest::testForcesWithoutPeriodicBC() {
+	compareWithDirectSum(false);
+}
@@ -0,0 +1,33 @@
+/*
+ * AdaptivePseudoParticleContainerTest.h
+ */
+
+#ifndef SRC_BHFMM_CONTAINERS_TESTS_ADAPTIVEPSEUDOPARTICLECONTAINERTEST_H_
+#define SRC_BHFMM_CONTAINERS_TESTS_ADAPTIVEPSEUDOPARTICLECONTAINERTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+class AdaptivePseudoParticleContainerTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(AdaptivePseudoParticleContainerTest);
+
+	TEST_METHOD(testRefinementByCount);
+	TEST_METHOD(testForces);
+	TEST_METHOD(testForcesWithoutPeriodicBC);
+
+	TEST_SUITE_END();
+
+public:
+	AdaptivePseudoParticleContainerTest();
+	virtual ~AdaptivePseudoParticleContainerTest();
+
+	void testRefinementByCount();
+	void testForces();
+	void testForcesWithoutPeriodicBC();
+
+private:
+	//! compare the forces of the adaptive FMM with the direct summation over the (periodic images of the) charges
+	void compareWithDirectSum(bool periodic);
+};
+
+#endif /* SRC_BHFMM_CONTAINERS_TESTS_ADAPTIVEPSEUDOPARTICLECONTAINERTEST_H_ */
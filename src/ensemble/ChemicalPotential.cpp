@@ -2,9 +2,27 @@
 
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/ParticleContainer.h"
+#include "particleContainer/adapter/CellProcessor.h"
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "utils/Logger.h"
 
+namespace {
+
+//! @brief Pair energy of a test molecule with a molecule, which is not (or no longer) part of the container.
+//! @details Both molecules need their own SoA. Same cutoff handling as the LegacyCellProcessor.
+double pairEnergy(ParticlePairsHandler& particlePairsHandler, Molecule& testMolecule, Molecule& other,
+				  double cutoffRadiusSquare, double LJCutoffRadiusSquare) {
+	double distanceVector[3];
+	const double dd = other.dist2(testMolecule, distanceVector);
+	if (dd >= cutoffRadiusSquare) {
+		return 0.0;
+	}
+	return particlePairsHandler.processPair(testMolecule, other, distanceVector, MOLECULE_MOLECULE_FLUID, dd,
+											(dd < LJCutoffRadiusSquare));
+}
+
+}  // namespace
+
 
 ChemicalPotential::ChemicalPotential()
 {
@@ -457,6 +475,8 @@ void ChemicalPotential::grandcanonicalStep(
 	double DeltaUpot;
 
 	ParticlePairs2PotForceAdapter particlePairsHandler(*domain);
+	const double cutoffRadiusSquare = cellProcessor->getCutoffRadiusSquare();
+	const double LJCutoffRadiusSquare = cellProcessor->getLJCutoffRadiusSquare();
 
 	_localInsertionsMinusDeletions = 0;
 
@@ -468,15 +488,61 @@ void ChemicalPotential::grandcanonicalStep(
 		maxco[d] = moleculeContainer->getBoundingBoxMax(d);
 	}
 
+	if (!this->hasSample()) {
+		for (auto mit = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); mit.isValid(); ++mit) {
+			if (mit->componentid() == this->getComponentID()) {
+				this->storeMolecule(*mit);
+				break;
+			}
+		}
+	}
+
+	// All trial insertions of this step are set up in advance and their energies are calculated in one batch
+	// with respect to the configuration at the beginning of the step.
+	std::vector<Molecule> trialInsertions;
+	std::vector<double> trialEnergies;
+	double ins[3];
+	for (unsigned long nextid = this->getInsertion(ins); nextid > 0; nextid = this->getInsertion(ins)) {
+		Molecule tmp = this->loadMolecule();
+		for (int d = 0; d < 3; d++)
+			tmp.setr(d, ins[d]);
+		tmp.setid(nextid);
+		// reset forces and torques to zero
+		if (!this->isWidom()) {
+			double zeroVec[3] = { 0.0, 0.0, 0.0 };
+			tmp.setF(zeroVec);
+			tmp.setM(zeroVec);
+			tmp.setVi(zeroVec);
+		}
+		tmp.check(nextid);
+		trialInsertions.push_back(tmp);
+	}
+	moleculeContainer->getEnergies(&particlePairsHandler, trialInsertions, trialEnergies, *cellProcessor);
+
+	// Accepted deletions are removed from the container right away, accepted insertions are collected and added after
+	// all trials, so the caches are rebuilt only once. The energies of the following trials are corrected by the pair
+	// energies with the molecules deleted and inserted before (both kept with their own SoA until the end of the step).
+	std::vector<Molecule> deleted;
+	std::vector<Molecule> inserted;
+	inserted.reserve(trialInsertions.size());
+
 	bool hasDeletion = true;
 	bool hasInsertion = true;
-	double ins[3];
-	unsigned nextid = 0;
+	size_t nextTrial = 0;
 	while (hasDeletion || hasInsertion) {
 		if (hasDeletion) {
 			auto m = this->getDeletion(moleculeContainer, minco, maxco);
 			if(m.isValid()) {
-				DeltaUpot = -1.0 * moleculeContainer->getEnergy(&particlePairsHandler, &(*m), *cellProcessor);
+				std::vector<double> energy;
+				moleculeContainer->getEnergies(&particlePairsHandler, std::vector<Molecule>(1, *m), energy,
+											   *cellProcessor);
+				Molecule candidate = *m;
+				candidate.buildOwnSoA();
+				for (auto& insertedMolecule : inserted) {
+					energy[0] += pairEnergy(particlePairsHandler, candidate, insertedMolecule, cutoffRadiusSquare,
+											LJCutoffRadiusSquare);
+				}
+				DeltaUpot = -1.0 * energy[0];
 
 				accept = this->decideDeletion(DeltaUpot / T);
 #ifndef NDEBUG
@@ -484,14 +550,8 @@ void ChemicalPotential::grandcanonicalStep(
 					std::cout << "r" << this->rank() << "d" << m->getID() << " with energy " << DeltaUpot << std::endl;
 					std::cout.flush();
 				}
-				/*
-				 else
-				 cout << "   (r" << this->rank() << "-d" << m->getID()
-				 << ")" << std::endl;
-				 */
 #endif
 				if (accept) {
-					// m->upd_cache(); TODO what to do here? somebody deleted the method "upd_cache"!!! why???
 					// reset forces and momenta to zero
 					{
 						double zeroVec[3] = {0.0, 0.0, 0.0};
@@ -502,94 +562,72 @@ void ChemicalPotential::grandcanonicalStep(
 
 					this->storeMolecule(*m);
 
-					moleculeContainer->deleteMolecule(m, true/*rebuildCaches*/);
-					m = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+					deleted.push_back(candidate);
+					moleculeContainer->deleteMolecule(m, false/*rebuildCaches*/);
 					_localInsertionsMinusDeletions--;
+				} else {
+					candidate.releaseOwnSoA();
 				}
 			} else{
 				hasDeletion = false;
 			}
 		} /* end of second hasDeletion */
 
-		if (!this->hasSample()) {
-			for (auto mit = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); mit.isValid(); ++mit) {
-				if (mit->componentid() == this->getComponentID()) {
-
-					this->storeMolecule(*mit);
-					break;
-				}
-			}
-		}
 		if (hasInsertion) {
-			nextid = this->getInsertion(ins);
-			hasInsertion = (nextid > 0);
+			hasInsertion = (nextTrial < trialInsertions.size());
 		}
 		if (hasInsertion) {
-			Molecule tmp = this->loadMolecule();
+			Molecule& tmp = trialInsertions[nextTrial];
+			DeltaUpot = trialEnergies[nextTrial];
+			nextTrial++;
 			for (int d = 0; d < 3; d++)
-				tmp.setr(d, ins[d]);
-			tmp.setid(nextid);
-			// TODO: I (tchipevn) am changing the former code
-			// (add particle, compute energy and if rejected, delete particle)
-			// to: add particle only if accepted
-//			_particles.push_back(tmp);
-
-//			std::list<Molecule>::iterator mit = _particles.end();
-			Molecule* mit = &tmp;
-			// m->upd_cache(); TODO: what to do here? somebody deleted the method "upd_cache"!!! why??? -- update caches do no longer exist ;)
-			// reset forces and torques to zero
-			if (!this->isWidom()) {
-				double zeroVec[3] = { 0.0, 0.0, 0.0 };
-				mit->setF(zeroVec);
-				mit->setM(zeroVec);
-				mit->setVi(zeroVec);
-			}
-			mit->check(nextid);
-#ifndef NDEBUG
-			/*
-			 cout << "rank " << this->rank() << ": insert "
-			 << m->getID() << " at the reduced position (" << ins[0] << "/"
-			 << ins[1] << "/" << ins[2] << ")? " << std::endl;
-			 */
-#endif
+				ins[d] = tmp.r(d);
 
-//			unsigned long cellid = moleculeContainer->getCellIndexOfMolecule(m);
-//			moleculeContainer->_cells[cellid].addParticle(m);
-			DeltaUpot = moleculeContainer->getEnergy(&particlePairsHandler, mit,
-					*cellProcessor);
+			// the Widom method never accepts an insertion, so no corrections are needed
+			const bool ownSoA = not this->isWidom();
+			if (ownSoA) {
+				tmp.buildOwnSoA();
+			}
+			for (auto& deletedMolecule : deleted) {
+				DeltaUpot -= pairEnergy(particlePairsHandler, tmp, deletedMolecule, cutoffRadiusSquare,
+										LJCutoffRadiusSquare);
+			}
+			for (auto& insertedMolecule : inserted) {
+				DeltaUpot += pairEnergy(particlePairsHandler, tmp, insertedMolecule, cutoffRadiusSquare,
+										LJCutoffRadiusSquare);
+			}
 			domain->submitDU(this->getComponentID(), DeltaUpot, ins);
 			accept = this->decideInsertion(DeltaUpot / T);
 
 #ifndef NDEBUG
 			if (accept) {
-				std::cout << "r" << this->rank() << "i" << mit->getID()
+				std::cout << "r" << this->rank() << "i" << tmp.getID()
 						<< " with energy " << DeltaUpot << std::endl;
 				std::cout.flush();
 			}
-			/*
-			 else
-			 cout << "   (r" << this->rank() << "-i"
-			 << mit->getID() << ")" << std::endl;
-			 */
 #endif
 			if (accept) {
 				this->_localInsertionsMinusDeletions++;
 				double zeroVec[3] = { 0.0, 0.0, 0.0 };
 				tmp.setVi(zeroVec);
-				bool inBoxCheckedAlready = false, checkWhetherDuplicate = false, rebuildCaches = true;
-				moleculeContainer->addParticle(tmp, inBoxCheckedAlready, checkWhetherDuplicate, rebuildCaches);
-			} else {
-				// moleculeContainer->deleteMolecule(m->getID(), m->r(0), m->r(1), m->r(2));
-//				moleculeContainer->_cells[cellid].deleteMolecule(m->getID());
-				double zeroVec[3] = { 0.0, 0.0, 0.0 };
-				mit->setF(zeroVec);
-				mit->setM(zeroVec);
-				mit->setVi(zeroVec);
-				mit->check(mit->getID());
-//				moleculeContainer->_particles.erase(mit);
+				inserted.push_back(tmp);
+			} else if (ownSoA) {
+				tmp.releaseOwnSoA();
 			}
 		}
 	}
+
+	for (auto& deletedMolecule : deleted) {
+		deletedMolecule.releaseOwnSoA();
+	}
+	for (auto& insertedMolecule : inserted) {
+		insertedMolecule.releaseOwnSoA();
+		bool inBoxCheckedAlready = false, checkWhetherDuplicate = false, rebuildCaches = false;
+		moleculeContainer->addParticle(insertedMolecule, inBoxCheckedAlready, checkWhetherDuplicate, rebuildCaches);
+	}
+	if (not deleted.empty() or not inserted.empty()) {
+		moleculeContainer->updateMoleculeCaches();
+	}
 #ifndef NDEBUG
 	for (auto m = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
 		// cout << *m << "\n";
@@ -75,6 +75,14 @@ public:
 		return _timestepLength;
 	}
 
+	//! @brief weight of the slow forces (long range correction, FMM far field) in the given time step
+	//!
+	//! The slow forces are only calculated in time steps with a non-zero weight and are multiplied with it.
+	//! Integrators with multiple time stepping return the number of time steps between two evaluations.
+	virtual double getSlowForceFactor(unsigned long /*simstep*/) const {
+		return 1.0;
+	}
+
 protected:
 
 	//! time between time step n and time step (n+1)
@@ -1,8 +1,12 @@
 #include "Leapfrog.h"
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <vector>
 
 #include "Domain.h"
+#include "Simulation.h"
+#include "WrapOpenMP.h"
 #include "ensemble/EnsembleBase.h"
 #include "molecules/Molecule.h"
 #include "particleContainer/ParticleContainer.h"
@@ -10,6 +14,50 @@
 #include "utils/Logger.h"
 #include "utils/xmlfileUnits.h"
 
+namespace {
+
+//! number of molecules, which are collected from the iterator and integrated together
+constexpr size_t batchSize = 256;
+
+void preF(Molecule* const* molecules, size_t count, double dt) {
+#if !defined(ENABLE_REDUCED_MEMORY_MODE) && !defined(MARDYN_AUTOPAS)
+	FullMolecule::upd_preF_batch(molecules, count, dt);
+#else
+	for (size_t i = 0; i < count; ++i) {
+		molecules[i]->upd_preF(dt);
+	}
+#endif
+}
+
+void postF(Molecule* const* molecules, size_t count, double dt_half, double* mv2, double* Iw2) {
+#if !defined(ENABLE_REDUCED_MEMORY_MODE) && !defined(MARDYN_AUTOPAS)
+	FullMolecule::upd_postF_batch(molecules, count, dt_half, mv2, Iw2);
+#else
+	for (size_t i = 0; i < count; ++i) {
+		mv2[i] = 0.0;
+		Iw2[i] = 0.0;
+		molecules[i]->upd_postF(dt_half, mv2[i], Iw2[i]);
+	}
+#endif
+}
+
+//! local sums of the thermostats, indexed by thermostat id + 1 (id -1 denotes molecules without thermostat)
+struct ThermostatSums {
+	void resize(size_t numThermostats) {
+		N.assign(numThermostats, 0);
+		rotDOF.assign(numThermostats, 0);
+		summv2.assign(numThermostats, 0.0);
+		sumIw2.assign(numThermostats, 0.0);
+	}
+
+	std::vector<unsigned long> N;
+	std::vector<unsigned long> rotDOF;
+	std::vector<double> summv2;
+	std::vector<double> sumIw2;
+};
+
+}  // namespace
+
 
 Leapfrog::Leapfrog(double timestepLength) :	Integrator(timestepLength) {
 	init();
@@ -52,9 +100,16 @@ void Leapfrog::transition1to2(ParticleContainer* molCont, Domain* /*domain*/) {
 	#pragma omp parallel
 	#endif
 	{
+		std::array<Molecule*, batchSize> batch;
+		size_t count = 0;
 		for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
-			i->upd_preF(_timestepLength);
+			batch[count++] = &(*i);
+			if (count == batchSize) {
+				preF(batch.data(), count, _timestepLength);
+				count = 0;
+			}
 		}
+		preF(batch.data(), count, _timestepLength);
 	}
 
 	this->_state = STATE_PRE_FORCE_CALCULATION;
@@ -65,81 +120,79 @@ void Leapfrog::transition2to3(ParticleContainer* molCont, Domain* domain) {
 		Log::global_log->error() << "Leapfrog::transition2to3(...): Wrong state for state transition" << std::endl;
 	}
 
-	/* TODO introduce
-	  	class Thermostat {
-		unsigned long N, rotDOF;
-		double summv2, sumIw2;
-	};
-	 * but not here, rather in a separate class. The current implementation of the thermostats
-	 * (here and in class Domain) is a nightmare.
-	 */
-
-	std::map<int, unsigned long> N;
-	std::map<int, unsigned long> rotDOF;
-	std::map<int, double> summv2;
-	std::map<int, double> sumIw2;
-	double dt_half = 0.5 * this->_timestepLength;
-	if (domain->severalThermostats()) {
-		#if defined(_OPENMP)
-		#pragma omp parallel
-		#endif
-		{
-			std::map<int, unsigned long> N_l;
-			std::map<int, unsigned long> rotDOF_l;
-			std::map<int, double> summv2_l;
-			std::map<int, double> sumIw2_l;
-
-			for (auto tM = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tM.isValid(); ++tM) {
-				int cid = tM->componentid();
-				int thermostat = domain->getThermostat(cid);
-				tM->upd_postF(dt_half, summv2_l[thermostat], sumIw2_l[thermostat]);
-				N_l[thermostat]++;
-				rotDOF_l[thermostat] += tM->component()->getRotationalDegreesOfFreedom();
+	// The sums of all thermostats are collected in fixed-size arrays. The thermostat of each component is looked up
+	// once, with a single thermostat all molecules contribute to thermostat 0.
+	std::vector<Component>& components = *global_simulation->getEnsemble()->getComponents();
+	const bool severalThermostats = domain->severalThermostats();
+	std::vector<int> indexOfComponent(components.size());
+	std::vector<unsigned long> rotDOFOfComponent(components.size());
+	size_t numThermostats = 0;
+	for (size_t cid = 0; cid < components.size(); ++cid) {
+		const int thermostat = severalThermostats ? domain->getThermostat(cid) : 0;
+		indexOfComponent[cid] = thermostat + 1;
+		rotDOFOfComponent[cid] = components[cid].getRotationalDegreesOfFreedom();
+		numThermostats = std::max(numThermostats, static_cast<size_t>(thermostat + 2));
+	}
+
+	const double dt_half = 0.5 * this->_timestepLength;
+	std::vector<ThermostatSums> threadSums(mardyn_get_max_threads());
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		ThermostatSums& sums = threadSums[mardyn_get_thread_num()];
+		sums.resize(numThermostats);
+
+		std::array<Molecule*, batchSize> batch;
+		std::array<double, batchSize> mv2;
+		std::array<double, batchSize> Iw2;
+		auto integrateBatch = [&](size_t count) {
+			postF(batch.data(), count, dt_half, mv2.data(), Iw2.data());
+			for (size_t i = 0; i < count; ++i) {
+				const int cid = batch[i]->componentid();
+				const int index = indexOfComponent[cid];
+				sums.summv2[index] += mv2[i];
+				sums.sumIw2[index] += Iw2[i];
+				sums.N[index]++;
+				sums.rotDOF[index] += rotDOFOfComponent[cid];
 			}
+		};
 
-			#if defined(_OPENMP)
-			#pragma omp critical (thermostat)
-			#endif
-			{
-				for (auto & it : N_l) N[it.first] += it.second;
-				for (auto & it : rotDOF_l) rotDOF[it.first] += it.second;
-				for (auto & it : summv2_l) summv2[it.first] += it.second;
-				for (auto & it : sumIw2_l) sumIw2[it.first] += it.second;
+		size_t count = 0;
+		for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
+			batch[count++] = &(*i);
+			if (count == batchSize) {
+				integrateBatch(count);
+				count = 0;
 			}
 		}
+		integrateBatch(count);
+	} // end pragma omp parallel
+
+	// the thread sums are added in a fixed order, which keeps the result independent of the thread scheduling
+	ThermostatSums total;
+	total.resize(numThermostats);
+	for (const auto& sums : threadSums) {
+		for (size_t index = 0; index < numThermostats; ++index) {
+			total.N[index] += sums.N[index];
+			total.rotDOF[index] += sums.rotDOF[index];
+			total.summv2[index] += sums.summv2[index];
+			total.sumIw2[index] += sums.sumIw2[index];
+		}
 	}
-	else {
-		#if defined(_OPENMP)
-		#pragma omp parallel
-		#endif
-		{
-			unsigned long Ngt_l = 0;
-			unsigned long rotDOFgt_l = 0;
-			double summv2gt_l = 0.0;
-			double sumIw2gt_l = 0.0;
-
-			for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
-				i->upd_postF(dt_half, summv2gt_l, sumIw2gt_l);
-				mardyn_assert(summv2gt_l >= 0.0);
-				Ngt_l++;
-				rotDOFgt_l += i->component()->getRotationalDegreesOfFreedom();
-			}
-
-			#if defined(_OPENMP)
-			#pragma omp critical (thermostat)
-			#endif
-			{
-				N[0] += Ngt_l;
-				rotDOF[0] += rotDOFgt_l;
-				summv2[0] += summv2gt_l;
-				sumIw2[0] += sumIw2gt_l;
-			}
-		} // end pragma omp parallel
+	std::vector<bool> hasComponents(numThermostats, false);
+	for (int index : indexOfComponent) {
+		hasComponents[index] = true;
 	}
-	for (auto & thermit : summv2) {
-		domain->setLocalSummv2(thermit.second, thermit.first);
-		domain->setLocalSumIw2(sumIw2[thermit.first], thermit.first);
-		domain->setLocalNrotDOF(thermit.first, N[thermit.first], rotDOF[thermit.first]);
+	for (size_t index = 0; index < numThermostats; ++index) {
+		if (not hasComponents[index]) {
+			continue;
+		}
+		const int thermostat = static_cast<int>(index) - 1;
+		mardyn_assert(total.summv2[index] >= 0.0);
+		domain->setLocalSummv2(total.summv2[index], thermostat);
+		domain->setLocalSumIw2(total.sumIw2[index], thermostat);
+		domain->setLocalNrotDOF(thermostat, total.N[index], total.rotDOF[index]);
 	}
 
 	this->_state = STATE_POST_FORCE_CALCULATION;
@@ -0,0 +1,26 @@
+#include "LeapfrogRESPA.h"
+
+#include <sstream>
+
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+#include "utils/xmlfileUnits.h"
+
+
+void LeapfrogRESPA::readXML(XMLfileUnits& xmlconfig) {
+	Leapfrog::readXML(xmlconfig);
+
+	xmlconfig.getNodeValue("slowForceInterval", _slowForceInterval);
+	if (_slowForceInterval < 1) {
+		std::ostringstream error_message;
+		error_message << "LeapfrogRESPA: slowForceInterval has to be at least 1." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	Log::global_log->info() << "Slow forces every " << _slowForceInterval << " time steps, outer time step: "
+							<< _slowForceInterval * _timestepLength << std::endl;
+}
+
+double LeapfrogRESPA::getSlowForceFactor(unsigned long simstep) const {
+	// the outer time steps are aligned to the global step count, so that restarts continue the same schedule
+	return (simstep % _slowForceInterval == 0) ? static_cast<double>(_slowForceInterval) : 0.0;
+}
@@ -0,0 +1,47 @@
+#ifndef SRC_INTEGRATORS_LEAPFROGRESPA_H_
+#define SRC_INTEGRATORS_LEAPFROGRESPA_H_
+
+#include "integrators/Leapfrog.h"
+
+/** @brief Leapfrog integrator with multiple time stepping (r-RESPA, impulse variant).
+ *
+ * The short-range forces, including the near field (P2P) of the fast multipole method, are calculated in every
+ * (inner) time step, the slow forces (long range correction and far field of the fast multipole method) only in
+ * every k-th time step. In these time steps, the slow forces are multiplied with k, so that the two half step kicks
+ * of the leapfrog scheme around the force calculation apply the impulse k * dt / 2 of the slow forces at the end of
+ * one outer time step and at the beginning of the next one. In all other time steps, only the short-range forces act
+ * on the molecules. With k = 1, this is the plain leapfrog integrator.
+ *
+ * The energy and virial of the slow forces are kept from their last evaluation. Values stored on the molecules by
+ * the long range correction (virial) are only present in time steps with slow forces. The sampling frequency of the
+ * planar long range correction counts its evaluations, i.e. outer time steps.
+ *
+ * @cite Tuckerman-1992
+ */
+class LeapfrogRESPA : public Leapfrog {
+public:
+	LeapfrogRESPA() = default;
+
+	/** @brief Read in XML configuration for the RESPA integrator.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <integrator type="LeapfrogRESPA" >
+	     <timestep>DOUBLE</timestep>  <!-- inner time step -->
+	     <slowForceInterval>UINT</slowForceInterval>  <!-- inner time steps per outer time step (default: 1) -->
+	   </integrator>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig) override;
+
+	double getSlowForceFactor(unsigned long simstep) const override;
+
+	unsigned getSlowForceInterval() const { return _slowForceInterval; }
+	void setSlowForceInterval(unsigned interval) { _slowForceInterval = interval; }
+
+private:
+	//! number of inner time steps per outer time step
+	unsigned _slowForceInterval{1};
+};
+
+#endif /* SRC_INTEGRATORS_LEAPFROGRESPA_H_ */
@@ -0,0 +1,156 @@
+/*
+ * LeapfrogRESPATest.cpp
+ */
+
+#include "LeapfrogRESPATest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "Domain.h"
+#include "bhfmm/FastMultipoleMethod.h"
+#include "integrators/Leapfrog.h"
+#include "integrators/LeapfrogRESPA.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+
+TEST_SUITE_REGISTRATION(LeapfrogRESPATest);
+
+namespace {
+constexpr double timestep = 0.005;
+constexpr unsigned numSteps = 400;
+}  // namespace
+
+std::vector<double> LeapfrogRESPATest::integrate(Integrator& integrator, unsigned steps,
+												 std::vector<double>& energies) {
+	const double cutoff = 2.0;
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, "RESPACharges.inp", cutoff);
+
+	double globalDomainLength[3] = {8., 8., 8.};
+	double bBoxMin[3] = {0., 0., 0.};
+	double bBoxMax[3] = {8., 8., 8.};
+	double LJCellLength[3] = {cutoff, cutoff, cutoff};
+	bhfmm::FastMultipoleMethod fmm;
+	fmm.setParameters(1, 6, true, false);
+	fmm.init(globalDomainLength, bBoxMin, bBoxMax, LJCellLength, container);
+
+	integrator.init();
+	integrator.setTimestepLength(timestep);
+
+	// the force calculation of Simulation::simulateOneTimestep without the short-range interactions
+	auto calculateForces = [&](unsigned long simstep) {
+		container->update();
+		_domainDecomposition->exchangeMolecules(container, _domain);
+		container->updateMoleculeCaches();
+		_domain->setLocalUpot(0.0);
+		_domain->setLocalVirial(0.0);
+		fmm.setFarFieldFactor(integrator.getSlowForceFactor(simstep));
+		fmm.computeElectrostatics(container);
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->calcFM();
+		}
+		container->deleteOuterParticles();
+	};
+	auto totalEnergy = [&]() {
+		double kinetic = 0.0;
+		for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			kinetic += 0.5 * m->mass() * m->v2();
+		}
+		return kinetic + _domain->getLocalUpot();
+	};
+
+	energies.clear();
+	calculateForces(0);
+	energies.push_back(totalEnergy());
+	for (unsigned long simstep = 1; simstep <= steps; ++simstep) {
+		integrator.eventNewTimestep(container, _domain);
+		calculateForces(simstep);
+		integrator.eventForcesCalculated(container, _domain);
+		energies.push_back(totalEnergy());
+	}
+
+	std::map<unsigned long, std::array<double, 3>> positions;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		positions[m->getID()] = {m->r(0), m->r(1), m->r(2)};
+	}
+	std::vector<double> result;
+	for (const auto& [id, r] : positions) {
+		result.insert(result.end(), r.begin(), r.end());
+	}
+	delete container;
+	return result;
+}
+
+void LeapfrogRESPATest::testIntervalOneIsLeapfrog() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LeapfrogRESPATest::testIntervalOneIsLeapfrog() only runs on 1 process" << std::endl;
+		return;
+	}
+
+	Leapfrog leapfrog;
+	std::vector<double> leapfrogEnergies;
+	const std::vector<double> leapfrogPositions = integrate(leapfrog, 20, leapfrogEnergies);
+
+	// reset the domain and the components
+	tearDown();
+	setUp();
+
+	LeapfrogRESPA respa;
+	respa.setSlowForceInterval(1);
+	std::vector<double> respaEnergies;
+	const std::vector<double> respaPositions = integrate(respa, 20, respaEnergies);
+
+	ASSERT_EQUAL(leapfrogPositions.size(), respaPositions.size());
+	for (size_t i = 0; i < leapfrogPositions.size(); ++i) {
+		ASSERT_DOUBLES_EQUAL(leapfrogPositions[i], respaPositions[i], 1e-14);
+	}
+	for (size_t i = 0; i < leapfrogEnergies.size(); ++i) {
+		ASSERT_DOUBLES_EQUAL(leapfrogEnergies[i], respaEnergies[i], 1e-12);
+	}
+}
+
+void LeapfrogRESPATest::testEnergyDrift() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LeapfrogRESPATest::testEnergyDrift() only runs on 1 process" << std::endl;
+		return;
+	}
+
+	Leapfrog leapfrog;
+	std::vector<double> leapfrogEnergies;
+	const std::vector<double> leapfrogPositions = integrate(leapfrog, numSteps, leapfrogEnergies);
+
+	tearDown();
+	setUp();
+
+	LeapfrogRESPA respa;
+	respa.setSlowForceInterval(4);
+	std::vector<double> respaEnergies;
+	const std::vector<double> respaPositions = integrate(respa, numSteps, respaEnergies);
+
+	// the FMM forces are not exactly the gradient of the FMM potential, so Leapfrog itself shows a small drift of the
+	// total energy. Evaluating the far field only every 4th step must not add to it.
+	auto maxDeviation = [](const std::vector<double>& energies) {
+		double deviation = 0.0;
+		for (double energy : energies) {
+			deviation = std::max(deviation, std::abs(energy - energies[0]));
+		}
+		return deviation;
+	};
+	const double leapfrogDeviation = maxDeviation(leapfrogEnergies);
+	const double respaDeviation = maxDeviation(respaEnergies);
+	test_log->info() << "Largest deviation of the total energy: Leapfrog " << leapfrogDeviation
+					 << ", LeapfrogRESPA (k=4) " << respaDeviation << std::endl;
+	ASSERT_TRUE(leapfrogDeviation < 1e-2 * std::abs(leapfrogEnergies[0]));
+
+	// in between, the velocities lack the far field kicks of the skipped steps
+	ASSERT_EQUAL(leapfrogEnergies.size(), respaEnergies.size());
+	for (size_t i = 0; i < leapfrogEnergies.size(); i += 4) {
+		ASSERT_DOUBLES_EQUAL(leapfrogEnergies[i], respaEnergies[i], 1e-5);
+	}
+
+	ASSERT_EQUAL(leapfrogPositions.size(), respaPositions.size());
+	for (size_t i = 0; i < leapfrogPositions.size(); ++i) {
+		ASSERT_DOUBLES_EQUAL(leapfrogPositions[i], respaPositions[i], 1e-5);
+	}
+}
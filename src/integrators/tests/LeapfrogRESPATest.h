@@ -0,0 +1,47 @@
+/*
+ * LeapfrogRESPATest.h
+ */
+
+#ifndef SRC_INTEGRATORS_TESTS_LEAPFROGRESPATEST_H_
+#define SRC_INTEGRATORS_TESTS_LEAPFROGRESPATEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+#include <vector>
+
+class Integrator;
+
+/**
+ * Integrates a perturbed rock salt lattice of point charges, which only interact via the FMM, with Leapfrog and
+ * LeapfrogRESPA.
+ */
+class LeapfrogRESPATest : public utils::TestWithSimulationSetup {
+	TEST_SUITE(LeapfrogRESPATest);
+	TEST_METHOD(testIntervalOneIsLeapfrog);
+	TEST_METHOD(testEnergyDrift);
+	TEST_SUITE_END();
+
+public:
+	LeapfrogRESPATest() = default;
+
+	~LeapfrogRESPATest() override = default;
+
+	//! With slowForceInterval 1, the trajectory has to be the same as with Leapfrog.
+	void testIntervalOneIsLeapfrog();
+
+	/**
+	 * With slowForceInterval 4, the far field is only evaluated every 4th step. The total energy has to follow the one
+	 * of Leapfrog and the trajectory has to stay close to the one of Leapfrog.
+	 */
+	void testEnergyDrift();
+
+private:
+	/**
+	 * @brief Integrates RESPACharges.inp for numSteps time steps, as Simulation does.
+	 * @param energies total energy after every time step (including the initial one)
+	 * @return positions of the molecules, sorted by id
+	 */
+	std::vector<double> integrate(Integrator& integrator, unsigned numSteps, std::vector<double>& energies);
+};
+
+#endif /* SRC_INTEGRATORS_TESTS_LEAPFROGRESPATEST_H_ */
@@ -22,15 +22,20 @@
 #include "parallel/DomainDecompBase.h"
 #endif
 
+#include "io/IOHelpers.h"
 #include "particleContainer/ParticleContainer.h"
 #include "utils/Logger.h"
 #include "utils/Timer.h"
 #include "utils/xmlfileUnits.h"
 #include "utils/mardyn_assert.h"
 
+#include <algorithm>
 #include <climits>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <string>
+#include <vector>
 
 
 enum MoleculeFormat : std::uint32_t {
@@ -38,7 +43,7 @@ enum MoleculeFormat : std::uint32_t {
 };
 
 BinaryReader::BinaryReader()
-		: _nMoleculeFormat(ICRVQD) {
+		: _nMoleculeFormat(ICRVQD), _parallelRead(true) {
 	// TODO Auto-generated constructor stub
 }
 
@@ -62,6 +67,8 @@ void BinaryReader::readXML(XMLfileUnits& xmlconfig) {
 	Log::global_log->info() << "phase space data file: " << pspfile << std::endl;
 	setPhaseSpaceHeaderFile(pspheaderfile);
 	setPhaseSpaceFile(pspfile);
+	xmlconfig.getNodeValue("parallelRead", _parallelRead);
+	Log::global_log->info() << "Parallel read-in of the phase space file: " << (_parallelRead ? "yes" : "no") << std::endl;
 }
 
 void BinaryReader::setPhaseSpaceFile(std::string filename) {
@@ -112,6 +119,7 @@ void BinaryReader::readPhaseSpaceHeader(Domain* domain, double timestep) {
 		error_message << "Not a valid molecule format: " << strMoleculeFormat << ", program exit ..." << std::endl;
 		MARDYN_EXIT(error_message.str());
 	}
+	_moleculeFormat = strMoleculeFormat;
 
 	// Set parameters of Domain and Simulation class
 	_simulation.setSimulationTime(dCurrentTime);
@@ -124,6 +132,12 @@ void BinaryReader::readPhaseSpaceHeader(Domain* domain, double timestep) {
 unsigned long
 BinaryReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp) {
 
+#ifdef ENABLE_MPI
+	if (_parallelRead) {
+		return readPhaseSpaceParallel(particleContainer, domain, domainDecomp);
+	}
+#endif
+
 	Timer inputTimer;
 	inputTimer.start();
 
@@ -341,3 +355,216 @@ BinaryReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domai
 #endif
 	return maxid;
 }
+
+
+#ifdef ENABLE_MPI
+namespace {
+
+//! number of records read by each rank per collective read
+const std::uint64_t PARALLEL_READ_CHUNK_SIZE = 64 * 1024;
+
+/**
+ * @brief Finds the ranks whose bounding box contains a position.
+ *
+ * The global domain is covered by a coarse grid, which stores for each of its cells the ranks whose box overlaps
+ * it, so only a few boxes have to be checked per molecule. Boxes touching the global boundary are extended to
+ * infinity, such that molecules outside of the domain still reach a rank, which then decides whether to keep them.
+ */
+class BoundingBoxOwners {
+public:
+	BoundingBoxOwners(const std::vector<double>& boxes, Domain* domain) : _boxes(boxes) {
+		const int numProcs = static_cast<int>(_boxes.size() / 6);
+		const int gridCells = std::min(64, 2 * static_cast<int>(std::ceil(std::cbrt(numProcs))));
+		for (int d = 0; d < 3; ++d) {
+			_gridCells[d] = gridCells;
+			_globalLength[d] = domain->getGlobalLength(d);
+			_gridCellLength[d] = _globalLength[d] / gridCells;
+		}
+		_ranks.resize(gridCells * gridCells * gridCells);
+
+		for (int rank = 0; rank < numProcs; ++rank) {
+			double* box = &_boxes[6 * rank];
+			int low[3], high[3];
+			for (int d = 0; d < 3; ++d) {
+				if (box[d] <= 0.) {
+					box[d] = std::numeric_limits<double>::lowest();
+				}
+				if (box[d + 3] >= _globalLength[d]) {
+					box[d + 3] = std::numeric_limits<double>::max();
+				}
+				low[d] = gridIndex(box[d], d);
+				high[d] = gridIndex(box[d + 3], d);
+			}
+			for (int z = low[2]; z <= high[2]; ++z) {
+				for (int y = low[1]; y <= high[1]; ++y) {
+					for (int x = low[0]; x <= high[0]; ++x) {
+						_ranks[(z * _gridCells[1] + y) * _gridCells[0] + x].push_back(rank);
+					}
+				}
+			}
+		}
+	}
+
+	//! @brief Calls f(rank) for every rank whose box contains r.
+	template <typename F>
+	void forEachOwner(const double r[3], F f) const {
+		const int cell = (gridIndex(r[2], 2) * _gridCells[1] + gridIndex(r[1], 1)) * _gridCells[0] + gridIndex(r[0], 0);
+		for (int rank : _ranks[cell]) {
+			const double* box = &_boxes[6 * rank];
+			if (r[0] >= box[0] && r[1] >= box[1] && r[2] >= box[2] && r[0] < box[3] && r[1] < box[4] && r[2] < box[5]) {
+				f(rank);
+			}
+		}
+	}
+
+private:
+	int gridIndex(double x, int d) const {
+		const double index = std::floor(x / _gridCellLength[d]);
+		return static_cast<int>(std::max(0., std::min(static_cast<double>(_gridCells[d] - 1), index)));
+	}
+
+	//! min and max corner of the box of each rank
+	std::vector<double> _boxes;
+	int _gridCells[3];
+	double _globalLength[3];
+	double _gridCellLength[3];
+	//! ranks overlapping each grid cell
+	std::vector<std::vector<int>> _ranks;
+};
+
+} /* namespace */
+
+unsigned long BinaryReader::readPhaseSpaceParallel(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp) {
+	Timer inputTimer;
+	inputTimer.start();
+
+	MPI_Comm comm = domainDecomp->getCommunicator();
+	int rank, numProcs;
+	MPI_CHECK(MPI_Comm_rank(comm, &rank));
+	MPI_CHECK(MPI_Comm_size(comm, &numProcs));
+
+	// the bounding boxes of the containers decide where the molecules go, as in the sequential version
+	double ownBox[6];
+	for (int d = 0; d < 3; ++d) {
+		ownBox[d] = particleContainer->getBoundingBoxMin(d);
+		ownBox[d + 3] = particleContainer->getBoundingBoxMax(d);
+	}
+	std::vector<double> boxes(6 * numProcs);
+	MPI_CHECK(MPI_Allgather(ownBox, 6, MPI_DOUBLE, boxes.data(), 6, MPI_DOUBLE, comm));
+	const BoundingBoxOwners owners(boxes, domain);
+
+	Log::global_log->info() << "Opening phase space file " << _phaseSpaceFile << " for parallel read-in" << std::endl;
+	MPI_File fh;
+	if (MPI_File_open(comm, _phaseSpaceFile.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+		std::ostringstream error_message;
+		error_message << "Could not open phaseSpaceFile " << _phaseSpaceFile << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	// Global number of particles must not be updated as this would result in numMolecules = 0
+	const std::uint64_t numMolecules = domain->getglobalNumMolecules(false);
+	const std::uint64_t recSize = IOHelpers::binaryRecordSize(_moleculeFormat);
+	MPI_Offset fileSize;
+	MPI_CHECK(MPI_File_get_size(fh, &fileSize));
+	if (static_cast<std::uint64_t>(fileSize) < numMolecules * recSize) {
+		std::ostringstream error_message;
+		error_message << "End of file was hit before all " << numMolecules << " expected molecules were read."
+			<< std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	// contiguous range of records of this rank, all ranks perform the same number of collective reads
+	const std::uint64_t first = numMolecules * rank / numProcs;
+	const std::uint64_t last = numMolecules * (rank + 1) / numProcs;
+	const std::uint64_t maxNumLocal = (numMolecules + numProcs - 1) / numProcs;
+	const std::uint64_t numChunks = (maxNumLocal + PARALLEL_READ_CHUNK_SIZE - 1) / PARALLEL_READ_CHUNK_SIZE;
+
+	MPI_Datatype mpi_Particle;
+	ParticleData::getMPIType(mpi_Particle);
+
+	std::vector<Component>& dcomponents = *(_simulation.getEnsemble()->getComponents());
+	const size_t numcomponents = dcomponents.size();
+	std::vector<unsigned long> numMoleculesPerComponent(numcomponents, 0);
+	// first molecule of each component read by this rank, used for storeSample
+	std::vector<Molecule> samples(numcomponents);
+	std::vector<bool> hasSample(numcomponents, false);
+	unsigned long maxid = 0;
+
+	std::vector<char> readBuffer(PARALLEL_READ_CHUNK_SIZE * recSize);
+	std::vector<std::vector<ParticleData>> outgoing(numProcs);
+	std::vector<ParticleData> sendBuffer, recvBuffer;
+	std::vector<int> sendCounts(numProcs), recvCounts(numProcs), sendDispls(numProcs), recvDispls(numProcs);
+
+	for (std::uint64_t chunk = 0; chunk < numChunks; ++chunk) {
+		const std::uint64_t begin = first + chunk * PARALLEL_READ_CHUNK_SIZE;
+		const std::uint64_t count = begin < last ? std::min(PARALLEL_READ_CHUNK_SIZE, last - begin) : 0;
+		MPI_CHECK(MPI_File_read_at_all(fh, static_cast<MPI_Offset>(begin * recSize), readBuffer.data(),
+									   static_cast<int>(count * recSize), MPI_BYTE, MPI_STATUS_IGNORE));
+
+		for (std::uint64_t i = 0; i < count; ++i) {
+			Molecule m = IOHelpers::moleculeFromBinaryRecord(&readBuffer[i * recSize], _moleculeFormat, dcomponents);
+			if ((m.r(0) < 0.0 || m.r(0) >= domain->getGlobalLength(0)) || (m.r(1) < 0.0 || m.r(1) >= domain->getGlobalLength(1)) ||
+				(m.r(2) < 0.0 || m.r(2) >= domain->getGlobalLength(2))) {
+				Log::global_log->warning() << "Molecule " << m.getID() << " out of box: " << m.r(0) << ";" << m.r(1) << ";" << m.r(2) << std::endl;
+			}
+			const unsigned cid = m.componentid();
+			ParticleData particle;
+			ParticleData::MoleculeToParticleData(particle, m);
+
+			numMoleculesPerComponent[cid]++;
+			maxid = std::max(maxid, static_cast<unsigned long>(m.getID()));
+			if (not hasSample[cid]) {
+				samples[cid] = m;
+				hasSample[cid] = true;
+			}
+			owners.forEachOwner(m.r_arr().data(), [&](int owner) { outgoing[owner].push_back(particle); });
+		}
+
+		// route the molecules of this chunk to their owners
+		sendBuffer.clear();
+		for (int r = 0; r < numProcs; ++r) {
+			sendCounts[r] = static_cast<int>(outgoing[r].size());
+			sendDispls[r] = static_cast<int>(sendBuffer.size());
+			sendBuffer.insert(sendBuffer.end(), outgoing[r].begin(), outgoing[r].end());
+			outgoing[r].clear();
+		}
+		MPI_CHECK(MPI_Alltoall(sendCounts.data(), 1, MPI_INT, recvCounts.data(), 1, MPI_INT, comm));
+		int numRecv = 0;
+		for (int r = 0; r < numProcs; ++r) {
+			recvDispls[r] = numRecv;
+			numRecv += recvCounts[r];
+		}
+		recvBuffer.resize(numRecv);
+		MPI_CHECK(MPI_Alltoallv(sendBuffer.data(), sendCounts.data(), sendDispls.data(), mpi_Particle,
+								recvBuffer.data(), recvCounts.data(), recvDispls.data(), mpi_Particle, comm));
+
+		for (const auto& particle : recvBuffer) {
+			Molecule m;
+			ParticleData::ParticleDataToMolecule(particle, m);
+			if (particleContainer->isInBoundingBox(m.r_arr().data())) {
+				particleContainer->addParticle(m, true, false);
+			}
+		}
+
+		Log::global_log->info() << "Finished reading molecules: " << 100 * (chunk + 1) / numChunks << "%\r" << std::flush;
+	}
+	MPI_CHECK(MPI_File_close(&fh));
+
+	Log::global_log->info() << "Finished reading molecules: 100%" << std::endl;
+	Log::global_log->info() << "Reading Molecules done" << std::endl;
+
+	maxid = IOHelpers::reduceReadInStatistics(numMoleculesPerComponent, samples, hasSample, maxid, domain, domainDecomp);
+
+	if (domain->getglobalRho() < 1e-5) {
+		domain->setglobalRho(
+				domain->getglobalNumMolecules(true, particleContainer, domainDecomp) / domain->getGlobalVolume());
+		Log::global_log->info() << "Calculated Rho_global = " << domain->getglobalRho() << std::endl;
+	}
+
+	inputTimer.stop();
+	Log::global_log->info() << "Initial IO took:                 "
+					   << inputTimer.get_etime() << " sec" << std::endl;
+	MPI_CHECK(MPI_Type_free(&mpi_Particle));
+	return maxid;
+}
+#endif
@@ -22,6 +22,20 @@ public:
 
 	~BinaryReader();
 
+	/** @brief Read in XML configuration for BinaryReader.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <file type="binary">
+	     <header>STRING</header>
+	     <data>STRING</data>
+	     <!-- MPI only: every rank reads a contiguous part of the data file with collective MPI-IO and the
+	          molecules are routed to their owners with an all-to-all exchange. Otherwise, rank 0 reads the
+	          whole file and broadcasts it. Default: true -->
+	     <parallelRead>BOOL</parallelRead>
+	   </file>
+	   \endcode
+	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 	//! @brief gets a filename and opens an ifstream associated with the given file
@@ -89,9 +103,22 @@ public:
 	//! @return Highest molecule ID found in the input phase space file.
 	unsigned long readPhaseSpace(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp);
 
+	//! @brief Enable or disable the collective read-in of readPhaseSpace (only used with MPI).
+	void setParallelRead(bool parallelRead) { _parallelRead = parallelRead; }
+
 private:
 
+#ifdef ENABLE_MPI
+	//! @brief Collective version of readPhaseSpace.
+	//!
+	//! The molecules are split into one contiguous range of records per rank, which is read with
+	//! MPI_File_read_at_all in chunks. After each chunk, the molecules are sent to all ranks whose bounding
+	//! box contains them with one MPI_Alltoallv.
+	unsigned long readPhaseSpaceParallel(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp);
+#endif
+
 	std::uint32_t _nMoleculeFormat;
+	bool _parallelRead;
 	std::string _moleculeFormat;
 	std::string _phaseSpaceFile;
 	std::string _phaseSpaceHeaderFile;
@@ -0,0 +1,66 @@
+/*
+ * BlockedCheckpointFormat.h
+ *
+ * Layout of the spatially indexed checkpoint files written by BlockedCheckpointWriter and read by
+ * BlockedCheckpointReader.
+ *
+ * The file consists of
+ *  - one FileHeader,
+ *  - the data blocks: the binary records of Molecule::writeBinary() of up to blockSize molecules each, compressed
+ *    with BlockCompression,
+ *  - the block table: one BlockInfo per block, starting at FileHeader::blockTableOffset.
+ * The molecules of each block are sorted along a Morton curve over the global domain and every block stores the
+ * bounding box of its molecules, so a process only has to read the blocks overlapping its own domain,
+ * independent of the decomposition which wrote the file. All values are stored in the byte order of the writing
+ * machine, which is checked with FileHeader::endianness.
+ */
+
+#ifndef SRC_IO_BLOCKEDCHECKPOINTFORMAT_H_
+#define SRC_IO_BLOCKEDCHECKPOINTFORMAT_H_
+
+#include <cstdint>
+
+namespace BlockedCheckpointFormat {
+
+const char magic[16] = "MarDynBlockedCP";
+const std::uint32_t version = 1;
+const std::int32_t endiannessTest = 0x0a0b0c0d;
+
+struct FileHeader {
+	char magic[16];
+	std::int32_t endianness;
+	std::uint32_t version;
+	//! molecule format of the records, e.g. "ICRVQD"
+	char moleculeFormat[8];
+	std::uint32_t recordSize;
+	//! number of bits per dimension of the Morton keys
+	std::uint32_t mortonBits;
+	std::uint64_t numMolecules;
+	std::uint64_t numBlocks;
+	std::uint64_t blockTableOffset;
+	double time;
+	double globalLength[3];
+};
+
+struct BlockInfo {
+	//! bounding box of the molecules in the block
+	double boundingBoxMin[3];
+	double boundingBoxMax[3];
+	//! Morton keys of the first and the last molecule of the block
+	std::uint64_t firstKey;
+	std::uint64_t lastKey;
+	//! position and size of the block in the file
+	std::uint64_t offset;
+	std::uint64_t size;
+	std::uint64_t numMolecules;
+	//! BlockCompression::Method of the block
+	std::uint32_t compression;
+	std::uint32_t reserved;
+};
+
+static_assert(sizeof(FileHeader) == 96, "FileHeader must not contain padding");
+static_assert(sizeof(BlockInfo) == 96, "BlockInfo must not contain padding");
+
+} /* namespace BlockedCheckpointFormat */
+
+#endif /* SRC_IO_BLOCKEDCHECKPOINTFORMAT_H_ */
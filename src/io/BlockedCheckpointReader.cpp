@@ -0,0 +1,218 @@
+#include "io/BlockedCheckpointReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "io/IOHelpers.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "utils/BlockCompression.h"
+#include "utils/Logger.h"
+#include "utils/String_utils.h"
+#include "utils/Timer.h"
+#include "utils/mardyn_assert.h"
+#include "utils/xmlfileUnits.h"
+
+using namespace BlockedCheckpointFormat;
+
+namespace {
+
+//! @brief Reads size bytes at offset on rank 0 of the decomposition and broadcasts them to all of its ranks.
+void readAndBroadcast(DomainDecompBase& domainDecomp, const std::string& filename, std::uint64_t offset, size_t size,
+					  char* buffer) {
+	if (domainDecomp.getRank() == 0) {
+		std::ifstream istrm(filename.c_str(), std::ios::in | std::ios::binary);
+		if (not istrm.is_open()) {
+			std::ostringstream error_message;
+			error_message << "Could not open phaseSpaceFile " << filename << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		istrm.seekg(static_cast<std::streamoff>(offset));
+		istrm.read(buffer, static_cast<std::streamsize>(size));
+		if (static_cast<size_t>(istrm.gcount()) != size) {
+			std::ostringstream error_message;
+			error_message << "Blocked checkpoint " << filename << " is truncated." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+	}
+#ifdef ENABLE_MPI
+	// broadcast in pieces, as the counts of MPI are int
+	const size_t maxChunk = 1ul << 30;
+	for (size_t begin = 0; begin < size; begin += maxChunk) {
+		MPI_CHECK(MPI_Bcast(buffer + begin, static_cast<int>(std::min(maxChunk, size - begin)), MPI_BYTE, 0,
+							domainDecomp.getCommunicator()));
+	}
+#endif
+}
+
+}  // namespace
+
+void BlockedCheckpointReader::readXML(XMLfileUnits& xmlconfig) {
+	std::string pspfile;
+	xmlconfig.getNodeValue("data", pspfile);
+	pspfile = string_utils::trim(pspfile);
+	// only prefix xml dir if path is not absolute
+	if (pspfile[0] != '/') {
+		pspfile.insert(0, xmlconfig.getDir());
+	}
+	Log::global_log->info() << "phase space data file: " << pspfile << std::endl;
+	setPhaseSpaceFile(pspfile);
+}
+
+void BlockedCheckpointReader::readPhaseSpaceHeader(Domain* domain, double /*timestep*/) {
+	readAndBroadcast(_simulation.domainDecomposition(), _phaseSpaceFile, 0, sizeof(FileHeader),
+					 reinterpret_cast<char*>(&_header));
+
+	if (std::strncmp(_header.magic, magic, sizeof(magic)) != 0) {
+		std::ostringstream error_message;
+		error_message << "File " << _phaseSpaceFile << " is not a blocked checkpoint." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (_header.endianness != endiannessTest) {
+		std::ostringstream error_message;
+		error_message << "Blocked checkpoint " << _phaseSpaceFile
+					  << " was written on a machine with different byte order." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (_header.version != version) {
+		std::ostringstream error_message;
+		error_message << "Blocked checkpoint " << _phaseSpaceFile << " has unsupported version " << _header.version
+					  << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	_header.moleculeFormat[sizeof(_header.moleculeFormat) - 1] = '\0';
+	if (IOHelpers::binaryRecordSize(_header.moleculeFormat) != _header.recordSize) {
+		std::ostringstream error_message;
+		error_message << "Not a valid molecule format: " << _header.moleculeFormat << ", program exit ..." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	_simulation.setSimulationTime(_header.time);
+	for (int d = 0; d < 3; ++d) {
+		domain->setGlobalLength(d, _header.globalLength[d]);
+	}
+	domain->setglobalNumMolecules(_header.numMolecules);
+	Log::global_log->info() << "Blocked checkpoint with " << _header.numMolecules << " molecules in "
+							<< _header.numBlocks << " blocks" << std::endl;
+}
+
+unsigned long BlockedCheckpointReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domain,
+													  DomainDecompBase* domainDecomp) {
+	Timer inputTimer;
+	inputTimer.start();
+
+	std::vector<BlockInfo> table(_header.numBlocks);
+	readAndBroadcast(*domainDecomp, _phaseSpaceFile, _header.blockTableOffset, table.size() * sizeof(BlockInfo),
+					 reinterpret_cast<char*>(table.data()));
+
+	// blocks overlapping the bounding box of this process
+	double boxMin[3], boxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		boxMin[d] = particleContainer->getBoundingBoxMin(d);
+		boxMax[d] = particleContainer->getBoundingBoxMax(d);
+	}
+	std::vector<const BlockInfo*> ownBlocks;
+	for (const auto& block : table) {
+		bool overlaps = true;
+		for (int d = 0; d < 3; ++d) {
+			overlaps = overlaps and block.boundingBoxMax[d] >= boxMin[d] and block.boundingBoxMin[d] < boxMax[d];
+		}
+		if (overlaps) {
+			ownBlocks.push_back(&block);
+		}
+	}
+
+#ifdef ENABLE_MPI
+	MPI_File fh;
+	if (MPI_File_open(domainDecomp->getCommunicator(), const_cast<char*>(_phaseSpaceFile.c_str()), MPI_MODE_RDONLY,
+					  MPI_INFO_NULL, &fh) != MPI_SUCCESS) {
+		std::ostringstream error_message;
+		error_message << "Could not open phaseSpaceFile " << _phaseSpaceFile << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+#else
+	std::ifstream istrm(_phaseSpaceFile.c_str(), std::ios::in | std::ios::binary);
+	if (not istrm.is_open()) {
+		std::ostringstream error_message;
+		error_message << "Could not open phaseSpaceFile " << _phaseSpaceFile << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+#endif
+
+	std::vector<Component>& components = *(_simulation.getEnsemble()->getComponents());
+	std::vector<unsigned long> numMoleculesPerComponent(components.size(), 0);
+	std::vector<Molecule> samples(components.size());
+	std::vector<bool> hasSample(components.size(), false);
+	unsigned long maxid = 0;
+	const std::string moleculeFormat(_header.moleculeFormat);
+
+	std::vector<char> compressed;
+	std::vector<char> records;
+	for (const BlockInfo* block : ownBlocks) {
+		compressed.resize(block->size);
+		records.resize(block->numMolecules * _header.recordSize);
+#ifdef ENABLE_MPI
+		MPI_CHECK(MPI_File_read_at(fh, static_cast<MPI_Offset>(block->offset), compressed.data(),
+								   static_cast<int>(block->size), MPI_BYTE, MPI_STATUS_IGNORE));
+#else
+		istrm.seekg(static_cast<std::streamoff>(block->offset));
+		istrm.read(compressed.data(), static_cast<std::streamsize>(block->size));
+#endif
+		if (not BlockCompression::decompress(static_cast<BlockCompression::Method>(block->compression),
+											 compressed.data(), compressed.size(), block->numMolecules,
+											 _header.recordSize, records.data())) {
+			std::ostringstream error_message;
+			error_message << "Blocked checkpoint " << _phaseSpaceFile << " contains a corrupted block at offset "
+						  << block->offset << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+
+		for (std::uint64_t i = 0; i < block->numMolecules; ++i) {
+			Molecule m = IOHelpers::moleculeFromBinaryRecord(&records[i * _header.recordSize], moleculeFormat,
+															 components);
+			// the boxes of the processes are disjoint, so every molecule is added and counted exactly once
+			if (not particleContainer->isInBoundingBox(m.r_arr().data())) {
+				continue;
+			}
+			const unsigned cid = m.componentid();
+			numMoleculesPerComponent[cid]++;
+			maxid = std::max(maxid, static_cast<unsigned long>(m.getID()));
+			if (not hasSample[cid]) {
+				samples[cid] = m;
+				hasSample[cid] = true;
+			}
+			particleContainer->addParticle(m, true, false);
+		}
+	}
+
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_File_close(&fh));
+#else
+	istrm.close();
+#endif
+
+	maxid = IOHelpers::reduceReadInStatistics(numMoleculesPerComponent, samples, hasSample, maxid, domain, domainDecomp);
+	Log::global_log->info() << "Read " << ownBlocks.size() << " of " << table.size() << " blocks" << std::endl;
+
+	if (domain->getglobalRho() < 1e-5) {
+		domain->setglobalRho(
+				domain->getglobalNumMolecules(true, particleContainer, domainDecomp) / domain->getGlobalVolume());
+		Log::global_log->info() << "Calculated Rho_global = " << domain->getglobalRho() << std::endl;
+	}
+
+	inputTimer.stop();
+	Log::global_log->info() << "Initial IO took:                 "
+					   << inputTimer.get_etime() << " sec" << std::endl;
+	return maxid;
+}
@@ -0,0 +1,45 @@
+#ifndef SRC_IO_BLOCKEDCHECKPOINTREADER_H_
+#define SRC_IO_BLOCKEDCHECKPOINTREADER_H_
+
+#include <string>
+
+#include "io/BlockedCheckpointFormat.h"
+#include "io/InputBase.h"
+
+/**
+ * @brief Reads the spatially indexed checkpoints of BlockedCheckpointWriter.
+ *
+ * The block table is read by rank 0 and broadcast. Afterwards, every process reads and decompresses only the blocks
+ * whose bounding box overlaps the bounding box of its particle container. This works for any number of processes
+ * and any decomposition, independent of the run which wrote the checkpoint.
+ */
+class BlockedCheckpointReader : public InputBase {
+public:
+	BlockedCheckpointReader() = default;
+	~BlockedCheckpointReader() override = default;
+
+	/** @brief Read in XML configuration for BlockedCheckpointReader.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <file type="blocked">
+	     <data>STRING</data>
+	   </file>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig) override;
+
+	void setPhaseSpaceFile(const std::string& filename) { _phaseSpaceFile = filename; }
+
+	//! @brief Reads time, box size and number of molecules from the header of the checkpoint.
+	void readPhaseSpaceHeader(Domain* domain, double timestep) override;
+
+	unsigned long readPhaseSpace(ParticleContainer* particleContainer, Domain* domain,
+								 DomainDecompBase* domainDecomp) override;
+
+private:
+	std::string _phaseSpaceFile;
+	BlockedCheckpointFormat::FileHeader _header{};
+};
+
+#endif /* SRC_IO_BLOCKEDCHECKPOINTREADER_H_ */
@@ -0,0 +1,378 @@
+#include "io/BlockedCheckpointWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+#include "Common.h"
+#include "Domain.h"
+#include "Simulation.h"
+#include "io/BlockedCheckpointFormat.h"
+#include "io/IOHelpers.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "utils/BlockCompression.h"
+#include "utils/Logger.h"
+#include "utils/SpaceFillingCurve.h"
+#include "utils/Timer.h"
+#include "utils/mardyn_assert.h"
+
+namespace {
+//! bits per dimension of the Morton keys used to sort the molecules
+const unsigned MORTON_BITS = 10;
+}
+
+struct BlockedCheckpointWriter::Snapshot {
+	std::string filename;
+	BlockedCheckpointFormat::FileHeader header{};
+	//! compressed blocks of this process
+	std::vector<char> data;
+	//! file offset of data
+	unsigned long dataOffset{0};
+	//! blocks of this process while the snapshot is created, afterwards the block table (only on rank 0 with MPI)
+	std::vector<BlockedCheckpointFormat::BlockInfo> blocks;
+	//! measures the time from the start of the writes until their completion
+	Timer timer;
+#ifdef ENABLE_MPI
+	MPI_File fh;
+	std::vector<MPI_Request> requests;
+#else
+	std::future<void> write;
+#endif
+};
+
+BlockedCheckpointWriter::BlockedCheckpointWriter() = default;
+
+BlockedCheckpointWriter::~BlockedCheckpointWriter() = default;
+
+void BlockedCheckpointWriter::readXML(XMLfileUnits& xmlconfig) {
+	xmlconfig.getNodeValue("writefrequency", _writeFrequency);
+	Log::global_log->info() << "[BlockedCheckpointWriter] write frequency: " << _writeFrequency << std::endl;
+	if (_writeFrequency == 0) {
+		std::ostringstream error_message;
+		error_message << "Write frequency must be a positive nonzero integer, but is " << _writeFrequency << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	xmlconfig.getNodeValue("outputprefix", _outputPrefix);
+	Log::global_log->info() << "[BlockedCheckpointWriter] output prefix: " << _outputPrefix << std::endl;
+
+	xmlconfig.getNodeValue("incremental", _incremental);
+	Log::global_log->info() << "[BlockedCheckpointWriter] incremental numbers: " << _incremental << std::endl;
+
+	xmlconfig.getNodeValue("appendTimestamp", _appendTimestamp);
+	Log::global_log->info() << "[BlockedCheckpointWriter] append timestamp: " << _appendTimestamp << std::endl;
+
+	xmlconfig.getNodeValue("blockSize", _blockSize);
+	if (_blockSize == 0) {
+		std::ostringstream error_message;
+		error_message << "[BlockedCheckpointWriter] blockSize must be a positive nonzero integer." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	Log::global_log->info() << "[BlockedCheckpointWriter] molecules per block: " << _blockSize << std::endl;
+
+	xmlconfig.getNodeValue("compression", _compression);
+	Log::global_log->info() << "[BlockedCheckpointWriter] compression: " << (_compression ? "yes" : "no") << std::endl;
+
+	xmlconfig.getNodeValue("asynchronous", _asynchronous);
+	xmlconfig.getNodeValue("maxSnapshotsInFlight", _maxSnapshotsInFlight);
+	if (_maxSnapshotsInFlight == 0) {
+		std::ostringstream error_message;
+		error_message << "[BlockedCheckpointWriter] maxSnapshotsInFlight must be a positive nonzero integer." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	Log::global_log->info() << "[BlockedCheckpointWriter] asynchronous writing: " << (_asynchronous ? "yes" : "no")
+							<< ", at most " << _maxSnapshotsInFlight << " snapshots in flight" << std::endl;
+}
+
+void BlockedCheckpointWriter::endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+									  Domain* domain, unsigned long simstep) {
+	for (auto& snapshot : _snapshotsInFlight) {
+		progressWriting(*snapshot);
+	}
+	if (simstep % _writeFrequency != 0) {
+		return;
+	}
+	std::stringstream filenamestream;
+	filenamestream << _outputPrefix;
+	if (_incremental) {
+		/* align file numbers with preceding '0's in the required range from 0 to _numberOfTimesteps. */
+		unsigned long numTimesteps = _simulation.getNumTimesteps();
+		int num_digits = (int) ceil( log( double( numTimesteps / _writeFrequency ) ) / log(10.) );
+		filenamestream << "-" << aligned_number(simstep / _writeFrequency, num_digits, '0');
+	}
+	if (_appendTimestamp) {
+		// all processes have to open the same file
+		char fmt[] = "%Y%m%dT%H%M%S";  // must have fixed size format for all time values/processes
+		char timestring[256];
+#ifdef ENABLE_MPI
+		int count = gettimestr(fmt, timestring, sizeof(timestring) / sizeof(timestring[0]));
+		MPI_CHECK(MPI_Bcast(timestring, count, MPI_CHAR, 0, domainDecomp->getCommunicator()));
+#else
+		gettimestr(fmt, timestring, sizeof(timestring) / sizeof(timestring[0]));
+#endif
+		filenamestream << "-" << std::string(timestring);
+	}
+	filenamestream << ".blocked.restart";
+
+	if (not _asynchronous) {
+		writeCheckpoint(filenamestream.str(), particleContainer, domainDecomp, domain, _simulation.getSimulationTime(),
+						_blockSize, _compression);
+		return;
+	}
+
+	// bound the memory of the buffered snapshots; without incremental numbers, all snapshots go to the same file, so
+	// the previous writes have to be completed first
+	while (not _snapshotsInFlight.empty() and
+		   (_snapshotsInFlight.size() >= _maxSnapshotsInFlight or
+			_snapshotsInFlight.back()->filename == filenamestream.str())) {
+		finishWriting(*_snapshotsInFlight.front());
+		_snapshotsInFlight.pop_front();
+	}
+	_snapshotsInFlight.push_back(createSnapshot(filenamestream.str(), particleContainer, domainDecomp, domain,
+												_simulation.getSimulationTime(), _blockSize, _compression));
+	startWriting(*_snapshotsInFlight.back(), domainDecomp);
+}
+
+void BlockedCheckpointWriter::finish(ParticleContainer* /*particleContainer*/, DomainDecompBase* /*domainDecomp*/,
+									 Domain* /*domain*/) {
+	for (auto& snapshot : _snapshotsInFlight) {
+		finishWriting(*snapshot);
+	}
+	_snapshotsInFlight.clear();
+}
+
+void BlockedCheckpointWriter::writeCheckpoint(const std::string& filename, ParticleContainer* particleContainer,
+											  DomainDecompBase* domainDecomp, Domain* domain, double currentTime,
+											  unsigned long blockSize, bool compression) {
+	auto snapshot = createSnapshot(filename, particleContainer, domainDecomp, domain, currentTime, blockSize, compression);
+	startWriting(*snapshot, domainDecomp);
+	finishWriting(*snapshot);
+}
+
+std::unique_ptr<BlockedCheckpointWriter::Snapshot> BlockedCheckpointWriter::createSnapshot(
+		const std::string& filename, ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+		Domain* domain, double currentTime, unsigned long blockSize, bool compression) {
+	using namespace BlockedCheckpointFormat;
+
+	Timer timer;
+	timer.start();
+	domainDecomp->assertDisjunctivity(particleContainer);
+	auto snapshot = std::make_unique<Snapshot>();
+	snapshot->filename = filename;
+	std::vector<char>& data = snapshot->data;
+	std::vector<BlockInfo>& blocks = snapshot->blocks;
+	FileHeader& header = snapshot->header;
+
+	// serialize the molecules in the order of the container and compute their Morton keys
+	const std::string moleculeFormat = Molecule::getWriteFormat();
+	const size_t recordSize = IOHelpers::binaryRecordSize(moleculeFormat);
+	std::ostringstream recordStream(std::ios_base::binary);
+	std::vector<std::uint64_t> keys;
+	std::vector<double> positions;
+	const double numGridCells = static_cast<double>(1u << MORTON_BITS);
+	for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->writeBinary(recordStream);
+		std::uint32_t cell[3];
+		for (int d = 0; d < 3; ++d) {
+			const double scaled = std::floor(m->r(d) / domain->getGlobalLength(d) * numGridCells);
+			cell[d] = static_cast<std::uint32_t>(std::max(0., std::min(numGridCells - 1., scaled)));
+			positions.push_back(m->r(d));
+		}
+		keys.push_back(SpaceFillingCurve::mortonKey(cell[0], cell[1], cell[2]));
+	}
+	const std::string records = recordStream.str();
+	const size_t numMolecules = keys.size();
+	if (recordSize == 0 or records.size() != numMolecules * recordSize) {
+		std::ostringstream error_message;
+		error_message << "[BlockedCheckpointWriter] Molecule format " << moleculeFormat
+					  << " does not support binary output." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	std::vector<size_t> order(numMolecules);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] < keys[b]; });
+
+	// split the sorted molecules into blocks
+	std::vector<char> blockRecords;
+	for (size_t begin = 0; begin < numMolecules; begin += blockSize) {
+		const size_t end = std::min(numMolecules, begin + blockSize);
+		BlockInfo block{};
+		for (int d = 0; d < 3; ++d) {
+			block.boundingBoxMin[d] = std::numeric_limits<double>::max();
+			block.boundingBoxMax[d] = std::numeric_limits<double>::lowest();
+		}
+		blockRecords.resize((end - begin) * recordSize);
+		for (size_t i = begin; i < end; ++i) {
+			std::memcpy(&blockRecords[(i - begin) * recordSize], &records[order[i] * recordSize], recordSize);
+			for (int d = 0; d < 3; ++d) {
+				block.boundingBoxMin[d] = std::min(block.boundingBoxMin[d], positions[3 * order[i] + d]);
+				block.boundingBoxMax[d] = std::max(block.boundingBoxMax[d], positions[3 * order[i] + d]);
+			}
+		}
+		block.firstKey = keys[order[begin]];
+		block.lastKey = keys[order[end - 1]];
+		block.offset = data.size();
+		block.numMolecules = end - begin;
+		if (compression) {
+			block.compression = BlockCompression::compress(blockRecords.data(), end - begin, recordSize, data);
+		} else {
+			block.compression = BlockCompression::NONE;
+			data.insert(data.end(), blockRecords.begin(), blockRecords.end());
+		}
+		block.size = data.size() - block.offset;
+		blocks.push_back(block);
+	}
+
+	std::memcpy(header.magic, magic, sizeof(header.magic));
+	header.endianness = endiannessTest;
+	header.version = version;
+	std::strncpy(header.moleculeFormat, moleculeFormat.c_str(), sizeof(header.moleculeFormat) - 1);
+	header.recordSize = static_cast<std::uint32_t>(recordSize);
+	header.mortonBits = MORTON_BITS;
+	header.time = currentTime;
+	for (int d = 0; d < 3; ++d) {
+		header.globalLength[d] = domain->getGlobalLength(d);
+	}
+
+#ifdef ENABLE_MPI
+	MPI_Comm comm = domainDecomp->getCommunicator();
+	int rank, numProcs;
+	MPI_CHECK(MPI_Comm_rank(comm, &rank));
+	MPI_CHECK(MPI_Comm_size(comm, &numProcs));
+
+	// position of the data of this process and global sizes
+	unsigned long localSizes[3] = {data.size(), numMolecules, blocks.size()};
+	unsigned long offsets[3] = {0, 0, 0};
+	unsigned long totals[3];
+	MPI_CHECK(MPI_Exscan(localSizes, offsets, 3, MPI_UNSIGNED_LONG, MPI_SUM, comm));
+	if (rank == 0) {
+		std::fill(offsets, offsets + 3, 0);
+	}
+	MPI_CHECK(MPI_Allreduce(localSizes, totals, 3, MPI_UNSIGNED_LONG, MPI_SUM, comm));
+	snapshot->dataOffset = sizeof(FileHeader) + offsets[0];
+	for (auto& block : blocks) {
+		block.offset += snapshot->dataOffset;
+	}
+	header.numMolecules = totals[1];
+	header.numBlocks = totals[2];
+	header.blockTableOffset = sizeof(FileHeader) + totals[0];
+
+	// block table on rank 0
+	const int localTableSize = static_cast<int>(blocks.size() * sizeof(BlockInfo));
+	std::vector<int> tableSizes(numProcs), tableDispls(numProcs);
+	MPI_CHECK(MPI_Gather(&localTableSize, 1, MPI_INT, tableSizes.data(), 1, MPI_INT, 0, comm));
+	std::vector<BlockInfo> table;
+	if (rank == 0) {
+		std::exclusive_scan(tableSizes.begin(), tableSizes.end(), tableDispls.begin(), 0);
+		table.resize(header.numBlocks);
+	}
+	MPI_CHECK(MPI_Gatherv(blocks.data(), localTableSize, MPI_BYTE, table.data(), tableSizes.data(),
+						  tableDispls.data(), MPI_BYTE, 0, comm));
+	blocks.swap(table);
+#else
+	snapshot->dataOffset = sizeof(FileHeader);
+	for (auto& block : blocks) {
+		block.offset += snapshot->dataOffset;
+	}
+	header.numMolecules = numMolecules;
+	header.numBlocks = blocks.size();
+	header.blockTableOffset = sizeof(FileHeader) + data.size();
+#endif
+
+	timer.stop();
+	Log::global_log->info() << "[BlockedCheckpointWriter] snapshot of " << header.numMolecules << " molecules in "
+							<< header.numBlocks << " blocks for " << filename << " (" << header.blockTableOffset
+							<< " bytes) took " << timer.get_etime() << " sec" << std::endl;
+	return snapshot;
+}
+
+void BlockedCheckpointWriter::startWriting(Snapshot& snapshot, DomainDecompBase* domainDecomp) {
+	using namespace BlockedCheckpointFormat;
+	snapshot.timer.start();
+#ifdef ENABLE_MPI
+	MPI_Comm comm = domainDecomp->getCommunicator();
+	int rank;
+	MPI_CHECK(MPI_Comm_rank(comm, &rank));
+	MPI_CHECK(MPI_File_open(comm, const_cast<char*>(snapshot.filename.c_str()), MPI_MODE_WRONLY | MPI_MODE_CREATE,
+							MPI_INFO_NULL, &snapshot.fh));
+	MPI_CHECK(MPI_File_set_size(snapshot.fh, 0));
+	// the counts of MPI-IO are int, so large data is written in several collective calls
+	const unsigned long maxChunk = 1ul << 30;
+	unsigned long numChunks = (snapshot.data.size() + maxChunk - 1) / maxChunk;
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &numChunks, 1, MPI_UNSIGNED_LONG, MPI_MAX, comm));
+	for (unsigned long chunk = 0; chunk < numChunks; ++chunk) {
+		const unsigned long begin = std::min(snapshot.data.size(), chunk * maxChunk);
+		const unsigned long count = std::min(snapshot.data.size() - begin, maxChunk);
+		snapshot.requests.emplace_back();
+		MPI_CHECK(MPI_File_iwrite_at_all(snapshot.fh, static_cast<MPI_Offset>(snapshot.dataOffset + begin),
+										 snapshot.data.data() + begin, static_cast<int>(count), MPI_BYTE,
+										 &snapshot.requests.back()));
+	}
+	if (rank == 0) {
+		snapshot.requests.emplace_back();
+		MPI_CHECK(MPI_File_iwrite_at(snapshot.fh, 0, &snapshot.header, sizeof(FileHeader), MPI_BYTE,
+									 &snapshot.requests.back()));
+		snapshot.requests.emplace_back();
+		MPI_CHECK(MPI_File_iwrite_at(snapshot.fh, static_cast<MPI_Offset>(snapshot.header.blockTableOffset),
+									 snapshot.blocks.data(), static_cast<int>(snapshot.blocks.size() * sizeof(BlockInfo)),
+									 MPI_BYTE, &snapshot.requests.back()));
+	}
+#else
+	// errors are passed through the future and reported by finishWriting
+	snapshot.write = std::async(std::launch::async, [&snapshot]() {
+		std::ofstream ostrm(snapshot.filename.c_str(), std::ios::out | std::ios::binary);
+		if (not ostrm.is_open()) {
+			throw std::runtime_error("could not open " + snapshot.filename);
+		}
+		ostrm.write(reinterpret_cast<const char*>(&snapshot.header), sizeof(FileHeader));
+		ostrm.write(snapshot.data.data(), snapshot.data.size());
+		ostrm.write(reinterpret_cast<const char*>(snapshot.blocks.data()), snapshot.blocks.size() * sizeof(BlockInfo));
+		ostrm.close();
+		if (ostrm.fail()) {
+			throw std::runtime_error("could not write " + snapshot.filename);
+		}
+	});
+#endif
+}
+
+void BlockedCheckpointWriter::progressWriting(Snapshot& snapshot) {
+#ifdef ENABLE_MPI
+	// testing the requests drives the progress of the non-blocking writes
+	int completed;
+	MPI_CHECK(MPI_Testall(static_cast<int>(snapshot.requests.size()), snapshot.requests.data(), &completed,
+						  MPI_STATUSES_IGNORE));
+#endif
+}
+
+void BlockedCheckpointWriter::finishWriting(Snapshot& snapshot) {
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_Waitall(static_cast<int>(snapshot.requests.size()), snapshot.requests.data(), MPI_STATUSES_IGNORE));
+	MPI_CHECK(MPI_File_close(&snapshot.fh));
+#else
+	try {
+		snapshot.write.get();
+	} catch (const std::exception& e) {
+		std::ostringstream error_message;
+		error_message << "[BlockedCheckpointWriter] " << e.what() << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+#endif
+	snapshot.timer.stop();
+	Log::global_log->info() << "[BlockedCheckpointWriter] wrote " << snapshot.filename << ", "
+							<< snapshot.timer.get_etime() << " sec after starting" << std::endl;
+}
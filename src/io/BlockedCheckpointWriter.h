@@ -0,0 +1,98 @@
+#ifndef SRC_IO_BLOCKEDCHECKPOINTWRITER_H_
+#define SRC_IO_BLOCKEDCHECKPOINTWRITER_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "plugins/PluginBase.h"
+
+/**
+ * @brief Writes spatially indexed checkpoints, see BlockedCheckpointFormat.h for the layout.
+ *
+ * Every process sorts its molecules along a Morton curve, splits them into blocks and compresses them. The blocks
+ * of all processes are written to one file with collective MPI-IO, rank 0 writes the header and the block table.
+ * The checkpoints are read with the phase space file type "blocked" (BlockedCheckpointReader), where every
+ * process reads only the blocks overlapping its domain.
+ *
+ * In asynchronous mode, endStep only copies the molecules into a memory snapshot and starts non-blocking writes
+ * (MPI_File_iwrite_at_all, or a background thread without MPI), the simulation continues while the data is written.
+ * At most maxSnapshotsInFlight snapshots are kept in memory, the oldest one is completed before a new one is taken.
+ */
+class BlockedCheckpointWriter : public PluginBase {
+	friend class CheckpointRestartTest;
+
+public:
+	BlockedCheckpointWriter();
+	~BlockedCheckpointWriter() override;
+
+	/** @brief Read in XML configuration for BlockedCheckpointWriter.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <outputplugin name="BlockedCheckpointWriter">
+	     <writefrequency>INTEGER</writefrequency>
+	     <outputprefix>STRING</outputprefix>
+	     <incremental>BOOL</incremental>
+	     <appendTimestamp>BOOL</appendTimestamp>
+	     <blockSize>INTEGER</blockSize> <!-- maximal number of molecules per block; Default: 4096 -->
+	     <compression>BOOL</compression> <!-- compress the blocks; Default: true -->
+	     <asynchronous>BOOL</asynchronous> <!-- write in the background; Default: false -->
+	     <maxSnapshotsInFlight>INTEGER</maxSnapshotsInFlight> <!-- snapshots buffered while writing asynchronously; Default: 2 -->
+	   </outputplugin>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig) override;
+
+	void init(ParticleContainer* /*particleContainer*/, DomainDecompBase* /*domainDecomp*/, Domain* /*domain*/) override {}
+
+	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
+				 unsigned long simstep) override;
+
+	//! @brief Completes all asynchronous writes.
+	void finish(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
+
+	std::string getPluginName() override { return std::string("BlockedCheckpointWriter"); }
+
+	static PluginBase* createInstance() { return new BlockedCheckpointWriter(); }
+
+	/**
+	 * @brief Writes the inner molecules of all processes to filename (collective).
+	 * @param blockSize maximal number of molecules per block
+	 * @param compression whether the blocks are compressed
+	 */
+	static void writeCheckpoint(const std::string& filename, ParticleContainer* particleContainer,
+								DomainDecompBase* domainDecomp, Domain* domain, double currentTime,
+								unsigned long blockSize = 4096, bool compression = true);
+
+private:
+	//! in-memory copy of a checkpoint and the state of its writes
+	struct Snapshot;
+
+	//! @brief Serializes, sorts and compresses the molecules and computes the file layout (collective).
+	static std::unique_ptr<Snapshot> createSnapshot(const std::string& filename, ParticleContainer* particleContainer,
+													DomainDecompBase* domainDecomp, Domain* domain, double currentTime,
+													unsigned long blockSize, bool compression);
+
+	//! @brief Starts the non-blocking writes of a snapshot (collective).
+	static void startWriting(Snapshot& snapshot, DomainDecompBase* domainDecomp);
+
+	//! @brief Lets the writes of a snapshot progress without blocking.
+	static void progressWriting(Snapshot& snapshot);
+
+	//! @brief Waits for the writes of a snapshot and closes its file (collective), exits if they failed.
+	static void finishWriting(Snapshot& snapshot);
+
+	std::string _outputPrefix{"mardyn"};
+	unsigned long _writeFrequency{1};
+	bool _incremental{false};
+	bool _appendTimestamp{false};
+	unsigned long _blockSize{4096};
+	bool _compression{true};
+	bool _asynchronous{false};
+	unsigned long _maxSnapshotsInFlight{2};
+	//! snapshots which are being written, oldest first
+	std::deque<std::unique_ptr<Snapshot>> _snapshotsInFlight;
+};
+
+#endif /* SRC_IO_BLOCKEDCHECKPOINTWRITER_H_ */
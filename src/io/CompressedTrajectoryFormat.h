@@ -0,0 +1,63 @@
+/*
+ * CompressedTrajectoryFormat.h
+ *
+ * Layout of the compressed trajectory files written by CompressedTrajectoryWriter and read by
+ * CompressedTrajectoryReader.
+ *
+ * The file consists of one FileHeader followed by the frames. Every frame consists of
+ *  - one FrameHeader,
+ *  - FrameHeader::numChunks chunks, one per writing process: a ChunkHeader followed by ChunkHeader::encodedSize
+ *    bytes, which are the Huffman encoded (TrajectoryCodec::huffmanEncode) delta encoded records
+ *    (TrajectoryCodec::encodeRecords) of ChunkHeader::numMolecules molecules.
+ * The positions are quantized on the grid of FileHeader::cellLength, every cell edge is split into
+ * 2^FileHeader::precisionBits steps. An integer position q is restored to (q + 0.5) * cellLength / 2^precisionBits,
+ * so the error is at most half a step. All values are stored in the byte order of the writing machine, which is
+ * checked with FileHeader::endianness.
+ */
+
+#ifndef SRC_IO_COMPRESSEDTRAJECTORYFORMAT_H_
+#define SRC_IO_COMPRESSEDTRAJECTORYFORMAT_H_
+
+#include <cstdint>
+
+namespace CompressedTrajectoryFormat {
+
+const char magic[16] = "MarDynTrajCodec";
+const std::uint32_t version = 1;
+const std::int32_t endiannessTest = 0x0a0b0c0d;
+
+struct FileHeader {
+	char magic[16];
+	std::int32_t endianness;
+	std::uint32_t version;
+	//! number of quantization bits per cell edge
+	std::uint32_t precisionBits;
+	std::uint32_t reserved;
+	double globalLength[3];
+	//! edge lengths of the quantization cells
+	double cellLength[3];
+};
+
+struct FrameHeader {
+	std::uint64_t simstep;
+	double time;
+	std::uint64_t numMolecules;
+	std::uint64_t numChunks;
+	//! size of the frame including this header
+	std::uint64_t frameSize;
+};
+
+struct ChunkHeader {
+	std::uint64_t numMolecules;
+	//! size of the delta encoded records before the Huffman coding
+	std::uint64_t rawSize;
+	std::uint64_t encodedSize;
+};
+
+static_assert(sizeof(FileHeader) == 80, "FileHeader must not contain padding");
+static_assert(sizeof(FrameHeader) == 40, "FrameHeader must not contain padding");
+static_assert(sizeof(ChunkHeader) == 24, "ChunkHeader must not contain padding");
+
+} /* namespace CompressedTrajectoryFormat */
+
+#endif /* SRC_IO_COMPRESSEDTRAJECTORYFORMAT_H_ */
@@ -0,0 +1,84 @@
+#include "io/CompressedTrajectoryReader.h"
+
+#include <cstring>
+
+#include "utils/TrajectoryCodec.h"
+
+bool CompressedTrajectoryReader::open(const std::string& filename) {
+	using namespace CompressedTrajectoryFormat;
+	_error.clear();
+	_file.open(filename.c_str(), std::ios::in | std::ios::binary);
+	if (not _file.read(reinterpret_cast<char*>(&_header), sizeof(FileHeader))) {
+		_error = "Could not read the header of " + filename;
+		return false;
+	}
+	if (std::memcmp(_header.magic, magic, sizeof(magic)) != 0) {
+		_error = filename + " is not a compressed trajectory";
+		return false;
+	}
+	if (_header.endianness != endiannessTest) {
+		_error = filename + " was written on a machine with a different byte order";
+		return false;
+	}
+	if (_header.version != version) {
+		_error = "Unsupported version " + std::to_string(_header.version) + " of " + filename;
+		return false;
+	}
+	return true;
+}
+
+bool CompressedTrajectoryReader::readFrame(Frame& frame) {
+	using namespace CompressedTrajectoryFormat;
+	_error.clear();
+	FrameHeader frameHeader;
+	if (not _file.read(reinterpret_cast<char*>(&frameHeader), sizeof(FrameHeader))) {
+		if (_file.gcount() != 0) {
+			_error = "Truncated frame header";
+		}
+		return false;
+	}
+	frame.simstep = frameHeader.simstep;
+	frame.time = frameHeader.time;
+	frame.molecules.clear();
+	frame.molecules.reserve(frameHeader.numMolecules);
+
+	double step[3];
+	for (int d = 0; d < 3; ++d) {
+		step[d] = _header.cellLength[d] / static_cast<double>(1ul << _header.precisionBits);
+	}
+	std::vector<char> encoded;
+	std::vector<unsigned char> raw;
+	std::vector<TrajectoryCodec::Record> records;
+	for (std::uint64_t c = 0; c < frameHeader.numChunks; ++c) {
+		ChunkHeader chunk;
+		if (not _file.read(reinterpret_cast<char*>(&chunk), sizeof(ChunkHeader))) {
+			_error = "Truncated chunk header in frame of step " + std::to_string(frameHeader.simstep);
+			return false;
+		}
+		encoded.resize(chunk.encodedSize);
+		if (not _file.read(encoded.data(), encoded.size())) {
+			_error = "Truncated chunk in frame of step " + std::to_string(frameHeader.simstep);
+			return false;
+		}
+		const auto* in = reinterpret_cast<const unsigned char*>(encoded.data());
+		if (not TrajectoryCodec::huffmanDecode(in, encoded.size(), chunk.rawSize, raw) or
+			not TrajectoryCodec::decodeRecords(raw.data(), raw.size(), chunk.numMolecules, records)) {
+			_error = "Corrupted chunk in frame of step " + std::to_string(frameHeader.simstep);
+			return false;
+		}
+		for (const auto& record : records) {
+			Molecule molecule;
+			molecule.id = record.id;
+			molecule.componentId = record.componentId;
+			for (int d = 0; d < 3; ++d) {
+				molecule.r[d] = (static_cast<double>(record.position[d]) + 0.5) * step[d];
+			}
+			frame.molecules.push_back(molecule);
+		}
+	}
+	if (frame.molecules.size() != frameHeader.numMolecules) {
+		_error = "Wrong number of molecules in frame of step " + std::to_string(frameHeader.simstep);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,54 @@
+#ifndef SRC_IO_COMPRESSEDTRAJECTORYREADER_H_
+#define SRC_IO_COMPRESSEDTRAJECTORYREADER_H_
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "io/CompressedTrajectoryFormat.h"
+
+/**
+ * @brief Sequential reader for the trajectories of CompressedTrajectoryWriter, see CompressedTrajectoryFormat.h.
+ *
+ * The reader only depends on the standard library and is also used by tools/trajectory-decompress. Typical use:
+ * \code
+   CompressedTrajectoryReader reader;
+   if (not reader.open("traj.ctrj")) { std::cerr << reader.getError(); }
+   CompressedTrajectoryReader::Frame frame;
+   while (reader.readFrame(frame)) { ... frame.molecules ... }
+   \endcode
+ * Within a frame, the molecules of each writing process are sorted along a Hilbert curve.
+ */
+class CompressedTrajectoryReader {
+public:
+	struct Molecule {
+		std::uint64_t id;
+		std::uint32_t componentId;
+		double r[3];
+	};
+
+	struct Frame {
+		std::uint64_t simstep;
+		double time;
+		std::vector<Molecule> molecules;
+	};
+
+	//! @return false, if the file cannot be opened or has no valid header
+	bool open(const std::string& filename);
+
+	//! @return false at the end of the file or if the frame is corrupted, see getError()
+	bool readFrame(Frame& frame);
+
+	const CompressedTrajectoryFormat::FileHeader& getHeader() const { return _header; }
+
+	//! @return description of the last error, empty at the regular end of the file
+	const std::string& getError() const { return _error; }
+
+private:
+	std::ifstream _file;
+	CompressedTrajectoryFormat::FileHeader _header{};
+	std::string _error;
+};
+
+#endif /* SRC_IO_COMPRESSEDTRAJECTORYREADER_H_ */
@@ -0,0 +1,181 @@
+#include "io/CompressedTrajectoryWriter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "utils/Logger.h"
+#include "utils/SpaceFillingCurve.h"
+#include "utils/TrajectoryCodec.h"
+#include "utils/mardyn_assert.h"
+
+void CompressedTrajectoryWriter::readXML(XMLfileUnits& xmlconfig) {
+	xmlconfig.getNodeValue("writefrequency", _writeFrequency);
+	Log::global_log->info() << "[CompressedTrajectoryWriter] write frequency: " << _writeFrequency << std::endl;
+	if (_writeFrequency == 0) {
+		std::ostringstream error_message;
+		error_message << "Write frequency must be a positive nonzero integer, but is " << _writeFrequency << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	xmlconfig.getNodeValue("outputprefix", _outputPrefix);
+	Log::global_log->info() << "[CompressedTrajectoryWriter] output prefix: " << _outputPrefix << std::endl;
+
+	xmlconfig.getNodeValue("precisionBits", _precisionBits);
+	if (_precisionBits > 32) {
+		std::ostringstream error_message;
+		error_message << "[CompressedTrajectoryWriter] precisionBits must not exceed 32, but is " << _precisionBits
+					  << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	Log::global_log->info() << "[CompressedTrajectoryWriter] quantization steps per cell edge: 2^" << _precisionBits
+							<< std::endl;
+}
+
+void CompressedTrajectoryWriter::init(ParticleContainer* /*particleContainer*/, DomainDecompBase* domainDecomp,
+									  Domain* domain) {
+	using namespace CompressedTrajectoryFormat;
+
+	std::memcpy(_header.magic, magic, sizeof(_header.magic));
+	_header.endianness = endiannessTest;
+	_header.version = version;
+	_header.precisionBits = _precisionBits;
+	unsigned long maxCells = 1;
+	for (int d = 0; d < 3; ++d) {
+		const double length = domain->getGlobalLength(d);
+		_numCells[d] = std::max(1ul, static_cast<unsigned long>(length / _simulation.getcutoffRadius()));
+		_numCells[d] = std::min(_numCells[d], 1ul << 21);
+		maxCells = std::max(maxCells, _numCells[d]);
+		_header.globalLength[d] = length;
+		_header.cellLength[d] = length / static_cast<double>(_numCells[d]);
+	}
+	_curveBits = 1;
+	while ((1ul << _curveBits) < maxCells) {
+		++_curveBits;
+	}
+	Log::global_log->info() << "[CompressedTrajectoryWriter] quantization cells: " << _numCells[0] << " x "
+							<< _numCells[1] << " x " << _numCells[2] << std::endl;
+
+	if (domainDecomp->getRank() == 0) {
+		std::ofstream ostrm((_outputPrefix + ".ctrj").c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+		ostrm.write(reinterpret_cast<const char*>(&_header), sizeof(FileHeader));
+	}
+	_fileSize = sizeof(FileHeader);
+}
+
+void CompressedTrajectoryWriter::endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+										 Domain* /*domain*/, unsigned long simstep) {
+	if (simstep % _writeFrequency != 0) {
+		return;
+	}
+	writeFrame(particleContainer, domainDecomp, simstep);
+}
+
+void CompressedTrajectoryWriter::writeFrame(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+											unsigned long simstep) {
+	using namespace CompressedTrajectoryFormat;
+
+	// quantize the positions and sort the molecules along the Hilbert curve over the cells
+	const double stepsPerCell = static_cast<double>(1ul << _precisionBits);
+	std::vector<std::pair<std::uint64_t, TrajectoryCodec::Record>> keyedRecords;
+	for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		TrajectoryCodec::Record record;
+		record.id = m->getID();
+		record.componentId = m->componentid();
+		std::uint32_t cell[3];
+		for (int d = 0; d < 3; ++d) {
+			const double numSteps = static_cast<double>(_numCells[d]) * stepsPerCell;
+			const double scaled = std::floor(m->r(d) / _header.cellLength[d] * stepsPerCell);
+			record.position[d] = static_cast<std::int64_t>(std::max(0., std::min(numSteps - 1., scaled)));
+			cell[d] = static_cast<std::uint32_t>(record.position[d] >> _precisionBits);
+		}
+		keyedRecords.emplace_back(SpaceFillingCurve::hilbertKey(cell[0], cell[1], cell[2], _curveBits), record);
+	}
+	std::stable_sort(keyedRecords.begin(), keyedRecords.end(),
+					 [](const auto& a, const auto& b) { return a.first < b.first; });
+	std::vector<TrajectoryCodec::Record> records;
+	records.reserve(keyedRecords.size());
+	for (const auto& keyedRecord : keyedRecords) {
+		records.push_back(keyedRecord.second);
+	}
+
+	std::vector<unsigned char> raw;
+	TrajectoryCodec::encodeRecords(records, raw);
+	std::vector<char> chunk(sizeof(ChunkHeader));
+	TrajectoryCodec::huffmanEncode(raw.data(), raw.size(), chunk);
+	ChunkHeader chunkHeader;
+	chunkHeader.numMolecules = records.size();
+	chunkHeader.rawSize = raw.size();
+	chunkHeader.encodedSize = chunk.size() - sizeof(ChunkHeader);
+	std::memcpy(chunk.data(), &chunkHeader, sizeof(ChunkHeader));
+
+	FrameHeader frameHeader;
+	frameHeader.simstep = simstep;
+	frameHeader.time = _simulation.getSimulationTime();
+	const std::string filename = _outputPrefix + ".ctrj";
+#ifdef ENABLE_MPI
+	MPI_Comm comm = domainDecomp->getCommunicator();
+	int rank, numProcs;
+	MPI_CHECK(MPI_Comm_rank(comm, &rank));
+	MPI_CHECK(MPI_Comm_size(comm, &numProcs));
+	unsigned long localSizes[2] = {chunk.size(), records.size()};
+	unsigned long offsets[2] = {0, 0};
+	unsigned long totals[2];
+	MPI_CHECK(MPI_Exscan(localSizes, offsets, 2, MPI_UNSIGNED_LONG, MPI_SUM, comm));
+	if (rank == 0) {
+		std::fill(offsets, offsets + 2, 0);
+	}
+	MPI_CHECK(MPI_Allreduce(localSizes, totals, 2, MPI_UNSIGNED_LONG, MPI_SUM, comm));
+	frameHeader.numMolecules = totals[1];
+	frameHeader.numChunks = numProcs;
+	frameHeader.frameSize = sizeof(FrameHeader) + totals[0];
+
+	MPI_File fh;
+	MPI_CHECK(MPI_File_open(comm, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY | MPI_MODE_CREATE,
+							MPI_INFO_NULL, &fh));
+	// the counts of MPI-IO are int, so large chunks are written in several collective calls
+	const unsigned long maxWrite = 1ul << 30;
+	unsigned long numWrites = (chunk.size() + maxWrite - 1) / maxWrite;
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &numWrites, 1, MPI_UNSIGNED_LONG, MPI_MAX, comm));
+	const unsigned long chunkOffset = _fileSize + sizeof(FrameHeader) + offsets[0];
+	for (unsigned long w = 0; w < numWrites; ++w) {
+		const unsigned long begin = std::min(chunk.size(), w * maxWrite);
+		const unsigned long count = std::min(chunk.size() - begin, maxWrite);
+		MPI_CHECK(MPI_File_write_at_all(fh, static_cast<MPI_Offset>(chunkOffset + begin), chunk.data() + begin,
+										static_cast<int>(count), MPI_BYTE, MPI_STATUS_IGNORE));
+	}
+	if (rank == 0) {
+		MPI_CHECK(MPI_File_write_at(fh, static_cast<MPI_Offset>(_fileSize), &frameHeader, sizeof(FrameHeader), MPI_BYTE,
+									MPI_STATUS_IGNORE));
+	}
+	MPI_CHECK(MPI_File_close(&fh));
+#else
+	frameHeader.numMolecules = records.size();
+	frameHeader.numChunks = 1;
+	frameHeader.frameSize = sizeof(FrameHeader) + chunk.size();
+	std::ofstream ostrm(filename.c_str(), std::ios::out | std::ios::binary | std::ios::app);
+	ostrm.write(reinterpret_cast<const char*>(&frameHeader), sizeof(FrameHeader));
+	ostrm.write(chunk.data(), chunk.size());
+#endif
+	_fileSize += frameHeader.frameSize;
+
+	// compared to an id, a component id and three doubles per molecule
+	const double uncompressedSize =
+		static_cast<double>(frameHeader.numMolecules) * (sizeof(std::uint64_t) + sizeof(std::uint32_t) + 3 * sizeof(double));
+	Log::global_log->info() << "[CompressedTrajectoryWriter] wrote frame of step " << simstep << " with "
+							<< frameHeader.numMolecules << " molecules, " << frameHeader.frameSize << " bytes (ratio "
+							<< uncompressedSize / static_cast<double>(frameHeader.frameSize) << ")" << std::endl;
+}
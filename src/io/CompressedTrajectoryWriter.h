@@ -0,0 +1,64 @@
+#ifndef SRC_IO_COMPRESSEDTRAJECTORYWRITER_H_
+#define SRC_IO_COMPRESSEDTRAJECTORYWRITER_H_
+
+#include <string>
+
+#include "io/CompressedTrajectoryFormat.h"
+#include "plugins/PluginBase.h"
+
+/**
+ * @brief Writes compact, lossless compressed trajectories of the molecule positions, ids and component ids.
+ *
+ * The positions are quantized on a grid of cells with about the cutoff radius as edge length, every cell edge is
+ * split into 2^precisionBits steps. Every process sorts its molecules along a Hilbert curve over the cells, delta
+ * encodes them and compresses the result with a Huffman code (TrajectoryCodec.h). All frames go into one file
+ * (written with collective MPI-IO), the format is described in CompressedTrajectoryFormat.h. The files are read with
+ * CompressedTrajectoryReader, tools/trajectory-decompress converts them to text.
+ */
+class CompressedTrajectoryWriter : public PluginBase {
+public:
+	CompressedTrajectoryWriter() = default;
+	~CompressedTrajectoryWriter() override = default;
+
+	/** @brief Read in XML configuration for CompressedTrajectoryWriter.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <outputplugin name="CompressedTrajectoryWriter">
+	     <writefrequency>INTEGER</writefrequency>
+	     <outputprefix>STRING</outputprefix> <!-- the file is named outputprefix.ctrj -->
+	     <precisionBits>INTEGER</precisionBits> <!-- quantization steps per cell edge are 2^precisionBits; Default: 10 -->
+	   </outputplugin>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig) override;
+
+	//! @brief Sets up the quantization grid and writes the file header.
+	void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
+
+	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
+				 unsigned long simstep) override;
+
+	void finish(ParticleContainer* /*particleContainer*/, DomainDecompBase* /*domainDecomp*/,
+				Domain* /*domain*/) override {}
+
+	std::string getPluginName() override { return std::string("CompressedTrajectoryWriter"); }
+
+	static PluginBase* createInstance() { return new CompressedTrajectoryWriter(); }
+
+private:
+	//! @brief Appends one frame with the inner molecules of all processes to the file (collective).
+	void writeFrame(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep);
+
+	std::string _outputPrefix{"mardyn"};
+	unsigned long _writeFrequency{1};
+	unsigned _precisionBits{10};
+	CompressedTrajectoryFormat::FileHeader _header{};
+	//! number of quantization cells per dimension and bits of the Hilbert curve over them
+	unsigned long _numCells[3]{1, 1, 1};
+	unsigned _curveBits{1};
+	//! current size of the file, the same on all processes
+	unsigned long _fileSize{0};
+};
+
+#endif /* SRC_IO_COMPRESSEDTRAJECTORYWRITER_H_ */
@@ -1,6 +1,12 @@
 #include "IOHelpers.h"
 
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+#include "Domain.h"
 #include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/ParticleContainer.h"
 #include "utils/generator/EqualVelocityAssigner.h"
@@ -149,3 +155,142 @@ unsigned long IOHelpers::makeParticleIdsUniqueAndGetTotalNumParticles(ParticleCo
 	domainDecomp->collCommFinalize();
 	return globalNumParticles;
 }
+
+size_t IOHelpers::binaryRecordSize(const std::string& format) {
+	if (format == "ICRVQD") {
+		return 8 + 4 + 13 * 8;
+	} else if (format == "ICRV") {
+		return 8 + 4 + 6 * 8;
+	} else if (format == "IRV") {
+		return 8 + 6 * 8;
+	}
+	return 0;
+}
+
+namespace {
+template <typename T>
+T readValue(const char*& record) {
+	T value;
+	std::memcpy(&value, record, sizeof(T));
+	record += sizeof(T);
+	return value;
+}
+}  // namespace
+
+Molecule IOHelpers::moleculeFromBinaryRecord(const char* record, const std::string& format,
+											 std::vector<Component>& components) {
+	double r[3], v[3];
+	double q[4] = {1., 0., 0., 0.};
+	double D[3] = {0., 0., 0.};
+	std::uint32_t componentid = 1;
+
+	const auto id = readValue<std::uint64_t>(record);
+	if (format != "IRV") {
+		componentid = readValue<std::uint32_t>(record);
+	}
+	for (double& ri : r) {
+		ri = readValue<double>(record);
+	}
+	for (double& vi : v) {
+		vi = readValue<double>(record);
+	}
+	if (format == "ICRVQD") {
+		for (double& qi : q) {
+			qi = readValue<double>(record);
+		}
+		for (double& Di : D) {
+			Di = readValue<double>(record);
+		}
+	}
+
+	if (componentid > components.size()) {
+		std::ostringstream error_message;
+		error_message << "Molecule id " << id
+					  << " has a component ID greater than the existing number of components: " << componentid << ">"
+					  << components.size() << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (componentid == 0) {
+		std::ostringstream error_message;
+		error_message << "Molecule id " << id << " has componentID == 0." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	// ComponentIDs in the input files start with 1
+	return Molecule(id, &components[componentid - 1], r[0], r[1], r[2], v[0], v[1], v[2], q[0], q[1], q[2], q[3], D[0],
+					D[1], D[2]);
+}
+
+unsigned long IOHelpers::reduceReadInStatistics(const std::vector<unsigned long>& numMoleculesPerComponent,
+												const std::vector<Molecule>& samples, const std::vector<bool>& hasSample,
+												unsigned long maxId, Domain* domain, DomainDecompBase* domainDecomp) {
+	std::vector<Component>& components = *(_simulation.getEnsemble()->getComponents());
+	const size_t numComponents = components.size();
+
+	domainDecomp->collCommInit(static_cast<int>(numComponents));
+	for (size_t cid = 0; cid < numComponents; ++cid) {
+		domainDecomp->collCommAppendUnsLong(numMoleculesPerComponent[cid]);
+	}
+	domainDecomp->collCommAllreduceSum();
+	for (auto& component : components) {
+		const unsigned long numMolecules = domainDecomp->collCommGetUnsLong();
+		component.setNumMolecules(component.getNumMolecules() + numMolecules);
+		domain->setglobalRotDOF(domain->getglobalRotDOF() + numMolecules * component.getRotationalDegreesOfFreedom());
+	}
+	domainDecomp->collCommFinalize();
+
+	domainDecomp->collCommInit(1);
+	domainDecomp->collCommAppendUnsLong(maxId);
+	domainDecomp->collCommAllreduceCustom(ReduceType::MAX);
+	maxId = domainDecomp->collCommGetUnsLong();
+	domainDecomp->collCommFinalize();
+
+	// lowest rank with a sample of each component
+	const int numProcs = domainDecomp->getNumProcs();
+	std::vector<int> sampleRanks(numComponents);
+	domainDecomp->collCommInit(static_cast<int>(numComponents));
+	for (size_t cid = 0; cid < numComponents; ++cid) {
+		domainDecomp->collCommAppendInt(hasSample[cid] ? domainDecomp->getRank() : numProcs);
+	}
+	domainDecomp->collCommAllreduceCustom(ReduceType::MIN);
+	for (size_t cid = 0; cid < numComponents; ++cid) {
+		sampleRanks[cid] = domainDecomp->collCommGetInt();
+	}
+	domainDecomp->collCommFinalize();
+
+	// only used inside GrandCanonical
+	for (size_t cid = 0; cid < numComponents; ++cid) {
+		if (sampleRanks[cid] == numProcs) {
+			continue;
+		}
+
+		const Molecule sample = hasSample[cid] ? samples[cid] : Molecule();
+		domainDecomp->collCommInit(14);
+		domainDecomp->collCommAppendUnsLong(sample.getID());
+		for (int d = 0; d < 3; ++d) {
+			domainDecomp->collCommAppendDouble(sample.r(d));
+			domainDecomp->collCommAppendDouble(sample.v(d));
+			domainDecomp->collCommAppendDouble(sample.D(d));
+		}
+		domainDecomp->collCommAppendDouble(sample.q().qw());
+		domainDecomp->collCommAppendDouble(sample.q().qx());
+		domainDecomp->collCommAppendDouble(sample.q().qy());
+		domainDecomp->collCommAppendDouble(sample.q().qz());
+		domainDecomp->collCommBroadcast(sampleRanks[cid]);
+		const unsigned long id = domainDecomp->collCommGetUnsLong();
+		double r[3], v[3], D[3];
+		for (int d = 0; d < 3; ++d) {
+			r[d] = domainDecomp->collCommGetDouble();
+			v[d] = domainDecomp->collCommGetDouble();
+			D[d] = domainDecomp->collCommGetDouble();
+		}
+		const double qw = domainDecomp->collCommGetDouble();
+		const double qx = domainDecomp->collCommGetDouble();
+		const double qy = domainDecomp->collCommGetDouble();
+		const double qz = domainDecomp->collCommGetDouble();
+		domainDecomp->collCommFinalize();
+
+		Molecule m(id, &components[cid], r[0], r[1], r[2], v[0], v[1], v[2], qw, qx, qy, qz, D[0], D[1], D[2]);
+		global_simulation->getEnsemble()->storeSample(&m, cid);
+	}
+	return maxId;
+}
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "molecules/Component.h"
+#include "molecules/Molecule.h"
 
 class ParticleContainer;
 class DomainDecompBase;
+class Domain;
 
 namespace IOHelpers {
 
@@ -45,4 +50,38 @@ void initializeVelocityAccordingToTemperature(ParticleContainer* particleContain
 unsigned long makeParticleIdsUniqueAndGetTotalNumParticles(ParticleContainer* particleContainer,
 														   DomainDecompBase* domainDecomp);
 
+/**
+ * Size of one molecule record of the binary phase space formats, as written by Molecule::writeBinary().
+ * @param format One of "ICRVQD", "ICRV" or "IRV".
+ * @return The size in bytes, 0 for an unknown format.
+ */
+size_t binaryRecordSize(const std::string& format);
+
+/**
+ * Creates a molecule from one record of a binary phase space file.
+ * Exits, if the component id of the record is not valid.
+ * @param record Begin of the record, binaryRecordSize(format) bytes are read.
+ * @param format One of "ICRVQD", "ICRV" or "IRV". Records without component id belong to the first component.
+ * @param components The components of the simulation, the ids in the record start at 1.
+ */
+Molecule moleculeFromBinaryRecord(const char* record, const std::string& format, std::vector<Component>& components);
+
+/**
+ * Completes a read-in, in which each rank only read a part of the molecules.
+ * The numbers of molecules per component are summed up over all ranks and added to the components and to the
+ * rotational degrees of freedom of the domain. The first sample of each component found on any rank is passed to
+ * Ensemble::storeSample() on all ranks.
+ *
+ * @param numMoleculesPerComponent Number of molecules per component read by this rank.
+ * @param samples One molecule per component read by this rank, only valid if the corresponding hasSample is set.
+ * @param hasSample Whether this rank read a molecule of the component.
+ * @param maxId Highest molecule id read by this rank.
+ * @param domain
+ * @param domainDecomp
+ * @return The highest molecule id of all ranks.
+ */
+unsigned long reduceReadInStatistics(const std::vector<unsigned long>& numMoleculesPerComponent,
+									 const std::vector<Molecule>& samples, const std::vector<bool>& hasSample,
+									 unsigned long maxId, Domain* domain, DomainDecompBase* domainDecomp);
+
 }  // namespace IOHelpers
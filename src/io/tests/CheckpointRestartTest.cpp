@@ -10,6 +10,10 @@
 #include "Domain.h"
 #include "particleContainer/ParticleContainer.h"
 #include "parallel/DomainDecompBase.h"
+#include "io/BinaryReader.h"
+#include "io/BlockedCheckpointReader.h"
+#include "io/BlockedCheckpointWriter.h"
+#include "particleContainer/LinkedCells.h"
 #include <iostream>
 
 #include "io/tests/CheckpointRestartTest.h"
@@ -58,6 +62,114 @@ void CheckpointRestartTest::testCheckpointRestart(bool binary) {
 	delete particleContainer2;
 }
 
+void CheckpointRestartTest::testParallelBinaryRead() {
+	constexpr double cutoff = 10.5;
+	ParticleContainer* particleContainer
+		= initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationMultiComponentMultiPotentials_50_molecules.inp", cutoff);
+	const std::string filename = getTestDataFilename("parallelread.test", false);
+	_domain->writeCheckpoint(filename, particleContainer, _domainDecomposition, 0., true);
+
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = particleContainer->getBoundingBoxMin(d);
+		bBoxMax[d] = particleContainer->getBoundingBoxMax(d);
+	}
+	delete particleContainer;
+
+	unsigned long numParticles[2];
+	unsigned long sumOfIDs[2];
+	double sumOfPositions[2];
+	unsigned long maxIDs[2];
+	for (int parallel = 0; parallel < 2; ++parallel) {
+		BinaryReader reader;
+		reader.setPhaseSpaceHeaderFile(filename + ".header.xml");
+		reader.setPhaseSpaceFile(filename + ".dat");
+		reader.setParallelRead(parallel == 1);
+		reader.readPhaseSpaceHeader(_domain, 1.0);
+
+		LinkedCells container(bBoxMin, bBoxMax, cutoff);
+		maxIDs[parallel] = reader.readPhaseSpace(&container, _domain, _domainDecomposition);
+		numParticles[parallel] = container.getNumberOfParticles();
+		sumOfIDs[parallel] = 0;
+		sumOfPositions[parallel] = 0.;
+		for (auto m = container.iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			sumOfIDs[parallel] += m->getID();
+			sumOfPositions[parallel] += m->r(0) + m->r(1) + m->r(2);
+		}
+	}
+	ASSERT_EQUAL(numParticles[0], numParticles[1]);
+	ASSERT_EQUAL(sumOfIDs[0], sumOfIDs[1]);
+	ASSERT_DOUBLES_EQUAL(sumOfPositions[0], sumOfPositions[1], 1e-8);
+	ASSERT_EQUAL(maxIDs[0], maxIDs[1]);
+}
+
+void CheckpointRestartTest::testCheckpointRestartBlocked() {
+	testCheckpointRestartBlocked(false);
+}
+
+void CheckpointRestartTest::testCheckpointRestartBlockedAsync() {
+	testCheckpointRestartBlocked(true);
+}
+
+void CheckpointRestartTest::testCheckpointRestartBlocked(bool asynchronous) {
+	constexpr double cutoff = 10.5;
+	ParticleContainer* particleContainer
+		= initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationMultiComponentMultiPotentials_50_molecules.inp", cutoff);
+	const auto initialParticleCount = getGlobalParticleNumber(particleContainer);
+	unsigned long initialSumOfIDs = 0;
+	for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		initialSumOfIDs += m->getID();
+	}
+
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = particleContainer->getBoundingBoxMin(d);
+		bBoxMax[d] = particleContainer->getBoundingBoxMax(d);
+	}
+	// small blocks, such that a part of the domain only needs a part of them
+	const std::string prefix = getTestDataFilename(asynchronous ? "restart.async" : "restart", false);
+	const std::string filename = prefix + ".blocked.restart";
+	if (asynchronous) {
+		BlockedCheckpointWriter writer;
+		writer._outputPrefix = prefix;
+		writer._blockSize = 4;
+		writer._asynchronous = true;
+		writer.endStep(particleContainer, _domainDecomposition, _domain, 0);
+		ASSERT_EQUAL(writer._snapshotsInFlight.size(), static_cast<size_t>(1));
+		delete particleContainer;
+		writer.finish(nullptr, _domainDecomposition, _domain);
+		ASSERT_TRUE(writer._snapshotsInFlight.empty());
+	} else {
+		BlockedCheckpointWriter::writeCheckpoint(filename, particleContainer, _domainDecomposition, _domain, 0., 4);
+		delete particleContainer;
+	}
+
+	BlockedCheckpointReader reader;
+	reader.setPhaseSpaceFile(filename);
+	reader.readPhaseSpaceHeader(_domain, 1.0);
+	ASSERT_EQUAL(initialParticleCount, _domain->getglobalNumMolecules(false));
+
+	// read the lower and the upper half of the own domain separately
+	unsigned long particleCount = 0;
+	unsigned long sumOfIDs = 0;
+	const double split = 0.5 * (bBoxMin[0] + bBoxMax[0]);
+	for (int half = 0; half < 2; ++half) {
+		double min[3] = {half == 0 ? bBoxMin[0] : split, bBoxMin[1], bBoxMin[2]};
+		double max[3] = {half == 0 ? split : bBoxMax[0], bBoxMax[1], bBoxMax[2]};
+		LinkedCells container(min, max, cutoff);
+		reader.readPhaseSpace(&container, _domain, _domainDecomposition);
+		for (auto m = container.iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			ASSERT_TRUE(container.isInBoundingBox(m->r_arr().data()));
+			sumOfIDs += m->getID();
+		}
+		particleCount += getGlobalParticleNumber(&container);
+	}
+	ASSERT_EQUAL(initialParticleCount, particleCount);
+	ASSERT_EQUAL(initialSumOfIDs, sumOfIDs);
+}
+
 unsigned long CheckpointRestartTest::getGlobalParticleNumber(ParticleContainer* particleContainer){
 	unsigned long localParticleCount = particleContainer->getNumberOfParticles();
 	_domainDecomposition->collCommInit(1);
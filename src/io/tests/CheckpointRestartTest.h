@@ -21,6 +21,12 @@ class CheckpointRestartTest : public utils::TestWithSimulationSetup {
 	// add a method which perform test
 	TEST_METHOD(testCheckpointRestartBinary);
 
+	TEST_METHOD(testParallelBinaryRead);
+
+	TEST_METHOD(testCheckpointRestartBlocked);
+
+	TEST_METHOD(testCheckpointRestartBlockedAsync);
+
 	// end suite declaration
 	TEST_SUITE_END();
 
@@ -31,8 +37,27 @@ public:
 	void testCheckpointRestartASCII();
 
 	void testCheckpointRestartBinary();
+
+	/**
+	 * The collective read-in of the BinaryReader has to yield the same molecules on each rank as the sequential one.
+	 */
+	void testParallelBinaryRead();
+
+	/**
+	 * A blocked checkpoint restores all molecules, also when it is read into a container covering only a part of the
+	 * domain.
+	 */
+	void testCheckpointRestartBlocked();
+
+	/**
+	 * Same as testCheckpointRestartBlocked, but the checkpoint is written asynchronously by the plugin. The container
+	 * is deleted before the writes are completed, the snapshot has to be independent of it.
+	 */
+	void testCheckpointRestartBlockedAsync();
 private:
 
+	void testCheckpointRestartBlocked(bool asynchronous);
+
 	void testCheckpointRestart(bool binary);
 	unsigned long getGlobalParticleNumber(ParticleContainer* particleContainer);
 };
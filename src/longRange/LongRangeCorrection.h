@@ -18,6 +18,13 @@ public:
 	virtual void readXML(XMLfileUnits& xmlconfig) = 0;
 	virtual void calculateLongRange() = 0;
 	virtual void writeProfiles(DomainDecompBase* domainDecomp, Domain* domain, unsigned long simstep) = 0;
+
+	//! @brief weight of the forces applied to the molecules (multiple time stepping), energy and virial are not weighted
+	void setForceFactor(double factor) { _forceFactor = factor; }
+	double getForceFactor() const { return _forceFactor; }
+
+protected:
+	double _forceFactor{1.0};
 /*
 private:
 	unsigned _type;
@@ -81,6 +81,8 @@ void Planar::init()
 	resizeExactly(rhoDipole, _slabs*numDipoleSum);
 	resizeExactly(rhoDipoleL, _slabs*numDipoleSum);
 	resizeExactly(eLong, numLJSum);
+	_rhoLJBins.resize(_slabs*numLJSum);
+	_rhoDipoleBins.resize(_slabs*numDipoleSum);
 
 	unsigned counter=0;
 	for (unsigned i =0; i< numComp; i++){		// Determination of the elongation of the Lennard-Jones sites
@@ -220,9 +222,42 @@ void Planar::readXML(XMLfileUnits& xmlconfig)
 	}
 }
 
+void Planar::binDensity(Molecule& mol, double delta_inv, double slabsPerV) {
+	unsigned cid=mol.componentid();
+
+	for (unsigned i=0; i<numLJ[cid]; i++){
+		int loc=(mol.ljcenter_d_abs(i)[1]) * delta_inv;
+		if (loc < 0){
+			loc=loc+_slabs;
+		}
+		else if (loc > sint-1){
+			loc=loc-_slabs;
+		}
+		const int index = loc + _slabs * (i + numLJSum2[cid]);
+		_rhoLJBins.add(index, slabsPerV);
+	}
+	if (numDipole[cid] != 0){
+		int loc=mol.r(1) * delta_inv;
+
+		const int index = loc + _slabs * (numDipoleSum2[cid]);
+		_rhoDipoleBins.add(index, slabsPerV);
+	}
+}
+
+void Planar::reduceDensityBins(std::vector<double>& rhoLJ, std::vector<double>& rhoDip) {
+	_rhoLJBins.reduceInto(rhoLJ);
+	_rhoDipoleBins.reduceInto(rhoDip);
+	_rhoLJBins.reset();
+	_rhoDipoleBins.reset();
+}
+
 void Planar::calculateLongRange() {
 
-	if (_smooth){
+	const bool profileStep = simstep % frequency == 0;
+
+	// In smooth mode the density of every time step is accumulated. Apart from the steps in which the profile
+	// is evaluated, this is done in the loop applying the correction below to save a pass over all molecules.
+	if (_smooth and profileStep){
 		const double delta_inv = 1.0 / delta;
 		const double slabsPerV = _slabs / V;
 
@@ -230,36 +265,11 @@ void Planar::calculateLongRange() {
 		#pragma omp parallel
 		#endif
 		for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
-			unsigned cid=tempMol->componentid();
-
-			for (unsigned i=0; i<numLJ[cid]; i++){
-				int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
-				if (loc < 0){
-					loc=loc+_slabs;
-				}
-				else if (loc > sint-1){
-					loc=loc-_slabs;
-				}
-				const int index = loc + _slabs * (i + numLJSum2[cid]);
-
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				rho_g[index] += slabsPerV;
-			}
-			if (numDipole[cid] != 0){
-				int loc=tempMol->r(1) * delta_inv;
-
-				const int index = loc + _slabs * (numDipoleSum2[cid]);
-
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				rhoDipole[index] += slabsPerV;
-			}
+			binDensity(*tempMol, delta_inv, slabsPerV);
 		}
+		reduceDensityBins(rho_g, rhoDipole);
 	}
-	if (simstep % frequency == 0){	// The Density Profile is only calculated once in 10 simulation steps
+	if (profileStep){	// The Density Profile is only calculated once in 10 simulation steps
 
 		std::fill(rho_l.begin(), rho_l.end(), 0.0);
 		std::fill(uLJ.begin(), uLJ.end(), 0.0);
@@ -282,33 +292,9 @@ void Planar::calculateLongRange() {
 			#pragma omp parallel
 			#endif
 			for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
-				unsigned cid=tempMol->componentid();
-
-				for (unsigned i=0; i<numLJ[cid]; i++){
-					int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
-					if (loc < 0){
-						loc=loc+_slabs;
-					}
-					else if (loc > sint-1){
-						loc=loc-_slabs;
-					}
-					const int index = loc+_slabs*(i+numLJSum2[cid]);
-
-					#if defined(_OPENMP)
-					#pragma omp atomic
-					#endif
-					rho_l[index] += slabsPerV;
-				}
-				if (numDipole[cid] != 0){
-					int loc=tempMol->r(1) * delta_inv;
-					const int index = loc+_slabs*numDipoleSum2[cid];
-
-					#if defined(_OPENMP)
-					#pragma omp atomic
-					#endif
-					rhoDipoleL[index] += slabsPerV;
-				}
+				binDensity(*tempMol, delta_inv, slabsPerV);
 			}
+			reduceDensityBins(rho_l, rhoDipoleL);
 		}
 		else{
 			for (unsigned i=0; i<_slabs*numLJSum; i++){
@@ -405,6 +391,8 @@ void Planar::calculateLongRange() {
 
 	// Adding the Force to the Molecules; this is done in every timestep
 	const double delta_inv = 1.0 / delta;
+	const double slabsPerV = _slabs / V;
+	const bool accumulateDensity = _smooth and not profileStep;
 
 	double Upot_c=0.0;
 	double Virial_c=0.0; // Correction used for the Pressure Calculation
@@ -420,6 +408,10 @@ void Planar::calculateLongRange() {
 
 		unsigned cid = tempMol->componentid();
 
+		if (accumulateDensity){
+			binDensity(*tempMol, delta_inv, slabsPerV);
+		}
+
 		for (unsigned i=0; i<numLJ[cid]; i++){
 			int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
 			if (loc < 0){
@@ -430,7 +422,7 @@ void Planar::calculateLongRange() {
 			}
 			double Fa[3]={0.0, 0.0, 0.0};
 			const int index = loc + i * _slabs + _slabs * numLJSum2[cid];
-			Fa[1] = fLJ[index];
+			Fa[1] = _forceFactor * fLJ[index];
 			Upot_c += uLJ[index];
 			Virial_c += 2 * vTLJ[index] + vNLJ[index];
 			double Via[3] = {0.0, 0.0, 0.0};
@@ -447,7 +439,7 @@ void Planar::calculateLongRange() {
 			int loc = tempMol->r(1) * delta_inv;
 			double Fa[3] = {0.0, 0.0, 0.0};
 			const int index = loc + _slabs * numDipoleSum2[cid];
-			Fa[1] = fDipole[index];
+			Fa[1] = _forceFactor * fDipole[index];
 			Upot_c += uDipole[index];
 			Virial_c += 2 * vTDipole[index] + vNDipole[index];
 			double Via[3] = {0.0, 0.0, 0.0};
@@ -462,6 +454,10 @@ void Planar::calculateLongRange() {
 		}
 	}
 
+	if (accumulateDensity){
+		reduceDensityBins(rho_g, rhoDipole);
+	}
+
 	// Summation of the correction terms
 	_domainDecomposition->collCommInit(2);
 	_domainDecomposition->collCommAppendDouble(Upot_c);
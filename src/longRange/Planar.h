@@ -5,6 +5,7 @@
 
 #include "utils/ObserverBase.h"
 #include "utils/Region.h"
+#include "utils/BinnedAccumulator.h"
 
 #include <vector>
 #include <cmath>
@@ -79,6 +80,11 @@ private:
 	void siteSite(double sig,double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj);
 	void dipoleDipole(unsigned ci,unsigned cj,unsigned si,unsigned sj);
 
+	//! add the sites of a molecule to the thread-private density bins
+	void binDensity(Molecule& mol, double delta_inv, double slabsPerV);
+	//! add the density bins to rhoLJ and rhoDipole and reset the bins
+	void reduceDensityBins(std::vector<double>& rhoLJ, std::vector<double>& rhoDip);
+
 	unsigned _slabs;
 	unsigned numComp;
 	std::vector<unsigned> numLJ;
@@ -101,6 +107,8 @@ private:
 	std::vector<double> vTDipole;
 	std::vector<double> rhoDipole;
 	std::vector<double> rhoDipoleL;
+	BinnedAccumulator<double> _rhoLJBins; //!< thread-private density profile of the LJ sites
+	BinnedAccumulator<double> _rhoDipoleBins; //!< thread-private density profile of the dipoles
 	std::vector<double> muSquare;
 	std::vector<double> eLong;
 	double cutoff;
@@ -2,6 +2,7 @@
 #include "particleContainer/adapter/CellDataSoA.h"
 
 #include "utils/mardyn_assert.h"
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 
@@ -386,6 +387,185 @@ void FullMolecule::upd_postF(double dt_halve, double& summv2, double& sumIw2) {
 }
 
 
+namespace {
+
+//! number of molecules copied to the local arrays of the batched integrator steps
+constexpr size_t integrationChunk = 64;
+
+//! @brief Same as Quaternion::rotateinv() on scalars.
+inline void rotateinv(double qw, double qx, double qy, double qz, double d0, double d1, double d2, double& r0,
+					  double& r1, double& r2) {
+	const double ww = qw * qw;
+	const double xx = qx * qx;
+	const double yy = qy * qy;
+	const double zz = qz * qz;
+	const double wx = qw * qx;
+	const double wy = qw * qy;
+	const double wz = qw * qz;
+	const double xy = qx * qy;
+	const double xz = qx * qz;
+	const double yz = qy * qz;
+	r0 = (ww + xx - yy - zz) * d0 + 2. * (xy + wz) * d1 + 2. * (xz - wy) * d2;
+	r1 = 2. * (xy - wz) * d0 + (ww - xx + yy - zz) * d1 + 2. * (yz + wx) * d2;
+	r2 = 2. * (xz + wy) * d0 + 2. * (yz - wx) * d1 + (ww - xx - yy + zz) * d2;
+}
+
+//! @brief Same as Quaternion::differentiate() on scalars.
+inline void differentiate(double qw, double qx, double qy, double qz, double w0, double w1, double w2, double& dw,
+						  double& dx, double& dy, double& dz) {
+	dw = .5 * (-qx * w0 - qy * w1 - qz * w2);
+	dx = .5 * (qw * w0 - qz * w1 + qy * w2);
+	dy = .5 * (qz * w0 + qw * w1 - qx * w2);
+	dz = .5 * (-qy * w0 + qx * w1 + qw * w2);
+}
+
+}  // namespace
+
+void FullMolecule::upd_preF_batch(FullMolecule* const* molecules, size_t count, double dt) {
+	const double dt_halve = .5 * dt;
+	alignas(64) double m[integrationChunk];
+	alignas(64) double r[3][integrationChunk], v[3][integrationChunk], F[3][integrationChunk];
+	alignas(64) double L[3][integrationChunk], M[3][integrationChunk], invI[3][integrationChunk];
+	alignas(64) double q[4][integrationChunk];
+
+	for (size_t start = 0; start < count; start += integrationChunk) {
+		const size_t n = std::min(integrationChunk, count - start);
+		for (size_t i = 0; i < n; ++i) {
+			const FullMolecule& mol = *molecules[start + i];
+			mardyn_assert(mol._m > 0);
+			m[i] = mol._m;
+			for (unsigned short d = 0; d < 3; ++d) {
+				r[d][i] = mol._r[d];
+				v[d][i] = mol._v[d];
+				F[d][i] = mol._F[d];
+				L[d][i] = mol._L[d];
+				M[d][i] = mol._M[d];
+				invI[d][i] = mol._invI[d];
+			}
+			q[0][i] = mol._q.qw();
+			q[1][i] = mol._q.qx();
+			q[2][i] = mol._q.qy();
+			q[3][i] = mol._q.qz();
+		}
+
+		#pragma omp simd aligned(m, r, v, F, L, M, invI, q : 64)
+		for (size_t i = 0; i < n; ++i) {
+			const double dtInv2m = dt_halve / m[i];
+			for (unsigned short d = 0; d < 3; ++d) {
+				v[d][i] += dtInv2m * F[d][i];
+				r[d][i] += dt * v[d][i];
+			}
+
+			double w0, w1, w2;
+			rotateinv(q[0][i], q[1][i], q[2][i], q[3][i], L[0][i], L[1][i], L[2][i], w0, w1, w2);
+			w0 *= invI[0][i];
+			w1 *= invI[1][i];
+			w2 *= invI[2][i];
+			double hw, hx, hy, hz;
+			differentiate(q[0][i], q[1][i], q[2][i], q[3][i], w0, w1, w2, hw, hx, hy, hz);
+			hw = hw * dt_halve + q[0][i];
+			hx = hx * dt_halve + q[1][i];
+			hy = hy * dt_halve + q[2][i];
+			hz = hz * dt_halve + q[3][i];
+			double qcorr = 1. / sqrt(hw * hw + hx * hx + hy * hy + hz * hz);
+			hw *= qcorr;
+			hx *= qcorr;
+			hy *= qcorr;
+			hz *= qcorr;
+			for (unsigned short d = 0; d < 3; ++d) {
+				L[d][i] += dt_halve * M[d][i];
+			}
+			rotateinv(hw, hx, hy, hz, L[0][i], L[1][i], L[2][i], w0, w1, w2);
+			w0 *= invI[0][i];
+			w1 *= invI[1][i];
+			w2 *= invI[2][i];
+			double iw, ix, iy, iz;
+			differentiate(hw, hx, hy, hz, w0, w1, w2, iw, ix, iy, iz);
+			double qw = q[0][i] + iw * dt;
+			double qx = q[1][i] + ix * dt;
+			double qy = q[2][i] + iy * dt;
+			double qz = q[3][i] + iz * dt;
+			qcorr = 1. / sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+			q[0][i] = qw * qcorr;
+			q[1][i] = qx * qcorr;
+			q[2][i] = qy * qcorr;
+			q[3][i] = qz * qcorr;
+		}
+
+		for (size_t i = 0; i < n; ++i) {
+			FullMolecule& mol = *molecules[start + i];
+			for (unsigned short d = 0; d < 3; ++d) {
+				mol._r[d] = r[d][i];
+				mol._v[d] = v[d][i];
+				mol._L[d] = L[d][i];
+			}
+			mol._q = Quaternion(q[0][i], q[1][i], q[2][i], q[3][i]);
+		}
+	}
+}
+
+void FullMolecule::upd_postF_batch(FullMolecule* const* molecules, size_t count, double dt_halve, double* mv2,
+								   double* Iw2) {
+	alignas(64) double m[integrationChunk];
+	alignas(64) double v[3][integrationChunk], F[3][integrationChunk];
+	alignas(64) double L[3][integrationChunk], M[3][integrationChunk];
+	alignas(64) double I[3][integrationChunk], invI[3][integrationChunk];
+	alignas(64) double q[4][integrationChunk];
+
+	for (size_t start = 0; start < count; start += integrationChunk) {
+		const size_t n = std::min(integrationChunk, count - start);
+		for (size_t i = 0; i < n; ++i) {
+			const FullMolecule& mol = *molecules[start + i];
+			m[i] = mol._m;
+			for (unsigned short d = 0; d < 3; ++d) {
+				v[d][i] = mol._v[d];
+				F[d][i] = mol._F[d];
+				L[d][i] = mol._L[d];
+				M[d][i] = mol._M[d];
+				I[d][i] = mol._I[d];
+				invI[d][i] = mol._invI[d];
+			}
+			q[0][i] = mol._q.qw();
+			q[1][i] = mol._q.qx();
+			q[2][i] = mol._q.qy();
+			q[3][i] = mol._q.qz();
+		}
+
+		double* const mv2Chunk = mv2 + start;
+		double* const Iw2Chunk = Iw2 + start;
+		#pragma omp simd aligned(m, v, F, L, M, I, invI, q : 64)
+		for (size_t i = 0; i < n; ++i) {
+			const double dtInv2m = dt_halve / m[i];
+			double v2 = 0.;
+			for (unsigned short d = 0; d < 3; ++d) {
+				v[d][i] += dtInv2m * F[d][i];
+				v2 += v[d][i] * v[d][i];
+				L[d][i] += dt_halve * M[d][i];
+			}
+			mv2Chunk[i] = m[i] * v2;
+
+			double w[3];
+			rotateinv(q[0][i], q[1][i], q[2][i], q[3][i], L[0][i], L[1][i], L[2][i], w[0], w[1], w[2]);
+			double iw2 = 0.;
+			for (unsigned short d = 0; d < 3; ++d) {
+				w[d] *= invI[d][i];
+				iw2 += I[d][i] * w[d] * w[d];
+			}
+			Iw2Chunk[i] = iw2;
+		}
+
+		for (size_t i = 0; i < n; ++i) {
+			FullMolecule& mol = *molecules[start + i];
+			for (unsigned short d = 0; d < 3; ++d) {
+				mol._v[d] = v[d][i];
+				mol._L[d] = L[d][i];
+			}
+			mardyn_assert(!std::isnan(mv2Chunk[i]));  // catches NaN
+			mardyn_assert(!std::isnan(Iw2Chunk[i]));
+		}
+	}
+}
+
 double FullMolecule::U_rot() {
 	std::array<double, 3> w = _q.rotateinv(D_arr());
 	double Iw2 = 0.;
@@ -296,6 +296,20 @@ public:
 	/** second step of the leap frog integrator */
 	void upd_postF(double dt_halve, double& summv2, double& sumIw2) override;
 
+	/**
+	 * @brief Batched version of upd_preF(), same results up to rounding.
+	 * @details The molecules are processed in chunks, which are copied to local arrays, so that the translational
+	 * and rotational updates are vectorized across the molecules.
+	 */
+	static void upd_preF_batch(FullMolecule* const* molecules, size_t count, double dt);
+	/**
+	 * @brief Batched version of upd_postF(), same results up to rounding.
+	 * @param[out] mv2 receives \f$ m v^2 \f$ of each molecule
+	 * @param[out] Iw2 receives \f$ I w^2 \f$ of each molecule
+	 */
+	static void upd_postF_batch(FullMolecule* const* molecules, size_t count, double dt_halve, double* mv2,
+								double* Iw2);
+
 	/** @brief Calculate twice the translational and rotational kinetic energies
 	 * @param[out] summv2   twice the translational kinetic energy \f$ m v^2 \f$
 	 * @param[out] sumIw2   twice the rotational kinetic energy \f$ I \omega^2 \f$
@@ -8,6 +8,9 @@
 #include "MoleculeTest.h"
 #include "molecules/Molecule.h"
 
+#include <cmath>
+#include <vector>
+
 TEST_SUITE_REGISTRATION(MoleculeTest);
 
 MoleculeTest::MoleculeTest() {
@@ -53,3 +56,54 @@ void MoleculeTest::testIsLessThan() {
 	ASSERT_TRUE(!a.isLessThan(b));
 	ASSERT_TRUE(b.isLessThan(a));
 }
+
+void MoleculeTest::testBatchedIntegration() {
+	std::vector<Component> components;
+	Component rotatingComponent(0);
+	rotatingComponent.addLJcenter(-0.5, 0.1, 0, 1.0, 1.0, 1.0);
+	rotatingComponent.addLJcenter(0.5, -0.2, 0.3, 2.0, 1.0, 1.0);
+	components.push_back(rotatingComponent);
+
+	// more molecules than fit into one chunk of the batched steps
+	const size_t numMolecules = 150;
+	std::vector<FullMolecule> batched;
+	for (size_t i = 0; i < numMolecules; ++i) {
+		const double x = 0.1 * i;
+		Quaternion q(std::cos(x), std::sin(x), 0.5 * std::cos(3 * x), 0.2);
+		q.normalize();
+		FullMolecule m(i, &components[0], x, 2 * x, 3 * x, std::sin(x), std::cos(x), 0.3, q.qw(), q.qx(), q.qy(),
+					   q.qz(), 0.1 * std::cos(x), 0.2, -0.1 * std::sin(2 * x));
+		double F[3] = {std::cos(5 * x), 0.5, -std::sin(x)};
+		double M[3] = {0.01, 0.02 * std::cos(x), -0.01 * std::sin(3 * x)};
+		m.setF(F);
+		m.setM(M);
+		batched.push_back(m);
+	}
+	std::vector<FullMolecule> single(batched);
+	std::vector<FullMolecule*> pointers;
+	for (auto& m : batched) {
+		pointers.push_back(&m);
+	}
+
+	const double dt = 0.01;
+	FullMolecule::upd_preF_batch(pointers.data(), pointers.size(), dt);
+	std::vector<double> mv2(numMolecules), Iw2(numMolecules);
+	FullMolecule::upd_postF_batch(pointers.data(), pointers.size(), 0.5 * dt, mv2.data(), Iw2.data());
+
+	for (size_t i = 0; i < numMolecules; ++i) {
+		double summv2 = 0.0, sumIw2 = 0.0;
+		single[i].upd_preF(dt);
+		single[i].upd_postF(0.5 * dt, summv2, sumIw2);
+		ASSERT_DOUBLES_EQUAL(summv2, mv2[i], 1e-14 * summv2);
+		ASSERT_DOUBLES_EQUAL(sumIw2, Iw2[i], 1e-14 * sumIw2);
+		for (unsigned short d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(single[i].r(d), batched[i].r(d), 1e-14);
+			ASSERT_DOUBLES_EQUAL(single[i].v(d), batched[i].v(d), 1e-14);
+			ASSERT_DOUBLES_EQUAL(single[i].D(d), batched[i].D(d), 1e-14);
+		}
+		ASSERT_DOUBLES_EQUAL(single[i].q().qw(), batched[i].q().qw(), 1e-14);
+		ASSERT_DOUBLES_EQUAL(single[i].q().qx(), batched[i].q().qx(), 1e-14);
+		ASSERT_DOUBLES_EQUAL(single[i].q().qy(), batched[i].q().qy(), 1e-14);
+		ASSERT_DOUBLES_EQUAL(single[i].q().qz(), batched[i].q().qz(), 1e-14);
+	}
+}
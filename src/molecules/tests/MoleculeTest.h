@@ -14,6 +14,7 @@ class MoleculeTest : public utils::Test {
 
 	TEST_SUITE(MoleculeTest);
 	TEST_METHOD(testIsLessThan);
+	TEST_METHOD(testBatchedIntegration);
 	TEST_SUITE_END();
 
 public:
@@ -24,6 +25,11 @@ public:
 
 	void testIsLessThan();
 
+	/**
+	 * The batched leapfrog steps of FullMolecule have to match the steps of single molecules.
+	 */
+	void testBatchedIntegration();
+
 };
 
 #endif /* MOLECULETEST_H_ */
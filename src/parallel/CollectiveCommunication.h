@@ -3,14 +3,20 @@
 
 #include <mpi.h>
 
+#include <array>
+#include <sstream>
+#include <utility>
+#include <vector>
+
 #include "utils/Logger.h"
 #include "CollectiveCommBase.h"
 #include "CollectiveCommunicationInterface.h"
+#include "PackedValues.h"
 #include "utils/mardyn_assert.h"
 
 
-/* Enable agglomerated reduce operations. This will store all values in one array and apply a
- * user defined reduce operation so that the MPI reduce operation is only called once. */
+/* Enable agglomerated reduce operations. This will sort all values by type into contiguous arrays
+ * so that the MPI reduce operation is only called once per type, using the built-in operations. */
 #define ENABLE_AGGLOMERATED_REDUCE 1
 
 //! @brief This class is used to transfer several values of different types with a single command
@@ -26,7 +32,11 @@
 //! to use a single MPI command to transfer several values of possible different types.
 //! Currently supported commands are:
 //! - broadcast
-//! - reduce using add as reduce operation
+//! - reduce using add, max or min as reduce operation
+//! - scan using add as reduce operation
+//!
+//! For the reductions, the values are sorted by type into contiguous buffers, which are reduced
+//! with the built-in MPI operations (one call per type, usually one or two calls).
 //!
 //! Currently supported datatypes are:
 //! - MPI_INT
@@ -145,58 +155,16 @@ public:
 	void allreduceCustom(ReduceType type) override {
 		Log::global_log->debug() << "CollectiveCommunication: custom Allreduce" << std::endl;
 #if ENABLE_AGGLOMERATED_REDUCE
-		setMPIType();
-		MPI_Op agglomeratedTypeAddOperator;
-		const int commutative = 1;
-		valType * startOfValues = _values.data();
-
-		switch (type) {
-		case ReduceType::SUM:
-			MPI_CHECK(
-					MPI_Op_create(
-							(MPI_User_function * ) CollectiveCommunication::add,
-							commutative, &agglomeratedTypeAddOperator));
-			break;
-		case ReduceType::MAX:
-			MPI_CHECK(
-					MPI_Op_create(
-							(MPI_User_function * ) CollectiveCommunication::max,
-							commutative, &agglomeratedTypeAddOperator));
-			break;
-		case ReduceType::MIN:
-			MPI_CHECK(
-					MPI_Op_create(
-							(MPI_User_function * ) CollectiveCommunication::min,
-							commutative, &agglomeratedTypeAddOperator));
-			break;
-		default:
-			std::ostringstream error_message;
-			error_message<<"invalid reducetype, aborting." << std::endl;
-			MARDYN_EXIT(error_message.str());
-		}
-
-		MPI_CHECK(
-				MPI_Allreduce(MPI_IN_PLACE, startOfValues, 1, _agglomeratedType, agglomeratedTypeAddOperator, _communicator));
-		MPI_CHECK(MPI_Op_free(&agglomeratedTypeAddOperator));
-		MPI_CHECK(MPI_Type_free(&_agglomeratedType));
+		const MPI_Op op = builtinOperation(type);
+		updateLayout(type != ReduceType::SUM);
+		pack(_values, _packedValues);
+		forEachPackedBuffer(_packedValues, [this, op](void* buffer, int count, MPI_Datatype datatype) {
+			MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, buffer, count, datatype, op, _communicator));
+		});
+		unpack(_packedValues, _values);
 #else
+		const MPI_Op op = builtinOperation(type);
 		for (unsigned int i = 0; i < _types.size(); i++) {
-			MPI_Op op = MPI_NO_OP;
-			switch(type) {
-			case ReduceType::SUM:
-				op = MPI_SUM;
-				break;
-			case ReduceType::MIN:
-				op = MPI_MIN;
-				break;
-			case ReduceType::MAX:
-				op = MPI_MAX;
-				break;
-			default:
-				std::ostringstream error_message;
-				error_message<<"invalid reducetype, aborting." << std::endl;
-				MARDYN_EXIT(error_message.str());
-			}
 			MPI_CHECK(MPI_Allreduce( MPI_IN_PLACE, &_values[i], 1, _types[i], op, _communicator ));
 		}
 #endif
@@ -211,28 +179,24 @@ public:
 
 	// documentation in base class
 	void scanSum() override {
-	#if ENABLE_AGGLOMERATED_REDUCE
-			setMPIType();
-			MPI_Op agglomeratedTypeAddOperator;
-			const int commutative = 1;
-			valType * startOfValues = _values.data();
-			MPI_CHECK(
-					MPI_Op_create(
-							(MPI_User_function * ) CollectiveCommunication::add,
-							commutative, &agglomeratedTypeAddOperator));
-			MPI_CHECK(
-					MPI_Scan(MPI_IN_PLACE, startOfValues, 1, _agglomeratedType, agglomeratedTypeAddOperator, _communicator));
-			MPI_CHECK(MPI_Op_free(&agglomeratedTypeAddOperator));
-			MPI_CHECK(MPI_Type_free(&_agglomeratedType));
-	#else
-			for(unsigned int i = 0; i < _types.size(); i++ ) {
-				MPI_CHECK( MPI_Scan( MPI_IN_PLACE, _values.data(), 1, _types[i], MPI_SUM, _communicator ) );
-			}
-	#endif
+#if ENABLE_AGGLOMERATED_REDUCE
+		updateLayout(false);
+		pack(_values, _packedValues);
+		forEachPackedBuffer(_packedValues, [this](void* buffer, int count, MPI_Datatype datatype) {
+			MPI_CHECK(MPI_Scan(MPI_IN_PLACE, buffer, count, datatype, MPI_SUM, _communicator));
+		});
+		unpack(_packedValues, _values);
+#else
+		for(unsigned int i = 0; i < _types.size(); i++ ) {
+			MPI_CHECK( MPI_Scan( MPI_IN_PLACE, &_values[i], 1, _types[i], MPI_SUM, _communicator ) );
 		}
+#endif
+	}
 
 	virtual size_t getTotalSize() override{
-		return CollectiveCommBase::getTotalSize() + _types.capacity() * sizeof(MPI_Datatype);
+		return CollectiveCommBase::getTotalSize() + _types.capacity() * sizeof(MPI_Datatype) +
+			   _layout.types.capacity() * sizeof(MPI_Datatype) +
+			   _layout.positions.capacity() * sizeof(_layout.positions[0]) + _packedValues.getTotalSize();
 	}
 
 
@@ -264,127 +228,117 @@ protected:
 		MPI_CHECK(MPI_Type_commit(&_agglomeratedType));
 	}
 
-	//! @brief method used by MPI to add variables of this type
-	//!
-	//! For collective reduce commands, an operation has to be specified
-	//! which should be used to combine the values from the different processes.
-	//! As with this class, special datatypes are sent, the build-in
-	//! MPI operations don't work on those datatypes. Therefore, operations have
-	//! to be defined which work on those datatypes. MPI allows to create own
-	//! operations (type MPI_Op) by specifying a function which will be used
-	//! in the reduce operation. MPI specifies the signature of such functions
-	//! This methods checks from which basic datatypes the given datatype
-	//! was constructed and performs an add operation for each of the basic types.
-	static void add(valType *invec, valType *inoutvec, int */*len*/,
-			MPI_Datatype *dtype) {
-		int numints;
-		int numaddr;
-		int numtypes;
-		int combiner;
-
-		MPI_CHECK(
-				MPI_Type_get_envelope(*dtype, &numints, &numaddr, &numtypes,
-						&combiner));
-
-		std::vector<int> arrayInts(numints);
-		std::vector<MPI_Aint> arrayAddr(numaddr);
-		std::vector<MPI_Datatype> arrayTypes(numtypes);
+	//! @brief identifies a buffer of PackedValues
+	enum class PackedBuffer { LONG, UNS_LONG, DOUBLE, LONG_DOUBLE };
 
-		MPI_CHECK(
-				MPI_Type_get_contents(*dtype, numints, numaddr, numtypes,
-						arrayInts.data(), arrayAddr.data(), arrayTypes.data()));
+	//! @brief position of each value in the PackedValues
+	//!
+	//! The layout only depends on the sequence of appended types, which is the same in every
+	//! time step for a given reduction. It is therefore cached and only recomputed, if the
+	//! types change.
+	struct PackedLayout {
+		//! types, for which the layout was computed
+		std::vector<MPI_Datatype> types;
+		//! whether int values are stored in the signed buffer
+		bool signedIntegers{false};
+		//! buffer and index of each value
+		std::vector<std::pair<PackedBuffer, int>> positions;
+		//! number of values of each buffer
+		std::array<int, 4> sizes{};
+	};
+
+	//! @brief maps a ReduceType to the corresponding built-in MPI operation
+	static MPI_Op builtinOperation(ReduceType type) {
+		switch (type) {
+		case ReduceType::SUM:
+			return MPI_SUM;
+		case ReduceType::MAX:
+			return MPI_MAX;
+		case ReduceType::MIN:
+			return MPI_MIN;
+		default:
+			std::ostringstream error_message;
+			error_message<<"invalid reducetype, aborting." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		return MPI_OP_NULL;
+	}
 
-		for (int i = 0; i < numtypes; i++) {
-			if (arrayTypes[i] == MPI_INT) {
-				inoutvec[i].v_int += invec[i].v_int;
-			}
-			else if (arrayTypes[i] == MPI_UNSIGNED_LONG) {
-				inoutvec[i].v_unsLong += invec[i].v_unsLong;
-			}
-			else if (arrayTypes[i] == MPI_FLOAT) {
-				inoutvec[i].v_float += invec[i].v_float;
-			}
-			else if (arrayTypes[i] == MPI_DOUBLE) {
-				inoutvec[i].v_double += invec[i].v_double;
-			}
-			else if (arrayTypes[i] == MPI_LONG_DOUBLE) {
-				inoutvec[i].v_longDouble += invec[i].v_longDouble;
+	//! @brief computes the position of each value in the PackedValues, if the types changed
+	//! @param signedIntegers int values are stored in the signed buffer (needed for min and max)
+	void updateLayout(bool signedIntegers) {
+		if (_layout.signedIntegers == signedIntegers && _layout.types == _types) {
+			return;
+		}
+		_layout.types = _types;
+		_layout.signedIntegers = signedIntegers;
+		_layout.positions.resize(_types.size());
+		_layout.sizes.fill(0);
+		for (size_t i = 0; i < _types.size(); i++) {
+			PackedBuffer buffer = PackedBuffer::DOUBLE;
+			if (_types[i] == MPI_INT) {
+				buffer = signedIntegers ? PackedBuffer::LONG : PackedBuffer::UNS_LONG;
+			} else if (_types[i] == MPI_UNSIGNED_LONG) {
+				buffer = PackedBuffer::UNS_LONG;
+			} else if (_types[i] == MPI_LONG_DOUBLE) {
+				buffer = PackedBuffer::LONG_DOUBLE;
 			}
+			_layout.positions[i] = std::make_pair(buffer, _layout.sizes[static_cast<int>(buffer)]++);
 		}
 	}
 
-	static void max(valType *invec, valType *inoutvec, int */*len*/,
-			MPI_Datatype *dtype) {
-		int numints;
-		int numaddr;
-		int numtypes;
-		int combiner;
-
-		MPI_CHECK(
-				MPI_Type_get_envelope(*dtype, &numints, &numaddr, &numtypes,
-						&combiner));
-
-		std::vector<int> arrayInts(numints);
-		std::vector<MPI_Aint> arrayAddr(numaddr);
-		std::vector<MPI_Datatype> arrayTypes(numtypes);
-
-		MPI_CHECK(
-				MPI_Type_get_contents(*dtype, numints, numaddr, numtypes,
-						arrayInts.data(), arrayAddr.data(), arrayTypes.data()));
-
-		for (int i = 0; i < numtypes; i++) {
-			if (arrayTypes[i] == MPI_INT) {
-				inoutvec[i].v_int = std::max(inoutvec[i].v_int, invec[i].v_int);
-			}
-			else if (arrayTypes[i] == MPI_UNSIGNED_LONG) {
-				inoutvec[i].v_unsLong = std::max(inoutvec[i].v_unsLong, invec[i].v_unsLong);
-			}
-			else if (arrayTypes[i] == MPI_FLOAT) {
-				inoutvec[i].v_float = std::max(inoutvec[i].v_float, invec[i].v_float);
-			}
-			else if (arrayTypes[i] == MPI_DOUBLE) {
-				inoutvec[i].v_double = std::max(inoutvec[i].v_double, invec[i].v_double);
-			}
-			else if (arrayTypes[i] == MPI_LONG_DOUBLE) {
-				inoutvec[i].v_longDouble = std::max(inoutvec[i].v_longDouble, invec[i].v_longDouble);
+	//! @brief copies the values into the type sorted buffers according to the current layout
+	void pack(const std::vector<valType>& values, PackedValues& packed) const {
+		packed.longs.resize(_layout.sizes[static_cast<int>(PackedBuffer::LONG)]);
+		packed.unsLongs.resize(_layout.sizes[static_cast<int>(PackedBuffer::UNS_LONG)]);
+		packed.doubles.resize(_layout.sizes[static_cast<int>(PackedBuffer::DOUBLE)]);
+		packed.longDoubles.resize(_layout.sizes[static_cast<int>(PackedBuffer::LONG_DOUBLE)]);
+		for (size_t i = 0; i < values.size(); i++) {
+			const int index = _layout.positions[i].second;
+			switch (_layout.positions[i].first) {
+			case PackedBuffer::LONG:
+				packed.longs[index] = values[i].v_int;
+				break;
+			case PackedBuffer::UNS_LONG:
+				packed.unsLongs[index] = _types[i] == MPI_INT
+											 ? static_cast<unsigned long>(static_cast<long>(values[i].v_int))
+											 : values[i].v_unsLong;
+				break;
+			case PackedBuffer::DOUBLE:
+				packed.doubles[index] = _types[i] == MPI_FLOAT ? values[i].v_float : values[i].v_double;
+				break;
+			case PackedBuffer::LONG_DOUBLE:
+				packed.longDoubles[index] = values[i].v_longDouble;
+				break;
 			}
 		}
 	}
 
-	static void min(valType *invec, valType *inoutvec, int */*len*/,
-			MPI_Datatype *dtype) {
-		int numints;
-		int numaddr;
-		int numtypes;
-		int combiner;
-
-		MPI_CHECK(
-				MPI_Type_get_envelope(*dtype, &numints, &numaddr, &numtypes,
-						&combiner));
-
-		std::vector<int> arrayInts(numints);
-		std::vector<MPI_Aint> arrayAddr(numaddr);
-		std::vector<MPI_Datatype> arrayTypes(numtypes);
-
-		MPI_CHECK(
-				MPI_Type_get_contents(*dtype, numints, numaddr, numtypes,
-						arrayInts.data(), arrayAddr.data(), arrayTypes.data()));
-
-		for (int i = 0; i < numtypes; i++) {
-			if (arrayTypes[i] == MPI_INT) {
-				inoutvec[i].v_int = std::min(inoutvec[i].v_int, invec[i].v_int);
-			}
-			else if (arrayTypes[i] == MPI_UNSIGNED_LONG) {
-				inoutvec[i].v_unsLong = std::min(inoutvec[i].v_unsLong, invec[i].v_unsLong);
-			}
-			else if (arrayTypes[i] == MPI_FLOAT) {
-				inoutvec[i].v_float = std::min(inoutvec[i].v_float, invec[i].v_float);
-			}
-			else if (arrayTypes[i] == MPI_DOUBLE) {
-				inoutvec[i].v_double = std::min(inoutvec[i].v_double, invec[i].v_double);
-			}
-			else if (arrayTypes[i] == MPI_LONG_DOUBLE) {
-				inoutvec[i].v_longDouble = std::min(inoutvec[i].v_longDouble, invec[i].v_longDouble);
+	//! @brief copies the values back from the type sorted buffers according to the current layout
+	void unpack(const PackedValues& packed, std::vector<valType>& values) const {
+		for (size_t i = 0; i < values.size(); i++) {
+			const int index = _layout.positions[i].second;
+			switch (_layout.positions[i].first) {
+			case PackedBuffer::LONG:
+				values[i].v_int = static_cast<int>(packed.longs[index]);
+				break;
+			case PackedBuffer::UNS_LONG:
+				if (_types[i] == MPI_INT) {
+					values[i].v_int = static_cast<int>(static_cast<long>(packed.unsLongs[index]));
+				} else {
+					values[i].v_unsLong = packed.unsLongs[index];
+				}
+				break;
+			case PackedBuffer::DOUBLE:
+				if (_types[i] == MPI_FLOAT) {
+					values[i].v_float = static_cast<float>(packed.doubles[index]);
+				} else {
+					values[i].v_double = packed.doubles[index];
+				}
+				break;
+			case PackedBuffer::LONG_DOUBLE:
+				values[i].v_longDouble = packed.longDoubles[index];
+				break;
 			}
 		}
 	}
@@ -392,10 +346,15 @@ protected:
 	//! Vector of the corresponding MPI types for the values stored in _values
 	std::vector<MPI_Datatype> _types;
 
-	//! MPI_Datatype which will be used in the communication command and which
-	//! represents all values
+	//! MPI_Datatype which will be used in the broadcast and which represents all values
 	MPI_Datatype _agglomeratedType;
 
+	//! cached position of the values in the type sorted buffers
+	PackedLayout _layout;
+
+	//! type sorted buffers of the blocking reductions
+	PackedValues _packedValues;
+
 	//! Communicator to be used by the communication commands
 	MPI_Comm _communicator;
 
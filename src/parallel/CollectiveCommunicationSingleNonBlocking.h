@@ -38,13 +38,8 @@ public:
 	 * Destructor
 	 */
 	~CollectiveCommunicationSingleNonBlocking() override {
-		if (_request) {
-			if (_communicationInitiated) {
-				MPI_Wait(_request.get(), MPI_STATUS_IGNORE);
-			}
-		}
-		if (_agglomeratedTypeAddOperator != MPI_OP_NULL) {
-			MPI_CHECK(MPI_Op_free(&_agglomeratedTypeAddOperator));
+		if (_communicationInitiated) {
+			MPI_Waitall(static_cast<int>(_requests.size()), _requests.data(), MPI_STATUSES_IGNORE);
 		}
 		if (_agglomeratedType != MPI_DATATYPE_NULL) {
 			MPI_CHECK(MPI_Type_free(&_agglomeratedType));
@@ -111,7 +106,11 @@ private:
 	 * Waits for communication to end and also sets the data in the correct place (values)
 	 */
 	void waitAndUpdateData() {
-		MPI_CHECK(MPI_Wait(_request.get(), MPI_STATUS_IGNORE));
+		MPI_CHECK(MPI_Waitall(static_cast<int>(_requests.size()), _requests.data(), MPI_STATUSES_IGNORE));
+		_requests.clear();
+#if ENABLE_AGGLOMERATED_REDUCE
+		unpack(_tempPacked, _tempValues);
+#endif
 		// copy the temporary values to the real values!
 		_values = _tempValues;
 
@@ -125,18 +124,16 @@ private:
 		// this is necessary to maintain the validity of the data from previous steps
 		_tempValues = values;
 #if ENABLE_AGGLOMERATED_REDUCE
-		if (_agglomeratedType == MPI_DATATYPE_NULL) {
-			setMPIType();
-		}
-		const int commutative = 1;
-		valType * startOfValues = &(_tempValues[0]);
-		if (_agglomeratedTypeAddOperator == MPI_OP_NULL) {
-			MPI_CHECK(
-					MPI_Op_create((MPI_User_function * ) CollectiveCommunication::add, commutative,
-							&_agglomeratedTypeAddOperator));
-		}
-		MPI_CHECK(
-				MPI_Iallreduce(MPI_IN_PLACE, startOfValues, 1, _agglomeratedType, _agglomeratedTypeAddOperator, _communicator, _request.get()));
+		updateLayout(false);
+		pack(_tempValues, _tempPacked);
+		// one request per non-empty buffer
+		_requests.resize(4);
+		size_t numRequests = 0;
+		forEachPackedBuffer(_tempPacked, [&](void* buffer, int count, MPI_Datatype datatype) {
+			MPI_CHECK(MPI_Iallreduce(MPI_IN_PLACE, buffer, count, datatype, MPI_SUM, _communicator,
+									 &_requests[numRequests++]));
+		});
+		_requests.resize(numRequests);
 		_communicationInitiated = true;
 #else
 		for( unsigned int i = 0; i < _types.size(); i++ ) {
@@ -146,12 +143,13 @@ private:
 
 	}
 
-	std::unique_ptr<MPI_Request> _request{new MPI_Request()};
-	MPI_Op _agglomeratedTypeAddOperator{MPI_OP_NULL};
+	std::vector<MPI_Request> _requests;
 	bool _communicationInitiated{false};
 	bool _valuesValid{false};
 	/// tempValues is used for overlapped communications!
 	std::vector<valType> _tempValues;
+	/// type sorted buffers of the overlapped communication
+	PackedValues _tempPacked;
 	bool _firstComm{true};
 };
 
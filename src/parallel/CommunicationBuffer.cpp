@@ -11,7 +11,11 @@
 #include "utils/mardyn_assert.h"
 #include "ensemble/EnsembleBase.h"
 
+#include <algorithm>
 #include <climits> /* UINT64_MAX */
+#include <cstdint>
+#include <cstring>
+#include <numeric>
 
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 // position, velocity, id
@@ -23,6 +27,8 @@ size_t CommunicationBuffer::_numBytesHalo = 3 * sizeof(vcp_real_calc)
 	#endif
 		;
 size_t CommunicationBuffer::_numBytesForces = sizeof(unsigned long) + 3 * sizeof(vcp_real_calc) + 3 * sizeof(vcp_real_accum);
+// id
+size_t CommunicationBuffer::_numBytesHaloKey = sizeof(unsigned long);
 #else
 // position, velocity, orientation, angular momentum, id, cid
 size_t CommunicationBuffer::_numBytesLeaving = 13 * sizeof(double) + sizeof(unsigned long) + sizeof(int);
@@ -33,27 +39,53 @@ size_t CommunicationBuffer::_numBytesHalo = 7 * sizeof(double) + sizeof(int)
 	#endif
 		;
 size_t CommunicationBuffer::_numBytesForces = sizeof(unsigned long) + 12 * sizeof(double);
+// id, cid
+size_t CommunicationBuffer::_numBytesHaloKey = sizeof(unsigned long) + sizeof(int);
 #endif
 
 
 unsigned char* CommunicationBuffer::getDataForSending() {
-	return _buffer.data();
+	return _buffer.data() + _numBytesSize;
 }
 
 size_t CommunicationBuffer::getNumElementsForSending() {
-	return _buffer.size();
+	return _buffer.size() - _numBytesSize;
+}
+
+unsigned char* CommunicationBuffer::getDataWithSize(size_t numBytes) {
+	mardyn_assert(numBytes >= _buffer.size());
+	const std::uint64_t numBytesMessage = getNumElementsForSending();
+	std::memcpy(_buffer.data(), &numBytesMessage, _numBytesSize);
+	// zero the bytes behind the message, then shrink to the message again, the storage stays
+	const size_t numBytesWithSize = _buffer.size();
+	_buffer.resize(numBytes);
+	_buffer.resize(numBytesWithSize);
+	return _buffer.data();
+}
+
+unsigned char* CommunicationBuffer::getStorageForReceivingWithSize(size_t numBytes) {
+	_buffer.resize(std::max(numBytes, _numBytesSize));
+	return _buffer.data();
+}
+
+size_t CommunicationBuffer::resizeForReceivedSize() {
+	std::uint64_t numBytesMessage;
+	std::memcpy(&numBytesMessage, _buffer.data(), _numBytesSize);
+	resizeForRawBytes(numBytesMessage);
+	return numBytesMessage;
 }
 
 void CommunicationBuffer::clear() {
 	_numHalo = 0;
 	_numLeaving = 0;
 	_numForces = 0;
-	_buffer.clear();
+	// keeps the storage, which may be bound to persistent requests
+	_buffer.resize(_numBytesSize);
 }
 
 void CommunicationBuffer::resizeForRawBytes(unsigned long numBytes) {
-	_buffer.reserve(numBytes);
-	_buffer.resize(numBytes);
+	_buffer.reserve(_numBytesSize + numBytes);
+	_buffer.resize(_numBytesSize + numBytes);
 }
 
 void CommunicationBuffer::resizeForReceivingMolecules(unsigned long& numLeaving, unsigned long& numHalo) { // adjust for force exchange?
@@ -73,7 +105,7 @@ void CommunicationBuffer::resizeForReceivingMolecules(unsigned long& numForces)
 	// read _numForces
 	size_t i_runningByte = 0;
 	//i_runningByte = readValue(i_runningByte, _numForces);
-	_numForces = _buffer.size() / _numBytesForces;
+	_numForces = getNumElementsForSending() / _numBytesForces;
 	numForces = _numForces;
 }
 
@@ -116,7 +148,7 @@ void CommunicationBuffer::addLeavingMolecule(size_t indexOfMolecule, const Molec
 	mardyn_assert(indexOfMolecule < _numLeaving);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::LEAVING, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesLeaving <= _buffer.capacity());
+	mardyn_assert(_numBytesSize + i_firstByte + _numBytesLeaving <= _buffer.capacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -153,7 +185,7 @@ void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const Molecule
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(_numBytesSize + i_firstByte + _numBytesHalo <= _buffer.capacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -217,7 +249,7 @@ void CommunicationBuffer::readLeavingMolecule(size_t indexOfMolecule, Molecule&
 	mardyn_assert(indexOfMolecule < _numLeaving);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::LEAVING, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesLeaving <= _buffer.capacity());
+	mardyn_assert(_numBytesSize + i_firstByte + _numBytesLeaving <= _buffer.capacity());
 
 	size_t i_runningByte = i_firstByte;
 #ifdef ENABLE_REDUCED_MEMORY_MODE
@@ -272,7 +304,7 @@ void CommunicationBuffer::readHaloMolecule(size_t indexOfMolecule, Molecule& m)
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(_numBytesSize + i_firstByte + _numBytesHalo <= _buffer.capacity());
 
 	// add id, r, v
 	size_t i_runningByte = i_firstByte;
@@ -394,6 +426,137 @@ size_t CommunicationBuffer::getStartPosition(ParticleType_t type, size_t indexOf
 	return ret;
 }
 
+// the delta encoding relies on the ids of the halo molecules
+#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+void CommunicationBuffer::encodeHaloDelta(std::vector<byte_t>& previousKeys, bool refresh) {
+	if (_numHalo == 0) {
+		return;
+	}
+	const size_t keySize = _numBytesHaloKey;
+	const size_t haloBegin = getStartPosition(ParticleType_t::HALO, 0);
+	const byte_t* halo = getDataForSending() + haloBegin;
+	auto key = [&](size_t i) { return halo + i * _numBytesHalo; };
+	// any consistent order of the keys works, as sender and receiver sort the same way
+	std::vector<size_t> order(_numHalo);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+					 [&](size_t a, size_t b) { return std::memcmp(key(a), key(b), keySize) < 0; });
+
+	if (refresh) {
+		previousKeys.clear();
+	}
+	const std::uint64_t numPrevious = previousKeys.size() / keySize;
+	std::vector<byte_t> bitmask((numPrevious + 7) / 8, 0);
+	std::vector<size_t> kept, added;
+	size_t p = 0;
+	for (size_t i : order) {
+		while (p < numPrevious and std::memcmp(&previousKeys[p * keySize], key(i), keySize) < 0) {
+			++p;
+		}
+		if (p < numPrevious and std::memcmp(&previousKeys[p * keySize], key(i), keySize) == 0) {
+			bitmask[p / 8] |= static_cast<byte_t>(1u << (p % 8));
+			kept.push_back(i);
+			++p;
+		} else {
+			added.push_back(i);
+		}
+	}
+
+	// header and leaving molecules stay, then number of previous and kept molecules, bitmask, kept, added
+	const std::uint64_t numKept = kept.size();
+	std::vector<byte_t> message;
+	message.reserve(_numBytesSize + haloBegin + 2 * sizeof(std::uint64_t) + bitmask.size() +
+					_numHalo * _numBytesHalo - kept.size() * keySize);
+	message.insert(message.end(), _buffer.begin(), _buffer.begin() + _numBytesSize + haloBegin);
+	const auto* counts = reinterpret_cast<const byte_t*>(&numPrevious);
+	message.insert(message.end(), counts, counts + sizeof(numPrevious));
+	counts = reinterpret_cast<const byte_t*>(&numKept);
+	message.insert(message.end(), counts, counts + sizeof(numKept));
+	message.insert(message.end(), bitmask.begin(), bitmask.end());
+	for (size_t i : kept) {
+		message.insert(message.end(), key(i) + keySize, key(i) + _numBytesHalo);
+	}
+	for (size_t i : added) {
+		message.insert(message.end(), key(i), key(i) + _numBytesHalo);
+	}
+
+	// the receiver merges the kept and added keys in the same way, kept keys first for equal keys
+	std::vector<byte_t> keys;
+	keys.reserve(_numHalo * keySize);
+	size_t a = 0, b = 0;
+	while (a < kept.size() or b < added.size()) {
+		const bool takeKept =
+			b == added.size() or (a < kept.size() and std::memcmp(key(kept[a]), key(added[b]), keySize) <= 0);
+		const byte_t* k = takeKept ? key(kept[a++]) : key(added[b++]);
+		keys.insert(keys.end(), k, k + keySize);
+	}
+	previousKeys.swap(keys);
+	// assigning keeps the storage, which may be bound to persistent requests
+	_buffer.assign(message.begin(), message.end());
+}
+
+bool CommunicationBuffer::decodeHaloDelta(std::vector<byte_t>& previousKeys) {
+	size_t i_runningByte = 0;
+	i_runningByte = readValue(i_runningByte, _numLeaving);
+	i_runningByte = readValue(i_runningByte, _numHalo);
+	if (_numHalo == 0) {
+		return true;
+	}
+	const size_t keySize = _numBytesHaloKey;
+	const size_t tailSize = _numBytesHalo - keySize;
+	const size_t haloBegin = getStartPosition(ParticleType_t::HALO, 0);
+	std::uint64_t numPrevious, numKept;
+	i_runningByte = readValue(haloBegin, numPrevious);
+	i_runningByte = readValue(i_runningByte, numKept);
+	if (numPrevious == 0) {
+		previousKeys.clear();
+	} else if (numPrevious != previousKeys.size() / keySize) {
+		return false;
+	}
+	const byte_t* bitmask = getDataForSending() + i_runningByte;
+	const byte_t* keptData = bitmask + (numPrevious + 7) / 8;
+	const byte_t* addedData = keptData + numKept * tailSize;
+	const size_t numAdded = _numHalo - numKept;
+	if (numKept > _numHalo or addedData + numAdded * _numBytesHalo != _buffer.data() + _buffer.size()) {
+		return false;
+	}
+
+	std::vector<byte_t> message;
+	message.reserve(_numBytesSize + haloBegin + _numHalo * _numBytesHalo);
+	message.insert(message.end(), _buffer.begin(), _buffer.begin() + _numBytesSize + haloBegin);
+	std::vector<const byte_t*> keptKeys;
+	keptKeys.reserve(numKept);
+	for (std::uint64_t p = 0; p < numPrevious; ++p) {
+		if (bitmask[p / 8] & (1u << (p % 8))) {
+			if (keptKeys.size() == numKept) {
+				return false;
+			}
+			const byte_t* tail = keptData + keptKeys.size() * tailSize;
+			keptKeys.push_back(&previousKeys[p * keySize]);
+			message.insert(message.end(), keptKeys.back(), keptKeys.back() + keySize);
+			message.insert(message.end(), tail, tail + tailSize);
+		}
+	}
+	if (keptKeys.size() != numKept) {
+		return false;
+	}
+	message.insert(message.end(), addedData, addedData + numAdded * _numBytesHalo);
+
+	std::vector<byte_t> keys;
+	keys.reserve(_numHalo * keySize);
+	size_t a = 0, b = 0;
+	while (a < numKept or b < numAdded) {
+		const byte_t* addedKey = addedData + b * _numBytesHalo;
+		const bool takeKept = b == numAdded or (a < numKept and std::memcmp(keptKeys[a], addedKey, keySize) <= 0);
+		const byte_t* k = takeKept ? keptKeys[a++] : (++b, addedKey);
+		keys.insert(keys.end(), k, k + keySize);
+	}
+	previousKeys.swap(keys);
+	_buffer.assign(message.begin(), message.end());
+	return true;
+}
+#endif /* LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES */
+
 size_t CommunicationBuffer::getDynamicSize() {
 	return _buffer.capacity() * sizeof(byte_t);
 }
@@ -11,6 +11,7 @@
 #include "molecules/MoleculeForwardDeclaration.h"
 #include "utils/mardyn_assert.h"
 
+#include <cstdint>
 #include <vector>
 #include <stddef.h>
 #include <mpi.h>
@@ -33,6 +34,8 @@
  * due to CHAR conversion.
  *
  * Stores two unsigned long integers, then leaving molecules, then halo molecules.
+ * The buffer reserves room for the size of the message in front of it, so that the message can be sent to a receiver,
+ * which does not probe the size, without copying it (see getDataWithSize).
  */
 class CommunicationBuffer {
 
@@ -54,6 +57,32 @@ public:
 	size_t getNumElementsForSending();
 	void resizeForRawBytes(unsigned long numBytes);
 
+	//! @return number of bytes of the message together with its size
+	size_t getNumBytesWithSize() const {
+		return _buffer.size();
+	}
+
+	/**
+	 * @brief Writes the size of the message in front of it.
+	 * @param numBytes number of bytes, which are sent, at least getNumBytesWithSize(). The bytes behind the message are
+	 * set to zero, they are only part of the storage and not of the message.
+	 * @return the size followed by the message
+	 */
+	unsigned char* getDataWithSize(size_t numBytes);
+
+	/**
+	 * @brief Provides the storage for receiving a message together with its size.
+	 * @param numBytes maximal number of bytes, which are received
+	 * @return storage of numBytes, which stays the same as long as the buffer does not grow
+	 */
+	unsigned char* getStorageForReceivingWithSize(size_t numBytes);
+
+	/**
+	 * @brief Resizes the buffer to the message after it was received by getStorageForReceivingWithSize.
+	 * @return size of the message, which may be larger than the received part
+	 */
+	size_t resizeForReceivedSize();
+
 	// write
 	void addLeavingMolecule(size_t indexOfMolecule, const Molecule& m);
 	void addHaloMolecule(size_t indexOfMolecule, const Molecule& m);
@@ -67,6 +96,24 @@ public:
 	void resizeForReceivingMolecules(unsigned long& numLeaving, unsigned long& numHalo);
 	void resizeForReceivingMolecules(unsigned long& numForces);
 
+	/**
+	 * @brief Replaces the halo molecules by a delta against the halo molecules of the previous message to the partner.
+	 * @details The halo molecules are sorted by their key (id and component id). Molecules, whose key was already in
+	 * the previous message, are only sent with position (and orientation) in the order of previousKeys, which is
+	 * marked with one bit per previous key. The other molecules follow as complete records. Messages without halo
+	 * molecules are not changed and leave previousKeys untouched.
+	 * @param previousKeys keys of the previous message, replaced by the keys of this message
+	 * @param refresh encode against an empty list, so that the receiver restarts from this message
+	 */
+	void encodeHaloDelta(std::vector<unsigned char>& previousKeys, bool refresh);
+
+	/**
+	 * @brief Restores the halo molecules of a message encoded by encodeHaloDelta.
+	 * @param previousKeys keys of the previous message from the partner, replaced by the keys of this message
+	 * @return false, if the message does not refer to previousKeys
+	 */
+	bool decodeHaloDelta(std::vector<unsigned char>& previousKeys);
+
 	size_t getNumHalo() const {
 		return _numHalo;
 	}
@@ -87,6 +134,10 @@ private:
 	static size_t _numBytesHalo;
 	static size_t _numBytesLeaving;
         static size_t _numBytesForces; // where is this set?
+	//! leading bytes of a halo molecule, which identify it (id and component id)
+	static size_t _numBytesHaloKey;
+	//! leading bytes of _buffer, which hold the size of the message
+	static constexpr size_t _numBytesSize = sizeof(std::uint64_t);
 
 	enum class ParticleType_t {HALO=0, LEAVING=1, FORCE=3};
 	size_t getStartPosition(ParticleType_t type, size_t indexOfMolecule) const;
@@ -101,6 +152,7 @@ private:
 	size_t readValue(size_t indexInBytes, T& passByReference) const;
 
 	typedef unsigned char byte_t;
+	//! the size of the message, then the message
 	std::vector<byte_t> _buffer;
 	size_t _numLeaving, _numHalo, _numForces;
 };
@@ -110,11 +162,11 @@ inline size_t CommunicationBuffer::emplaceValue(size_t indexInBytes, T passByVal
 	const size_t numBytesOfT = sizeof(T);
 	size_t ret = indexInBytes + numBytesOfT;
 
-	mardyn_assert(_buffer.size() >= ret);
+	mardyn_assert(_buffer.size() >= _numBytesSize + ret);
 
 	const byte_t * pointer = reinterpret_cast<byte_t *> (&passByValue);
 	for (size_t i = 0; i < numBytesOfT; ++i) {
-		_buffer[indexInBytes + i] = pointer[i];
+		_buffer[_numBytesSize + indexInBytes + i] = pointer[i];
 	}
 
 	return ret;
@@ -125,11 +177,11 @@ inline size_t CommunicationBuffer::readValue(size_t indexInBytes, T& passByRefer
 	const size_t numBytesOfT = sizeof(T);
 	size_t ret = indexInBytes + numBytesOfT;
 
-	mardyn_assert(_buffer.size() >= ret);
+	mardyn_assert(_buffer.size() >= _numBytesSize + ret);
 
 	byte_t * pointer = reinterpret_cast<byte_t *> (&passByReference);
 	for (size_t i = 0; i < numBytesOfT; ++i) {
-		pointer[i] = _buffer[indexInBytes + i];
+		pointer[i] = _buffer[_numBytesSize + indexInBytes + i];
 	}
 
 	return ret;
@@ -6,7 +6,10 @@
  */
 
 #include "CommunicationPartner.h"
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
 #include "Domain.h"
 #include "ForceHelper.h"
@@ -101,6 +104,13 @@ CommunicationPartner::CommunicationPartner(const CommunicationPartner& o) {
 	_rank = o._rank;
 
 	_haloInfo = o._haloInfo;
+	_viaSharedMemory = o._viaSharedMemory;
+	_persistentSendSize = o._persistentSendSize;
+	_persistentRecvSize = o._persistentRecvSize;
+	_haloDeltaInterval = o._haloDeltaInterval;
+	_numHaloMessagesSent = o._numHaloMessagesSent;
+	_sentHaloKeys = o._sentHaloKeys;
+	_receivedHaloKeys = o._receivedHaloKeys;
 
 	// some values, to silence the warnings:
 	_sendRequest = new MPI_Request;
@@ -116,6 +126,15 @@ CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartne
 	if (this != &o) {
 		_rank = o._rank;
 		_haloInfo = o._haloInfo;
+		_viaSharedMemory = o._viaSharedMemory;
+		// the persistent requests are bound to the buffers of this object, they are recreated on demand
+		freeRequests();
+		_persistentSendSize = o._persistentSendSize;
+		_persistentRecvSize = o._persistentRecvSize;
+		_haloDeltaInterval = o._haloDeltaInterval;
+		_numHaloMessagesSent = o._numHaloMessagesSent;
+		_sentHaloKeys = o._sentHaloKeys;
+		_receivedHaloKeys = o._receivedHaloKeys;
 		delete _sendRequest;
 		delete _recvRequest;
 		delete _sendStatus;
@@ -131,6 +150,7 @@ CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartne
 }
 
 CommunicationPartner::~CommunicationPartner() {
+	freeRequests();
 	delete _sendRequest;
 	delete _recvRequest;
 	delete _sendStatus;
@@ -224,7 +244,58 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 
 	#endif
 
-	MPI_CHECK(MPI_Isend(_sendBuf.getDataForSending(), (int ) _sendBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, 99, comm, _sendRequest));
+	if (_viaSharedMemory) {
+		// the buffer is published by SharedMemoryHaloExchange and kept until the next initSend
+		_msgSent = true;
+		_isSending = false;
+		return;
+	}
+
+	if (_haloDeltaInterval > 0 and _sendBuf.getNumHalo() > 0) {
+		_sendBuf.encodeHaloDelta(_sentHaloKeys, _numHaloMessagesSent++ % _haloDeltaInterval == 0);
+	}
+	sendPacked(comm);
+}
+
+void CommunicationPartner::sendPacked(const MPI_Comm& comm) {
+	if (_persistentSendSize > 0) {
+		// the size precedes the message in the buffer, the receiver starts the receive without probing
+		const size_t numBytes = _sendBuf.getNumBytesWithSize();
+		if (numBytes <= _persistentSendSize) {
+			// the message is sent with the persistent request of the smallest size class it fits into
+			const size_t classSize = (_persistentSendSize + _numPersistentSendClasses - 1) / _numPersistentSendClasses;
+			const size_t sizeClass = (numBytes - 1) / classSize;
+			const size_t numBytesSent = std::min((sizeClass + 1) * classSize, _persistentSendSize);
+			const unsigned char* data = _sendBuf.getDataWithSize(numBytesSent);
+			if (data != _persistentSendData or comm != _persistentSendComm) {
+				// the buffer has grown, the requests are bound to the old one
+				freePersistentSendRequests();
+				_persistentSendData = data;
+				_persistentSendComm = comm;
+			}
+			MPI_Request& request = _persistentSendRequests[sizeClass];
+			if (request == MPI_REQUEST_NULL) {
+				MPI_CHECK(MPI_Send_init(data, (int) numBytesSent, _sendBuf.getMPIDataType(), _rank, 99, comm, &request));
+			}
+			MPI_CHECK(MPI_Start(&request));
+			_activeSendRequest = &request;
+		} else {
+			// the receiver knows the size from the first part and receives the rest without probing
+			Log::global_log->debug() << "Message of " << numBytes << " bytes to " << _rank
+									 << " exceeds the persistent buffer, sending the rest separately" << std::endl;
+			const unsigned char* data = _sendBuf.getDataWithSize(numBytes);
+			MPI_CHECK(MPI_Isend(data, (int) _persistentSendSize, _sendBuf.getMPIDataType(), _rank, 99, comm,
+								_sendRequest));
+			MPI_CHECK(MPI_Isend(data + _persistentSendSize, (int) (numBytes - _persistentSendSize),
+								_sendBuf.getMPIDataType(), _rank, 98, comm, &_remainderSendRequest));
+			_activeSendRequest = _sendRequest;
+			_persistentSendSize = grownPersistentBufferSize(_sendBuf.getNumElementsForSending());
+			freePersistentSendRequests();
+		}
+	} else {
+		MPI_CHECK(MPI_Isend(_sendBuf.getDataForSending(), (int ) _sendBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, 99, comm, _sendRequest));
+		_activeSendRequest = _sendRequest;
+	}
 	_msgSent = false;
 	_isSending = true;
 }
@@ -232,7 +303,12 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 bool CommunicationPartner::testSend() {
 	if (not _msgSent) {
 		int flag = 0;
-		MPI_CHECK(MPI_Test(_sendRequest, &flag, _sendStatus)); // THIS CAUSES A SEG FAULT IN PUSH_PULL_NEIGHBOURS
+		if (_remainderSendRequest != MPI_REQUEST_NULL) {
+			MPI_CHECK(MPI_Test(&_remainderSendRequest, &flag, MPI_STATUS_IGNORE));
+		}
+		if (_remainderSendRequest == MPI_REQUEST_NULL) {
+			MPI_CHECK(MPI_Test(_activeSendRequest, &flag, _sendStatus)); // THIS CAUSES A SEG FAULT IN PUSH_PULL_NEIGHBOURS
+		}
 		if (flag == 1) {
 			_msgSent = true;
 			_isSending = false;
@@ -247,6 +323,27 @@ void CommunicationPartner::resetReceive() {
 }
 
 bool CommunicationPartner::iprobeCount(const MPI_Comm& comm, const MPI_Datatype& /*type*/) {
+	if (not _countReceived and _persistentRecvSize > 0) {
+		// the size precedes the message, so the receive can be started without probing
+		unsigned char* data = _recvBuf.getStorageForReceivingWithSize(_persistentRecvSize);
+		if (_persistentRecvRequest == MPI_REQUEST_NULL or _persistentRecvComm != comm or
+			_persistentRecvData != data or _persistentRecvCount != _persistentRecvSize) {
+			// the buffer or its size has changed, the request is bound to the old one
+			if (_persistentRecvRequest != MPI_REQUEST_NULL) {
+				MPI_CHECK(MPI_Request_free(&_persistentRecvRequest));
+			}
+			MPI_CHECK(MPI_Recv_init(data, (int) _persistentRecvSize, _sendBuf.getMPIDataType(), _rank, 99, comm,
+									&_persistentRecvRequest));
+			_persistentRecvComm = comm;
+			_persistentRecvData = data;
+			_persistentRecvCount = _persistentRecvSize;
+		}
+		MPI_CHECK(MPI_Start(&_persistentRecvRequest));
+		_persistentRecvActive = true;
+		_isReceiving = true;
+		_countReceived = true;
+		_countTested = 0;
+	}
 	if (not _countReceived) {
 		_isReceiving = true;
 		int flag = 0;
@@ -266,7 +363,32 @@ bool CommunicationPartner::iprobeCount(const MPI_Comm& comm, const MPI_Datatype&
 	}
 	return _countReceived;
 }
+
+bool CommunicationPartner::testPersistentRecv() {
+	int flag = 0;
+	MPI_CHECK(MPI_Test(&_persistentRecvRequest, &flag, _recvStatus));
+	if (flag == 0) {
+		return false;
+	}
+	_persistentRecvActive = false;
+	// the message has been received in place, only its size has to be adjusted
+	const size_t numBytes = _recvBuf.resizeForReceivedSize();
+	const size_t numFirst = std::min<size_t>(numBytes, _persistentRecvSize - sizeof(std::uint64_t));
+	if (numFirst < numBytes) {
+		// the rest is completed by _recvRequest as an ordinary message, the next one fits
+		MPI_CHECK(MPI_Irecv(_recvBuf.getDataForSending() + numFirst, (int) (numBytes - numFirst),
+							_sendBuf.getMPIDataType(), _rank, 98, _persistentRecvComm, _recvRequest));
+		_persistentRecvSize = grownPersistentBufferSize(numBytes);
+	} else {
+		*_recvRequest = MPI_REQUEST_NULL;
+	}
+	return true;
+}
+
 bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool removeRecvDuplicates, bool force) {
+	if (_persistentRecvActive and not testPersistentRecv()) {
+		return false;
+	}
 	if (_countReceived and not _msgReceived) {
 		int flag = 1;
 		if (_countTested > 10) {
@@ -284,6 +406,14 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 
 			if(!force) { // Buffer is particle data
 
+				// messages via shared memory are not encoded
+				if (_haloDeltaInterval > 0 and not _viaSharedMemory and
+					not _recvBuf.decodeHaloDelta(_receivedHaloKeys)) {
+					std::ostringstream error_message;
+					error_message << "[CommunicationPartner] Halo delta from rank " << _rank
+								  << " does not match the previously received halo molecules." << std::endl;
+					MARDYN_EXIT(error_message.str());
+				}
 				unsigned long numHalo, numLeaving;
 				_recvBuf.resizeForReceivingMolecules(numLeaving, numHalo);
 
@@ -402,6 +532,54 @@ void CommunicationPartner::initRecv(int numParticles, const MPI_Comm& comm, cons
 	MPI_CHECK(MPI_Irecv(_recvBuf.getDataForSending(), _recvBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, 99, comm, _recvRequest));
 }
 
+void CommunicationPartner::setPersistentBufferSize(size_t numBytes) {
+	freeRequests();
+	// the buffer has to hold at least the size of the message
+	_persistentSendSize = _persistentRecvSize = numBytes > 0 ? std::max(numBytes, 2 * sizeof(std::uint64_t)) : 0;
+}
+
+size_t CommunicationPartner::grownPersistentBufferSize(size_t numBytes) {
+	// a quarter more than the message and its size, so that slightly larger messages fit as well
+	const size_t needed = numBytes + sizeof(std::uint64_t);
+	return needed + needed / 4;
+}
+
+void CommunicationPartner::freeRequests() {
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	for (MPI_Request* request : {&_persistentRecvRequest, &_remainderSendRequest}) {
+		if (*request != MPI_REQUEST_NULL and not finalized) {
+			MPI_Request_free(request);
+		}
+		*request = MPI_REQUEST_NULL;
+	}
+	_persistentRecvActive = false;
+	freePersistentSendRequests();
+	_activeSendRequest = nullptr;
+}
+
+void CommunicationPartner::freePersistentSendRequests() {
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	for (MPI_Request& request : _persistentSendRequests) {
+		if (request != MPI_REQUEST_NULL and not finalized) {
+			MPI_Request_free(&request);
+		}
+	}
+	_persistentSendRequests.assign(_numPersistentSendClasses, MPI_REQUEST_NULL);
+	_persistentSendData = nullptr;
+}
+
+void CommunicationPartner::receiveFromSharedMemory(const unsigned char* data, size_t numBytes) {
+	_recvBuf.resizeForRawBytes(numBytes);
+	std::memcpy(_recvBuf.getDataForSending(), data, numBytes);
+	// testRecv completes the null request immediately and unpacks the buffer
+	*_recvRequest = MPI_REQUEST_NULL;
+	_countReceived = true;
+	_isReceiving = true;
+	_countTested = 0;
+}
+
 void CommunicationPartner::deadlockDiagnosticSendRecv() {
 
 	deadlockDiagnosticSend();
@@ -637,7 +815,9 @@ void CommunicationPartner::collectLeavingMoleculesFromInvalidParticles(std::vect
 }
 
 size_t CommunicationPartner::getDynamicSize() {
-	return _sendBuf.getDynamicSize() + _recvBuf.getDynamicSize() + _haloInfo.capacity() * sizeof(PositionInfo);
+	return _sendBuf.getDynamicSize() + _recvBuf.getDynamicSize() + _haloInfo.capacity() * sizeof(PositionInfo) +
+		   _persistentSendRequests.capacity() * sizeof(MPI_Request) +
+		   _sentHaloKeys.capacity() + _receivedHaloKeys.capacity();
 }
 
 void CommunicationPartner::print(std::ostream& stream) const {
@@ -54,6 +54,12 @@ public:
 				  MessageType msgType, std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
 				  bool doHaloPositionCheck, bool removeFromContainer = false);
 
+	/**
+	 * @brief Sends the message packed by the last initSend with MPI.
+	 * @details Called by initSend, and by SharedMemoryHaloExchange for messages which do not fit into shared memory.
+	 */
+	void sendPacked(const MPI_Comm& comm);
+
 	bool testSend();
 
 	void resetReceive();
@@ -64,6 +70,55 @@ public:
 
 	void initRecv(int numParticles, const MPI_Comm& comm, const MPI_Datatype& type);
 
+	//! If set, initSend only packs the send buffer and the message is exchanged by SharedMemoryHaloExchange
+	void setViaSharedMemory(bool viaSharedMemory) {
+		_viaSharedMemory = viaSharedMemory;
+	}
+
+	bool isViaSharedMemory() const {
+		return _viaSharedMemory;
+	}
+
+	/**
+	 * @brief Sends and receives the messages with persistent requests (MPI_Send_init / MPI_Recv_init) of up to
+	 * numBytes.
+	 * @details The communication buffers hold the size of the packed message in the 8 bytes in front of it, so the
+	 * receive is started without the MPI_Iprobe / MPI_Get_count round trip and neither side copies the message. The
+	 * receive request is bound to the receive buffer. A message is sent by one of 16 persistent send requests, which
+	 * send up to 1/16, 2/16, ... of numBytes, so only the bytes behind the message up to the next of these sizes are
+	 * transferred in addition. Of a larger message, the part which does not fit follows as a separate message, then the
+	 * buffers for this direction grow on both sides, so that the next message of this size fits. The requests are
+	 * recreated if a buffer grows. numBytes has to be the same on all processes, 0 disables the persistent requests.
+	 * The messages to a rank must not be received by another partner object for the same rank (see
+	 * NeighbourCommunicationScheme::assignPartnerOptions). Messages exchanged via shared memory do not use them.
+	 */
+	void setPersistentBufferSize(size_t numBytes);
+
+	/**
+	 * @brief Sends the halo molecules as delta against the previous message to this partner.
+	 * @details Halo molecules, which were already sent, are sent without id and component id, every interval-th message
+	 * with halo molecules is complete. 0 disables the delta encoding, it has to be the same on both sides. The messages
+	 * to a rank must not be received by another partner object for the same rank, so it may only be enabled for
+	 * partners, whose rank is unique in their list (see NeighbourCommunicationScheme::assignPartnerOptions). Messages
+	 * exchanged via shared memory are not encoded.
+	 * @see CommunicationBuffer::encodeHaloDelta
+	 */
+	void setHaloDeltaInterval(unsigned interval) {
+		_haloDeltaInterval = interval;
+	}
+
+	//! packed message of the last initSend
+	unsigned char* getSendData() {
+		return _sendBuf.getDataForSending();
+	}
+
+	size_t getSendSize() {
+		return _sendBuf.getNumElementsForSending();
+	}
+
+	//! @brief Copies a message from shared memory, testRecv unpacks it as if it was received by MPI.
+	void receiveFromSharedMemory(const unsigned char* data, size_t numBytes);
+
 	void deadlockDiagnosticSendRecv();
 	void deadlockDiagnosticSend();
 	void deadlockDiagnosticRecv();
@@ -136,10 +191,55 @@ private:
 	MPI_Status *_sendStatus, *_recvStatus;
 	CommunicationBuffer _sendBuf, _recvBuf; // used to be ParticleData and
 	bool _msgSent, _countReceived, _msgReceived, _isSending, _isReceiving;
+	bool _viaSharedMemory{false};
+
+	// persistent requests, created by the first exchange
+	//! size of the persistent buffers for the messages to / from the partner (with their size), grown by larger messages
+	size_t _persistentSendSize{0}, _persistentRecvSize{0};
+	static constexpr size_t _numPersistentSendClasses = 16;
+	//! the i-th request sends (i + 1) / _numPersistentSendClasses of _persistentSendSize from the storage of _sendBuf
+	std::vector<MPI_Request> _persistentSendRequests;
+	const unsigned char* _persistentSendData{nullptr};
+	MPI_Comm _persistentSendComm{MPI_COMM_NULL};
+	//! request of the last send, either one of the persistent requests or _sendRequest
+	MPI_Request* _activeSendRequest{nullptr};
+	//! receives into the storage of _recvBuf
+	MPI_Request _persistentRecvRequest{MPI_REQUEST_NULL};
+	const unsigned char* _persistentRecvData{nullptr};
+	size_t _persistentRecvCount{0};
+	MPI_Comm _persistentRecvComm{MPI_COMM_NULL};
+	//! the persistent receive has been started and is not yet completed
+	bool _persistentRecvActive{false};
+	//! part of the message, which did not fit into the persistent buffer of the partner
+	MPI_Request _remainderSendRequest{MPI_REQUEST_NULL};
+
+	//! @brief Frees the persistent and the pending requests, which are bound to the buffers of this object.
+	void freeRequests();
+
+	//! @brief Frees the persistent send requests, if the send buffer or its bound has changed.
+	void freePersistentSendRequests();
+
+	//! @return size of the persistent buffers after a message of numBytes did not fit, the same on both sides
+	static size_t grownPersistentBufferSize(size_t numBytes);
+
+	/**
+	 * @brief Resizes _recvBuf to the message received by the completed persistent receive.
+	 * @details If the message did not fit, the receive of the rest is started with _recvRequest.
+	 * @return false, if the persistent receive is not completed yet
+	 */
+	bool testPersistentRecv();
+
+	// delta encoding of the halo molecules
+	unsigned _haloDeltaInterval{0};
+	unsigned long _numHaloMessagesSent{0};
+	//! keys of the halo molecules of the last message to / from the partner
+	std::vector<unsigned char> _sentHaloKeys, _receivedHaloKeys;
 
 	void collectLeavingMoleculesFromInvalidParticles(std::vector<Molecule>& invalidParticles, double lowCorner [3], double highCorner [3], double shift [3]);
 
 	friend class NeighborAcquirerTest;
+	friend class SharedMemoryHaloExchangeTest;
+	friend class CommunicationPartnerTest;
 };
 
 #endif /* COMMUNICATIONPARTNER_H_ */
@@ -113,6 +113,37 @@ void DomainDecompMPIBase::readXML(XMLfileUnits& xmlconfig) {
 	setCommunicationScheme(neighbourCommunicationScheme, zonalMethod);
 	_neighbourCommunicationScheme->setSequentialFallback(useSequentialFallback);
 
+	bool useSharedMemoryHalo = false;
+	xmlconfig.getNodeValue("useSharedMemoryHalo", useSharedMemoryHalo);
+	if (useSharedMemoryHalo) {
+		if (neighbourCommunicationScheme == "indirect") {
+			Log::global_log->warning() << "DomainDecompMPIBase: useSharedMemoryHalo requires the direct communication "
+										  "scheme and is ignored." << std::endl;
+		} else {
+			unsigned long sharedMemoryHaloSize = 16 * 1024 * 1024;
+			xmlconfig.getNodeValue("sharedMemoryHaloSize", sharedMemoryHaloSize);
+			Log::global_log->info() << "DomainDecompMPIBase: exchanging halos on the same node via shared memory"
+									<< std::endl;
+			_neighbourCommunicationScheme->setSharedMemoryHaloSize(std::max(sharedMemoryHaloSize, 1ul));
+		}
+	}
+
+	unsigned long persistentBufferSize = 0;
+	xmlconfig.getNodeValue("persistentBufferSize", persistentBufferSize);
+	if (persistentBufferSize > 0) {
+		Log::global_log->info() << "DomainDecompMPIBase: exchanging messages with persistent requests on buffers of "
+								<< persistentBufferSize << " bytes" << std::endl;
+		_neighbourCommunicationScheme->setPersistentBufferSize(persistentBufferSize);
+	}
+
+	unsigned haloDeltaInterval = 0;
+	xmlconfig.getNodeValue("haloDeltaInterval", haloDeltaInterval);
+	if (haloDeltaInterval > 0) {
+		Log::global_log->info() << "DomainDecompMPIBase: sending halo molecules as delta, complete every "
+								<< haloDeltaInterval << " messages" << std::endl;
+		_neighbourCommunicationScheme->setHaloDeltaInterval(haloDeltaInterval);
+	}
+
 	bool overlappingCollectives = false;
 	xmlconfig.getNodeValue("overlappingCollectives", overlappingCollectives);
 	if(overlappingCollectives) {
@@ -281,6 +312,30 @@ void DomainDecompMPIBase::finishNonBlockingStageImpl(ParticleContainer* molecule
 			removeRecvDuplicates, this);
 }
 
+void DomainDecompMPIBase::prepareNonBlockingLeavingAndHaloStage(ParticleContainer* moleculeContainer,
+		Domain* domain, unsigned int stageNumber, bool removeRecvDuplicates) {
+	if (sendLeavingWithCopies()) {
+		prepareNonBlockingStageImpl(moleculeContainer, domain, stageNumber, LEAVING_AND_HALO_COPIES,
+				removeRecvDuplicates);
+	} else {
+		// the halo copies depend on the leaving particles, so only the halo exchange can overlap
+		if (stageNumber == 0) {
+			global_simulation->timers()->start("SIMULATION_OVERLAP_LEAVING_EXCHANGE");
+			exchangeMoleculesMPI(moleculeContainer, domain, LEAVING_ONLY, true /*doHaloPositionCheck*/,
+					removeRecvDuplicates);
+			moleculeContainer->deleteOuterParticles();
+			global_simulation->timers()->stop("SIMULATION_OVERLAP_LEAVING_EXCHANGE");
+		}
+		prepareNonBlockingStageImpl(moleculeContainer, domain, stageNumber, HALO_COPIES, removeRecvDuplicates);
+	}
+}
+
+void DomainDecompMPIBase::finishNonBlockingLeavingAndHaloStage(ParticleContainer* moleculeContainer, Domain* domain,
+		unsigned int stageNumber, bool removeRecvDuplicates) {
+	finishNonBlockingStageImpl(moleculeContainer, domain, stageNumber,
+			sendLeavingWithCopies() ? LEAVING_AND_HALO_COPIES : HALO_COPIES, removeRecvDuplicates);
+}
+
 void DomainDecompMPIBase::exchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* domain,
 		MessageType msgType, bool doHaloPositionCheck, bool removeRecvDuplicates) {
 
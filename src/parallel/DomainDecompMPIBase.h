@@ -201,6 +201,18 @@ public:
 	   	 <overlappingStartAtStep></overlappingStartAtStep>
 	   	 <!--default: yes-->
 	   	 <useSequentialFallback>yes OR no</useSequentialFallback>
+	   	 <!--default: no; exchange with processes on the same node via an MPI shared memory window, direct schemes only-->
+	   	 <useSharedMemoryHalo>yes OR no</useSharedMemoryHalo>
+	   	 <!--default: 16777216; initial size in bytes of the shared memory of every process, messages which do not fit
+	   	     are sent with MPI and enlarge it when the partners are set up anew-->
+	   	 <sharedMemoryHaloSize>INTEGER</sharedMemoryHaloSize>
+	   	 <!--default: 0 (disabled); initial size in bytes of the messages sent and received with persistent requests,
+	   	     larger messages are sent in two parts and enlarge the buffers for this partner; not used for partners,
+	   	     which occur several times among the neighbours-->
+	   	 <persistentBufferSize>INTEGER</persistentBufferSize>
+	   	 <!--default: 0 (disabled); send known halo molecules without id and component id, a complete halo message
+	   	     every INTEGER messages; not used for partners, which occur several times among the neighbours-->
+	   	 <haloDeltaInterval>INTEGER</haloDeltaInterval>
 	     <!-- structure handled by DomainDecomposition or KDDecomposition -->
 	   </parallelisation>
 	   \endcode
@@ -252,6 +264,18 @@ protected:
 	virtual void finishNonBlockingStageImpl(ParticleContainer* moleculeContainer, Domain* domain,
 			unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates = false);
 
+	/**
+	 * Prepares the stageNumber'th stage of a non-blocking exchange of leaving particles and halo copies.
+	 * If they can not be sent together, the leaving particles are exchanged blocking at the beginning of the first
+	 * stage and only the halo copies are sent non-blocking.
+	 */
+	void prepareNonBlockingLeavingAndHaloStage(ParticleContainer* moleculeContainer, Domain* domain,
+			unsigned int stageNumber, bool removeRecvDuplicates = false);
+
+	//! Finishes the stageNumber'th stage started by prepareNonBlockingLeavingAndHaloStage().
+	void finishNonBlockingLeavingAndHaloStage(ParticleContainer* moleculeContainer, Domain* domain,
+			unsigned int stageNumber, bool removeRecvDuplicates = false);
+
 	MPI_Datatype _mpiParticleType;
 	MPI_Datatype _mpiParticleForceType;
 
@@ -58,31 +58,12 @@ void DomainDecomposition::initCommunicationPartners(double cutoffRadius, Domain
 
 void DomainDecomposition::prepareNonBlockingStage(bool /*forceRebalancing*/, ParticleContainer* moleculeContainer,
 		Domain* domain, unsigned int stageNumber) {
-	if (sendLeavingWithCopies()) {
-		DomainDecompMPIBase::prepareNonBlockingStageImpl(moleculeContainer, domain, stageNumber,
-														 LEAVING_AND_HALO_COPIES);
-	} else {
-		// Would first need to send leaving, then halo -> not good for overlapping!
-		std::ostringstream error_message;
-		error_message << "nonblocking P2P using separate messages for leaving and halo is currently not "
-							   "supported. Please use the indirect neighbor communication scheme!"
-							<< std::endl;
-		MARDYN_EXIT(error_message.str());
-	}
+	DomainDecompMPIBase::prepareNonBlockingLeavingAndHaloStage(moleculeContainer, domain, stageNumber);
 }
 
 void DomainDecomposition::finishNonBlockingStage(bool /*forceRebalancing*/, ParticleContainer* moleculeContainer,
 		Domain* domain, unsigned int stageNumber) {
-	if (sendLeavingWithCopies()) {
-		DomainDecompMPIBase::finishNonBlockingStageImpl(moleculeContainer, domain, stageNumber,
-														LEAVING_AND_HALO_COPIES);
-	} else {
-		// Would first need to send leaving, then halo -> not good for overlapping!
-		std::ostringstream error_message;
-		error_message
-			<< "nonblocking P2P using separate messages for leaving and halo is currently not supported." << std::endl;
-		MARDYN_EXIT(error_message.str());
-	}
+	DomainDecompMPIBase::finishNonBlockingLeavingAndHaloStage(moleculeContainer, domain, stageNumber);
 }
 
 bool DomainDecomposition::queryBalanceAndExchangeNonBlocking(bool /*forceRebalancing*/,
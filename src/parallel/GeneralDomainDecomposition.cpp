@@ -140,6 +140,34 @@ void GeneralDomainDecomposition::balanceAndExchange(double lastTraversalTime, bo
 	++_steps;
 }
 
+void GeneralDomainDecomposition::balanceAndExchangeInitNonBlocking(bool /*forceRebalancing*/,
+																   ParticleContainer* /*moleculeContainer*/,
+																   Domain* /*domain*/) {
+	// the non-blocking exchange replaces balanceAndExchange in this step
+	++_steps;
+}
+
+void GeneralDomainDecomposition::prepareNonBlockingStage(bool /*forceRebalancing*/,
+														 ParticleContainer* moleculeContainer, Domain* domain,
+														 unsigned int stageNumber) {
+	DomainDecompMPIBase::prepareNonBlockingLeavingAndHaloStage(moleculeContainer, domain, stageNumber);
+}
+
+void GeneralDomainDecomposition::finishNonBlockingStage(bool /*forceRebalancing*/,
+														ParticleContainer* moleculeContainer, Domain* domain,
+														unsigned int stageNumber) {
+	DomainDecompMPIBase::finishNonBlockingLeavingAndHaloStage(moleculeContainer, domain, stageNumber);
+}
+
+bool GeneralDomainDecomposition::queryBalanceAndExchangeNonBlocking(bool forceRebalancing,
+																	ParticleContainer* /*moleculeContainer*/,
+																	Domain* /*domain*/, double etime) {
+	if (_steps == 0 or forceRebalancing) {
+		return false;
+	}
+	return not queryRebalancing(_steps, _rebuildFrequency, _initPhase, _initFrequency, etime);
+}
+
 void GeneralDomainDecomposition::migrateParticles(Domain* domain, ParticleContainer* particleContainer,
 												  std::array<double, 3> newMin, std::array<double, 3> newMax) {
 	std::array<double, 3> oldBoxMin{particleContainer->getBoundingBoxMin(0), particleContainer->getBoundingBoxMin(1),
@@ -70,24 +70,24 @@ public:
 		throw std::runtime_error("GeneralDomainDecomposition::getNeighbourRanksFullShell() not yet implemented");
 	}
 
+	// documentation in base class
+	void balanceAndExchangeInitNonBlocking(bool forceRebalancing, ParticleContainer* moleculeContainer,
+										   Domain* domain) override;
+
 	// documentation in base class
 	void prepareNonBlockingStage(bool forceRebalancing, ParticleContainer* moleculeContainer, Domain* domain,
-								 unsigned int stageNumber) override {
-		throw std::runtime_error("GeneralDomainDecomposition::prepareNonBlockingStage() not yet implemented");
-	}
+								 unsigned int stageNumber) override;
 
 	// documentation in base class
 	void finishNonBlockingStage(bool forceRebalancing, ParticleContainer* moleculeContainer, Domain* domain,
-								unsigned int stageNumber) override {
-		throw std::runtime_error("GeneralDomainDecomposition::prepareNonBlockingStage() not yet implemented");
-	}
+								unsigned int stageNumber) override;
 
-	// documentation in base class
+	/**
+	 * The exchange is non-blocking in all steps, in which neither the communication partners are initialized nor the
+	 * domain is rebalanced.
+	 */
 	bool queryBalanceAndExchangeNonBlocking(bool forceRebalancing, ParticleContainer* moleculeContainer, Domain* domain,
-											double etime) override {
-		throw std::runtime_error(
-			"GeneralDomainDecomposition::queryBalanceAndExchangeNonBlocking() not yet implemented");
-	}
+											double etime) override;
 
 	std::vector<CommunicationPartner> getNeighboursFromHaloRegion(Domain* domain, const HaloRegion& haloRegion,
 																  double cutoff) override {
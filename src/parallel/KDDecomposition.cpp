@@ -6,6 +6,7 @@
 #include <climits>
 #include <cmath>
 #include <limits>
+#include <numeric>
 
 #ifdef ENABLE_MPI
 #include <mpi.h>
@@ -193,6 +194,28 @@ void KDDecomposition::readXML(XMLfileUnits& xmlconfig) {
 	Log::global_log->info() << "measureLoad: Ensure that cells with more particles take longer ? "
 					   << (_measureLoadIncreasingTimeValues ? "yes" : "no") << std::endl;
 
+	xmlconfig.getNodeValue("incrementalRebalancing", _incrementalRebalancing);
+	Log::global_log->info() << "KDDecomposition incremental rebalancing?: " << (_incrementalRebalancing ? "yes" : "no") << std::endl;
+	if (_incrementalRebalancing) {
+		xmlconfig.getNodeValue("incrementalMaxShift", _incrementalMaxShift);
+		xmlconfig.getNodeValue("incrementalImbalanceThreshold", _incrementalImbalanceThreshold);
+		if (_incrementalMaxShift < 1) {
+			std::ostringstream error_message;
+			error_message << "KDDecomposition incrementalMaxShift has to be at least 1!" << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		Log::global_log->info() << "KDDecomposition shifts split planes by at most " << _incrementalMaxShift
+						   << " cells if the imbalance exceeds " << _incrementalImbalanceThreshold << std::endl;
+		if (_clusteredHeterogeneouseSystems) {
+			Log::global_log->warning() << "KDDecomposition: incremental rebalancing is not supported for clustered "
+										  "heterogeneous systems, constructing new trees instead." << std::endl;
+		}
+	}
+
+	xmlconfig.getNodeValue("useMeasuredCellCosts", _useMeasuredCellCosts);
+	Log::global_log->info() << "KDDecomposition uses measured cycles per cell as costs?: "
+					   << (_useMeasuredCellCosts ? "yes" : "no") << std::endl;
+
 	DomainDecompMPIBase::readXML(xmlconfig);
 
 	std::string oldPath(xmlconfig.getcurrentnodepath());
@@ -209,24 +232,16 @@ void KDDecomposition::prepareNonBlockingStage(bool /*forceRebalancing*/,
 		ParticleContainer* moleculeContainer, Domain* domain,
 		unsigned int stageNumber) {
 	const bool removeRecvDuplicates = true;
-	if(sendLeavingWithCopies()){
-		DomainDecompMPIBase::prepareNonBlockingStageImpl(moleculeContainer, domain, stageNumber, LEAVING_AND_HALO_COPIES, removeRecvDuplicates);
-	} else {
-		DomainDecompMPIBase::prepareNonBlockingStageImpl(moleculeContainer, domain, stageNumber, LEAVING_ONLY, removeRecvDuplicates);
-		DomainDecompMPIBase::prepareNonBlockingStageImpl(moleculeContainer, domain, stageNumber, HALO_COPIES, removeRecvDuplicates);
-	}
+	DomainDecompMPIBase::prepareNonBlockingLeavingAndHaloStage(moleculeContainer, domain, stageNumber,
+															   removeRecvDuplicates);
 }
 
 void KDDecomposition::finishNonBlockingStage(bool /*forceRebalancing*/,
 		ParticleContainer* moleculeContainer, Domain* domain,
 		unsigned int stageNumber) {
 	const bool removeRecvDuplicates = true;
-	if(sendLeavingWithCopies()){
-		DomainDecompMPIBase::finishNonBlockingStageImpl(moleculeContainer, domain, stageNumber, LEAVING_AND_HALO_COPIES, removeRecvDuplicates);
-	} else {
-		DomainDecompMPIBase::finishNonBlockingStageImpl(moleculeContainer, domain, stageNumber, LEAVING_ONLY, removeRecvDuplicates);
-		DomainDecompMPIBase::finishNonBlockingStageImpl(moleculeContainer, domain, stageNumber, HALO_COPIES, removeRecvDuplicates);
-	}
+	DomainDecompMPIBase::finishNonBlockingLeavingAndHaloStage(moleculeContainer, domain, stageNumber,
+															  removeRecvDuplicates);
 }
 
 //check whether or not to do rebalancing in the specified step
@@ -234,7 +249,18 @@ bool KDDecomposition::doRebalancing(bool forceRebalancing, bool needsRebalance,
 	return forceRebalancing or ((steps % frequency == 0 or steps <= 1) and needsRebalance);
 }
 
+void KDDecomposition::balanceAndExchangeInitNonBlocking(bool /*forceRebalancing*/,
+		ParticleContainer* /*moleculeContainer*/, Domain* /*domain*/) {
+	// the non-blocking exchange replaces balanceAndExchange in this step
+	_steps++;
+}
+
 bool KDDecomposition::queryBalanceAndExchangeNonBlocking(bool forceRebalancing, ParticleContainer* /*moleculeContainer*/, Domain* /*domain*/, double etime){
+	// MeasureLoad is set up in balanceAndExchange
+	const size_t nextStep = _steps + 1;
+	if (_doMeasureLoadCalc and (nextStep == _measureLoadInitTimersStep or nextStep == _measureLoadStartStep)) {
+		return false;
+	}
 	bool needsRebalance = checkNeedRebalance(etime);
 	return not doRebalancing(forceRebalancing, needsRebalance, _steps, _frequency);
 }
@@ -261,13 +287,25 @@ bool KDDecomposition::checkNeedRebalance(double lastTraversalTime) const {
 }
 
 void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceRebalancing, ParticleContainer* moleculeContainer, Domain* domain) {
+	if (_useMeasuredCellCosts and not _cellCostMeasurementStarted) {
+		// all processes have to agree, otherwise the costs of some cells would be missing
+		int supported = moleculeContainer->setMeasureCellCosts(true) ? 1 : 0;
+		MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &supported, 1, MPI_INT, MPI_MIN, _comm));
+		if (not supported) {
+			Log::global_log->warning() << "KDDecomposition: the container or traversal does not support measuring "
+										  "the costs per cell, using particle counts instead." << std::endl;
+			moleculeContainer->setMeasureCellCosts(false);
+			_useMeasuredCellCosts = false;
+		}
+		_cellCostMeasurementStarted = true;
+	}
+
 	bool needsRebalance = checkNeedRebalance(lastTraversalTime);
 	bool rebalance = doRebalancing(forceRebalancing, needsRebalance, _steps, _frequency);
 	_steps++;
 	const bool removeRecvDuplicates = true;
 
-	size_t measureLoadInitTimers = 2;
-	if (_steps == measureLoadInitTimers and _doMeasureLoadCalc) {
+	if (_steps == _measureLoadInitTimersStep and _doMeasureLoadCalc) {
 		if(global_simulation->getEnsemble()->getComponents()->size() > 1){
 			Log::global_log->warning() << "MeasureLoad is designed to work with one component. Using it with more than one "
 									 "component might produce bad results if their force calculation differs."
@@ -275,8 +313,7 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 		}
 		_measureLoadCalc = new MeasureLoad(_measureLoadIncreasingTimeValues, _measureLoadInterpolationStartsAt);
 	}
-	size_t measureLoadStart = 50;
-	if (_steps == measureLoadStart and _doMeasureLoadCalc) {
+	if (_steps == _measureLoadStartStep and _doMeasureLoadCalc) {
 		bool faulty = _measureLoadCalc->prepareLoads(this, _comm);
 		if (faulty) {
 			Log::global_log->info() << "Not using MeasureLoad as it failed. No rebalance forced." << std::endl;
@@ -316,6 +353,9 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 		KDNode * newOwnLeaf = nullptr;
 
 		calcNumParticlesPerCell(moleculeContainer);
+		if (_useMeasuredCellCosts) {
+			calcMeasuredCellCosts(moleculeContainer);
+		}
 		constructNewTree(newDecompRoot, newOwnLeaf, moleculeContainer);
 		bool migrationSuccessful = migrateParticles(*newDecompRoot, *newOwnLeaf, moleculeContainer, domain);
 		if (not migrationSuccessful) {
@@ -584,9 +624,12 @@ void KDDecomposition::constructNewTree(KDNode *& newRoot, KDNode *& newOwnLeaf,
 	KDNode * toCleanUp = newRoot;
 
 	updateMeanProcessorSpeeds(_processorSpeeds,_accumulatedProcessorSpeeds, moleculeContainer);
-	bool result;
+	bool result = false;
+	// the first rebalancing replaces the initial, purely geometric tree
 	if(_clusteredHeterogeneouseSystems){
 		result = heteroDecompose(newRoot, newOwnLeaf, MPI_COMM_WORLD);
+	} else if (_incrementalRebalancing and _steps > 1) {
+		decomposeIncrementally(newRoot, _decompTree, newOwnLeaf, MPI_COMM_WORLD, calculateLoad(_ownArea));
 	} else {
 		result = decompose(newRoot, newOwnLeaf, MPI_COMM_WORLD);
 	}
@@ -935,6 +978,194 @@ bool KDDecomposition::decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm c
 }
 
 
+void KDDecomposition::decomposeIncrementally(KDNode* fatherNode, const KDNode* oldNode, KDNode*& ownArea, MPI_Comm commGroup,
+		double ownLoad) {
+	if (fatherNode->_numProcs == 1) {
+		// own area must belong to this process!
+		mardyn_assert(fatherNode->_owningProc == _rank);
+		ownArea = fatherNode;
+		fatherNode->calculateDeviation(&_processorSpeeds, _totalMeanProcessorSpeed);
+		return;
+	}
+	mardyn_assert(oldNode->_numProcs == fatherNode->_numProcs and oldNode->_child1 != nullptr);
+
+	// a subtree, which has not been moved by its ancestors and is still balanced, is kept as it is. This saves the
+	// cost calculation of all of its nodes, which dominates the rebalancing.
+	bool sameArea = true;
+	for (int d = 0; d < KDDIM; d++) {
+		sameArea = sameArea and fatherNode->_lowCorner[d] == oldNode->_lowCorner[d]
+				   and fatherNode->_highCorner[d] == oldNode->_highCorner[d];
+	}
+	if (sameArea) {
+		const double speed = _processorSpeeds.size() > static_cast<size_t>(_rank) ? _processorSpeeds[_rank] : 1.;
+		double maxLoadPerSpeed = ownLoad / speed;
+		double sums[2] = {ownLoad, speed};
+		MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, &maxLoadPerSpeed, 1, MPI_DOUBLE, MPI_MAX, commGroup) );
+		MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM, commGroup) );
+		const double meanLoadPerSpeed = sums[0] / sums[1];
+		const double subtreeImbalance = meanLoadPerSpeed > 0. ? maxLoadPerSpeed / meanLoadPerSpeed - 1. : 0.;
+		if (subtreeImbalance <= _incrementalImbalanceThreshold) {
+			if (fatherNode->_level == 0) {
+				fatherNode->_optimalLoadPerProcess = sums[0] / fatherNode->_numProcs;
+				Log::global_log->info() << "KDDecomposition: incremental rebalancing, imbalance " << subtreeImbalance
+								   << " below the threshold, keeping the tree" << std::endl;
+			}
+			fatherNode->_load = sums[0];
+			copySubtree(fatherNode, oldNode, ownArea, ownLoad);
+			double deviation = ownArea->_deviation;
+			MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, &deviation, 1, MPI_DOUBLE, _deviationReductionOperation, commGroup) );
+			fatherNode->_deviation = deviation;
+			return;
+		}
+	}
+
+	std::vector<std::vector<double> > costsLeft(3);
+	std::vector<std::vector<double> > costsRight(3);
+	calculateCostsPar(fatherNode, costsLeft, costsRight, commGroup);
+
+	const int dim = getSplitDimension(oldNode);
+	const int numProcsLeft = oldNode->_child1->_numProcs;
+	const int minIndex = KDDStaticValues::minNumCellsPerDimension - 1;
+	const int maxIndex = fatherNode->_highCorner[dim] - fatherNode->_lowCorner[dim] - KDDStaticValues::minNumCellsPerDimension;
+	if (maxIndex < minIndex) {
+		std::ostringstream error_message;
+		error_message << "KDDecomposition: incremental rebalancing produced a node that can not be split. "
+							"Please disable incrementalRebalancing." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	const int oldIndex = std::min(maxIndex, std::max(minIndex, oldNode->_child1->_highCorner[dim] - fatherNode->_lowCorner[dim]));
+
+	// load per processor speed of the two children
+	double speedLeft = numProcsLeft;
+	double speedRight = fatherNode->_numProcs - numProcsLeft;
+	if (not _accumulatedProcessorSpeeds.empty()) {
+		speedLeft = _accumulatedProcessorSpeeds[fatherNode->_owningProc + numProcsLeft] - _accumulatedProcessorSpeeds[fatherNode->_owningProc];
+		speedRight = _accumulatedProcessorSpeeds[fatherNode->_owningProc + fatherNode->_numProcs]
+					 - _accumulatedProcessorSpeeds[fatherNode->_owningProc + numProcsLeft];
+	}
+	const auto maxLoad = [&](int i) {
+		return std::max(costsLeft[dim][i] / speedLeft, costsRight[dim][i] / speedRight);
+	};
+	const double meanLoad = (costsLeft[dim][oldIndex] + costsRight[dim][oldIndex]) / (speedLeft + speedRight);
+	const double imbalance = meanLoad > 0. ? maxLoad(oldIndex) / meanLoad - 1. : 0.;
+
+	int index = oldIndex;
+	if (imbalance > _incrementalImbalanceThreshold) {
+		for (int i = std::max(minIndex, oldIndex - _incrementalMaxShift); i <= std::min(maxIndex, oldIndex + _incrementalMaxShift); ++i) {
+			if (maxLoad(i) < maxLoad(index)) {
+				index = i;
+			}
+		}
+	}
+
+	// the shifts of the ancestors may leave too few cells for the processes of a child, search outwards in that case
+	const auto trySplit = [&](int i) {
+		fatherNode->split(dim, fatherNode->_lowCorner[dim] + i, numProcsLeft);
+		if (fatherNode->_child1->isResolvable() and fatherNode->_child2->isResolvable()) {
+			return true;
+		}
+		delete fatherNode->_child1;
+		delete fatherNode->_child2;
+		fatherNode->_child1 = nullptr;
+		fatherNode->_child2 = nullptr;
+		return false;
+	};
+	bool resolvable = trySplit(index);
+	for (int distance = 1; not resolvable and distance <= maxIndex - minIndex; ++distance) {
+		for (int i : {index - distance, index + distance}) {
+			if (not resolvable and i >= minIndex and i <= maxIndex and trySplit(i)) {
+				index = i;
+				resolvable = true;
+			}
+		}
+	}
+	if (not resolvable) {
+		std::ostringstream error_message;
+		error_message << "KDDecomposition: incremental rebalancing found no valid split plane. "
+							"Please disable incrementalRebalancing." << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+
+	if (fatherNode->_level == 0) {
+		fatherNode->_optimalLoadPerProcess = (costsLeft[dim][index] + costsRight[dim][index]) / fatherNode->_numProcs;
+		fatherNode->_child1->_optimalLoadPerProcess = fatherNode->_optimalLoadPerProcess;
+		fatherNode->_child2->_optimalLoadPerProcess = fatherNode->_optimalLoadPerProcess;
+		Log::global_log->info() << "KDDecomposition: incremental rebalancing, imbalance of the root split: " << imbalance
+						   << ", shift: " << index - oldIndex << " cells" << std::endl;
+	}
+	fatherNode->_child1->_load = costsLeft[dim][index];
+	fatherNode->_child2->_load = costsRight[dim][index];
+	fatherNode->_load = costsLeft[dim][index] + costsRight[dim][index];
+
+	// continue in the subtree of this process, see decompose
+	const bool isLeft = _rank < fatherNode->_child2->_owningProc;
+	std::vector<int> origRanks(isLeft ? fatherNode->_child1->_numProcs : fatherNode->_child2->_numProcs);
+	for (size_t i = 0; i < origRanks.size(); i++) {
+		origRanks[i] = static_cast<int>(i) + (isLeft ? 0 : fatherNode->_child1->_numProcs);
+	}
+
+	MPI_Comm newComm;
+	MPI_Group origGroup, newGroup;
+	MPI_CHECK( MPI_Comm_group(commGroup, &origGroup) );
+	MPI_CHECK( MPI_Group_incl(origGroup, static_cast<int>(origRanks.size()), origRanks.data(), &newGroup) );
+	MPI_CHECK( MPI_Comm_create(commGroup, newGroup, &newComm) );
+
+	double deviationChildren[] = {0.0, 0.0};
+	if (isLeft) {
+		decomposeIncrementally(fatherNode->_child1, oldNode->_child1, ownArea, newComm, ownLoad);
+		deviationChildren[0] = fatherNode->_child1->_deviation;
+	} else {
+		decomposeIncrementally(fatherNode->_child2, oldNode->_child2, ownArea, newComm, ownLoad);
+		deviationChildren[1] = fatherNode->_child2->_deviation;
+	}
+
+	MPI_CHECK( MPI_Group_free(&origGroup) );
+	MPI_CHECK( MPI_Group_free(&newGroup) );
+	MPI_CHECK( MPI_Comm_free(&newComm) );
+	MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, deviationChildren, 2, MPI_DOUBLE, _deviationReductionOperation, commGroup) );
+	fatherNode->_child1->_deviation = deviationChildren[0];
+	fatherNode->_child2->_deviation = deviationChildren[1];
+	fatherNode->calculateDeviation();
+}
+
+void KDDecomposition::copySubtree(KDNode* fatherNode, const KDNode* oldNode, KDNode*& ownArea, double ownLoad) {
+	if (fatherNode->_numProcs == 1) {
+		mardyn_assert(fatherNode->_owningProc == _rank);
+		ownArea = fatherNode;
+		fatherNode->_load = ownLoad;
+		fatherNode->calculateDeviation(&_processorSpeeds, _totalMeanProcessorSpeed);
+		return;
+	}
+	const int dim = getSplitDimension(oldNode);
+	fatherNode->split(dim, oldNode->_child1->_highCorner[dim], oldNode->_child1->_numProcs);
+	fatherNode->_child1->_load = oldNode->_child1->_load;
+	fatherNode->_child2->_load = oldNode->_child2->_load;
+	if (_rank < fatherNode->_child2->_owningProc) {
+		copySubtree(fatherNode->_child1, oldNode->_child1, ownArea, ownLoad);
+	} else {
+		copySubtree(fatherNode->_child2, oldNode->_child2, ownArea, ownLoad);
+	}
+}
+
+double KDDecomposition::calculateLoad(const KDNode* area) {
+	// a copy with one process lets calculateCostsPar work on the whole area without communication
+	KDNode ownCopy(*area);
+	ownCopy._numProcs = 1;
+	std::vector<std::vector<double> > costsLeft(3);
+	std::vector<std::vector<double> > costsRight(3);
+	calculateCostsPar(&ownCopy, costsLeft, costsRight, MPI_COMM_SELF);
+	return costsLeft[0].back();
+}
+
+int KDDecomposition::getSplitDimension(const KDNode* node) {
+	// the split dimension is the one in which the first child is smaller than its father
+	int dim = 0;
+	while (dim < KDDIM - 1 and node->_child1->_highCorner[dim] == node->_highCorner[dim]) {
+		dim++;
+	}
+	return dim;
+}
+
 bool KDDecomposition::calculateAllPossibleSubdivisions(KDNode* node, std::list<KDNode*>& subdividedNodes, MPI_Comm commGroup) {
 	bool domainTooSmall = false;
 	std::vector<std::vector<double> > costsLeft(3);
@@ -1199,6 +1430,11 @@ void KDDecomposition::calculateCostsPar(KDNode* area, std::vector<std::vector<do
 					//_maxPars = std::max(_maxPars, numParts);
 					_maxPars = std::max(_maxPars, numParts1);
 					_maxPars2 = std::max(_maxPars2, numParts2);
+					if (_haveMeasuredCellCosts) {
+						// the cycles measured for a (base) cell already include the interactions with its neighbours
+						cellCosts[dim][i_dim] += _measuredCellCosts[getGlobalIndex(dim, dim1, dim2, i_dim, i_dim1, i_dim2, area)];
+						continue;
+					}
 					// #######################
 					// ## Cell Costs        ##
 					// #######################
@@ -1444,6 +1680,48 @@ void KDDecomposition::calcNumParticlesPerCell(ParticleContainer* moleculeContain
 	MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, _numParticlesPerCell.data(), _globalNumCells * _numParticleTypes, MPI_UNSIGNED, MPI_SUM, MPI_COMM_WORLD) );
 }
 
+void KDDecomposition::calcMeasuredCellCosts(ParticleContainer* moleculeContainer) {
+	std::vector<std::array<double, 3>> cellCenters;
+	std::vector<double> cellCycles;
+	// always read the measurements, so that they are reset for the next interval
+	moleculeContainer->getMeasuredCellCosts(cellCenters, cellCycles);
+
+	// only the C08 based traversals measure, auto-tuning may have selected another one on some process
+	int measured = moleculeContainer->measuresCellCosts() ? 1 : 0;
+	MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, &measured, 1, MPI_INT, MPI_MIN, _comm) );
+	if (not measured) {
+		_haveMeasuredCellCosts = false;
+		Log::global_log->info() << "KDDecomposition: the traversal does not measure the cell costs, "
+								   "using the cost model." << std::endl;
+		return;
+	}
+
+	_measuredCellCosts.assign(_globalNumCells, 0.);
+
+	double bBMin[3]; // boundingBoxMin
+	for (int dim = 0; dim < 3; dim++) {
+		bBMin[dim] = moleculeContainer->getBoundingBoxMin(dim);
+	}
+
+	// a halo base cell only computes pairs with cells of this process, so its cycles are charged to the adjacent
+	// boundary cell of this process rather than to the periodic image, which belongs to another process
+	for (size_t i = 0; i < cellCenters.size(); ++i) {
+		int globalCellIdx[3];
+		for (int dim = 0; dim < 3; dim++) {
+			const int localCellIndex = (int) floor((cellCenters[i][dim] - bBMin[dim]) / _cellSize[dim]);
+			globalCellIdx[dim] = std::min(_ownArea->_highCorner[dim],
+										  std::max(_ownArea->_lowCorner[dim], _ownArea->_lowCorner[dim] + localCellIndex));
+		}
+		_measuredCellCosts[_globalCellsPerDim[0] * (globalCellIdx[2] * _globalCellsPerDim[1] + globalCellIdx[1]) + globalCellIdx[0]] += cellCycles[i];
+	}
+	MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, _measuredCellCosts.data(), _globalNumCells, MPI_DOUBLE, MPI_SUM, _comm) );
+
+	const double totalCycles = std::accumulate(_measuredCellCosts.begin(), _measuredCellCosts.end(), 0.);
+	_haveMeasuredCellCosts = totalCycles > 0.;
+	Log::global_log->info() << "KDDecomposition: " << (_haveMeasuredCellCosts ? "using" : "no")
+					   << " measured cell costs (" << totalCycles << " cycles in total)." << std::endl;
+}
+
 std::vector<int> KDDecomposition::getNeighbourRanks() {
 	std::ostringstream error_message;
 	error_message << "KDDecomposition::getNeighbourRanks() not implemented" << std::endl;
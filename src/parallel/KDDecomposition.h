@@ -131,6 +131,25 @@ class KDDecomposition: public DomainDecompMPIBase {
 		 <!-- Option for MeasureLoad: Forces increasing values for the load estimation (more particles = more load).
 		      Default: True-->
 		 <measureLoadIncreasingTimeValues>BOOL</measureLoadIncreasingTimeValues>
+		 <!-- Balance on the CPU cycles of the force calculation measured per cell (time stamp counter) since the last
+		      rebalancing instead of estimating the costs from the particle counts. Requires a c08 based traversal
+		      (c08, c04, c08ws) and an x86 CPU, otherwise the particle counts are used. The first decomposition is
+		      always based on the particle counts.
+		      Default: False-->
+		 <useMeasuredCellCosts>BOOL</useMeasuredCellCosts>
+		 <!-- Rebalance incrementally: keep the split dimensions and process counts of the current tree and only shift
+		      the split planes of nodes whose imbalance exceeds incrementalImbalanceThreshold, by at most
+		      incrementalMaxShift cells per rebalancing. This bounds the number of migrated particles. The first
+		      rebalancing always constructs a new tree.
+		      Default: False-->
+		 <incrementalRebalancing>BOOL</incrementalRebalancing>
+		 <!-- Maximal number of cells a split plane is shifted per incremental rebalancing.
+		      Default: 1-->
+		 <incrementalMaxShift>INTEGER</incrementalMaxShift>
+		 <!-- Relative imbalance (max load per speed of the two children / mean load per speed - 1) above which the
+		      split plane of a node is shifted.
+		      Default: 0.05-->
+		 <incrementalImbalanceThreshold>DOUBLE</incrementalImbalanceThreshold>
 		 <!-- The reduction operation for the deviation calculation.
 		      Default: sum-->
 		 <deviationReductionOperation>max OR sum</deviationReductionOperation>
@@ -154,6 +173,10 @@ class KDDecomposition: public DomainDecompMPIBase {
 			ParticleContainer* moleculeContainer, Domain* domain,
 			unsigned int stageNumber) override;
 
+	// documentation in base class
+	void balanceAndExchangeInitNonBlocking(bool forceRebalancing, ParticleContainer* moleculeContainer,
+										   Domain* domain) override;
+
 	// documentation in base class
 	bool queryBalanceAndExchangeNonBlocking(bool forceRebalancing, ParticleContainer* moleculeContainer, Domain* domain, double etime) override;
 
@@ -203,6 +226,13 @@ private:
 
 	void calculateCostsPar(KDNode* area, std::vector<std::vector<double> >& costsLeft, std::vector<std::vector<double> >& costsRight, MPI_Comm commGroup);
 
+	/**
+	 * Collect the force calculation cycles measured per cell by the container into _measuredCellCosts
+	 * (global cell indices, summed over all processes). The cycles of halo cells are charged to the adjacent cell
+	 * of the own area. If the current traversal does not measure on all processes, the cost model is used instead.
+	 */
+	void calcMeasuredCellCosts(ParticleContainer* moleculeContainer);
+
 
 	//! @brief calculates the index of a certain cell in the global cell array
 	//!
@@ -271,6 +301,29 @@ private:
 
 	bool decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm commGroup, double globalMinimalDeviation);
 
+	/**
+	 * Incremental version of decompose: the split dimension and the number of processes of each node are taken
+	 * from the corresponding node of the old tree. The split plane is kept, unless the imbalance between the
+	 * children exceeds _incrementalImbalanceThreshold, in which case it is moved by at most _incrementalMaxShift
+	 * cells to the position with the smallest maximal load.
+	 * If the area of fatherNode is unchanged and the imbalance between the processes of the subtree does not exceed
+	 * _incrementalImbalanceThreshold, the whole subtree is copied from the old tree without calculating its costs.
+	 * @param fatherNode node to be split, covering the (possibly shifted) area of oldNode
+	 * @param oldNode node of the current decomposition tree with the same position in the tree
+	 * @param ownLoad load of the old area of this process, see calculateLoad
+	 */
+	void decomposeIncrementally(KDNode* fatherNode, const KDNode* oldNode, KDNode*& ownArea, MPI_Comm commGroup,
+								double ownLoad);
+
+	//! Split fatherNode and the nodes below it on the path to this process like oldNode, see decomposeIncrementally.
+	void copySubtree(KDNode* fatherNode, const KDNode* oldNode, KDNode*& ownArea, double ownLoad);
+
+	//! @return the costs of all cells of area, calculated by this process alone
+	double calculateLoad(const KDNode* area);
+
+	//! @return the dimension in which node is split into its children
+	static int getSplitDimension(const KDNode* node);
+
 	/**
 	 * Does the "cluster" heterogeneous decomposition
 	 *
@@ -340,11 +393,14 @@ private:
 	//! Number of particles for each cell (including halo?)
 	std::vector<unsigned int> _numParticlesPerCell;
 
-	/* TODO: This may not be equal to the number simulation steps if balanceAndExchange
-	 * is not called exactly once in every simulation step! */
-	//! number of simulation steps. Can be used to trigger load-balancing every _frequency steps
+	//! number of simulation steps, counted by balanceAndExchange and balanceAndExchangeInitNonBlocking.
+	//! Can be used to trigger load-balancing every _frequency steps
 	size_t _steps{0ul};
 
+	//! steps, in which MeasureLoad is set up and in which its loads are used for the first time
+	static constexpr size_t _measureLoadInitTimersStep{2ul};
+	static constexpr size_t _measureLoadStartStep{50ul};
+
 	//! determines how often rebalancing is done
 	int _frequency;
 
@@ -373,6 +429,15 @@ private:
 	int  _measureLoadInterpolationStartsAt{1};  // specifies at which number of particles per cell measureLoad should start using interpolation.
 	bool _measureLoadIncreasingTimeValues{true};  // specifies if the time values should be increasing if the number of particles increases.
 
+	bool _incrementalRebalancing{false};  // shift the split planes of the existing tree instead of constructing a new one.
+	int _incrementalMaxShift{1};  // maximal shift of a split plane in cells per rebalancing.
+	double _incrementalImbalanceThreshold{0.05};  // relative imbalance above which a split plane is shifted.
+
+	bool _useMeasuredCellCosts{false};  // specifies if the measured cycles per cell should be used as costs.
+	bool _cellCostMeasurementStarted{false};  // the container has been asked to measure the cycles.
+	bool _haveMeasuredCellCosts{false};  // _measuredCellCosts holds valid measurements.
+	std::vector<double> _measuredCellCosts;  // measured cycles for each global cell
+
 	/**
 	 * The decomposition only searches in all directions if _splitBiggest is false and the number of processors in a
 	 * node is less than the _splitThreshold.
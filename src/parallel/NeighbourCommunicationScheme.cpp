@@ -8,6 +8,7 @@ class NeighbourCommunicationScheme;
 class DirectNeighbourCommunicationScheme;
 class IndirectNeighbourCommunicationScheme;
 
+#include <map>
 #include <sstream>
 #include <mpi.h>
 
@@ -104,6 +105,16 @@ void DirectNeighbourCommunicationScheme::prepareNonBlockingStageImpl(ParticleCon
 		Domain* domain, unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates,
 		DomainDecompMPIBase* domainDecomp) {
 	mardyn_assert(stageNumber < getCommDims());
+	if (msgType == LEAVING_AND_HALO_COPIES) {
+		// as in exchangeMoleculesMPI, the leaving particles have to arrive before the halo copies are collected, so
+		// only the halo copies are non-blocking (see the documentation in the header)
+		global_simulation->timers()->start("SIMULATION_OVERLAP_LEAVING_EXCHANGE");
+		initExchangeMoleculesMPI(moleculeContainer, domain, LEAVING_ONLY, removeRecvDuplicates, domainDecomp, true);
+		finalizeExchangeMoleculesMPI(moleculeContainer, domain, LEAVING_ONLY, removeRecvDuplicates, domainDecomp);
+		moleculeContainer->deleteOuterParticles();
+		global_simulation->timers()->stop("SIMULATION_OVERLAP_LEAVING_EXCHANGE");
+		msgType = HALO_COPIES;
+	}
 	initExchangeMoleculesMPI(moleculeContainer, domain, msgType, removeRecvDuplicates, domainDecomp, true);
 }
 
@@ -111,6 +122,9 @@ void DirectNeighbourCommunicationScheme::finishNonBlockingStageImpl(ParticleCont
 		Domain* domain, unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates,
 		DomainDecompMPIBase* domainDecomp) {
 	mardyn_assert(stageNumber < getCommDims());
+	if (msgType == LEAVING_AND_HALO_COPIES) {
+		msgType = HALO_COPIES;
+	}
 	finalizeExchangeMoleculesMPI(moleculeContainer, domain, msgType, removeRecvDuplicates, domainDecomp);
 }
 
@@ -247,6 +261,10 @@ void DirectNeighbourCommunicationScheme::initExchangeMoleculesMPI(ParticleContai
 										  doHaloPositionCheck);
 		}
 	}
+	// partners on the same node only packed their messages, make them visible to the node
+	if (_sharedMemoryHalo) {
+		_sharedMemoryHalo->publish((*_neighbours)[0]);
+	}
 	if(not invalidParticles.empty()){
 		std::ostringstream error_message;
 		error_message << "NeighbourCommunicationScheme: Invalid particles that should have been "
@@ -316,6 +334,10 @@ void DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI(ParticleCo
 		// reset receive status
 		neighbor.resetReceive();
 	});
+	// messages from the same node are already complete, testRecv unpacks them without MPI
+	if (_sharedMemoryHalo) {
+		_sharedMemoryHalo->fetch((*_neighbours)[0]);
+	}
 
 	if (_pushPull) {
 		selectNeighbours(msgType, false /* export */);  // last selected is export
@@ -435,6 +457,31 @@ void NeighbourCommunicationScheme::selectNeighbours(MessageType msgType, bool im
 	}
 }
 
+void NeighbourCommunicationScheme::assignPartnerOptions() {
+	if (_persistentBufferSize == 0 and _haloDeltaInterval == 0) {
+		return;
+	}
+	for (auto* lists : {_neighbours, _haloExportForceImportNeighbours, _haloImportForceExportNeighbours,
+						_leavingExportNeighbours, _leavingImportNeighbours}) {
+		if (lists == nullptr) {
+			continue;
+		}
+		for (auto& partners : *lists) {
+			// all messages of one stage from a rank have the same tag, so if the rank has several partner objects,
+			// any of them can receive the message meant for another one, which breaks the halo delta and the sizes of
+			// the persistent buffers, which are tracked per partner
+			std::map<int, int> numPartnersPerRank;
+			for (auto& partner : partners) {
+				++numPartnersPerRank[partner.getRank()];
+			}
+			for (auto& partner : partners) {
+				const bool unique = numPartnersPerRank[partner.getRank()] == 1;
+				partner.setPersistentBufferSize(unique ? _persistentBufferSize : 0);
+				partner.setHaloDeltaInterval(unique ? _haloDeltaInterval : 0);
+			}
+		}
+	}
+}
 
 void DirectNeighbourCommunicationScheme::initCommunicationPartners(double cutoffRadius, Domain * domain,
 		DomainDecompMPIBase* domainDecomp, ParticleContainer* moleculeContainer) {
@@ -501,6 +548,36 @@ void DirectNeighbourCommunicationScheme::initCommunicationPartners(double cutoff
 		(*_neighbours)[0] = NeighborAcquirer::squeezePartners(commPartners);
 	}
 
+	if (_sharedMemoryHaloSize > 0) {
+		if (not _sharedMemoryHalo) {
+			_sharedMemoryHalo = std::make_unique<SharedMemoryHaloExchange>(domainDecomp->getCommunicator(),
+																			 _sharedMemoryHaloSize);
+		} else {
+			// all messages were exchanged, the partners are set up anew
+			_sharedMemoryHalo->grow();
+		}
+		if (_pushPull) {
+			assignSharedMemoryPartners((*_haloExportForceImportNeighbours)[0], domainDecomp->getRank());
+			assignSharedMemoryPartners((*_haloImportForceExportNeighbours)[0], domainDecomp->getRank());
+			assignSharedMemoryPartners((*_leavingExportNeighbours)[0], domainDecomp->getRank());
+			assignSharedMemoryPartners((*_leavingImportNeighbours)[0], domainDecomp->getRank());
+		} else {
+			assignSharedMemoryPartners((*_neighbours)[0], domainDecomp->getRank());
+		}
+	}
+	assignPartnerOptions();
+}
+
+void DirectNeighbourCommunicationScheme::assignSharedMemoryPartners(std::vector<CommunicationPartner>& partners,
+																	int ownRank) {
+	_sharedMemoryHalo->assignPartners(partners);
+	if (_useSequentialFallback) {
+		for (auto& partner : partners) {
+			if (partner.getRank() == ownRank) {
+				partner.setViaSharedMemory(false);
+			}
+		}
+	}
 }
 
 void IndirectNeighbourCommunicationScheme::initExchangeMoleculesMPI1D(ParticleContainer* moleculeContainer,
@@ -688,4 +765,5 @@ void IndirectNeighbourCommunicationScheme::initCommunicationPartners(double cuto
 	for (unsigned int d = 0; d < _commDimms; d++) {
 		(*_neighbours)[d]= NeighborAcquirer::squeezePartners((*_neighbours)[d]);
 	}
+	assignPartnerOptions();
 }
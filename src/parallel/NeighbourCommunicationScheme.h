@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "parallel/CommunicationPartner.h"
+#include "parallel/SharedMemoryHaloExchange.h"
 
 class DomainDecompMPIBase;
 class Domain;
@@ -84,6 +86,9 @@ public:
 			}
 		}
 		//std::cout << "post Neigh:" << totSize;
+		if (_sharedMemoryHalo) {
+			totSize += _sharedMemoryHalo->getDynamicSize();
+		}
 		return totSize;
 	}
 
@@ -93,7 +98,35 @@ public:
 		_useSequentialFallback = useSequentialFallback;
 	}
 
+	/**
+	 * Exchange the messages to partners on the same node via shared memory (only used by the direct scheme).
+	 * @param numBytes initial size of the shared memory of every process, 0 disables the exchange via shared memory
+	 */
+	void setSharedMemoryHaloSize(size_t numBytes) {
+		_sharedMemoryHaloSize = numBytes;
+	}
+
+	/**
+	 * Send and receive the messages with persistent requests of the given initial size, 0 disables them.
+	 * Partners, whose rank occurs more than once in the same neighbour list, do not use them.
+	 * @see CommunicationPartner::setPersistentBufferSize
+	 */
+	void setPersistentBufferSize(size_t numBytes) {
+		_persistentBufferSize = numBytes;
+	}
+
+	/**
+	 * Send the halo molecules as delta against the previous message, with a complete message every interval-th time.
+	 * Partners, whose rank occurs more than once in the same neighbour list, always send complete messages.
+	 * @see CommunicationPartner::setHaloDeltaInterval
+	 */
+	void setHaloDeltaInterval(unsigned interval) {
+		_haloDeltaInterval = interval;
+	}
+
 protected:
+	//! @brief Passes the persistent buffer size and the halo delta interval to all partners of the neighbour lists.
+	void assignPartnerOptions();
 
 	//! vector of neighbours. The first dimension should be of size getCommDims().
 	std::vector<std::vector<CommunicationPartner>> *_neighbours;
@@ -123,6 +156,15 @@ protected:
 	bool _pushPull;
 
 	bool _useSequentialFallback{true};
+
+	size_t _sharedMemoryHaloSize{0};
+
+	//! exchange with the partners on the same node, created by the first initCommunicationPartners if enabled
+	std::unique_ptr<SharedMemoryHaloExchange> _sharedMemoryHalo;
+
+	size_t _persistentBufferSize{0};
+
+	unsigned _haloDeltaInterval{0};
 };
 
 class DirectNeighbourCommunicationScheme: public NeighbourCommunicationScheme {
@@ -146,6 +188,13 @@ public:
 		return neighbourRanks;
 	}
 
+	/**
+	 * Start the non-blocking exchange of the halo copies.
+	 * For LEAVING_AND_HALO_COPIES, the leaving particles are exchanged blocking first: the halo copies are collected
+	 * from the own cells, so a particle has to be at its new owner before it can be sent as a halo copy. Only the
+	 * halo copies are overlapped with the force calculation. They are the bulk of the traffic, as they cover a layer
+	 * of the width of the cutoff radius, while only the particles that crossed a boundary in the last step leave.
+	 */
 	void prepareNonBlockingStageImpl(ParticleContainer* moleculeContainer, Domain* domain,
 			unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates,
 			DomainDecompMPIBase* domainDecomp) override;
@@ -164,6 +213,9 @@ protected:
 			bool /*removeRecvDuplicates*/, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck);
 
 private:
+	//! @brief Marks the partners on the same node, except for this process if the sequential fallback handles it.
+	void assignSharedMemoryPartners(std::vector<CommunicationPartner>& partners, int ownRank);
+
 	void doDirectFallBackExchange(const std::vector<HaloRegion>& haloRegions, MessageType msgType,
 								  DomainDecompMPIBase* domainDecomp, ParticleContainer*& moleculeContainer,
 								  std::vector<Molecule>& invalidParticles, bool doHaloPositionCheck);
@@ -65,6 +65,10 @@ void NonBlockingMPIHandlerBase::initBalanceAndExchange(bool forceRebalancing, do
 
 	_domainDecomposition->balanceAndExchange(etime, forceRebalancing, _moleculeContainer, _domain);
 
+	global_simulation->timers()->start("SIMULATION_BOUNDARY_TREATMENT");
+	_domainDecomposition->removeNonPeriodicHalos(_moleculeContainer);
+	global_simulation->timers()->stop("SIMULATION_BOUNDARY_TREATMENT");
+
 	// The cache of the molecules must be updated/build after the exchange process,
 	// as the cache itself isn't transferred
 	_moleculeContainer->updateMoleculeCaches();
@@ -38,18 +38,25 @@ void NonBlockingMPIMultiStepHandler::performComputation() {
 	for (unsigned int i = 0; i < static_cast<unsigned int>(stageCount); ++i) {
 #ifndef ADVANCED_OVERLAPPING
 		global_simulation->timers()->start("SIMULATION_DECOMPOSITION");
+		global_simulation->timers()->start("SIMULATION_OVERLAP_COMMUNICATION");
 		_domainDecomposition->prepareNonBlockingStage(false, _moleculeContainer, _domain, i);
+		global_simulation->timers()->stop("SIMULATION_OVERLAP_COMMUNICATION");
 		global_simulation->timers()->stop("SIMULATION_DECOMPOSITION");
 		// Force calculation and other pair interaction related computations
 		Log::global_log->debug() << "Traversing innermost cells" << std::endl;
 		global_simulation->timers()->start("SIMULATION_COMPUTATION");
 		global_simulation->timers()->start("SIMULATION_FORCE_CALCULATION");
+		global_simulation->timers()->start("SIMULATION_OVERLAP_COMPUTATION");
 		_moleculeContainer->traversePartialInnermostCells(*_cellProcessor, i, stageCount);
+		global_simulation->timers()->stop("SIMULATION_OVERLAP_COMPUTATION");
 		global_simulation->timers()->stop("SIMULATION_FORCE_CALCULATION");
 		global_simulation->timers()->stop("SIMULATION_COMPUTATION");
 
+		// the time spent here is the part of the communication, which was not hidden by the inner cells
 		global_simulation->timers()->start("SIMULATION_DECOMPOSITION");
+		global_simulation->timers()->start("SIMULATION_OVERLAP_COMMUNICATION");
 		_domainDecomposition->finishNonBlockingStage(false, _moleculeContainer, _domain, i);
+		global_simulation->timers()->stop("SIMULATION_OVERLAP_COMMUNICATION");
 		global_simulation->timers()->stop("SIMULATION_DECOMPOSITION");
 #else
 		omp_set_dynamic(0);
@@ -78,6 +85,10 @@ void NonBlockingMPIMultiStepHandler::performComputation() {
 #endif
 	}
 
+	global_simulation->timers()->start("SIMULATION_BOUNDARY_TREATMENT");
+	_domainDecomposition->removeNonPeriodicHalos(_moleculeContainer);
+	global_simulation->timers()->stop("SIMULATION_BOUNDARY_TREATMENT");
+
 	global_simulation->timers()->start("SIMULATION_DECOMPOSITION");
 	_moleculeContainer
 		->updateBoundaryAndHaloMoleculeCaches();  // update the caches of the other molecules (non-inner cells)
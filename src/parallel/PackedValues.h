@@ -0,0 +1,60 @@
+/*
+ * PackedValues.h
+ */
+
+#ifndef SRC_PARALLEL_PACKEDVALUES_H_
+#define SRC_PARALLEL_PACKEDVALUES_H_
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+#include <cstddef>
+#include <vector>
+
+//! @brief Contiguous buffers, into which values of different types are sorted by their type.
+//!
+//! A derived datatype would require a user defined reduce operation, which has to be
+//! created for every call and which prevents MPI from using its optimized (or hardware
+//! accelerated) reductions. Instead, the values are copied into one buffer per basic
+//! type, which are reduced with the built-in operations (one call per non-empty buffer).
+struct PackedValues {
+	//! int values of min and max reductions
+	std::vector<long> longs;
+	//! unsigned long values and int values of sums (the modular sum of the sign extended
+	//! values is exact)
+	std::vector<unsigned long> unsLongs;
+	//! double and float values
+	std::vector<double> doubles;
+	std::vector<long double> longDoubles;
+
+	bool empty() const {
+		return longs.empty() and unsLongs.empty() and doubles.empty() and longDoubles.empty();
+	}
+
+	size_t getTotalSize() const {
+		return longs.capacity() * sizeof(long) + unsLongs.capacity() * sizeof(unsigned long) +
+			   doubles.capacity() * sizeof(double) + longDoubles.capacity() * sizeof(long double);
+	}
+};
+
+#ifdef ENABLE_MPI
+//! @brief calls function(buffer, count, datatype) for each non-empty buffer of packed
+template <typename Function>
+void forEachPackedBuffer(PackedValues& packed, Function function) {
+	if (not packed.longs.empty()) {
+		function(packed.longs.data(), static_cast<int>(packed.longs.size()), MPI_LONG);
+	}
+	if (not packed.unsLongs.empty()) {
+		function(packed.unsLongs.data(), static_cast<int>(packed.unsLongs.size()), MPI_UNSIGNED_LONG);
+	}
+	if (not packed.doubles.empty()) {
+		function(packed.doubles.data(), static_cast<int>(packed.doubles.size()), MPI_DOUBLE);
+	}
+	if (not packed.longDoubles.empty()) {
+		function(packed.longDoubles.data(), static_cast<int>(packed.longDoubles.size()), MPI_LONG_DOUBLE);
+	}
+}
+#endif
+
+#endif /* SRC_PARALLEL_PACKEDVALUES_H_ */
@@ -0,0 +1,131 @@
+/*
+ * PluginReduction.cpp
+ */
+
+#include "parallel/PluginReduction.h"
+
+#include <type_traits>
+
+#include "parallel/DomainDecompBase.h"
+#include "utils/Logger.h"
+
+PluginReduction::~PluginReduction() {
+#ifdef ENABLE_MPI
+	if (_inFlight) {
+		MPI_Waitall(static_cast<int>(_requests.size()), _requests.data(), MPI_STATUSES_IGNORE);
+	}
+#endif
+}
+
+bool PluginReduction::isPending() const {
+	bool registered = not _callbacks.empty();
+	std::apply([&](const auto&... block) { ((registered = registered or not block.targets.empty()), ...); }, _blocks);
+	return _inFlight or registered;
+}
+
+void PluginReduction::start(DomainDecompBase* domainDecomp) {
+	if (_inFlight) {
+		complete(domainDecomp);
+	}
+	if (not isPending()) {
+		return;
+	}
+
+	std::swap(_blocks, _inFlightBlocks);
+	std::swap(_callbacks, _inFlightCallbacks);
+	pack();
+	_inFlight = true;
+
+#ifdef ENABLE_MPI
+	// rank 0 reduces in place, the other processes only send
+	MPI_Comm comm = domainDecomp->getCommunicator();
+	const bool root = domainDecomp->getRank() == 0;
+	_requests.clear();
+	forEachPackedBuffer(_packed, [&](void* buffer, int count, MPI_Datatype datatype) {
+		const void* sendBuffer = root ? MPI_IN_PLACE : buffer;
+#if MPI_VERSION >= 3
+		_requests.push_back(MPI_REQUEST_NULL);
+		MPI_CHECK(MPI_Ireduce(sendBuffer, buffer, count, datatype, MPI_SUM, 0, comm, &_requests.back()));
+#else
+		MPI_CHECK(MPI_Reduce(sendBuffer, buffer, count, datatype, MPI_SUM, 0, comm));
+#endif
+	});
+#endif
+}
+
+void PluginReduction::wait(DomainDecompBase* domainDecomp) {
+	if (_inFlight) {
+		complete(domainDecomp);
+	}
+	// arrays registered after the last start
+	if (isPending()) {
+		start(domainDecomp);
+		complete(domainDecomp);
+	}
+}
+
+void PluginReduction::complete(DomainDecompBase* domainDecomp) {
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_Waitall(static_cast<int>(_requests.size()), _requests.data(), MPI_STATUSES_IGNORE));
+	_requests.clear();
+#endif
+	if (domainDecomp->getRank() == 0) {
+		unpack();
+	}
+	_inFlight = false;
+
+	auto callbacks = std::move(_inFlightCallbacks);
+	_inFlightCallbacks.clear();
+	std::apply(
+		[](auto&... block) {
+			((block.values.clear(), block.targets.clear()), ...);
+		},
+		_inFlightBlocks);
+	for (auto& callback : callbacks) {
+		callback();
+	}
+}
+
+void PluginReduction::pack() {
+	auto& ints = std::get<Block<int>>(_inFlightBlocks).values;
+	auto& unsLongs = std::get<Block<unsigned long>>(_inFlightBlocks).values;
+	// the modular sum of the sign extended int values is exact
+	_packed.unsLongs.clear();
+	for (int value : ints) {
+		_packed.unsLongs.push_back(static_cast<unsigned long>(static_cast<long>(value)));
+	}
+	_packed.unsLongs.insert(_packed.unsLongs.end(), unsLongs.begin(), unsLongs.end());
+	_packed.doubles = std::get<Block<double>>(_inFlightBlocks).values;
+	_packed.longDoubles = std::get<Block<long double>>(_inFlightBlocks).values;
+	Log::global_log->debug() << "PluginReduction: packed " << _packed.unsLongs.size() << " integer, "
+							 << _packed.doubles.size() << " double and " << _packed.longDoubles.size()
+							 << " long double values" << std::endl;
+}
+
+void PluginReduction::unpack() {
+	auto scatter = [](const auto* position, auto& targets) {
+		for (auto& [global, count] : targets) {
+			for (size_t i = 0; i < count; ++i) {
+				global[i] = static_cast<std::remove_reference_t<decltype(*global)>>(*position++);
+			}
+		}
+	};
+	const unsigned long* integers = _packed.unsLongs.data();
+	std::vector<long> signedInts;
+	for (size_t i = 0; i < std::get<Block<int>>(_inFlightBlocks).values.size(); ++i) {
+		signedInts.push_back(static_cast<long>(*integers++));
+	}
+	scatter(signedInts.data(), std::get<Block<int>>(_inFlightBlocks).targets);
+	scatter(integers, std::get<Block<unsigned long>>(_inFlightBlocks).targets);
+	scatter(_packed.doubles.data(), std::get<Block<double>>(_inFlightBlocks).targets);
+	scatter(_packed.longDoubles.data(), std::get<Block<long double>>(_inFlightBlocks).targets);
+}
+
+size_t PluginReduction::getDynamicSize() const {
+	size_t size = _packed.getTotalSize();
+	auto blockSize = [](const auto&... block) {
+		return ((block.values.capacity() * sizeof(block.values[0]) +
+				 block.targets.capacity() * sizeof(block.targets[0])) + ...);
+	};
+	return size + std::apply(blockSize, _blocks) + std::apply(blockSize, _inFlightBlocks);
+}
@@ -0,0 +1,135 @@
+/*
+ * PluginReduction.h
+ */
+
+#ifndef SRC_PARALLEL_PLUGINREDUCTION_H_
+#define SRC_PARALLEL_PLUGINREDUCTION_H_
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "parallel/PackedValues.h"
+
+class DomainDecompBase;
+
+/**
+ * Shared reduction (sum to rank 0) of the sampling arrays of all plugins, which is overlapped with the computation of
+ * the following time step.
+ *
+ * Plugins register the arrays they want to reduce with add() during their endStep(). The local values are copied
+ * immediately, so the local arrays can be reset right after the call. Together with the arrays, a plugin registers a
+ * callback with onCompletion(), which writes its output. After all plugins finished their endStep(), the simulation
+ * sorts the values of all registered arrays by type into PackedValues and posts one MPI_Ireduce with the built-in
+ * MPI_SUM per non-empty buffer, usually two or three for all plugins together (start()). The
+ * simulation completes the reduction in the next time step, after the force calculation (wait()). Only then the
+ * global arrays are written on rank 0 and the callbacks are executed, in the order they were registered.
+ *
+ * Usage inside a plugin:
+ * @code
+ *   PluginReduction& reduction = global_simulation->getPluginReduction();
+ *   reduction.add(_localCounts.data(), _globalCounts.data(), _localCounts.size());
+ *   reduction.add(_localSums.data(), _globalSums.data(), _localSums.size());
+ *   reduction.onCompletion([this, simstep]() { writeOutput(simstep); });
+ *   resetLocalValues();
+ * @endcode
+ *
+ * The global arrays must stay valid and must not be read until the callback is executed. The global values are only
+ * valid on rank 0. All processes have to register the same arrays in the same order.
+ */
+class PluginReduction {
+public:
+	PluginReduction() = default;
+
+	~PluginReduction();
+
+	PluginReduction(const PluginReduction&) = delete;
+	PluginReduction& operator=(const PluginReduction&) = delete;
+
+	/**
+	 * @brief Registers an array for the next reduction.
+	 * @param local local values, copied during the call, may be the same as global
+	 * @param global receives the sum over all processes on rank 0, once the reduction is completed
+	 * @param count number of values
+	 */
+	void add(const int* local, int* global, size_t count) { addImpl(local, global, count); }
+	void add(const unsigned long* local, unsigned long* global, size_t count) { addImpl(local, global, count); }
+	void add(const double* local, double* global, size_t count) { addImpl(local, global, count); }
+	void add(const long double* local, long double* global, size_t count) { addImpl(local, global, count); }
+
+	//! @brief Registers a callback, which is executed on all processes after the reduction has been completed.
+	void onCompletion(std::function<void()> callback) { _callbacks.push_back(std::move(callback)); }
+
+	/**
+	 * @brief Posts the reduction of all arrays registered since the last call (collective).
+	 * @details Does nothing, if nothing was registered. If a reduction is still in flight, it is completed first.
+	 */
+	void start(DomainDecompBase* domainDecomp);
+
+	/**
+	 * @brief Completes the posted reduction, writes the global arrays on rank 0 and executes the callbacks.
+	 * @details Arrays registered after the last start() are reduced blocking. Can also be called by a plugin, which
+	 * needs its results earlier.
+	 */
+	void wait(DomainDecompBase* domainDecomp);
+
+	//! @return whether arrays or callbacks are registered that were not completed yet
+	bool isPending() const;
+
+	size_t getDynamicSize() const;
+
+private:
+	template <typename T>
+	struct Block {
+		//! local values of all registered arrays, back to back
+		std::vector<T> values;
+		//! start and length of the global arrays
+		std::vector<std::pair<T*, size_t>> targets;
+	};
+
+	using Blocks = std::tuple<Block<int>, Block<unsigned long>, Block<double>, Block<long double>>;
+
+	template <typename T>
+	void addImpl(const T* local, T* global, size_t count) {
+		auto& block = std::get<Block<T>>(_blocks);
+		const size_t offset = block.values.size();
+		block.values.resize(offset + count);
+		std::copy(local, local + count, block.values.begin() + offset);
+		block.targets.emplace_back(global, count);
+	}
+
+	//! @brief Completes the reduction in flight.
+	void complete(DomainDecompBase* domainDecomp);
+
+	//! @brief Copies the values of the blocks in flight to the type sorted buffers.
+	void pack();
+
+	//! @brief Writes the reduced values from the type sorted buffers to the global arrays of the blocks in flight.
+	void unpack();
+
+	//! arrays registered since the last start()
+	Blocks _blocks;
+	std::vector<std::function<void()>> _callbacks;
+
+	//! arrays and callbacks of the reduction in flight
+	Blocks _inFlightBlocks;
+	std::vector<std::function<void()>> _inFlightCallbacks;
+	bool _inFlight{false};
+
+	//! values of the reduction in flight, reduced in place on rank 0
+	PackedValues _packed;
+
+#ifdef ENABLE_MPI
+	//! one request per non-empty buffer of _packed
+	std::vector<MPI_Request> _requests;
+#endif
+};
+
+#endif /* SRC_PARALLEL_PLUGINREDUCTION_H_ */
@@ -0,0 +1,216 @@
+/*
+ * SharedMemoryHaloExchange.cpp
+ */
+
+#include "parallel/SharedMemoryHaloExchange.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+#include "parallel/CommunicationPartner.h"
+#include "utils/Logger.h"
+#include "utils/mardyn_assert.h"
+
+SharedMemoryHaloExchange::SharedMemoryHaloExchange(MPI_Comm comm, size_t capacity) : _comm(comm) {
+	MPI_CHECK(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &_nodeComm));
+	MPI_CHECK(MPI_Comm_rank(_nodeComm, &_nodeRank));
+	int numNodeProcs;
+	MPI_CHECK(MPI_Comm_size(_nodeComm, &numNodeProcs));
+
+	// translate all ranks of comm to node ranks
+	int numProcs;
+	MPI_CHECK(MPI_Comm_size(comm, &numProcs));
+	MPI_Group group, nodeGroup;
+	MPI_CHECK(MPI_Comm_group(comm, &group));
+	MPI_CHECK(MPI_Comm_group(_nodeComm, &nodeGroup));
+	std::vector<int> ranks(numProcs);
+	std::iota(ranks.begin(), ranks.end(), 0);
+	_nodeRanks.resize(numProcs);
+	MPI_CHECK(MPI_Group_translate_ranks(group, numProcs, ranks.data(), nodeGroup, _nodeRanks.data()));
+	MPI_CHECK(MPI_Group_free(&group));
+	MPI_CHECK(MPI_Group_free(&nodeGroup));
+
+	_segments.resize(numNodeProcs, nullptr);
+	_dataOffset = (slotWords + 1) * numNodeProcs * sizeof(std::uint64_t);
+	allocate(capacity);
+	Log::global_log->info() << "SharedMemoryHaloExchange: exchanging halos via shared memory between the "
+							<< numNodeProcs << " processes of a node, " << capacity << " bytes per process"
+							<< std::endl;
+}
+
+SharedMemoryHaloExchange::~SharedMemoryHaloExchange() {
+	if (_window != MPI_WIN_NULL) {
+		MPI_Win_unlock_all(_window);
+		MPI_Win_free(&_window);
+	}
+	if (_nodeComm != MPI_COMM_NULL) {
+		MPI_Comm_free(&_nodeComm);
+	}
+}
+
+void SharedMemoryHaloExchange::allocate(size_t capacity) {
+	if (_window != MPI_WIN_NULL) {
+		MPI_CHECK(MPI_Win_unlock_all(_window));
+		MPI_CHECK(MPI_Win_free(&_window));
+	}
+	// every segment is only written by its owner, so it may be placed in the memory close to the owner
+	MPI_Info info;
+	MPI_CHECK(MPI_Info_create(&info));
+	MPI_CHECK(MPI_Info_set(info, "alloc_shared_noncontig", "true"));
+	unsigned char* base;
+	MPI_CHECK(MPI_Win_allocate_shared(static_cast<MPI_Aint>(_dataOffset + capacity), 1, info, _nodeComm, &base,
+									  &_window));
+	MPI_CHECK(MPI_Info_free(&info));
+	MPI_CHECK(MPI_Win_lock_all(MPI_MODE_NOCHECK, _window));
+	_capacity = capacity;
+	for (size_t r = 0; r < _segments.size(); ++r) {
+		MPI_Aint size;
+		int dispUnit;
+		MPI_CHECK(MPI_Win_shared_query(_window, static_cast<int>(r), &size, &dispUnit, &_segments[r]));
+	}
+
+	// all sequence numbers start at 0 in the new window
+	std::memset(base, 0, _dataOffset);
+	_published.assign(_segments.size(), 0);
+	_acknowledged.assign(_segments.size(), 0);
+	_fetched.assign(_segments.size(), 0);
+	_largestPublished = 0;
+	MPI_CHECK(MPI_Win_sync(_window));
+	MPI_CHECK(MPI_Barrier(_nodeComm));
+	MPI_CHECK(MPI_Win_sync(_window));
+}
+
+std::uint64_t SharedMemoryHaloExchange::readFlag(int nodeRank, MPI_Aint displacement) const {
+	std::uint64_t value;
+	MPI_CHECK(MPI_Fetch_and_op(nullptr, &value, MPI_UINT64_T, nodeRank, displacement, MPI_NO_OP, _window));
+	MPI_CHECK(MPI_Win_flush(nodeRank, _window));
+	return value;
+}
+
+void SharedMemoryHaloExchange::writeFlag(MPI_Aint displacement, std::uint64_t value) const {
+	MPI_CHECK(MPI_Accumulate(&value, 1, MPI_UINT64_T, _nodeRank, displacement, 1, MPI_UINT64_T, MPI_REPLACE, _window));
+	MPI_CHECK(MPI_Win_flush(_nodeRank, _window));
+}
+
+void SharedMemoryHaloExchange::assignPartners(std::vector<CommunicationPartner>& partners) const {
+	for (auto& partner : partners) {
+		partner.setViaSharedMemory(isOnNode(partner.getRank()));
+	}
+}
+
+void SharedMemoryHaloExchange::grow() {
+	// every process has fetched all messages, when it enters the reduction
+	unsigned long required = _largestPublished;
+	MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &required, 1, MPI_UNSIGNED_LONG, MPI_MAX, _nodeComm));
+	if (required > _capacity) {
+		Log::global_log->info() << "SharedMemoryHaloExchange: enlarging the shared memory to "
+								<< required + required / 2 << " bytes per process" << std::endl;
+		allocate(required + required / 2);
+	}
+}
+
+void SharedMemoryHaloExchange::publish(std::vector<CommunicationPartner>& partners) {
+	// the receivers of the previous messages still read the data area until they acknowledge them
+	for (size_t receiver = 0; receiver < _segments.size(); ++receiver) {
+		while (_acknowledged[receiver] < _published[receiver]) {
+			_acknowledged[receiver] = readFlag(static_cast<int>(receiver), acknowledgementDisplacement(_nodeRank));
+		}
+	}
+
+	std::vector<std::vector<CommunicationPartner*>> messages(_segments.size());
+	for (auto& partner : partners) {
+		if (partner.isViaSharedMemory()) {
+			messages[_nodeRanks[partner.getRank()]].push_back(&partner);
+		}
+	}
+
+	// the messages for a receiver are stored contiguously, every one preceded by its size
+	unsigned char* segment = _segments[_nodeRank];
+	size_t offset = 0;
+	size_t required = 0;
+	for (size_t receiver = 0; receiver < _segments.size(); ++receiver) {
+		if (messages[receiver].empty()) {
+			continue;
+		}
+		std::uint64_t size = 0;
+		for (auto* partner : messages[receiver]) {
+			size += sizeof(std::uint64_t) + partner->getSendSize();
+		}
+		required += size;
+		auto* slot = reinterpret_cast<std::uint64_t*>(segment + slotDisplacement(static_cast<int>(receiver)));
+		if (offset + size <= _capacity) {
+			slot[1] = offset;
+			for (auto* partner : messages[receiver]) {
+				const std::uint64_t numBytes = partner->getSendSize();
+				std::memcpy(segment + _dataOffset + offset, &numBytes, sizeof(numBytes));
+				std::memcpy(segment + _dataOffset + offset + sizeof(numBytes), partner->getSendData(), numBytes);
+				offset += sizeof(numBytes) + numBytes;
+			}
+		} else {
+			slot[1] = viaMPI;
+			for (auto* partner : messages[receiver]) {
+				partner->sendPacked(_comm);
+			}
+		}
+		slot[2] = size;
+		slot[3] = messages[receiver].size();
+		++_published[receiver];
+	}
+	if (required > _capacity) {
+		Log::global_log->debug() << "SharedMemoryHaloExchange: " << required << " bytes do not fit into "
+								 << _capacity << " bytes of shared memory, sending the rest with MPI" << std::endl;
+	}
+	_largestPublished = std::max(_largestPublished, required);
+
+	// the messages and slots have to be visible before the sequence numbers
+	MPI_CHECK(MPI_Win_sync(_window));
+	for (size_t receiver = 0; receiver < _segments.size(); ++receiver) {
+		if (not messages[receiver].empty()) {
+			writeFlag(slotDisplacement(static_cast<int>(receiver)), _published[receiver]);
+		}
+	}
+}
+
+void SharedMemoryHaloExchange::fetch(std::vector<CommunicationPartner>& partners) {
+	// per sender: read position in its data area and number of messages handed out
+	std::map<int, std::pair<std::uint64_t, std::uint64_t>> positions;
+	for (auto& partner : partners) {
+		if (not partner.isViaSharedMemory()) {
+			continue;
+		}
+		const int sender = _nodeRanks[partner.getRank()];
+		const auto* slot = reinterpret_cast<const std::uint64_t*>(_segments[sender] + slotDisplacement(_nodeRank));
+		auto position = positions.find(sender);
+		if (position == positions.end()) {
+			const std::uint64_t expected = ++_fetched[sender];
+			while (readFlag(sender, slotDisplacement(_nodeRank)) < expected) {
+			}
+			MPI_CHECK(MPI_Win_sync(_window));
+			position = positions.emplace(sender, std::make_pair(slot[1], std::uint64_t(0))).first;
+		}
+		if (position->second.second++ >= slot[3]) {
+			std::ostringstream error_message;
+			error_message << "SharedMemoryHaloExchange: no message from rank " << partner.getRank()
+						  << " in shared memory." << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		if (slot[1] == viaMPI) {
+			// testRecv receives the message with MPI
+			continue;
+		}
+		const unsigned char* data = _segments[sender] + _dataOffset + position->second.first;
+		std::uint64_t numBytes;
+		std::memcpy(&numBytes, data, sizeof(numBytes));
+		partner.receiveFromSharedMemory(data + sizeof(numBytes), numBytes);
+		position->second.first += sizeof(numBytes) + numBytes;
+	}
+
+	// the senders may overwrite the messages
+	for (const auto& position : positions) {
+		writeFlag(acknowledgementDisplacement(position.first), _fetched[position.first]);
+	}
+}
@@ -0,0 +1,120 @@
+/*
+ * SharedMemoryHaloExchange.h
+ */
+
+#ifndef SRC_PARALLEL_SHAREDMEMORYHALOEXCHANGE_H_
+#define SRC_PARALLEL_SHAREDMEMORYHALOEXCHANGE_H_
+
+#include <mpi.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CommunicationPartner;
+
+/**
+ * Exchanges the messages of CommunicationPartners on the same node through an MPI shared memory window instead of
+ * point-to-point messages.
+ *
+ * Every process owns one segment of a window allocated with MPI_Win_allocate_shared on the node communicator. A
+ * segment starts with one slot per process of the node (sequence number, offset, size and number of the messages for
+ * this process) and one acknowledgement per process of the node, followed by the data area. In publish(), a process
+ * copies its packed messages into its data area, fills the slots of the receivers and increments their sequence
+ * numbers. In fetch(), a process waits for the sequence numbers of its senders, reads the messages in place from
+ * their segments and acknowledges them in its own segment. Before the data area is overwritten by the next publish(),
+ * the sender waits for the acknowledgements of its previous receivers. So only the processes which exchange messages
+ * synchronize, there are neither collectives nor barriers per exchange. The flags are accessed with MPI atomics.
+ *
+ * The segments have a fixed size. Messages for a receiver which do not fit into the rest of the data area are sent
+ * with MPI as for partners on other nodes, the slot tells the receiver to leave them to MPI. grow() enlarges the
+ * segments to the largest message set published so far.
+ */
+class SharedMemoryHaloExchange {
+public:
+	/**
+	 * @brief Splits comm into node communicators and allocates the window (collective).
+	 * @param comm communicator of the partner ranks, messages which do not fit are sent on comm
+	 * @param capacity initial size in bytes of the data area of every process
+	 */
+	SharedMemoryHaloExchange(MPI_Comm comm, size_t capacity);
+
+	~SharedMemoryHaloExchange();
+
+	SharedMemoryHaloExchange(const SharedMemoryHaloExchange&) = delete;
+	SharedMemoryHaloExchange& operator=(const SharedMemoryHaloExchange&) = delete;
+
+	//! @return whether rank (in the communicator of the constructor) is on the same node as this process
+	bool isOnNode(int rank) const { return _nodeRanks[rank] != MPI_UNDEFINED; }
+
+	//! @brief Marks all partners on the same node to communicate via shared memory.
+	void assignPartners(std::vector<CommunicationPartner>& partners) const;
+
+	/**
+	 * @brief Enlarges the data areas, if a process of the node published more bytes than fit (collective on the node).
+	 * @details All messages of previous exchanges have to be fetched.
+	 */
+	void grow();
+
+	/**
+	 * @brief Makes the packed send buffers of all shared memory partners visible to their receivers.
+	 * @param partners the partners for which CommunicationPartner::initSend was called
+	 */
+	void publish(std::vector<CommunicationPartner>& partners);
+
+	/**
+	 * @brief Hands the published messages for this process to the receiving partners.
+	 * @details Waits for the messages of all senders of partners. If a process is listed several times, the n-th
+	 * partner object gets the n-th message, as for MPI messages with the same tag. Messages which were sent with MPI
+	 * instead are left to CommunicationPartner::testRecv.
+	 */
+	void fetch(std::vector<CommunicationPartner>& partners);
+
+	//! @return size in bytes of the data area of every process
+	size_t getCapacity() const { return _capacity; }
+
+	size_t getDynamicSize() const {
+		return _dataOffset + _capacity + _nodeRanks.capacity() * sizeof(int) +
+			   (_published.capacity() + _acknowledged.capacity() + _fetched.capacity()) * sizeof(std::uint64_t);
+	}
+
+private:
+	//! words of a slot: sequence number, offset of the messages in the data area, their size, number of messages
+	static constexpr size_t slotWords = 4;
+	//! offset of the slot, which marks messages sent with MPI
+	static constexpr std::uint64_t viaMPI = UINT64_MAX;
+
+	//! @brief Replaces the window by one with data areas of capacity bytes (collective on the node).
+	void allocate(size_t capacity);
+
+	//! @return displacement of the slot for receiver in a segment
+	MPI_Aint slotDisplacement(int receiver) const { return receiver * slotWords * sizeof(std::uint64_t); }
+
+	//! @return displacement of the acknowledgement for sender in a segment
+	MPI_Aint acknowledgementDisplacement(int sender) const {
+		return (_segments.size() * slotWords + sender) * sizeof(std::uint64_t);
+	}
+
+	std::uint64_t readFlag(int nodeRank, MPI_Aint displacement) const;
+	void writeFlag(MPI_Aint displacement, std::uint64_t value) const;
+
+	MPI_Comm _comm;
+	MPI_Comm _nodeComm{MPI_COMM_NULL};
+	int _nodeRank{0};
+	//! node rank for every rank of the communicator, MPI_UNDEFINED for ranks on other nodes
+	std::vector<int> _nodeRanks;
+
+	MPI_Win _window{MPI_WIN_NULL};
+	//! size of the data area of every segment, the same on all processes of the node
+	size_t _capacity{0};
+	//! offset of the data area in a segment
+	size_t _dataOffset{0};
+	//! base addresses of the segments of all processes of the node
+	std::vector<unsigned char*> _segments;
+
+	//! per node rank: sequence number of the last messages published for / acknowledged by / fetched from it
+	std::vector<std::uint64_t> _published, _acknowledged, _fetched;
+	//! largest number of bytes published at once since the last grow()
+	size_t _largestPublished{0};
+};
+
+#endif /* SRC_PARALLEL_SHAREDMEMORYHALOEXCHANGE_H_ */
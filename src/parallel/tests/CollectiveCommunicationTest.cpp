@@ -145,4 +145,44 @@ void CollectiveCommunicationTest::testSingleIteration(CollectiveCommunicationInt
 	ASSERT_DOUBLES_EQUAL(1. * _commSize, val4, 1e-8);
 	ASSERT_DOUBLES_EQUAL(2.f * _commSize, val5, 1e-8);
 	ASSERT_DOUBLES_EQUAL(3. * _commSize, val6, 1e-8);
+
+	// allreduce with all types, repeated to reuse the cached layout of the type sorted buffers
+	for (int iteration = 0; iteration < 2; iteration++) {
+		collComm.init(MPI_COMM_WORLD, 5);
+		collComm.appendInt(-_rank - iteration);
+		collComm.appendLongDouble(0.5l);
+		collComm.appendUnsLong(2ul);
+		collComm.appendDouble(-1.5);
+		collComm.appendInt(1);
+		collComm.allreduceSum();
+		int val7 = collComm.getInt();
+		long double val8 = collComm.getLongDouble();
+		unsigned long val9 = collComm.getUnsLong();
+		double val10 = collComm.getDouble();
+		int val11 = collComm.getInt();
+		collComm.finalize();
+		ASSERT_EQUAL(-_commSize * (_commSize - 1) / 2 - iteration * _commSize, val7);
+		ASSERT_DOUBLES_EQUAL(0.5 * _commSize, static_cast<double>(val8), 1e-8);
+		ASSERT_EQUAL(2ul * _commSize, val9);
+		ASSERT_DOUBLES_EQUAL(-1.5 * _commSize, val10, 1e-8);
+		ASSERT_EQUAL(_commSize, val11);
+	}
+
+	// max and min with negative int values
+	collComm.init(MPI_COMM_WORLD, 2);
+	collComm.appendInt(-_rank);
+	collComm.appendDouble(static_cast<double>(_rank));
+	collComm.allreduceCustom(ReduceType::MIN);
+	int val12 = collComm.getInt();
+	double val13 = collComm.getDouble();
+	collComm.finalize();
+	ASSERT_EQUAL(-(_commSize - 1), val12);
+	ASSERT_DOUBLES_EQUAL(0., val13, 1e-8);
+
+	collComm.init(MPI_COMM_WORLD, 1);
+	collComm.appendInt(-_rank - 1);
+	collComm.allreduceCustom(ReduceType::MAX);
+	int val14 = collComm.getInt();
+	collComm.finalize();
+	ASSERT_EQUAL(-1, val14);
 }
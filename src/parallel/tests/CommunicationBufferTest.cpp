@@ -15,7 +15,10 @@
 #include "ensemble/EnsembleBase.h"
 #include "ensemble/CanonicalEnsemble.h"
 
+#include <algorithm>
+#include <array>
 #include <iostream>
+#include <vector>
 
 TEST_SUITE_REGISTRATION(CommunicationBufferTest);
 
@@ -301,3 +304,91 @@ void CommunicationBufferTest::testPackSendRecvUnpack() {
 
 	//MPI_Barrier(MPI_COMM_WORLD);
 }
+
+namespace {
+//! packs one leaving molecule and the halo molecules, encodes them against sentKeys and copies the raw bytes
+CommunicationBuffer sendHaloDelta(const Molecule& leaving, const std::vector<Molecule>& halo,
+								  std::vector<unsigned char>& sentKeys, bool refresh) {
+	CommunicationBuffer buf;
+	buf.resizeForAppendingLeavingMolecules(1);
+	buf.addLeavingMolecule(0, leaving);
+	buf.resizeForAppendingHaloMolecules(halo.size());
+	for (size_t i = 0; i < halo.size(); ++i) {
+		buf.addHaloMolecule(i, halo[i]);
+	}
+	buf.encodeHaloDelta(sentKeys, refresh);
+
+	CommunicationBuffer received;
+	received.resizeForRawBytes(buf.getNumElementsForSending());
+	std::copy(buf.getDataForSending(), buf.getDataForSending() + buf.getNumElementsForSending(),
+			  received.getDataForSending());
+	return received;
+}
+
+//! id and position of the molecules, sorted, as the order of the halo molecules is not kept
+std::vector<std::array<double, 4>> sortedRecords(const std::vector<Molecule>& molecules) {
+	std::vector<std::array<double, 4>> records;
+	for (const Molecule& m : molecules) {
+		records.push_back({static_cast<double>(m.getID()), m.r(0), m.r(1), m.r(2)});
+	}
+	std::sort(records.begin(), records.end());
+	return records;
+}
+}  // namespace
+
+void CommunicationBufferTest::testHaloDelta() {
+#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
+	global_simulation->getEnsemble()->addComponent(dummyComponent);
+	Component* component = global_simulation->getEnsemble()->getComponent(0);
+
+	const Molecule leaving(100, component, 1., 2., 3., -1., -2., -3.);
+	auto halo = [&](unsigned long id, double x) { return Molecule(id, component, x, x + 1., x + 2.); };
+
+	// molecule 3 is a periodic copy twice, 5 is removed later, 9 and 1 are added, 8 moves
+	const std::vector<std::vector<Molecule>> messages{
+		{halo(5, 0.5), halo(3, 1.5), halo(3, 11.5), halo(8, 2.5)},
+		{halo(3, 1.5), halo(8, 2.75), halo(9, 3.5), halo(3, 11.5), halo(1, 4.5)},
+		{halo(1, 4.5), halo(3, 1.5), halo(3, 11.5), halo(3, 21.5), halo(8, 3.)},
+		{halo(8, 3.25), halo(1, 4.5)},
+	};
+	const std::vector<bool> refresh{false, false, true, false};
+
+	std::vector<unsigned char> sentKeys, receivedKeys;
+	for (size_t n = 0; n < messages.size(); ++n) {
+		CommunicationBuffer buf = sendHaloDelta(leaving, messages[n], sentKeys, refresh[n]);
+		if (refresh[n]) {
+			// the receiver restarts from a refresh, whatever it received before
+			receivedKeys.clear();
+		}
+		ASSERT_TRUE(buf.decodeHaloDelta(receivedKeys));
+		ASSERT_TRUE(sentKeys == receivedKeys);
+
+		unsigned long numLeaving, numHalo;
+		buf.resizeForReceivingMolecules(numLeaving, numHalo);
+		ASSERT_EQUAL(1ul, numLeaving);
+		ASSERT_EQUAL(messages[n].size(), numHalo);
+
+		Molecule leavingRead;
+		buf.readLeavingMolecule(0, leavingRead);
+		ASSERT_EQUAL(leaving.getID(), leavingRead.getID());
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(leaving.v(d), leavingRead.v(d), 1e-16);
+		}
+		std::vector<Molecule> haloRead(numHalo);
+		for (unsigned long i = 0; i < numHalo; ++i) {
+			buf.readHaloMolecule(i, haloRead[i]);
+		}
+		ASSERT_TRUE(sortedRecords(messages[n]) == sortedRecords(haloRead));
+	}
+
+	// a message encoded against keys the receiver does not have is rejected
+	std::vector<unsigned char> otherKeys;
+	sendHaloDelta(leaving, messages[0], otherKeys, true);
+	CommunicationBuffer buf = sendHaloDelta(leaving, messages[1], otherKeys, false);
+	std::vector<unsigned char> noKeys;
+	ASSERT_TRUE(not buf.decodeHaloDelta(noKeys));
+	ASSERT_TRUE(not buf.decodeHaloDelta(receivedKeys));
+#endif
+}
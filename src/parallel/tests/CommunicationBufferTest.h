@@ -17,6 +17,7 @@ class CommunicationBufferTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testLeaving);
 	TEST_METHOD(testLeavingAndHalo);
 	TEST_METHOD(testPackSendRecvUnpack);
+	TEST_METHOD(testHaloDelta);
 	TEST_SUITE_END();
 
 public:
@@ -33,6 +34,12 @@ public:
 	void testLeavingAndHalo();
 
 	void testPackSendRecvUnpack();
+
+	/**
+	 * Encodes a sequence of messages with halo duplicates, kept, added and removed molecules and a refresh, decodes
+	 * them and compares the halo molecules. A message encoded against other keys than the receiver's is rejected.
+	 */
+	void testHaloDelta();
 };
 
 #endif /* SRC_PARALLEL_TESTS_COMMUNICATIONBUFFERTEST_H_ */
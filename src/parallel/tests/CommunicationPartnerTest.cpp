@@ -0,0 +1,84 @@
+/*
+ * CommunicationPartnerTest.cpp
+ */
+
+#include "CommunicationPartnerTest.h"
+
+#include "parallel/CommunicationPartner.h"
+
+#include <algorithm>
+#include <cstdint>
+
+TEST_SUITE_REGISTRATION(CommunicationPartnerTest);
+
+int CommunicationPartnerTest::exchange(CommunicationPartner& partner, size_t numBytes) {
+	partner._sendBuf.resizeForRawBytes(numBytes);
+	for (size_t i = 0; i < numBytes; ++i) {
+		partner._sendBuf.getDataForSending()[i] = static_cast<unsigned char>(i * 7 + numBytes);
+	}
+	partner.sendPacked(MPI_COMM_WORLD);
+
+	partner.resetReceive();
+	// the persistent receive is started without probing
+	ASSERT_TRUE(partner.iprobeCount(MPI_COMM_WORLD, partner._sendBuf.getMPIDataType()));
+	while (not partner.testPersistentRecv()) {
+	}
+	int numReceived;
+	MPI_Get_count(partner._recvStatus, partner._sendBuf.getMPIDataType(), &numReceived);
+	MPI_Wait(partner._recvRequest, partner._recvStatus);
+	while (not partner.testSend()) {
+	}
+
+	ASSERT_EQUAL(numBytes, partner._recvBuf.getNumElementsForSending());
+	for (size_t i = 0; i < numBytes; ++i) {
+		ASSERT_EQUAL(static_cast<unsigned char>(i * 7 + numBytes), partner._recvBuf.getDataForSending()[i]);
+	}
+	return numReceived;
+}
+
+void CommunicationPartnerTest::testPersistentFits() {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	CommunicationPartner partner(rank);
+	partner.setPersistentBufferSize(1024);
+
+	// the message and its size are sent in multiples of 1024 / 16 bytes
+	const unsigned char* recvData = nullptr;
+	for (auto numBytesAndSent : {std::make_pair(100ul, 128), std::make_pair(1016ul, 1024), std::make_pair(0ul, 64),
+								 std::make_pair(10ul, 64), std::make_pair(100ul, 128)}) {
+		ASSERT_EQUAL(numBytesAndSent.second, exchange(partner, numBytesAndSent.first));
+		ASSERT_EQUAL(1024ul, partner._persistentSendSize);
+		ASSERT_EQUAL(1024ul, partner._persistentRecvSize);
+		// the receive request stays bound to the same storage
+		if (recvData != nullptr) {
+			ASSERT_TRUE(recvData == partner._persistentRecvData);
+		}
+		recvData = partner._persistentRecvData;
+	}
+	// one persistent send request per used size class
+	const auto numSendRequests = std::count_if(partner._persistentSendRequests.begin(),
+											   partner._persistentSendRequests.end(),
+											   [](MPI_Request request) { return request != MPI_REQUEST_NULL; });
+	ASSERT_EQUAL(3l, static_cast<long>(numSendRequests));
+}
+
+void CommunicationPartnerTest::testPersistentOverflow() {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	CommunicationPartner partner(rank);
+	partner.setPersistentBufferSize(64);
+
+	// only the first part of the message is received by the persistent request
+	ASSERT_EQUAL(64, exchange(partner, 1000));
+	ASSERT_TRUE(partner._persistentSendSize >= sizeof(std::uint64_t) + 1000);
+	ASSERT_EQUAL(partner._persistentSendSize, partner._persistentRecvSize);
+
+	const size_t grownSize = partner._persistentRecvSize;
+	const size_t classSize = (grownSize + 15) / 16;
+	for (size_t numBytes : {1000ul, 10ul}) {
+		const size_t numBytesSent = (sizeof(std::uint64_t) + numBytes + classSize - 1) / classSize * classSize;
+		ASSERT_EQUAL(static_cast<int>(std::min(numBytesSent, grownSize)), exchange(partner, numBytes));
+		ASSERT_EQUAL(grownSize, partner._persistentSendSize);
+		ASSERT_EQUAL(grownSize, partner._persistentRecvSize);
+	}
+}
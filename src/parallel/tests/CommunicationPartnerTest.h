@@ -0,0 +1,45 @@
+/*
+ * CommunicationPartnerTest.h
+ */
+
+#ifndef SRC_PARALLEL_TESTS_COMMUNICATIONPARTNERTEST_H_
+#define SRC_PARALLEL_TESTS_COMMUNICATIONPARTNERTEST_H_
+
+#include "utils/Testing.h"
+
+#include <cstddef>
+
+class CommunicationPartner;
+
+class CommunicationPartnerTest : public utils::Test {
+	TEST_SUITE(CommunicationPartnerTest);
+	TEST_METHOD(testPersistentFits);
+	TEST_METHOD(testPersistentOverflow);
+	TEST_SUITE_END();
+
+public:
+	CommunicationPartnerTest() = default;
+
+	~CommunicationPartnerTest() override = default;
+
+	/**
+	 * Messages which fit into the persistent buffer are sent by the persistent request of their size class and
+	 * received in place, they leave the buffer size unchanged.
+	 */
+	void testPersistentFits();
+
+	/**
+	 * A message which does not fit arrives in two parts and enlarges the buffers of both directions, so that the next
+	 * message of this size fits.
+	 */
+	void testPersistentOverflow();
+
+private:
+	/**
+	 * Sends numBytes to the process itself with persistent requests and checks the received message.
+	 * @return number of bytes received by the persistent request
+	 */
+	int exchange(CommunicationPartner& partner, size_t numBytes);
+};
+
+#endif /* SRC_PARALLEL_TESTS_COMMUNICATIONPARTNERTEST_H_ */
@@ -17,6 +17,7 @@
 
 #include <sstream>
 #include <cmath>
+#include <limits>
 #include <string>
 #include <fstream>
 
@@ -484,6 +485,93 @@ void KDDecompositionTest::testbalanceAndExchange() {
 
 }
 
+void KDDecompositionTest::testIncrementalRebalancing() {
+
+	// INIT
+	const double boxL = 1241.26574;
+	const double cutOff = 26.4562;
+	int fullSearchThreshold = 2;
+
+	_domain->setGlobalLength(0, boxL);
+	_domain->setGlobalLength(1, boxL);
+	_domain->setGlobalLength(2, boxL);
+	KDDecomposition * kdd = new KDDecomposition(cutOff, 1, 1, fullSearchThreshold);
+	kdd->init(_domain);
+
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int i = 0; i < 3; i++) {
+		bBoxMin[i] = kdd->getBoundingBoxMin(i, _domain);
+		bBoxMax[i] = kdd->getBoundingBoxMax(i, _domain);
+	}
+#ifndef MARDYN_AUTOPAS
+	ParticleContainer * moleculeContainer = new LinkedCells(bBoxMin, bBoxMax, cutOff);
+#else
+	ParticleContainer * moleculeContainer = new AutoPasContainer(cutOff);
+	moleculeContainer->rebuild(bBoxMin, bBoxMax);
+#endif
+	moleculeContainer->update();
+	_rank = kdd->_rank;
+	srand(42);
+
+	// the first rebalancing constructs a new tree
+	kdd->_steps = 0;
+	kdd->_incrementalRebalancing = true;
+	kdd->_incrementalMaxShift = 2;
+	kdd->_incrementalImbalanceThreshold = 0.0;
+
+	// TEST
+	const int numReps = 5;
+	for (int i = 0; i < numReps; ++i) {
+		initCoeffs(_currentCoeffs);
+
+		KDNode * newDecompRoot = nullptr;
+		KDNode * newOwnLeaf = nullptr;
+		setNumParticlesPerCell(kdd->_numParticlesPerCell, kdd->_globalCellsPerDim);
+		kdd->constructNewTree(newDecompRoot, newOwnLeaf, moleculeContainer);
+		clearNumParticlesPerCell(kdd->_numParticlesPerCell, kdd->_globalNumCells);
+
+		if (kdd->_steps > 1) {
+			ASSERT_EQUAL(kdd->_ownArea->_nodeID, newOwnLeaf->_nodeID);
+			ASSERT_EQUAL(kdd->_ownArea->_owningProc, newOwnLeaf->_owningProc);
+			const KDNode * oldRoot = kdd->_decompTree;
+			if (oldRoot->_child1 != nullptr) {
+				ASSERT_EQUAL(oldRoot->_child1->_numProcs, newDecompRoot->_child1->_numProcs);
+				for (int dim = 0; dim < 3; ++dim) {
+					ASSERT_TRUE(std::abs(oldRoot->_child1->_highCorner[dim] - newDecompRoot->_child1->_highCorner[dim]) <= 2);
+				}
+			}
+		}
+
+		bool isOK = kdd->migrateParticles(*newDecompRoot, *newOwnLeaf, moleculeContainer, _domain);
+		ASSERT_TRUE(isOK);
+		delete kdd->_decompTree;
+		kdd->_decompTree = newDecompRoot;
+		kdd->_ownArea = newOwnLeaf;
+		kdd->_steps = 2;
+
+		_oldCoeffs = _currentCoeffs;
+		_currentCoeffs.clear();
+	}
+
+	// below the threshold, the tree is kept without calculating the costs of its nodes
+	kdd->_incrementalImbalanceThreshold = std::numeric_limits<double>::max();
+	initCoeffs(_currentCoeffs);
+	KDNode * keptRoot = nullptr;
+	KDNode * keptOwnLeaf = nullptr;
+	setNumParticlesPerCell(kdd->_numParticlesPerCell, kdd->_globalCellsPerDim);
+	kdd->constructNewTree(keptRoot, keptOwnLeaf, moleculeContainer);
+	clearNumParticlesPerCell(kdd->_numParticlesPerCell, kdd->_globalNumCells);
+	ASSERT_TRUE(keptRoot->equals(*kdd->_decompTree));
+	ASSERT_EQUAL(kdd->_ownArea->_nodeID, keptOwnLeaf->_nodeID);
+	delete keptRoot;
+	_currentCoeffs.clear();
+
+	// SHUTDOWN
+	delete moleculeContainer;
+	delete kdd;
+}
+
 void KDDecompositionTest::initCoeffs(std::vector<double>& c) const {
 	for (int i = 0; i < 10; ++i)
 		c.push_back(myRand(-1.0, 1.0));
@@ -24,6 +24,7 @@ class KDDecompositionTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testCompleteTreeInfo);
 	TEST_METHOD(testRebalancingDeadlocks);
 	TEST_METHOD(testbalanceAndExchange);
+	TEST_METHOD(testIncrementalRebalancing);
 	TEST_SUITE_END();
 
 public:
@@ -52,6 +53,12 @@ public:
 
 	void testbalanceAndExchange();
 
+	/**
+	 * Incremental rebalancing has to keep the structure of the tree and must not
+	 * shift a split plane by more than incrementalMaxShift cells.
+	 */
+	void testIncrementalRebalancing();
+
 private:
 
 	void testNoDuplicatedParticlesFilename(const char * filename, double cutoff, double domainLength);
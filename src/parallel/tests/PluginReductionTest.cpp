@@ -0,0 +1,89 @@
+/*
+ * PluginReductionTest.cpp
+ */
+
+#include "parallel/tests/PluginReductionTest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "parallel/DomainDecompBase.h"
+#include "parallel/PluginReduction.h"
+
+TEST_SUITE_REGISTRATION(PluginReductionTest);
+
+void PluginReductionTest::testReduce() {
+	const int rank = _domainDecomposition->getRank();
+	const int numProcs = _domainDecomposition->getNumProcs();
+	const size_t numValues = 5;
+
+	std::vector<int> localInts(numValues), globalInts(numValues, -1);
+	std::vector<unsigned long> localUnsLongs(numValues), globalUnsLongs(numValues, 0);
+	std::vector<double> localDoubles(numValues), globalDoubles(numValues, -1.);
+	std::vector<long double> localLongDoubles(numValues), globalLongDoubles(numValues, -1.);
+	for (size_t i = 0; i < numValues; ++i) {
+		localInts[i] = rank + static_cast<int>(i);
+		localUnsLongs[i] = 1;
+		localDoubles[i] = 0.5 * (rank + 1);
+		localLongDoubles[i] = i;
+	}
+
+	PluginReduction reduction;
+	std::vector<int> callbacks;
+	reduction.add(localInts.data(), globalInts.data(), numValues);
+	reduction.add(localDoubles.data(), globalDoubles.data(), numValues);
+	reduction.onCompletion([&]() { callbacks.push_back(1); });
+	reduction.add(localUnsLongs.data(), globalUnsLongs.data(), numValues);
+	reduction.add(localLongDoubles.data(), globalLongDoubles.data(), numValues);
+	reduction.onCompletion([&]() { callbacks.push_back(2); });
+
+	// the local values are copied on registration
+	std::fill(localInts.begin(), localInts.end(), 0);
+	std::fill(localDoubles.begin(), localDoubles.end(), 0.);
+
+	ASSERT_TRUE(reduction.isPending());
+	reduction.start(_domainDecomposition);
+	ASSERT_TRUE(callbacks.empty());
+	reduction.wait(_domainDecomposition);
+	ASSERT_TRUE(not reduction.isPending());
+
+	ASSERT_EQUAL(2ul, callbacks.size());
+	ASSERT_EQUAL(1, callbacks[0]);
+	ASSERT_EQUAL(2, callbacks[1]);
+
+	if (rank == 0) {
+		for (size_t i = 0; i < numValues; ++i) {
+			ASSERT_EQUAL(numProcs * (numProcs - 1) / 2 + numProcs * static_cast<int>(i), globalInts[i]);
+			ASSERT_EQUAL(static_cast<unsigned long>(numProcs), globalUnsLongs[i]);
+			ASSERT_DOUBLES_EQUAL(0.25 * numProcs * (numProcs + 1), globalDoubles[i], 1e-12);
+			ASSERT_DOUBLES_EQUAL(static_cast<double>(numProcs * i), static_cast<double>(globalLongDoubles[i]), 1e-12);
+		}
+	}
+}
+
+void PluginReductionTest::testOverlapWithNextRegistration() {
+	const int rank = _domainDecomposition->getRank();
+	const int numProcs = _domainDecomposition->getNumProcs();
+
+	PluginReduction reduction;
+	double first = 1., second = 2.;
+	double firstGlobal = 0., secondGlobal = 0.;
+	int numCallbacks = 0;
+
+	reduction.add(&first, &firstGlobal, 1);
+	reduction.onCompletion([&]() { ++numCallbacks; });
+	reduction.start(_domainDecomposition);
+
+	// registered while the first reduction is in flight
+	reduction.add(&second, &secondGlobal, 1);
+	reduction.onCompletion([&]() { ++numCallbacks; });
+	reduction.start(_domainDecomposition);
+	ASSERT_EQUAL(1, numCallbacks);
+
+	reduction.wait(_domainDecomposition);
+	ASSERT_EQUAL(2, numCallbacks);
+	if (rank == 0) {
+		ASSERT_DOUBLES_EQUAL(1. * numProcs, firstGlobal, 1e-12);
+		ASSERT_DOUBLES_EQUAL(2. * numProcs, secondGlobal, 1e-12);
+	}
+}
@@ -0,0 +1,33 @@
+/*
+ * PluginReductionTest.h
+ */
+
+#ifndef SRC_PARALLEL_TESTS_PLUGINREDUCTIONTEST_H_
+#define SRC_PARALLEL_TESTS_PLUGINREDUCTIONTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+class PluginReductionTest : public utils::TestWithSimulationSetup {
+	TEST_SUITE(PluginReductionTest);
+	TEST_METHOD(testReduce);
+	TEST_METHOD(testOverlapWithNextRegistration);
+	TEST_SUITE_END();
+
+public:
+	PluginReductionTest() = default;
+
+	~PluginReductionTest() override = default;
+
+	/**
+	 * Registers arrays of all supported types, resets the local arrays and checks the sums on rank 0 as well as the
+	 * execution of the callbacks.
+	 */
+	void testReduce();
+
+	/**
+	 * Registers new arrays while a reduction is in flight and checks, that both reductions deliver their own values.
+	 */
+	void testOverlapWithNextRegistration();
+};
+
+#endif /* SRC_PARALLEL_TESTS_PLUGINREDUCTIONTEST_H_ */
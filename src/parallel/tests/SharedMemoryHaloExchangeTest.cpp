@@ -0,0 +1,105 @@
+/*
+ * SharedMemoryHaloExchangeTest.cpp
+ */
+
+#include "SharedMemoryHaloExchangeTest.h"
+
+#include "parallel/CommunicationPartner.h"
+#include "parallel/SharedMemoryHaloExchange.h"
+
+#include <cstdint>
+#include <cstring>
+
+TEST_SUITE_REGISTRATION(SharedMemoryHaloExchangeTest);
+
+namespace {
+//! the n-th message from sender to receiver consists of 1 + sender + n + iteration values
+size_t messageLength(int sender, int n, int iteration) {
+	return 1 + sender + n + iteration;
+}
+
+std::uint64_t messageValue(int sender, int receiver, int n, int iteration) {
+	return ((static_cast<std::uint64_t>(sender) * 1000 + receiver) * 10 + n) * 10 + iteration;
+}
+
+//! two partners for every process of the node
+std::vector<CommunicationPartner> createPartners(const SharedMemoryHaloExchange& exchange) {
+	int numProcs;
+	MPI_Comm_size(MPI_COMM_WORLD, &numProcs);
+	std::vector<CommunicationPartner> partners;
+	for (int rank = 0; rank < numProcs; ++rank) {
+		if (exchange.isOnNode(rank)) {
+			partners.emplace_back(rank);
+			partners.emplace_back(rank);
+		}
+	}
+	exchange.assignPartners(partners);
+	return partners;
+}
+}  // namespace
+
+int SharedMemoryHaloExchangeTest::exchange(SharedMemoryHaloExchange& exchange,
+										   std::vector<CommunicationPartner>& partners, int iteration) {
+	int rank;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+	// pack the messages as initSend does for partners on the node
+	for (size_t p = 0; p < partners.size(); ++p) {
+		CommunicationPartner& partner = partners[p];
+		ASSERT_TRUE(partner.isViaSharedMemory());
+		const size_t length = messageLength(rank, p % 2, iteration);
+		const std::vector<std::uint64_t> values(length, messageValue(rank, partner.getRank(), p % 2, iteration));
+		partner._sendBuf.resizeForRawBytes(length * sizeof(std::uint64_t));
+		std::memcpy(partner._sendBuf.getDataForSending(), values.data(), length * sizeof(std::uint64_t));
+		partner._msgSent = true;
+	}
+	exchange.publish(partners);
+
+	int numViaSharedMemory = 0;
+	for (auto& partner : partners) {
+		partner.resetReceive();
+	}
+	exchange.fetch(partners);
+	for (size_t p = 0; p < partners.size(); ++p) {
+		CommunicationPartner& partner = partners[p];
+		if (partner._countReceived) {
+			++numViaSharedMemory;
+		} else {
+			while (not partner.iprobeCount(MPI_COMM_WORLD, partner._sendBuf.getMPIDataType())) {
+			}
+			MPI_Wait(partner._recvRequest, partner._recvStatus);
+		}
+		const size_t length = messageLength(partner.getRank(), p % 2, iteration);
+		ASSERT_EQUAL(length * sizeof(std::uint64_t), partner._recvBuf.getNumElementsForSending());
+		std::vector<std::uint64_t> values(length);
+		std::memcpy(values.data(), partner._recvBuf.getDataForSending(), length * sizeof(std::uint64_t));
+		for (std::uint64_t value : values) {
+			ASSERT_EQUAL(messageValue(partner.getRank(), rank, p % 2, iteration), value);
+		}
+	}
+	for (auto& partner : partners) {
+		if (not partner._msgSent) {
+			MPI_Wait(partner._sendRequest, partner._sendStatus);
+		}
+	}
+	return numViaSharedMemory;
+}
+
+void SharedMemoryHaloExchangeTest::testExchange() {
+	SharedMemoryHaloExchange sharedMemoryHalo(MPI_COMM_WORLD, 1 << 20);
+	std::vector<CommunicationPartner> partners = createPartners(sharedMemoryHalo);
+	for (int iteration = 0; iteration < 5; ++iteration) {
+		ASSERT_EQUAL(static_cast<int>(partners.size()), exchange(sharedMemoryHalo, partners, iteration));
+	}
+}
+
+void SharedMemoryHaloExchangeTest::testOverflow() {
+	SharedMemoryHaloExchange sharedMemoryHalo(MPI_COMM_WORLD, 0);
+	std::vector<CommunicationPartner> partners = createPartners(sharedMemoryHalo);
+	ASSERT_EQUAL(0, exchange(sharedMemoryHalo, partners, 0));
+
+	sharedMemoryHalo.grow();
+	ASSERT_TRUE(sharedMemoryHalo.getCapacity() > 0);
+	ASSERT_EQUAL(static_cast<int>(partners.size()), exchange(sharedMemoryHalo, partners, 0));
+	ASSERT_EQUAL(static_cast<int>(partners.size()), exchange(sharedMemoryHalo, partners, 1));
+}
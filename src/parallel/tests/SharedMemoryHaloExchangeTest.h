@@ -0,0 +1,45 @@
+/*
+ * SharedMemoryHaloExchangeTest.h
+ */
+
+#ifndef SRC_PARALLEL_TESTS_SHAREDMEMORYHALOEXCHANGETEST_H_
+#define SRC_PARALLEL_TESTS_SHAREDMEMORYHALOEXCHANGETEST_H_
+
+#include "utils/Testing.h"
+
+#include <vector>
+
+class CommunicationPartner;
+class SharedMemoryHaloExchange;
+
+class SharedMemoryHaloExchangeTest : public utils::Test {
+	TEST_SUITE(SharedMemoryHaloExchangeTest);
+	TEST_METHOD(testExchange);
+	TEST_METHOD(testOverflow);
+	TEST_SUITE_END();
+
+public:
+	SharedMemoryHaloExchangeTest() = default;
+
+	~SharedMemoryHaloExchangeTest() override = default;
+
+	/**
+	 * Every process sends two messages to every process of the node in several exchanges, which have to fit into
+	 * shared memory and arrive in order.
+	 */
+	void testExchange();
+
+	/**
+	 * Without shared memory, all messages have to arrive with MPI. After grow(), they have to fit into shared memory.
+	 */
+	void testOverflow();
+
+private:
+	/**
+	 * Exchanges the messages of one iteration and checks their contents.
+	 * @return number of messages received via shared memory
+	 */
+	int exchange(SharedMemoryHaloExchange& exchange, std::vector<CommunicationPartner>& partners, int iteration);
+};
+
+#endif /* SRC_PARALLEL_TESTS_SHAREDMEMORYHALOEXCHANGETEST_H_ */
@@ -11,11 +11,16 @@
 #include "utils/UnorderedVector.h"
 #include "utils/mardyn_assert.h"
 
+#include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
 
 
 FullParticleCell::FullParticleCell() :
-		_molecules(), _cellDataSoA(0, 0, 0, 0, 0) {
+		_molecules(), _cellDataSoA(0, 0, 0, 0, 0), _contentVersion(0),
+		_soaContentVersion(std::numeric_limits<unsigned long>::max()), _verletReferenceVersion(0),
+		_verletReferenceID(0), _verletInteractionLengthSquare(0.0) {
 }
 
 FullParticleCell::~FullParticleCell() {
@@ -26,6 +31,7 @@ FullParticleCell::~FullParticleCell() {
 
 void FullParticleCell::deallocateAllParticles() {
 	_molecules.clear();
+	++_contentVersion;
 }
 
 bool FullParticleCell::findMoleculeByID(size_t& index, unsigned long molid) const {
@@ -65,6 +71,9 @@ bool FullParticleCell::addParticle(Molecule& particle, bool checkWhetherDuplicat
 			wasInserted = true;
 		}
 	}
+	if (wasInserted) {
+		++_contentVersion;
+	}
 	return wasInserted;
 }
 
@@ -82,6 +91,7 @@ bool FullParticleCell::deleteMoleculeByIndex(size_t index) {
 
 	bool found = true;
 	UnorderedVector::fastRemove(_molecules, index);
+	++_contentVersion;
 	return found;
 }
 
@@ -140,22 +150,43 @@ void FullParticleCell::getRegion(double lowCorner[3], double highCorner[3], std:
 
 void FullParticleCell::buildSoACaches() {
 
-	// Determine the total number of centers.
 	size_t numMolecules = _molecules.size();
-	size_t nLJCenters = 0;
-	size_t nCharges = 0;
-	size_t nDipoles = 0;
-	size_t nQuadrupoles = 0;
 
-	for (size_t m = 0;  m < numMolecules; ++m) {
-		nLJCenters += _molecules[m].numLJcenters();
-		nCharges += _molecules[m].numCharges();
-		nDipoles += _molecules[m].numDipoles();
-		nQuadrupoles += _molecules[m].numQuadrupoles();
+	// The layout of the SoA (number and offsets of the centers) persists between steps. It can be
+	// reused, if no molecule was added or removed and no molecule changed its number of centers.
+	bool layoutValid = _soaContentVersion == _contentVersion and _cellDataSoA.getMolNum() == numMolecules;
+	for (size_t m = 0; layoutValid and m < numMolecules; ++m) {
+		layoutValid = _cellDataSoA._mol_ljc_num[m] == static_cast<int>(_molecules[m].numLJcenters())
+				and _cellDataSoA._mol_charges_num[m] == static_cast<int>(_molecules[m].numCharges())
+				and _cellDataSoA._mol_dipoles_num[m] == static_cast<int>(_molecules[m].numDipoles())
+				and _cellDataSoA._mol_quadrupoles_num[m] == static_cast<int>(_molecules[m].numQuadrupoles());
 	}
 
-	// Construct the SoA.
-	_cellDataSoA.resize(numMolecules,nLJCenters,nCharges,nDipoles,nQuadrupoles);
+	if (not layoutValid) {
+		// Determine the total number of centers.
+		size_t nLJCenters = 0;
+		size_t nCharges = 0;
+		size_t nDipoles = 0;
+		size_t nQuadrupoles = 0;
+
+		for (size_t m = 0;  m < numMolecules; ++m) {
+			nLJCenters += _molecules[m].numLJcenters();
+			nCharges += _molecules[m].numCharges();
+			nDipoles += _molecules[m].numDipoles();
+			nQuadrupoles += _molecules[m].numQuadrupoles();
+		}
+
+		// Construct the SoA.
+		_cellDataSoA.resize(numMolecules,nLJCenters,nCharges,nDipoles,nQuadrupoles);
+
+		for (size_t i = 0; i < numMolecules; ++i) {
+			_cellDataSoA._mol_ljc_num[i] = _molecules[i].numLJcenters();
+			_cellDataSoA._mol_charges_num[i] = _molecules[i].numCharges();
+			_cellDataSoA._mol_dipoles_num[i] = _molecules[i].numDipoles();
+			_cellDataSoA._mol_quadrupoles_num[i] = _molecules[i].numQuadrupoles();
+		}
+		_soaContentVersion = _contentVersion;
+	}
 
 	size_t iLJCenters = 0;
 	size_t iCharges = 0;
@@ -163,17 +194,8 @@ void FullParticleCell::buildSoACaches() {
 	size_t iQuadrupoles = 0;
 
 	// For each molecule iterate over all its centers.
-	for (size_t i = 0; i < _molecules.size(); ++i) {
+	for (size_t i = 0; i < numMolecules; ++i) {
 		Molecule & M = _molecules[i];
-		const size_t mol_ljc_num = M.numLJcenters();
-		const size_t mol_charges_num = M.numCharges();
-		const size_t mol_dipoles_num = M.numDipoles();
-		const size_t mol_quadrupoles_num = M.numQuadrupoles();
-
-		_cellDataSoA._mol_ljc_num[i] = mol_ljc_num;
-		_cellDataSoA._mol_charges_num[i] = mol_charges_num;
-		_cellDataSoA._mol_dipoles_num[i] = mol_dipoles_num;
-		_cellDataSoA._mol_quadrupoles_num[i] = mol_quadrupoles_num;
 
 		_cellDataSoA._mol_pos.x(i) = M.r(0);
 		_cellDataSoA._mol_pos.y(i) = M.r(1);
@@ -181,10 +203,10 @@ void FullParticleCell::buildSoACaches() {
 
 		M.setupSoACache(&_cellDataSoA, iLJCenters, iCharges, iDipoles, iQuadrupoles);
 
-		iLJCenters += mol_ljc_num;
-		iCharges += mol_charges_num;
-		iDipoles += mol_dipoles_num;
-		iQuadrupoles += mol_quadrupoles_num;
+		iLJCenters += _cellDataSoA._mol_ljc_num[i];
+		iCharges += _cellDataSoA._mol_charges_num[i];
+		iDipoles += _cellDataSoA._mol_dipoles_num[i];
+		iQuadrupoles += _cellDataSoA._mol_quadrupoles_num[i];
 
 		M.clearFM();
 	}
@@ -193,3 +215,135 @@ void FullParticleCell::buildSoACaches() {
 void FullParticleCell::increaseMoleculeStorage(size_t numExtraMols) {
 	_molecules.reserve(_molecules.size() + numExtraMols);
 }
+
+double FullParticleCell::updateVerletReference(double interactionLengthSquare, bool forceRebuild) {
+	const size_t numMolecules = _molecules.size();
+	const bool outdated = _verletReferenceID == 0 or _verletReferenceVersion != _contentVersion
+			or _verletInteractionLengthSquare != interactionLengthSquare;
+
+	if (forceRebuild or outdated) {
+		_verletReferencePositions.resize(3 * numMolecules);
+		for (size_t i = 0; i < numMolecules; ++i) {
+			for (int d = 0; d < 3; ++d) {
+				_verletReferencePositions[3 * i + d] = _molecules[i].r(d);
+			}
+		}
+		_verletReferenceVersion = _contentVersion;
+		_verletInteractionLengthSquare = interactionLengthSquare;
+		++_verletReferenceID;
+		_verletLists.clear();
+		return 0.0;
+	}
+
+	double maxDisplacementSquare = 0.0;
+	for (size_t i = 0; i < numMolecules; ++i) {
+		double displacementSquare = 0.0;
+		for (int d = 0; d < 3; ++d) {
+			const double dr = _molecules[i].r(d) - _verletReferencePositions[3 * i + d];
+			displacementSquare += dr * dr;
+		}
+		maxDisplacementSquare = std::max(maxDisplacementSquare, displacementSquare);
+	}
+	return maxDisplacementSquare;
+}
+
+void FullParticleCell::clearVerletReference() {
+	_verletReferencePositions.clear();
+	_verletLists.clear();
+	_verletReferenceID = 0;
+}
+
+const CellVerletList* FullParticleCell::getVerletList(const FullParticleCell& partner) {
+	if (isHaloCell() or partner.isHaloCell()) {
+		return nullptr;
+	}
+	const bool ownReferenceValid = _verletReferenceID != 0 and _verletReferenceVersion == _contentVersion;
+	const bool partnerReferenceValid = partner._verletReferenceID != 0 and partner._verletReferenceVersion == partner._contentVersion;
+	if (not ownReferenceValid or not partnerReferenceValid) {
+		return nullptr;
+	}
+
+	const unsigned long partnerIndex = partner.getCellIndex();
+	auto list = std::find_if(_verletLists.begin(), _verletLists.end(),
+			[partnerIndex](const CellVerletList& l) { return l.partnerCellIndex == partnerIndex; });
+	if (list == _verletLists.end()) {
+		_verletLists.emplace_back();
+		list = _verletLists.end() - 1;
+		list->partnerCellIndex = partnerIndex;
+		list->ownReferenceID = 0;
+		list->partnerReferenceID = 0;
+	} else if (list->ownReferenceID == _verletReferenceID and list->partnerReferenceID == partner._verletReferenceID) {
+		return &(*list);
+	}
+
+	// (re)build the list from the snapshots
+	const bool isSelf = (&partner == this);
+	const size_t numOwn = _verletReferencePositions.size() / 3;
+	const size_t numPartner = partner._verletReferencePositions.size() / 3;
+	const double * const ownPos = _verletReferencePositions.data();
+	const double * const partnerPos = partner._verletReferencePositions.data();
+
+	list->neighbourOffsets.resize(numOwn + 1);
+	list->neighbours.clear();
+	for (size_t i = 0; i < numOwn; ++i) {
+		list->neighbourOffsets[i] = list->neighbours.size();
+		for (size_t j = isSelf ? i + 1 : 0; j < numPartner; ++j) {
+			const double dx = ownPos[3 * i + 0] - partnerPos[3 * j + 0];
+			const double dy = ownPos[3 * i + 1] - partnerPos[3 * j + 1];
+			const double dz = ownPos[3 * i + 2] - partnerPos[3 * j + 2];
+			if (dx * dx + dy * dy + dz * dz < _verletInteractionLengthSquare) {
+				list->neighbours.push_back(j);
+			}
+		}
+	}
+	list->neighbourOffsets[numOwn] = list->neighbours.size();
+	list->ownReferenceID = _verletReferenceID;
+	list->partnerReferenceID = partner._verletReferenceID;
+	return &(*list);
+}
+
+void FullParticleCell::sortMoleculesAlongCurve(SpaceFillingCurve::CurveType curveType) {
+	const size_t numMolecules = _molecules.size();
+	if (numMolecules < 2 or curveType == SpaceFillingCurve::CurveType::NONE) {
+		return;
+	}
+
+	// map the positions onto a grid of 2^bits points per dimension inside the cell
+	const unsigned bits = 10;
+	const double gridPoints = static_cast<double>(1u << bits);
+	double scale[3];
+	for (int d = 0; d < 3; ++d) {
+		scale[d] = gridPoints / (getBoxMax(d) - getBoxMin(d));
+	}
+
+	std::vector<std::pair<uint64_t, size_t>> keys(numMolecules);
+	for (size_t i = 0; i < numMolecules; ++i) {
+		uint32_t coords[3];
+		for (int d = 0; d < 3; ++d) {
+			const double scaled = (_molecules[i].r(d) - getBoxMin(d)) * scale[d];
+			coords[d] = static_cast<uint32_t>(std::min(std::max(scaled, 0.0), gridPoints - 1.0));
+		}
+		keys[i] = std::make_pair(SpaceFillingCurve::key(curveType, coords[0], coords[1], coords[2], bits), i);
+	}
+	std::sort(keys.begin(), keys.end());
+
+	bool isSorted = true;
+	for (size_t i = 0; i < numMolecules; ++i) {
+		if (keys[i].second != i) {
+			isSorted = false;
+			break;
+		}
+	}
+	if (isSorted) {
+		return;
+	}
+
+	std::vector<Molecule> sortedMolecules;
+	sortedMolecules.reserve(_molecules.capacity());
+	for (const auto& key : keys) {
+		sortedMolecules.push_back(std::move(_molecules[key.second]));
+	}
+	_molecules.swap(sortedMolecules);
+	// indices of the molecules have changed
+	++_contentVersion;
+}
@@ -14,6 +14,22 @@
 #include "particleContainer/ParticleCellBase.h"
 #include "particleContainer/adapter/CellDataSoA.h"
 #include "SingleCellIterator.h"
+#include "utils/SpaceFillingCurve.h"
+
+/**
+ * \brief Verlet list of a cell with respect to one partner cell.
+ * \details Built from the position snapshots of both cells with interaction length cutoff + skin.
+ * Stores for every molecule i of the owning cell the (ascending) indices of the molecules of the
+ * partner cell within the interaction length in neighbours[neighbourOffsets[i], neighbourOffsets[i+1]).
+ * It stays valid as long as the content of both cells and their position snapshots do not change.
+ */
+struct CellVerletList {
+	unsigned long partnerCellIndex;
+	unsigned long ownReferenceID;
+	unsigned long partnerReferenceID;
+	std::vector<unsigned> neighbourOffsets;
+	std::vector<unsigned> neighbours;
+};
 
 //! @brief FullParticleCell data structure. Renamed from ParticleCell.
 //! @author Martin Buchholz
@@ -114,6 +130,44 @@ public:
 
 	bool findMoleculeByID(size_t& index, unsigned long molid) const override;
 
+	/**
+	 * \brief Counter of the structural changes (insertions, deletions) of this cell.
+	 * \details Data indexed by the position of a molecule in this cell (e.g. Verlet lists)
+	 * is only valid as long as this counter does not change.
+	 */
+	unsigned long getContentVersion() const {
+		return _contentVersion;
+	}
+
+	/**
+	 * \brief Update the position snapshot, which is used to build the Verlet lists of this cell.
+	 * \details A new snapshot is taken, if forced, if none exists or if the content of the cell
+	 * has changed since the last snapshot. Taking a snapshot invalidates all Verlet lists of this cell.
+	 * @param interactionLengthSquare squared interaction length (cutoff + skin) for new Verlet lists
+	 * @param forceRebuild take a new snapshot in any case
+	 * @return maximal squared displacement of a molecule since the snapshot (0.0 if a new one was taken)
+	 */
+	double updateVerletReference(double interactionLengthSquare, bool forceRebuild);
+
+	//! @brief Discard the position snapshot and all Verlet lists of this cell.
+	void clearVerletReference();
+
+	/**
+	 * \brief Get the Verlet list of this cell with respect to partner (which may be this cell itself).
+	 * \details The list is (re)built if it does not exist or is outdated.
+	 * For the cell itself only partners with a larger index are considered (cf. SingleCellPolicy_).
+	 * Halo cells never have lists, as their content changes in every time step.
+	 * @return nullptr, if either cell is a halo cell or has no valid position snapshot
+	 */
+	const CellVerletList* getVerletList(const FullParticleCell& partner);
+
+	/**
+	 * \brief Reorder the molecules of this cell along a space-filling curve through the cell.
+	 * \details Molecules which are close in space are then also close in memory.
+	 * Changes the content version, if the order changes.
+	 */
+	void sortMoleculesAlongCurve(SpaceFillingCurve::CurveType curveType);
+
 private:
 
 	void updateLeavingMolecules(FullParticleCell& otherCell);
@@ -133,6 +187,19 @@ private:
 	 * \author Johannes Heckl
 	 */
 	CellDataSoA _cellDataSoA;
+
+	unsigned long _contentVersion;
+	//! content version at the last (re)construction of the SoA layout
+	unsigned long _soaContentVersion;
+
+	//! positions (x,y,z interleaved) of the molecules at the last snapshot
+	std::vector<double> _verletReferencePositions;
+	//! content version at the last snapshot
+	unsigned long _verletReferenceVersion;
+	//! incremented with every new snapshot, 0 means no snapshot
+	unsigned long _verletReferenceID;
+	double _verletInteractionLengthSquare;
+	std::vector<CellVerletList> _verletLists;
 };
 
 #endif /* SRC_PARTICLECONTAINER_FULLPARTICLECELL_H_ */
@@ -35,8 +35,8 @@ public:
 	}
 
 	void traverseCellPairs(CellProcessor& cellProcessor);
-	void traverseCellPairsOuter(CellProcessor& cellProcessor) {}
-	void traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage, unsigned stageCount) {}
+	void traverseCellPairsOuter(CellProcessor& cellProcessor);
+	void traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage, unsigned stageCount);
 
 private:
 	void traverseCellPairsBackend(CellProcessor& cellProcessor,
@@ -74,6 +74,61 @@ inline void C04CellPairTraversal<CellTemplate>::traverseCellPairs(
 	traverseCellPairsBackend(cellProcessor, start, end);
 }
 
+template<class CellTemplate>
+inline void C04CellPairTraversal<CellTemplate>::traverseCellPairsOuter(
+		CellProcessor& cellProcessor) {
+	unsigned long minsize = std::min(this->_dims[0], std::min(this->_dims[1], this->_dims[2]));
+	if (minsize <= 5) {
+		// iterating in the inner region didn't do anything. Iterate normally.
+		traverseCellPairs(cellProcessor);
+		return;
+	}
+
+	// the base cells, which are not covered by traverseCellPairsInner, form six disjoint slabs:
+	// two in z direction, two in y direction without the z slabs and two in x direction without the y and z slabs
+	for (int d = 2; d >= 0; --d) {
+		std::array<long, 3> start, end;
+		for (int i = 0; i < 3; ++i) {
+			const long dim = static_cast<long>(this->_dims[i]);
+			start[i] = i > d ? 2l : 0l;
+			end[i] = i > d ? dim - 3 : dim - 1;
+		}
+		const long dim = static_cast<long>(this->_dims[d]);
+		end[d] = 2l;
+		traverseCellPairsBackend(cellProcessor, start, end);
+		start[d] = dim - 3;
+		end[d] = dim - 1;
+		traverseCellPairsBackend(cellProcessor, start, end);
+	}
+}
+
+template<class CellTemplate>
+inline void C04CellPairTraversal<CellTemplate>::traverseCellPairsInner(
+		CellProcessor& cellProcessor, unsigned stage, unsigned stageCount) {
+	unsigned long minsize = std::min(this->_dims[0], std::min(this->_dims[1], this->_dims[2]));
+	if (minsize <= 5) {
+		return;  // we can not iterate over any inner cells, that do not depend on boundary or halo cells
+	}
+
+	// same split as in the C08 traversal: base cells in [2, dims - 3) along the largest dimension
+	int splitdim = 0;
+	for (int d = 1; d < 3; ++d) {
+		if (this->_dims[d] > this->_dims[splitdim]) {
+			splitdim = d;
+		}
+	}
+	const long splitsize = static_cast<long>(this->_dims[splitdim]) - 5;
+
+	std::array<long, 3> start, end;
+	for (int d = 0; d < 3; ++d) {
+		start[d] = 2l;
+		end[d] = static_cast<long>(this->_dims[d]) - 3;
+	}
+	start[splitdim] = 2l + splitsize * stage / stageCount;
+	end[splitdim] = 2l + splitsize * (stage + 1) / stageCount;
+	traverseCellPairsBackend(cellProcessor, start, end);
+}
+
 template<class CellTemplate>
 void C04CellPairTraversal<CellTemplate>::computeOffsets32Pack() {
 	using threeDimensionalMapping::threeToOneD;
@@ -202,7 +257,7 @@ void C04CellPairTraversal<CellTemplate>::traverseSingleColor(CellProcessor& cell
 	long correctParity;
 	correctParity = parity(startOfThisColor[0], startOfThisColor[1], startOfThisColor[2]);
 	if (color >= 2) {
-		correctParity += 4;
+		correctParity = (correctParity + 4) % 8;
 	}
 
 	// to fix compiler complaints about perfectly nested loop.
@@ -8,6 +8,11 @@
 #ifndef SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08BASEDTRAVERSALS_H_
 #define SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08BASEDTRAVERSALS_H_
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define MARDYN_HAS_RDTSC 1
+#endif
+
 #include "particleContainer/LinkedCellTraversals/CellPairTraversals.h"
 #include "particleContainer/adapter/CellProcessor.h"
 #include "utils/threeDimensionalMapping.h"
@@ -32,6 +37,22 @@ public:
 		computeOffsets();
 	};
 
+	/**
+	 * If enabled, the time stamp counter is read before and after every base cell and the difference is added
+	 * to the entry of the base cell in cellCycles. The cycles of the 14 cell pairs of a base step thus end up in
+	 * one entry, which is only touched by one thread at a time.
+	 */
+	bool setMeasureCellCosts(std::vector<unsigned long long>* cellCycles) override {
+#ifdef MARDYN_HAS_RDTSC
+		_cellCycles = cellCycles;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool measuresCellCosts() const override { return _cellCycles != nullptr; }
+
 protected:
 	template <bool eighthShell=false>
 	void processBaseCell(CellProcessor& cellProcessor, unsigned long cellIndex) const;
@@ -39,6 +60,9 @@ protected:
 private:
 	void computeOffsets();
 
+	//! cycles per cell, nullptr if not measured
+	std::vector<unsigned long long>* _cellCycles = nullptr;
+
 	std::array<std::pair<unsigned long, unsigned long>, 14> _cellPairOffsets8Pack;
 	std::array<unsigned long, 8> _cellOffsets8Pack;
 };
@@ -63,6 +87,10 @@ void C08BasedTraversals<CellTemplate>::processBaseCell(CellProcessor& cellProces
 	}
 #endif
 
+#ifdef MARDYN_HAS_RDTSC
+	const unsigned long long startCycles = _cellCycles != nullptr ? __rdtsc() : 0ull;
+#endif
+
 	const int num_pairs = _cellPairOffsets8Pack.size();
 	for(int j = 0; j < num_pairs; ++j) {
 		std::pair<long, long> current_pair = _cellPairOffsets8Pack[j];
@@ -96,6 +124,12 @@ void C08BasedTraversals<CellTemplate>::processBaseCell(CellProcessor& cellProces
 			}
 		}
 	}
+
+#ifdef MARDYN_HAS_RDTSC
+	if (_cellCycles != nullptr) {
+		(*_cellCycles)[baseIndex] += __rdtsc() - startCycles;
+	}
+#endif
 }
 
 template<class CellTemplate>
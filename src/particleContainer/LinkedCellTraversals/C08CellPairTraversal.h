@@ -34,6 +34,9 @@ public:
 
 	bool requiresForceExchange() const override {return eighthShell;}
 
+	// the eighth shell variant skips the base cells at index 0, which the split into inner and outer base cells does not
+	bool supportsInnerOuterTraversal() const override {return not eighthShell;}
+
 private:
 	void traverseCellPairsBackend(CellProcessor& cellProcessor,
 			const std::array<unsigned long, 3> & start,
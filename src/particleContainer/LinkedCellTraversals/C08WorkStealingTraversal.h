@@ -0,0 +1,342 @@
+/*
+ * C08WorkStealingTraversal.h
+ *
+ * C08 traversal without color barriers: every base cell is a task, conflicting base cells are ordered
+ * by per-cell atomic dependency counters and idle threads steal ready tasks from the others.
+ */
+
+#ifndef SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08WORKSTEALINGTRAVERSAL_H_
+#define SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08WORKSTEALINGTRAVERSAL_H_
+
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "C08BasedTraversals.h"
+#include "utils/mardyn_assert.h"
+#include "utils/threeDimensionalMapping.h"
+#include "WrapOpenMP.h"
+
+struct C08WorkStealingTraversalData : CellPairTraversalData {
+};
+
+/**
+ * @brief C08 traversal scheduled by dependency counting and work stealing.
+ * @details The base cells (x, y, z) and (x', y', z') touch common cells iff they differ by at most one in every
+ * dimension. The plain C08 traversal separates such base cells by processing the eight colors
+ * (x % 2, y % 2, z % 2) one after the other with a barrier in between. Here, a base cell only waits for its
+ * conflicting neighbours of a lower color: each base cell holds an atomic counter of these unfinished
+ * predecessors and becomes ready once it drops to zero. Ready base cells are put into the queue of the thread
+ * that released them, threads without work steal from the queues of the other threads.
+ * A counter of the queued tasks lets idle threads skip the scan of the other queues while nothing can be stolen;
+ * they back off with pause instructions and eventually yield instead.
+ * Only the non eighth-shell variant is supported.
+ */
+template <class CellTemplate>
+class C08WorkStealingTraversal : public C08BasedTraversals<CellTemplate> {
+public:
+	C08WorkStealingTraversal(
+			std::vector<CellTemplate>& cells,
+			const std::array<unsigned long, 3>& dims) :
+			C08BasedTraversals<CellTemplate>(cells, dims), _remainingTasks(0), _pendingTasks(0) {
+		resizeCounters();
+		initQueues();
+	}
+
+	~C08WorkStealingTraversal() {
+		destroyQueues();
+	}
+
+	void rebuild(std::vector<CellTemplate> &cells,
+				 const std::array<unsigned long, 3> &dims, double cellLength[3], double cutoff,
+				 CellPairTraversalData *data) override {
+		C08BasedTraversals<CellTemplate>::rebuild(cells, dims, cellLength, cutoff, data);
+		resizeCounters();
+		if (_queues.size() != static_cast<size_t>(mardyn_get_max_threads())) {
+			destroyQueues();
+			initQueues();
+		}
+	}
+
+	void traverseCellPairs(CellProcessor& cellProcessor) override;
+	void traverseCellPairsOuter(CellProcessor& cellProcessor) override;
+	void traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage, unsigned stageCount) override;
+
+private:
+	//! task queue of one thread, aligned to avoid false sharing of the locks
+	struct alignas(64) TaskQueue {
+		mardyn_lock_t lock{};
+		std::deque<unsigned long> tasks;
+	};
+
+	/**
+	 * Process all base cells inside [lower, upper), except for those inside [excludeLower, excludeUpper).
+	 * Opens its own parallel region.
+	 */
+	void traverseCellPairsBackend(CellProcessor& cellProcessor,
+			const std::array<unsigned long, 3>& lower,
+			const std::array<unsigned long, 3>& upper,
+			const std::array<unsigned long, 3>& excludeLower,
+			const std::array<unsigned long, 3>& excludeUpper);
+
+	static int color(unsigned long x, unsigned long y, unsigned long z) {
+		return static_cast<int>((x & 1ul) + 2ul * (y & 1ul) + 4ul * (z & 1ul));
+	}
+
+	void push(int thread, unsigned long task);
+	bool pop(int thread, unsigned long& task);
+	bool steal(int thread, int numThreads, unsigned long& task);
+
+	/**
+	 * Wait a little before the next attempt to find a task. The waiting time doubles with every unsuccessful round,
+	 * after maxSpinRounds rounds the thread yields its core.
+	 * @param round number of consecutive unsuccessful rounds, incremented
+	 */
+	static void backoff(int& round) {
+		constexpr int maxSpinRounds = 6;
+		if (round < maxSpinRounds) {
+			for (int i = 0; i < (1 << round); ++i) {
+#if defined(__x86_64__) || defined(__i386__)
+				_mm_pause();
+#endif
+			}
+			++round;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+	void resizeCounters() {
+		// std::atomic is neither copyable nor movable, so the vector can not be resized in place
+		if (_dependencyCounters.size() != this->_cells->size()) {
+			_dependencyCounters = std::vector<std::atomic<int>>(this->_cells->size());
+		}
+	}
+
+	void initQueues() {
+		_queues = std::vector<TaskQueue>(mardyn_get_max_threads());
+		for (auto& queue : _queues) {
+			mardyn_init_lock(&queue.lock);
+		}
+	}
+
+	void destroyQueues() {
+		for (auto& queue : _queues) {
+			mardyn_destroy_lock(&queue.lock);
+		}
+		_queues.clear();
+	}
+
+	//! number of unfinished lower-color neighbours per base cell, indexed like the cells
+	std::vector<std::atomic<int>> _dependencyCounters;
+	std::vector<TaskQueue> _queues;
+	std::atomic<unsigned long> _remainingTasks;
+	//! number of ready tasks in all queues, lets idle threads avoid locking the queues while they are empty
+	std::atomic<unsigned long> _pendingTasks;
+};
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::traverseCellPairs(CellProcessor& cellProcessor) {
+	const std::array<unsigned long, 3> lower = {0, 0, 0};
+	const std::array<unsigned long, 3> upper = {this->_dims[0] - 1, this->_dims[1] - 1, this->_dims[2] - 1};
+	const std::array<unsigned long, 3> none = {0, 0, 0};
+	traverseCellPairsBackend(cellProcessor, lower, upper, none, none);
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::traverseCellPairsOuter(CellProcessor& cellProcessor) {
+	unsigned long minsize = std::min(this->_dims[0], std::min(this->_dims[1], this->_dims[2]));
+	if (minsize <= 5) {
+		// iterating in the inner region doesn't do anything. Iterate normally.
+		traverseCellPairs(cellProcessor);
+		return;
+	}
+
+	// everything except for the base cells covered by traverseCellPairsInner
+	const std::array<unsigned long, 3> lower = {0, 0, 0};
+	const std::array<unsigned long, 3> upper = {this->_dims[0] - 1, this->_dims[1] - 1, this->_dims[2] - 1};
+	const std::array<unsigned long, 3> innerLower = {2, 2, 2};
+	const std::array<unsigned long, 3> innerUpper = {this->_dims[0] - 3, this->_dims[1] - 3, this->_dims[2] - 3};
+	traverseCellPairsBackend(cellProcessor, lower, upper, innerLower, innerUpper);
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::traverseCellPairsInner(CellProcessor& cellProcessor, unsigned stage,
+																	unsigned stageCount) {
+	unsigned long splitdim = 0;
+	unsigned long maxcellsize = this->_dims[0];
+	for (unsigned long i = 1; i < 3; i++) {
+		if (this->_dims[i] > maxcellsize) {
+			splitdim = i;
+			maxcellsize = this->_dims[i];
+		}
+	}
+	unsigned long splitsize = maxcellsize - 5;
+	unsigned long minsize = std::min(this->_dims[0], std::min(this->_dims[1], this->_dims[2]));
+
+	mardyn_assert(minsize >= 4);  // there should be at least 4 cells in each dimension, otherwise we did something stupid!
+
+	if (minsize <= 5) {
+		return;  // we can not iterate over any inner cells, that do not depend on boundary or halo cells
+	}
+
+	std::array<unsigned long, 3> lower;
+	std::array<unsigned long, 3> upper;
+	for (unsigned long i = 0; i < 3; i++) {
+		lower[i] = 2;
+		upper[i] = this->_dims[i] - 3;
+	}
+	lower[splitdim] = 2 + splitsize * stage / stageCount;
+	upper[splitdim] = 2 + splitsize * (stage + 1) / stageCount;
+
+	const std::array<unsigned long, 3> none = {0, 0, 0};
+	traverseCellPairsBackend(cellProcessor, lower, upper, none, none);
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::traverseCellPairsBackend(CellProcessor& cellProcessor,
+		const std::array<unsigned long, 3>& lower, const std::array<unsigned long, 3>& upper,
+		const std::array<unsigned long, 3>& excludeLower, const std::array<unsigned long, 3>& excludeUpper) {
+
+	const std::array<unsigned long, 3> dims = this->_dims;
+	const auto isTask = [&](unsigned long x, unsigned long y, unsigned long z) {
+		const bool inside = x >= lower[0] and x < upper[0] and y >= lower[1] and y < upper[1] and z >= lower[2]
+							and z < upper[2];
+		const bool excluded = x >= excludeLower[0] and x < excludeUpper[0] and y >= excludeLower[1]
+							  and y < excludeUpper[1] and z >= excludeLower[2] and z < excludeUpper[2];
+		return inside and not excluded;
+	};
+
+	// visits all base cells of this traversal that conflict with (x, y, z) and have a lower (before = true) or
+	// higher (before = false) color
+	const auto forEachNeighbour = [&](unsigned long x, unsigned long y, unsigned long z, bool before, auto&& f) {
+		const int ownColor = color(x, y, z);
+		for (int dz = -1; dz <= 1; ++dz) {
+			for (int dy = -1; dy <= 1; ++dy) {
+				for (int dx = -1; dx <= 1; ++dx) {
+					// unsigned wrap-around of x + dx for x = 0 is rejected by isTask
+					const unsigned long nx = x + dx, ny = y + dy, nz = z + dz;
+					if ((dx == 0 and dy == 0 and dz == 0) or not isTask(nx, ny, nz)) {
+						continue;
+					}
+					const int neighbourColor = color(nx, ny, nz);
+					if ((before and neighbourColor < ownColor) or (not before and neighbourColor > ownColor)) {
+						f(threeDimensionalMapping::threeToOneD(nx, ny, nz, dims));
+					}
+				}
+			}
+		}
+	};
+
+	_remainingTasks = 0;
+	_pendingTasks = 0;
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		const int thread = mardyn_get_thread_num();
+		const int numThreads = mardyn_get_num_threads();
+		mardyn_assert(static_cast<size_t>(numThreads) <= _queues.size());
+
+		// set up the counters, the base cells without predecessors are the initial tasks
+		unsigned long numTasks = 0;
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static) collapse(3) nowait
+		#endif
+		for (unsigned long z = lower[2]; z < upper[2]; ++z) {
+			for (unsigned long y = lower[1]; y < upper[1]; ++y) {
+				for (unsigned long x = lower[0]; x < upper[0]; ++x) {
+					if (not isTask(x, y, z)) {
+						continue;
+					}
+					int numPredecessors = 0;
+					forEachNeighbour(x, y, z, true, [&](unsigned long) { ++numPredecessors; });
+					const unsigned long baseIndex = threeDimensionalMapping::threeToOneD(x, y, z, dims);
+					_dependencyCounters[baseIndex].store(numPredecessors, std::memory_order_relaxed);
+					if (numPredecessors == 0) {
+						push(thread, baseIndex);
+					}
+					++numTasks;
+				}
+			}
+		}
+		_remainingTasks.fetch_add(numTasks, std::memory_order_relaxed);
+		#if defined(_OPENMP)
+		#pragma omp barrier
+		#endif
+
+		unsigned long baseIndex;
+		int idleRounds = 0;
+		while (_remainingTasks.load(std::memory_order_acquire) > 0) {
+			if (not pop(thread, baseIndex) and not steal(thread, numThreads, baseIndex)) {
+				backoff(idleRounds);
+				continue;
+			}
+			idleRounds = 0;
+			this->template processBaseCell<false>(cellProcessor, baseIndex);
+
+			const std::array<unsigned long, 3> base = threeDimensionalMapping::oneToThreeD(baseIndex, dims);
+			forEachNeighbour(base[0], base[1], base[2], false, [&](unsigned long successor) {
+				if (_dependencyCounters[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+					push(thread, successor);
+				}
+			});
+			_remainingTasks.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	} // end pragma omp parallel
+}
+
+template<class CellTemplate>
+void C08WorkStealingTraversal<CellTemplate>::push(int thread, unsigned long task) {
+	TaskQueue& queue = _queues[thread];
+	mardyn_set_lock(&queue.lock);
+	queue.tasks.push_back(task);
+	// counted inside the lock, so that the task can not be taken before it is counted
+	_pendingTasks.fetch_add(1, std::memory_order_release);
+	mardyn_unset_lock(&queue.lock);
+}
+
+template<class CellTemplate>
+bool C08WorkStealingTraversal<CellTemplate>::pop(int thread, unsigned long& task) {
+	// the most recently released tasks are neighbours of the last processed base cell and still in the cache
+	TaskQueue& queue = _queues[thread];
+	bool found = false;
+	mardyn_set_lock(&queue.lock);
+	if (not queue.tasks.empty()) {
+		task = queue.tasks.back();
+		queue.tasks.pop_back();
+		_pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+		found = true;
+	}
+	mardyn_unset_lock(&queue.lock);
+	return found;
+}
+
+template<class CellTemplate>
+bool C08WorkStealingTraversal<CellTemplate>::steal(int thread, int numThreads, unsigned long& task) {
+	// the own queue has just been found empty, so there is nothing to steal if no task is pending
+	if (_pendingTasks.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+	for (int i = 1; i < numThreads; ++i) {
+		TaskQueue& queue = _queues[(thread + i) % numThreads];
+		mardyn_set_lock(&queue.lock);
+		if (not queue.tasks.empty()) {
+			task = queue.tasks.front();
+			queue.tasks.pop_front();
+			_pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+			mardyn_unset_lock(&queue.lock);
+			return true;
+		}
+		mardyn_unset_lock(&queue.lock);
+	}
+	return false;
+}
+
+#endif /* SRC_PARTICLECONTAINER_LINKEDCELLTRAVERSALS_C08WORKSTEALINGTRAVERSAL_H_ */
@@ -43,9 +43,20 @@ public:
 	// or does this traversal calculate all forces.
 	virtual bool requiresForceExchange() const {return false;}
 
+	// @brief Can the traversal be split into traverseCellPairsInner and traverseCellPairsOuter,
+	// which is required to overlap the halo communication with the force calculation.
+	virtual bool supportsInnerOuterTraversal() const { return true; }
+
 	// @brief Returns the maximum number of cells per cutoff this traversal supports.
 	virtual unsigned maxCellsInCutoff() const { return 1; }
 
+	// @brief Enable accumulating the CPU cycles of the force calculation per cell into cellCycles (one entry per
+	// cell), nullptr disables it. Returns false if the traversal does not support measuring.
+	virtual bool setMeasureCellCosts(std::vector<unsigned long long>* /*cellCycles*/) { return false; }
+
+	// @brief Does the traversal currently accumulate the CPU cycles per cell.
+	virtual bool measuresCellCosts() const { return false; }
+
 protected:
 	//TODO:
 	//void traverseCellPairsNoDep(CellProcessor& cellProcessor);
@@ -49,6 +49,8 @@ public:
 	// NT traversal requires force exchange!
 	bool requiresForceExchange() const override { return true; }
 
+	bool supportsInnerOuterTraversal() const override { return false; }
+
 	// NT has no upper limit for number of cells in cutoff!
 	unsigned maxCellsInCutoff() const override { return std::numeric_limits<unsigned>::max(); }
 
@@ -42,6 +42,8 @@ public:
 
     void traverseCellPairsInner(CellProcessor &cellProcessor, unsigned stage, unsigned stageCount);
 
+    bool supportsInnerOuterTraversal() const override { return false; }
+
 private:
     enum taskType {
         PackedAdjustable
@@ -118,6 +118,9 @@ void LinkedCells::initializeTraversal() {
 	for (int d = 0; d < 3; ++d) {
 		dims[d] = _cellsPerDimension[d];
 	}
+	if (_measureCellCosts) {
+		_cellForceCycles.assign(_cells.size(), 0ull);
+	}
 	_traversalTuner->rebuild(_cells, dims, _cellLength, _cutoffRadius);
 }
 
@@ -125,6 +128,41 @@ void LinkedCells::readXML(XMLfileUnits& xmlconfig) {
 	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // new
 	mardyn_assert(_cellsInCutoff>=1); // new
 
+	xmlconfig.getNodeValue("verletSkin", _verletSkin);
+	_verletRebuildFrequency = xmlconfig.getNodeValue_int("verletRebuildFrequency", _verletRebuildFrequency);
+	if (_verletSkin < 0.0) {
+		std::ostringstream error_message;
+		error_message << "LinkedCells: verletSkin must not be negative, got " << _verletSkin << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	if (_verletSkin > 0.0) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+		Log::global_log->info() << "LinkedCells: using Verlet lists with skin " << _verletSkin
+				<< " and rebuild frequency " << _verletRebuildFrequency << std::endl;
+#else
+		Log::global_log->warning() << "LinkedCells: Verlet lists not supported in reduced memory mode, ignoring verletSkin." << std::endl;
+		_verletSkin = 0.0;
+#endif
+	}
+
+	std::string sortCurve = xmlconfig.getNodeValue_string("sortCurve", "none");
+	_sortCurve = SpaceFillingCurve::curveTypeFromString(sortCurve);
+	if (_sortCurve == SpaceFillingCurve::CurveType::NONE and sortCurve != "none") {
+		std::ostringstream error_message;
+		error_message << "LinkedCells: unknown sortCurve " << sortCurve << ", possible values are none, morton and hilbert" << std::endl;
+		MARDYN_EXIT(error_message.str());
+	}
+	_sortFrequency = xmlconfig.getNodeValue_int("sortFrequency", _sortFrequency);
+	if (_sortCurve != SpaceFillingCurve::CurveType::NONE) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+		Log::global_log->info() << "LinkedCells: sorting molecules within cells along " << sortCurve
+				<< " curve every " << _sortFrequency << " updates" << std::endl;
+#else
+		Log::global_log->warning() << "LinkedCells: sorting along a curve not supported in reduced memory mode, ignoring sortCurve." << std::endl;
+		_sortCurve = SpaceFillingCurve::CurveType::NONE;
+#endif
+	}
+
 	_traversalTuner = std::unique_ptr<TraversalTuner<ParticleCell>>(new TraversalTuner<ParticleCell>()); // new way to assign _traversalTuner
 	_traversalTuner->readXML(xmlconfig);
 }
@@ -188,6 +226,13 @@ bool LinkedCells::rebuild(double bBoxMin[3], double bBoxMax[3]) {
 
 	initializeCells();
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	// Verlet lists refer to cell indices, which are no longer valid
+	for (auto& cell : _cells) {
+		cell.clearVerletReference();
+	}
+#endif
+
 	// TODO: We loose particles here as they are not communicated to the new owner
 	// delete all Particles which are outside of the halo region
 	deleteParticlesOutsideBox(_haloBoundingBoxMin, _haloBoundingBoxMax);
@@ -246,6 +291,13 @@ void LinkedCells::update() {
 	// TODO: replace via a cellProcessor and a traverseCells call ?
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 	update_via_copies();
+
+	if (_sortCurve != SpaceFillingCurve::CurveType::NONE and _sortFrequency > 0) {
+		if (++_updatesSinceSort >= _sortFrequency) {
+			sortMoleculesAlongCurve();
+			_updatesSinceSort = 0;
+		}
+	}
 #else
 //	update_via_coloring();
 	std::array<long unsigned, 3> dims = {
@@ -559,6 +611,11 @@ void LinkedCells::traversePartialInnermostCells(CellProcessor& cellProcessor, un
 		MARDYN_EXIT(error_message.str());
 	}
 
+	if (_verletSkin > 0.0 and stage == 0) {
+		// halo cells, which are filled later, have no Verlet lists
+		updateVerletReferences();
+	}
+
 	_traversalTuner->traverseCellPairsInner(cellProcessor, stage, stageCount);
 }
 
@@ -569,8 +626,18 @@ void LinkedCells::traverseCells(CellProcessor& cellProcessor) {
 		MARDYN_EXIT(error_message.str());
 	}
 
+	if (_verletSkin > 0.0) {
+		updateVerletReferences();
+	}
+
 	cellProcessor.initTraversal();
-	_traversalTuner->traverseCellPairs(cellProcessor);
+	// only the force calculation is tuned, the other cell processors (e.g. of plugins) do not run on all processes in
+	// the same time steps
+	if (global_simulation != nullptr and &cellProcessor == global_simulation->getCellProcessor()) {
+		_traversalTuner->tuneAndTraverseCellPairs(cellProcessor);
+	} else {
+		_traversalTuner->traverseCellPairs(cellProcessor);
+	}
 	cellProcessor.endTraversal();
 }
 
@@ -938,6 +1005,64 @@ void LinkedCells::getCellIndicesOfRegion(const double startRegion[3], const doub
 	endIndex = getCellIndexOfPoint(endRegion);
 }
 
+void LinkedCells::updateVerletReferences() {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	const double interactionLength = _cutoffRadius + _verletSkin;
+	const double interactionLengthSquare = interactionLength * interactionLength;
+	const double maxAllowedDisplacementSquare = 0.25 * _verletSkin * _verletSkin;
+	const bool rebuildDue = _verletRebuildFrequency > 0 and _traversalsSinceVerletRebuild >= _verletRebuildFrequency;
+	const size_t numCells = _cells.size();
+
+	double maxDisplacementSquare = 0.0;
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static) reduction(max:maxDisplacementSquare)
+	#endif
+	for (size_t cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+		// halo cells are refilled in every time step and have no Verlet lists
+		if (_cells[cellIndex].isHaloCell()) {
+			continue;
+		}
+		const double displacementSquare = _cells[cellIndex].updateVerletReference(interactionLengthSquare, rebuildDue);
+		maxDisplacementSquare = std::max(maxDisplacementSquare, displacementSquare);
+	}
+
+	if (maxDisplacementSquare > maxAllowedDisplacementSquare) {
+		Log::global_log->debug() << "LinkedCells: rebuilding Verlet lists after " << _traversalsSinceVerletRebuild
+				<< " traversals (maximal displacement " << std::sqrt(maxDisplacementSquare) << ")" << std::endl;
+		#if defined(_OPENMP)
+		#pragma omp parallel for schedule(static)
+		#endif
+		for (size_t cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+			if (_cells[cellIndex].isHaloCell()) {
+				continue;
+			}
+			_cells[cellIndex].updateVerletReference(interactionLengthSquare, true);
+		}
+		_traversalsSinceVerletRebuild = 0;
+	} else if (rebuildDue) {
+		_traversalsSinceVerletRebuild = 0;
+	}
+	++_traversalsSinceVerletRebuild;
+#endif
+}
+
+void LinkedCells::sortMoleculesAlongCurve() {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	const long numCells = static_cast<long>(_cells.size());
+
+	// halo cells are recreated before their molecules are used
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic, 16)
+	#endif
+	for (long cellIndex = 0; cellIndex < numCells; ++cellIndex) {
+		ParticleCell& cell = _cells[cellIndex];
+		if (not cell.isHaloCell()) {
+			cell.sortMoleculesAlongCurve(_sortCurve);
+		}
+	}
+#endif
+}
+
 unsigned long LinkedCells::initCubicGrid(std::array<unsigned long, 3> numMoleculesPerDimension, std::array<double, 3> simBoxLength) {
 	const unsigned long numCells = _cells.size();
 
@@ -1072,6 +1197,121 @@ double LinkedCells::getEnergy(ParticlePairsHandler* particlePairsHandler, Molecu
 	return u;
 }
 
+void LinkedCells::getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+							  std::vector<double>& energies, CellProcessor& cellProcessor) {
+	const size_t numTestMolecules = testMolecules.size();
+	energies.assign(numTestMolecules, 0.0);
+	if (numTestMolecules == 0) {
+		return;
+	}
+
+	const double cutoffRadiusSquare = cellProcessor.getCutoffRadiusSquare();
+	const double LJCutoffRadiusSquare = cellProcessor.getLJCutoffRadiusSquare();
+
+	// group the test molecules by cell
+	std::vector<std::pair<unsigned long, size_t>> cellOfTestMolecule(numTestMolecules);
+	for (size_t i = 0; i < numTestMolecules; ++i) {
+		const double r[3] = {testMolecules[i].r(0), testMolecules[i].r(1), testMolecules[i].r(2)};
+		cellOfTestMolecule[i] = std::make_pair(getCellIndexOfPoint(r), i);
+	}
+	std::sort(cellOfTestMolecule.begin(), cellOfTestMolecule.end());
+	std::vector<size_t> groupStarts;
+	for (size_t i = 0; i < numTestMolecules; ++i) {
+		if (i == 0 or cellOfTestMolecule[i].first != cellOfTestMolecule[i - 1].first) {
+			groupStarts.push_back(i);
+		}
+	}
+	groupStarts.push_back(numTestMolecules);
+
+	// same order of the cells as in getEnergy(): own cell, forward neighbours, backward neighbours
+	std::vector<long> forwardNeighbourOffsets;
+	std::vector<long> backwardNeighbourOffsets;
+	calculateNeighbourIndices(forwardNeighbourOffsets, backwardNeighbourOffsets);
+	std::vector<long> neighbourOffsets(1, 0);
+	neighbourOffsets.insert(neighbourOffsets.end(), forwardNeighbourOffsets.begin(), forwardNeighbourOffsets.end());
+	for (long offset : backwardNeighbourOffsets) {
+		neighbourOffsets.push_back(-offset);
+	}
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		// molecules of the neighbour cells of the current group and their center of mass positions
+		std::vector<Molecule*> neighbours;
+		std::vector<double> neighbourX, neighbourY, neighbourZ, distanceSquare;
+		// end of each neighbour cell in the arrays above
+		std::vector<size_t> cellEnds;
+
+		#if defined(_OPENMP)
+		#pragma omp for schedule(dynamic)
+		#endif
+		for (size_t group = 0; group < groupStarts.size() - 1; ++group) {
+			const unsigned long cellIndex = cellOfTestMolecule[groupStarts[group]].first;
+			mardyn_assert(not _cells[cellIndex].isHaloCell());
+
+			neighbours.clear();
+			neighbourX.clear();
+			neighbourY.clear();
+			neighbourZ.clear();
+			cellEnds.clear();
+			for (long offset : neighbourOffsets) {
+				ParticleCell& neighbourCell = _cells[cellIndex + offset];
+				for (auto it = neighbourCell.iterator(); it.isValid(); ++it) {
+					neighbours.push_back(&(*it));
+					neighbourX.push_back(it->r(0));
+					neighbourY.push_back(it->r(1));
+					neighbourZ.push_back(it->r(2));
+				}
+				cellEnds.push_back(neighbours.size());
+			}
+			const size_t numNeighbours = neighbours.size();
+			distanceSquare.resize(numNeighbours);
+			const double* const x2 = neighbourX.data();
+			const double* const y2 = neighbourY.data();
+			const double* const z2 = neighbourZ.data();
+			double* const dd = distanceSquare.data();
+
+			for (size_t i = groupStarts[group]; i < groupStarts[group + 1]; ++i) {
+				const size_t testIndex = cellOfTestMolecule[i].second;
+				Molecule molWithSoA = testMolecules[testIndex];
+				molWithSoA.buildOwnSoA();
+				const double x1 = molWithSoA.r(0);
+				const double y1 = molWithSoA.r(1);
+				const double z1 = molWithSoA.r(2);
+
+				#pragma omp simd
+				for (size_t j = 0; j < numNeighbours; ++j) {
+					const double dx = x1 - x2[j];
+					const double dy = y1 - y2[j];
+					const double dz = z1 - z2[j];
+					dd[j] = dx * dx + dy * dy + dz * dz;
+				}
+
+				double u = 0.0;
+				size_t j = 0;
+				for (size_t cellEnd : cellEnds) {
+					double uCell = 0.0;
+					for (; j < cellEnd; ++j) {
+						if (dd[j] < cutoffRadiusSquare and neighbours[j]->getID() != molWithSoA.getID()) {
+							double distanceVector[3] = {x1 - x2[j], y1 - y2[j], z1 - z2[j]};
+							uCell += particlePairsHandler->processPair(molWithSoA, *neighbours[j], distanceVector,
+																	   MOLECULE_MOLECULE_FLUID, dd[j],
+																	   (dd[j] < LJCutoffRadiusSquare));
+						}
+					}
+					u += uCell;
+				}
+
+				molWithSoA.releaseOwnSoA();
+
+				mardyn_assert(not std::isnan(u)); // catches NaN
+				energies[testIndex] = u;
+			}
+		}
+	}
+}
+
 void LinkedCells::updateInnerMoleculeCaches() {
 	#if defined(_OPENMP)
 	#pragma omp parallel for schedule(static)
@@ -1164,6 +1404,11 @@ std::variant<ParticleIterator, SingleCellIterator<ParticleCell>> LinkedCells::ge
 
 bool LinkedCells::requiresForceExchange() const {return _traversalTuner->getCurrentOptimalTraversal()->requiresForceExchange();}
 
+bool LinkedCells::supportsInnerOuterTraversal() const {
+	auto* traversal = _traversalTuner->getCurrentOptimalTraversal();
+	return traversal != nullptr and traversal->supportsInnerOuterTraversal();
+}
+
 std::vector<unsigned long> LinkedCells::getParticleCellStatistics() {
 	int maxParticles = 0;
 	for (auto& cell : _cells) {
@@ -1181,6 +1426,35 @@ std::vector<unsigned long> LinkedCells::getParticleCellStatistics() {
 	return statistics;
 }
 
+bool LinkedCells::setMeasureCellCosts(bool measure) {
+	_measureCellCosts = measure;
+	_cellForceCycles.assign(measure ? _cells.size() : 0, 0ull);
+	return _traversalTuner->setMeasureCellCosts(measure ? &_cellForceCycles : nullptr);
+}
+
+bool LinkedCells::measuresCellCosts() const {
+	return _traversalTuner->measuresCellCosts();
+}
+
+void LinkedCells::getMeasuredCellCosts(std::vector<std::array<double, 3>>& cellCenters,
+									   std::vector<double>& cellCycles) {
+	cellCenters.clear();
+	cellCycles.clear();
+	// halo cells are base cells of the pairs with the boundary cells, so they are reported as well
+	for (size_t i = 0; i < _cellForceCycles.size(); ++i) {
+		if (_cellForceCycles[i] == 0) {
+			continue;
+		}
+		std::array<double, 3> center;
+		for (int d = 0; d < 3; ++d) {
+			center[d] = 0.5 * (_cells[i].getBoxMin(d) + _cells[i].getBoxMax(d));
+		}
+		cellCenters.push_back(center);
+		cellCycles.push_back(static_cast<double>(_cellForceCycles[i]));
+		_cellForceCycles[i] = 0;
+	}
+}
+
 std::string LinkedCells::getConfigurationAsString() {
 	std::stringstream ss;
 	// TODO: propper string representation for ls1 traversal choices
@@ -10,6 +10,7 @@
 #include "particleContainer/ParticleIterator.h"
 #include "particleContainer/RegionParticleIterator.h"
 #include "particleContainer/ParticleCell.h"
+#include "utils/SpaceFillingCurve.h"
 
 #include "WrapOpenMP.h"
 
@@ -104,6 +105,15 @@ public:
 	 * \code{.xml}
 		<datastructure type="LinkedCells">
 			<cellsInCutoffRadius>INTEGER</cellsInCutoffRadius>
+			<!-- optional Verlet lists for the VectorizedCellProcessor (disabled for skin 0.0, default) -->
+			<verletSkin>DOUBLE</verletSkin>
+			<!-- rebuild the lists at the latest after this many traversals (default 10, 0: only on displacement) -->
+			<verletRebuildFrequency>INTEGER</verletRebuildFrequency>
+			<!-- optional reordering of the molecules within each cell along a space-filling curve
+				possible values are none (default), morton and hilbert -->
+			<sortCurve>STRING</sortCurve>
+			<!-- reorder every n-th update (default 10) -->
+			<sortFrequency>INTEGER</sortFrequency>
 			<!-- from TraversalTuner: -->
 			<!-- select traversal algorithm
 				possible values are:
@@ -111,13 +121,24 @@ public:
 				- c04
 				- c08        (default for >1 threads)
 				- c08es      (eight-shell)
+				- c08ws      (c08 with per-cell dependency counters and work stealing instead of color barriers)
 				- quicksched
 				- sliced     (default for <2 threads)
 				- hs         (half shell method)
 				- mp         (mid point method)
 				- nt         (neutral territory method)
+				- auto       (time the full shell traversals during the first force calculations and use the fastest)
 			-->
 			<traversalSelector>c08</traversalSelector>
+			<!-- only used by traversalSelector auto -->
+			<traversalTuning>
+				<!-- timed force calculations per traversal (default 3) -->
+				<samples>INTEGER</samples>
+				<!-- tune again if the number of particles changed by this fraction (default 0.1) -->
+				<retuneThreshold>DOUBLE</retuneThreshold>
+				<!-- check the number of particles every n-th force calculation, a global reduction (default 100) -->
+				<retuneInterval>INTEGER</retuneInterval>
+			</traversalTuning>
 			<!-- override default block size (2x2x2) for quicksched tasks -->
 			<traversalData type="quicksched">
 				<taskBlockSize>
@@ -199,6 +220,16 @@ public:
 	/* TODO: The particle container should not contain any physics, search a new place for this. */
 	double getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessor) override;
 
+	/**
+	 * @brief Batched version of getEnergy().
+	 * @details The test molecules are grouped by cell. For each group, the molecules of the neighbour cells are gathered
+	 * once into contiguous arrays and the center of mass distances of each test molecule to all of them are computed in
+	 * one vectorized loop. Only the pairs inside the cutoff radius are passed to the pair handler. The cells and pairs
+	 * are processed in the same order as by getEnergy(). Different groups are processed in parallel.
+	 */
+	void getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+					 std::vector<double>& energies, CellProcessor& cellProcessor) override;
+
 	int* getBoxWidthInNumCells() {
 		return _boxWidthInNumCells;
 	}
@@ -259,11 +290,20 @@ public:
 
 	bool requiresForceExchange() const override; // new
 
+	bool supportsInnerOuterTraversal() const override;
+
 	unsigned long initCubicGrid(std::array<unsigned long, 3> numMoleculesPerDimension,
 								std::array<double, 3> simBoxLength) override;
 
 	std::vector<unsigned long> getParticleCellStatistics() override;
 
+	bool setMeasureCellCosts(bool measure) override;
+
+	bool measuresCellCosts() const override;
+
+	void getMeasuredCellCosts(std::vector<std::array<double, 3>>& cellCenters,
+							  std::vector<double>& cellCycles) override;
+
 	std::string getConfigurationAsString() override;
 
 private:
@@ -328,6 +368,18 @@ private:
 
 	void getCellIndicesOfRegion(const double startRegion[3], const double endRegion[3], unsigned int &startRegionCellIndex, unsigned int &endRegionCellIndex);
 
+	/**
+	 * @brief Update the position snapshots of the inner and boundary cells, on which the Verlet lists are based.
+	 *
+	 * Halo cells are skipped. Cells whose content changed get a new snapshot. If any molecule moved more than half the skin
+	 * since its snapshot or the rebuild frequency is reached, all snapshots are renewed, which
+	 * invalidates all Verlet lists.
+	 */
+	void updateVerletReferences();
+
+	//! @brief Reorder the molecules within each inner and boundary cell along the space-filling curve.
+	void sortMoleculesAlongCurve();
+
 	//####################################
 	//##### PRIVATE MEMBER VARIABLES #####
 	//####################################
@@ -338,6 +390,10 @@ private:
 
 	std::unique_ptr<TraversalTuner<ParticleCell>> _traversalTuner; // new
 
+	//! force calculation cycles per cell, only allocated if the cell costs are measured
+	std::vector<unsigned long long> _cellForceCycles;
+	bool _measureCellCosts = false;
+
 	double _haloBoundingBoxMin[3]; //!< low corner of the bounding box around the linked cells (including halo)
 	double _haloBoundingBoxMax[3]; //!< high corner of the bounding box around the linked cells (including halo)
 
@@ -350,6 +406,14 @@ private:
 	double _cutoffRadius; //!< RDF/electrostatics cutoff radius
 	unsigned _cellsInCutoff = 1; //!< Cells in cutoff radius -> cells with size cutoff / cellsInCutoff
 
+	double _verletSkin = 0.0; //!< skin of the Verlet lists, 0.0 disables them
+	unsigned _verletRebuildFrequency = 10; //!< maximal number of traversals between two list rebuilds, 0: no limit
+	unsigned _traversalsSinceVerletRebuild = 0; //!< number of traversals since the last list rebuild
+
+	SpaceFillingCurve::CurveType _sortCurve = SpaceFillingCurve::CurveType::NONE; //!< curve for ordering molecules within cells
+	unsigned _sortFrequency = 10; //!< number of updates between two reorderings
+	unsigned _updatesSinceSort = 0; //!< number of updates since the last reordering
+
 	//! @brief True if all Particles are in the right cell
 	//!
 	//! The particles themselves are not stored in cells, but in one large
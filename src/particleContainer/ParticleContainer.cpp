@@ -49,3 +49,12 @@ bool ParticleContainer::addHaloParticle(Molecule& particle, bool inBoxCheckedAlr
 	mardyn_assert(not particle.inBox(_boundingBoxMin,_boundingBoxMax));
 	return addParticle(particle, inBoxCheckedAlready, checkWhetherDuplicate, rebuildCaches);
 }
+
+void ParticleContainer::getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+									std::vector<double>& energies, CellProcessor& cellProcessor) {
+	energies.resize(testMolecules.size());
+	for (size_t i = 0; i < testMolecules.size(); ++i) {
+		Molecule testMolecule = testMolecules[i];
+		energies[i] = getEnergy(particlePairsHandler, &testMolecule, cellProcessor);
+	}
+}
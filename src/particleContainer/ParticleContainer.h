@@ -207,6 +207,15 @@ public:
     /* TODO goes into grand canonical ensemble */
 	virtual double getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessor) = 0;
 
+	/**
+	 * @brief Calculates the potential energy of each test molecule with the molecules of the container.
+	 * @details Test molecules, that are part of the container (e.g. trial deletions), do not interact with themselves.
+	 * The default implementation calls getEnergy() for each test molecule.
+	 * @param energies is resized to the number of test molecules
+	 */
+	virtual void getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+							 std::vector<double>& energies, CellProcessor& cellProcessor);
+
 	//! @brief Update the caches of the molecules, that lie in inner cells.
 	//! The caches of boundary and halo cells is not updated.
 	//! This method is used for a multi-step scheme of overlapping mpi communication
@@ -231,6 +240,10 @@ public:
 	// or does this particle container calculate all forces.
 	virtual bool requiresForceExchange() const {return false;}
 
+	// @brief Can traversePartialInnermostCells and traverseNonInnermostCells be used instead of traverseCells,
+	// i.e., can the halo communication be overlapped with the force calculation.
+	virtual bool supportsInnerOuterTraversal() const { return false; }
+
     /**
      * Generates a body-centered cubic grid.
      * @param numMoleculesPerDimension
@@ -255,6 +268,26 @@ public:
 	 */
 	virtual std::vector<unsigned long> getParticleCellStatistics() {return std::vector<unsigned long>();}
 
+	/**
+	 * Enable measuring the CPU cycles of the force calculation per cell.
+	 * @return false, if the container (or its traversal) does not support measuring.
+	 */
+	virtual bool setMeasureCellCosts(bool /*measure*/) { return false; }
+
+	/**
+	 * @return whether the cycles per cell are measured by the current traversal. This can change during the simulation,
+	 * e.g., if auto-tuning selects a traversal that does not support measuring.
+	 */
+	virtual bool measuresCellCosts() const { return false; }
+
+	/**
+	 * Get the CPU cycles measured per cell since the last call and reset them.
+	 * @param cellCenters centers of the cells with measured cycles
+	 * @param cellCycles cycles of these cells
+	 */
+	virtual void getMeasuredCellCosts(std::vector<std::array<double, 3>>& cellCenters,
+									  std::vector<double>& cellCycles) {}
+
 	/**
 	 * set the cutoff
 	 * @param rc
@@ -2,14 +2,21 @@
 #define TRAVERSALTUNER_H_
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <utility>
 #include <vector>
 
 #include <utils/Logger.h>
+#include <utils/Timer.h>
 #include <Simulation.h>
+#ifdef ENABLE_MPI
+#include "parallel/DomainDecompBase.h"
+#endif
 #include "LinkedCellTraversals/CellPairTraversals.h"
 #include "LinkedCellTraversals/QuickschedTraversal.h"
 #include "LinkedCellTraversals/C08CellPairTraversal.h"
+#include "LinkedCellTraversals/C08WorkStealingTraversal.h"
 #include "LinkedCellTraversals/C04CellPairTraversal.h"
 #include "LinkedCellTraversals/OriginalCellPairTraversal.h"
 #include "LinkedCellTraversals/HalfShellTraversal.h"
@@ -23,7 +30,6 @@ class TraversalTuner {
 	friend class LinkedCellsTest;
 
 public:
-	// Probably remove this once autotuning is implemented
 	enum traversalNames {
 		ORIGINAL = 0,
 		C08      = 1,
@@ -33,8 +39,9 @@ public:
 		MP       = 5,
 		C08ES    = 6,
 		NT       = 7,
+		C08WS    = 8,
 		// quicksched has to be the last traversal!
-		QSCHED   = 8,
+		QSCHED   = 9,
 	};
 
 	TraversalTuner();
@@ -57,6 +64,15 @@ public:
 
 	void traverseCellPairs(CellProcessor &cellProcessor);
 
+	/**
+	 * Traverse the cell pairs for the force calculation.
+	 * If auto-tuning is enabled, the traversal is timed and, while tuning, the candidate traversals are cycled.
+	 * The overlapping force calculation (traverseCellPairsInner() for all stages, then traverseCellPairsOuter()) is
+	 * tuned in the same way, the sum of its traversal times counts as one sample. Under MPI, all processes have to
+	 * call it for the same force calculations, other cell processors have to use traverseCellPairs().
+	 */
+	void tuneAndTraverseCellPairs(CellProcessor &cellProcessor);
+
 	void traverseCellPairs(traversalNames name, CellProcessor &cellProcessor);
 
 	void traverseCellPairsOuter(CellProcessor &cellProcessor);
@@ -73,7 +89,51 @@ public:
 
 	CellPairTraversals<ParticleCell> *getCurrentOptimalTraversal() { return _optimalTraversal; }
 
+	bool isAutoTuning() const { return _autoTune; }
+
+	/**
+	 * Enable measuring the force calculation cycles per cell in all traversals which support it.
+	 * @param cellCycles cycles of every cell, nullptr disables measuring
+	 * @return whether the selected traversal supports it
+	 */
+	bool setMeasureCellCosts(std::vector<unsigned long long>* cellCycles);
+
+	//! @return whether the selected traversal measures the force calculation cycles per cell
+	bool measuresCellCosts() const {
+		const CellPairTraversals<CellTemplate> *traversal = _traversals[selectedTraversal].first;
+		return traversal != nullptr and traversal->measuresCellCosts();
+	}
+
 private:
+	/**
+	 * Collect the traversals that can replace each other at runtime: they have to be applicable to the current
+	 * cell dimensions, must not require a different communication scheme than the full shell one and must support
+	 * the overlapping force calculation. Under MPI, only the traversals applicable on all processes are candidates.
+	 */
+	void startTuning(unsigned long numParticles);
+
+	void finishTuning(unsigned long numParticles);
+
+	/**
+	 * Start tuning if required, called before the first traversal of a force calculation.
+	 * The check for a changed number of particles needs a global reduction, so it is only done every
+	 * _retuneInterval-th force calculation.
+	 */
+	void beginTuningStep();
+
+	//! record the sample of the current candidate and advance to the next one, called after the last traversal
+	void endTuningStep();
+
+	//! run traversal and add its time to the sample of the current force calculation while tuning
+	template <typename Traversal>
+	void timeTraversal(Traversal&& traversal);
+
+	//! @return number of molecules in the local non-halo cells, used to detect density changes
+	unsigned long countParticles() const;
+
+	//! Sums up the values over all processes, so that all of them take the same decisions.
+	void sumOverProcesses(unsigned long* values, int count) const;
+
 	std::vector<CellTemplate>* _cells;
 	std::array<unsigned long, 3> _dims;
 
@@ -84,6 +144,30 @@ private:
 	CellPairTraversals<CellTemplate> *_optimalTraversal;
 
 	unsigned _cellsInCutoff = 1;
+
+	//! cycles per cell passed to the traversals, nullptr if not measured
+	std::vector<unsigned long long>* _cellCycles = nullptr;
+
+	// auto-tuning
+	bool _autoTune = false;
+	bool _tuning = false;
+	//! number of timed force traversals per candidate, the fastest one counts
+	unsigned _tuningSamples = 3;
+	//! relative change of the number of particles which triggers a new tuning phase
+	double _retuneThreshold = 0.1;
+	//! number of force calculations between the checks of the number of particles
+	unsigned _retuneInterval = 100;
+	//! force calculations outside of the tuning phases, the same on all processes
+	unsigned long _numForceCalculations = 0;
+	//! global number of particles when the last tuning phase finished, 0 if the cells were rebuilt since
+	unsigned long _tunedNumParticles = 0;
+	std::vector<traversalNames> _candidates;
+	std::vector<double> _candidateTimes;
+	size_t _currentCandidate = 0;
+	unsigned _samplesTaken = 0;
+	//! time of the traversals of the current force calculation
+	double _stepTime = 0.;
+	Timer _tuningTimer;
 };
 
 template<class CellTemplate>
@@ -100,6 +184,7 @@ TraversalTuner<CellTemplate>::TraversalTuner() : _cells(nullptr), _dims(), _opti
 	auto *mpData = new MidpointTraversalData;
 	auto *ntData = new NeutralTerritoryTraversalData;
 	auto *c08esData = new C08CellPairTraversalData;
+	auto *c08wsData = new C08WorkStealingTraversalData;
 
 	_traversals = {
 			std::make_pair(nullptr, origData),
@@ -109,7 +194,8 @@ TraversalTuner<CellTemplate>::TraversalTuner() : _cells(nullptr), _dims(), _opti
 			std::make_pair(nullptr, hsData),
 			std::make_pair(nullptr, mpData),
 			std::make_pair(nullptr, ntData),
-			std::make_pair(nullptr, c08esData)
+			std::make_pair(nullptr, c08esData),
+			std::make_pair(nullptr, c08wsData)
 	};
 #ifdef QUICKSCHED
 	struct QuickschedTraversalData *quiData = new QuickschedTraversalData;
@@ -132,8 +218,7 @@ TraversalTuner<CellTemplate>::~TraversalTuner() {
 
 template<class CellTemplate>
 void TraversalTuner<CellTemplate>::findOptimalTraversal() {
-	// TODO implement autotuning here! At the moment the traversal is chosen via readXML!
-
+	// with auto-tuning enabled, selectedTraversal is updated by tuneAndTraverseCellPairs
 	_optimalTraversal = _traversals[selectedTraversal].first;
 
 	// log traversal
@@ -145,6 +230,8 @@ void TraversalTuner<CellTemplate>::findOptimalTraversal() {
 		Log::global_log->info() << "Using C08CellPairTraversal without eighthShell." << std::endl;
 	else if (dynamic_cast<C08CellPairTraversal<CellTemplate, true> *>(_optimalTraversal))
 		Log::global_log->info() << "Using C08CellPairTraversal with eighthShell." << std::endl;
+	else if (dynamic_cast<C08WorkStealingTraversal<CellTemplate> *>(_optimalTraversal))
+		Log::global_log->info() << "Using C08WorkStealingTraversal." << std::endl;
 	else if (dynamic_cast<C04CellPairTraversal<CellTemplate> *>(_optimalTraversal))
 		Log::global_log->info() << "Using C04CellPairTraversal." << std::endl;
 	else if (dynamic_cast<MidpointTraversal<CellTemplate> *>(_optimalTraversal))
@@ -180,8 +267,33 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 	xmlconfig.getNodeValue("traversalSelector", traversalType);
 	transform(traversalType.begin(), traversalType.end(), traversalType.begin(), ::tolower);
 
-	if (traversalType.find("c08es") != std::string::npos)
+	if (traversalType.find("auto") != std::string::npos) {
+		// start with the default traversal, the others are tried out during the first steps
+		_autoTune = true;
+		const int samples = xmlconfig.getNodeValue_int("traversalTuning/samples", _tuningSamples);
+		if (samples < 1) {
+			std::ostringstream error_message;
+			error_message << "traversalTuning/samples has to be at least 1, but is " << samples << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		_tuningSamples = samples;
+		_retuneThreshold = xmlconfig.getNodeValue_double("traversalTuning/retuneThreshold", _retuneThreshold);
+		const int retuneInterval = xmlconfig.getNodeValue_int("traversalTuning/retuneInterval", _retuneInterval);
+		if (retuneInterval < 1) {
+			std::ostringstream error_message;
+			error_message << "traversalTuning/retuneInterval has to be at least 1, but is " << retuneInterval
+						  << std::endl;
+			MARDYN_EXIT(error_message.str());
+		}
+		_retuneInterval = retuneInterval;
+		Log::global_log->info() << "Traversal auto-tuning enabled: " << _tuningSamples
+								<< " samples per traversal, retuning at a relative change of the particle number of "
+								<< _retuneThreshold << ", checked every " << _retuneInterval
+								<< " force calculations" << std::endl;
+	} else if (traversalType.find("c08es") != std::string::npos)
 		selectedTraversal = C08ES;
+	else if (traversalType.find("c08ws") != std::string::npos)
+		selectedTraversal = C08WS;
 	else if (traversalType.find("c08") != std::string::npos)
 		selectedTraversal = C08;
 	else if (traversalType.find("c04") != std::string::npos)
@@ -303,6 +415,9 @@ void TraversalTuner<CellTemplate>::rebuild(std::vector<CellTemplate> &cells, con
 				case traversalNames::C08ES:
 					traversalPointerReference = new C08CellPairTraversal<CellTemplate, true>(cells, dims);
 					break;
+				case traversalNames::C08WS:
+					traversalPointerReference = new C08WorkStealingTraversal<CellTemplate>(cells, dims);
+					break;
 				case traversalNames::QSCHED: {
 					mardyn_assert((std::is_base_of<ParticleCellBase, CellTemplate>::value));
 					auto *quiData = dynamic_cast<QuickschedTraversalData *>(traversalData);
@@ -315,8 +430,15 @@ void TraversalTuner<CellTemplate>::rebuild(std::vector<CellTemplate> &cells, con
 			}
 		}
 		traversalPointerReference->rebuild(cells, dims, cellLength, cutoff, traversalData);
+		traversalPointerReference->setMeasureCellCosts(_cellCycles);
 	}
 	_optimalTraversal = nullptr;
+
+	if (_autoTune) {
+		// the timings are not valid for the new cell dimensions, tune again at the next check
+		_tuning = false;
+		_tunedNumParticles = 0;
+	}
 }
 
 template<class CellTemplate>
@@ -327,6 +449,166 @@ void TraversalTuner<CellTemplate>::traverseCellPairs(CellProcessor &cellProcesso
 	_optimalTraversal->traverseCellPairs(cellProcessor);
 }
 
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::tuneAndTraverseCellPairs(CellProcessor &cellProcessor) {
+	if (not _autoTune) {
+		traverseCellPairs(cellProcessor);
+		return;
+	}
+
+	beginTuningStep();
+	timeTraversal([&]() { traverseCellPairs(cellProcessor); });
+	endTuningStep();
+}
+
+template<class CellTemplate>
+template<typename Traversal>
+void TraversalTuner<CellTemplate>::timeTraversal(Traversal&& traversal) {
+	if (not _tuning) {
+		traversal();
+		return;
+	}
+	_tuningTimer.reset();
+	_tuningTimer.start();
+	traversal();
+	_tuningTimer.stop();
+	_stepTime += _tuningTimer.get_etime();
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::beginTuningStep() {
+	_stepTime = 0.;
+	if (_tuning or _numForceCalculations++ % _retuneInterval != 0) {
+		return;
+	}
+	// the global number of particles and the number of processes which have rebuilt their cells since the last tuning
+	unsigned long counts[2] = {countParticles(), _tunedNumParticles == 0 ? 1ul : 0ul};
+	sumOverProcesses(counts, 2);
+	const double change = std::abs(static_cast<double>(counts[0]) - static_cast<double>(_tunedNumParticles));
+	if (counts[1] > 0 or change > _retuneThreshold * static_cast<double>(_tunedNumParticles)) {
+		startTuning(counts[0]);
+	}
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::endTuningStep() {
+	if (not _tuning) {
+		return;
+	}
+	_candidateTimes[_currentCandidate] = std::min(_candidateTimes[_currentCandidate], _stepTime);
+	if (++_samplesTaken < _tuningSamples) {
+		return;
+	}
+
+	_samplesTaken = 0;
+	if (++_currentCandidate < _candidates.size()) {
+		selectedTraversal = _candidates[_currentCandidate];
+		_optimalTraversal = _traversals[selectedTraversal].first;
+	} else {
+		unsigned long numParticles = countParticles();
+		sumOverProcesses(&numParticles, 1);
+		finishTuning(numParticles);
+	}
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::startTuning(unsigned long numParticles) {
+	// the candidates also have to support the overlapping force calculation
+	const std::vector<traversalNames> names = {C08, C04, SLICED, C08WS};
+	std::vector<int> applicable(names.size(), 0);
+	for (size_t i = 0; i < names.size(); ++i) {
+		if (not isTraversalApplicable(names[i], _dims)) {
+			continue;
+		}
+		CellPairTraversals<CellTemplate> *traversal = _traversals[names[i]].first;
+		applicable[i] = not traversal->requiresForceExchange() and traversal->supportsInnerOuterTraversal()
+						and traversal->maxCellsInCutoff() >= _cellsInCutoff;
+	}
+#ifdef ENABLE_MPI
+	// all processes have to try the same candidates in the same time steps
+	if (global_simulation != nullptr) {
+		MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, applicable.data(), static_cast<int>(applicable.size()), MPI_INT,
+								MPI_MIN, global_simulation->domainDecomposition().getCommunicator()));
+	}
+#endif
+	_candidates.clear();
+	for (size_t i = 0; i < names.size(); ++i) {
+		if (applicable[i]) {
+			_candidates.push_back(names[i]);
+		}
+	}
+	if (_candidates.empty()) {
+		Log::global_log->warning() << "No traversal applicable for auto-tuning, keeping the selected one." << std::endl;
+		_tunedNumParticles = std::max(numParticles, 1ul);
+		return;
+	}
+
+	Log::global_log->info() << "Tuning traversal for " << numParticles << " particles among " << _candidates.size()
+							<< " traversals." << std::endl;
+	_candidateTimes.assign(_candidates.size(), std::numeric_limits<double>::max());
+	_currentCandidate = 0;
+	_samplesTaken = 0;
+	_tuning = true;
+	selectedTraversal = _candidates[0];
+	_optimalTraversal = _traversals[selectedTraversal].first;
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::finishTuning(unsigned long numParticles) {
+#ifdef ENABLE_MPI
+	// the slowest process determines the time of a step, all processes have to choose the same traversal
+	if (global_simulation != nullptr) {
+		MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, _candidateTimes.data(), static_cast<int>(_candidateTimes.size()),
+								MPI_DOUBLE, MPI_MAX, global_simulation->domainDecomposition().getCommunicator()));
+	}
+#endif
+	const size_t fastest = std::min_element(_candidateTimes.begin(), _candidateTimes.end()) - _candidateTimes.begin();
+	for (size_t i = 0; i < _candidates.size(); ++i) {
+		Log::global_log->debug() << "Traversal " << _candidates[i] << ": " << _candidateTimes[i] << " s" << std::endl;
+	}
+	_tuning = false;
+	_tunedNumParticles = std::max(numParticles, 1ul);
+	selectedTraversal = _candidates[fastest];
+	// log the chosen traversal
+	findOptimalTraversal();
+}
+
+template<class CellTemplate>
+bool TraversalTuner<CellTemplate>::setMeasureCellCosts(std::vector<unsigned long long>* cellCycles) {
+	_cellCycles = cellCycles;
+	bool selectedSupportsIt = false;
+	for (size_t i = 0; i < _traversals.size(); ++i) {
+		if (_traversals[i].first != nullptr) {
+			const bool supported = _traversals[i].first->setMeasureCellCosts(cellCycles);
+			if (i == static_cast<size_t>(selectedTraversal)) {
+				selectedSupportsIt = supported;
+			}
+		}
+	}
+	return selectedSupportsIt;
+}
+
+template<class CellTemplate>
+unsigned long TraversalTuner<CellTemplate>::countParticles() const {
+	unsigned long numParticles = 0;
+	for (const auto &cell : *_cells) {
+		if (not cell.isHaloCell()) {
+			numParticles += cell.getMoleculeCount();
+		}
+	}
+	return numParticles;
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::sumOverProcesses(unsigned long* values, int count) const {
+#ifdef ENABLE_MPI
+	if (global_simulation != nullptr) {
+		MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, values, count, MPI_UNSIGNED_LONG, MPI_SUM,
+								global_simulation->domainDecomposition().getCommunicator()));
+	}
+#endif
+}
+
 template<class CellTemplate>
 inline void TraversalTuner<CellTemplate>::traverseCellPairs(traversalNames name,
 		CellProcessor& cellProcessor) {
@@ -352,7 +634,13 @@ void TraversalTuner<CellTemplate>::traverseCellPairsOuter(CellProcessor &cellPro
 	if (not _optimalTraversal) {
 		findOptimalTraversal();
 	}
-	_optimalTraversal->traverseCellPairsOuter(cellProcessor);
+	if (not _autoTune) {
+		_optimalTraversal->traverseCellPairsOuter(cellProcessor);
+		return;
+	}
+	// the outer traversal is the last one of the overlapping force calculation
+	timeTraversal([&]() { _optimalTraversal->traverseCellPairsOuter(cellProcessor); });
+	endTuningStep();
 }
 
 template<class CellTemplate>
@@ -361,7 +649,14 @@ void TraversalTuner<CellTemplate>::traverseCellPairsInner(CellProcessor &cellPro
 	if (not _optimalTraversal) {
 		findOptimalTraversal();
 	}
-	_optimalTraversal->traverseCellPairsInner(cellProcessor, stage, stageCount);
+	if (not _autoTune) {
+		_optimalTraversal->traverseCellPairsInner(cellProcessor, stage, stageCount);
+		return;
+	}
+	if (stage == 0) {
+		beginTuningStep();
+	}
+	timeTraversal([&]() { _optimalTraversal->traverseCellPairsInner(cellProcessor, stage, stageCount); });
 }
 
 template<class CellTemplate>
@@ -382,6 +677,9 @@ inline bool TraversalTuner<CellTemplate>::isTraversalApplicable(
 	case C08:
 		ret = true;
 		break;
+	case C08WS:
+		ret = true;
+		break;
 	case C04:
 		ret = true;
 		break;
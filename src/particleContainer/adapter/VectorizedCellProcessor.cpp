@@ -792,7 +792,7 @@ void VectorizedCellProcessor::endTraversal() {
 	}
 
 template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
-void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2) {
+void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, const CellVerletList * const verletList) {
 	const int tid = mardyn_get_thread_num();
 	VLJCPThreadData &my_threadData = *_threadData[tid];
 
@@ -986,6 +986,22 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	const size_t end_quadrupoles_j = vcp_floor_to_vec_size(soa2._quadrupoles_num);
 	const size_t end_quadrupoles_j_longloop = vcp_ceil_to_vec_size(soa2._quadrupoles_num);//this is ceil _quadrupoles_num, VCP_VEC_SIZE
 
+	// Verlet lists: first center of every molecule of soa2 per center type
+	if (verletList != nullptr) {
+		const size_t soa2_mol_num = soa2.getMolNum();
+		auto centerOffsets = [soa2_mol_num](std::vector<size_t>& offsets, const int * const mol_centers_num) {
+			offsets.resize(soa2_mol_num + 1);
+			offsets[0] = 0;
+			for (size_t j = 0; j < soa2_mol_num; ++j) {
+				offsets[j + 1] = offsets[j] + mol_centers_num[j];
+			}
+		};
+		centerOffsets(my_threadData._ljc_offsets, soa2._mol_ljc_num);
+		centerOffsets(my_threadData._charges_offsets, soa2._mol_charges_num);
+		centerOffsets(my_threadData._dipoles_offsets, soa2._mol_dipoles_num);
+		centerOffsets(my_threadData._quadrupoles_offsets, soa2._mol_quadrupoles_num);
+	}
+
 	size_t i_ljc_idx = 0;
 	size_t i_charge_idx = 0;
 	size_t i_charge_dipole_idx = 0;
@@ -1004,22 +1020,63 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	// Iterate over each center in the first cell.
 	const size_t soa1_mol_num = soa1.getMolNum();
 	for (size_t i = 0; i < soa1_mol_num; ++i) {//over the molecules
+		const unsigned * neighboursBegin = nullptr;
+		const unsigned * neighboursEnd = nullptr;
+		if (verletList != nullptr) {
+			neighboursBegin = verletList->neighbours.data() + verletList->neighbourOffsets[i];
+			neighboursEnd = verletList->neighbours.data() + verletList->neighbourOffsets[i + 1];
+		}
+		if (verletList != nullptr and neighboursBegin == neighboursEnd) {
+			// no partner within the cutoff radius: advance indices as if all dist lookups were empty
+			i_ljc_idx += soa1_mol_ljc_num[i];
+			i_charge_idx += soa1_mol_charges_num[i];
+			i_dipole_charge_idx += soa1_mol_dipoles_num[i];
+			i_quadrupole_charge_idx += soa1_mol_quadrupoles_num[i];
+			i_dipole_idx += soa1_mol_dipoles_num[i];
+			i_charge_dipole_idx += soa1_mol_charges_num[i];
+			i_quadrupole_dipole_idx += soa1_mol_quadrupoles_num[i];
+			i_quadrupole_idx += soa1_mol_quadrupoles_num[i];
+			i_charge_quadrupole_idx += soa1_mol_charges_num[i];
+			i_dipole_quadrupole_idx += soa1_mol_dipoles_num[i];
+			continue;
+		}
 		const RealCalcVec m1_r_x = RealCalcVec::broadcast(soa1_mol_pos_x + i);
 		const RealCalcVec m1_r_y = RealCalcVec::broadcast(soa1_mol_pos_y + i);
 		const RealCalcVec m1_r_z = RealCalcVec::broadcast(soa1_mol_pos_z + i);
-		// Iterate over centers of second cell
-		const countertype32 compute_molecule_ljc = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
-				soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
-				ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z);
-		const countertype32 compute_molecule_charges = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
-				soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
-				cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z);
-		const countertype32 compute_molecule_dipoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
-				soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
-				cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z);
-		const countertype32 compute_molecule_quadrupoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
-				soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
-				cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z);
+		countertype32 compute_molecule_ljc, compute_molecule_charges, compute_molecule_dipoles, compute_molecule_quadrupoles;
+		if (verletList == nullptr) {
+			// Iterate over centers of second cell
+			compute_molecule_ljc = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
+					soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
+					ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_charges = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
+					soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
+					cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_dipoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
+					soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
+					cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_quadrupoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
+					soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
+					cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z);
+		} else {
+			// Iterate only over the centers of the neighbours of molecule i in the second cell
+			vcp_neighbourBlocks(my_threadData._ljc_blocks, neighboursBegin, neighboursEnd, my_threadData._ljc_offsets.data());
+			vcp_neighbourBlocks(my_threadData._charges_blocks, neighboursBegin, neighboursEnd, my_threadData._charges_offsets.data());
+			vcp_neighbourBlocks(my_threadData._dipoles_blocks, neighboursBegin, neighboursEnd, my_threadData._dipoles_offsets.data());
+			vcp_neighbourBlocks(my_threadData._quadrupoles_blocks, neighboursBegin, neighboursEnd, my_threadData._quadrupoles_offsets.data());
+			compute_molecule_ljc = calcDistLookupBlocks<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
+					soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
+					ljrc2, my_threadData._ljc_blocks, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_charges = calcDistLookupBlocks<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
+					soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
+					cutoffRadiusSquare, my_threadData._charges_blocks, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_dipoles = calcDistLookupBlocks<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
+					soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
+					cutoffRadiusSquare, my_threadData._dipoles_blocks, m1_r_x, m1_r_y, m1_r_z);
+			compute_molecule_quadrupoles = calcDistLookupBlocks<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
+					soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
+					cutoffRadiusSquare, my_threadData._quadrupoles_blocks, m1_r_x, m1_r_y, m1_r_z);
+		}
 
 		size_t end_ljc_loop = MaskGatherChooser::getEndloop(end_ljc_j_longloop, compute_molecule_ljc);
 		size_t end_charges_loop = MaskGatherChooser::getEndloop(end_charges_j_longloop, compute_molecule_charges);
@@ -2736,9 +2793,15 @@ void VectorizedCellProcessor::processCell(ParticleCell & c) {
 	if (c.isHaloCell() or soa.getMolNum() < 2) {
 		return;
 	}
+
+	const CellVerletList * const verletList = full_c.getVerletList(full_c);
+	if (verletList != nullptr and verletList->neighbours.empty()) {
+		return;
+	}
+
 	const bool CalculateMacroscopic = true;
 	const bool ApplyCutoff = true;
-	_calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa, soa);
+	_calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa, soa, verletList);
 }
 
 void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell & c2, bool sumAll) {
@@ -2762,6 +2825,12 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 	// is more efficient
 	const bool calc_soa1_soa2 = (soa1.getMolNum() <= soa2.getMolNum());
 
+	// if the cells have Verlet lists, only the neighbours in the second cell are considered
+	const CellVerletList * const verletList = calc_soa1_soa2 ? full_c1.getVerletList(full_c2) : full_c2.getVerletList(full_c1);
+	if (verletList != nullptr and verletList->neighbours.empty()) {
+		return;
+	}
+
 
 	if(sumAll) {
 
@@ -2772,9 +2841,9 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 		const bool CalculateMacroscopic = true;
 
 		if (calc_soa1_soa2) {
-			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2, verletList);
 		} else {
-			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1, verletList);
 		}
 	} else {
 		// if one cell is empty, or both cells are Halo, skip
@@ -2798,9 +2867,9 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 			const bool CalculateMacroscopic = true;
 
 			if (calc_soa1_soa2) {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2, verletList);
 			} else {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1, verletList);
 			}
 
 		} else {
@@ -2810,11 +2879,10 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 			const bool CalculateMacroscopic = false;
 
 			if (calc_soa1_soa2) {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2, verletList);
 			} else {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1, verletList);
 			}
 		}
 	}
 }
-
@@ -21,6 +21,7 @@ class Component;
 class Domain;
 class Comp2Param;
 class CellDataSoA;
+struct CellVerletList;
 
 /**
  * \brief Vectorized calculation of the force.
@@ -181,6 +182,12 @@ private:
 		vcp_lookupOrMask_single* _quadrupoles_dist_lookup;
 
 		AlignedArray<vcp_real_accum> _upot6ljV, _upotXpolesV, _virialV, _myRFV;
+
+		/**
+		 * \brief Verlet lists: first center of every molecule of soa2 and vector blocks of the neighbours of molecule i, per center type.
+		 */
+		std::vector<size_t> _ljc_offsets, _charges_offsets, _dipoles_offsets, _quadrupoles_offsets;
+		std::vector<size_t> _ljc_blocks, _charges_blocks, _dipoles_blocks, _quadrupoles_blocks;
 	};
 
 	std::vector<VLJCPThreadData *> _threadData;
@@ -314,9 +321,12 @@ private:
 	 * The boolean CalculateMacroscopic should specify, whether macroscopic values are to be calculated or not.
 	 * <br>
 	 * The class MaskGatherChooser is a class, that specifies the used loading,storing and masking routines.
+	 * <br>
+	 * If verletList is given (see CellVerletList), only the distances of molecule i of soa1 to its<br>
+	 * neighbours in soa2 (rather: the vector blocks containing their centers) are checked.
 	 */
 	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
-	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2);
+	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, const CellVerletList * const verletList = nullptr);
 
 }; /* end of class VectorizedCellProcessor */
 
@@ -20,6 +20,17 @@ public:
 		compute_molecule = compute_molecule or forceMask;
 	}
 
+	//! mask out the blocks [begin, end), which are not visited by storeCalcDistLookup (Verlet lists)
+	inline void clearCalcDistLookup(size_t begin, size_t end){
+		for (size_t j = begin; j < end; j += VCP_VEC_SIZE) {
+			MaskCalcVec::zero().aligned_store(storeCalcDistLookupLocation + j/VCP_INDICES_PER_LOOKUP_SINGLE);
+		}
+	}
+
+	//! the next call of storeCalcDistLookup is for block j
+	inline void seek(size_t /*j*/){
+	}
+
 	inline static size_t getEndloop(const size_t& long_loop, const countertype32& /*number_calculate*/ /* number of interactions, that are calculated*/) {
 		return long_loop;
 	}
@@ -72,6 +83,11 @@ public:
 	GatherChooser(vcp_lookupOrMask_single* const soa2_center_dist_lookup, size_t j):
 		storeCalcDistLookupLocation(soa2_center_dist_lookup)
 	{
+		seek(j);
+	}
+
+	//! the next call of storeCalcDistLookup is for block j
+	inline void seek(size_t j){
 		static const __m512i first_indices = _mm512_set_epi32(
 			0x0f, 0x0e, 0x0d, 0x0c, 0x0b, 0x0a, 0x09, 0x08,
 			0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0x00
@@ -84,6 +100,10 @@ public:
 		#endif
 	}
 
+	//! only the indices stored by storeCalcDistLookup are used, nothing to clear
+	inline void clearCalcDistLookup(size_t /*begin*/, size_t /*end*/){
+	}
+
 	inline void storeCalcDistLookup(size_t j, MaskCalcVec forceMask){
 		_mm512_mask_compressstoreu_epi32(storeCalcDistLookupLocation + counter, static_cast<__mmask16>(forceMask), indices);
 
@@ -14,6 +14,8 @@
 #include "SIMD_TYPES.h"
 #include "utils/AlignedArray.h"
 
+#include <vector>
+
 /**
  * unpacks eps_24 and sig2 from the eps_sigI array according to the index array id_j (for mic+avx2: use gather)
  * @param eps_24 vector in which eps_24 is saved
@@ -472,4 +474,83 @@ static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & so
 }
 
 
+/**
+ * \brief Start indices of the vector blocks, which contain centers of the given molecules.
+ * @param blocks output, ascending and unique
+ * @param neighboursBegin, neighboursEnd ascending indices of the molecules (Verlet list)
+ * @param centerOffsets centers of molecule j are [centerOffsets[j], centerOffsets[j+1])
+ */
+static vcp_inline
+void vcp_neighbourBlocks(std::vector<size_t>& blocks, const unsigned* const neighboursBegin, const unsigned* const neighboursEnd,
+		const size_t* const centerOffsets) {
+	blocks.clear();
+	for (const unsigned* n = neighboursBegin; n != neighboursEnd; ++n) {
+		const size_t first = centerOffsets[*n];
+		const size_t end = centerOffsets[*n + 1];
+		if (first == end) {
+			continue;
+		}
+		size_t block = vcp_floor_to_vec_size(first);
+		if (not blocks.empty() and blocks.back() >= block) {
+			block = blocks.back() + VCP_VEC_SIZE;
+		}
+		for (; block < end; block += VCP_VEC_SIZE) {
+			blocks.push_back(block);
+		}
+	}
+}
+
+/**
+ * \brief The dist lookup for a molecule and the centers of a type in the given vector blocks only (Verlet lists).
+ * \details Equivalent to calcDistLookup, if the blocks contain all centers within the cutoff radius.
+ * All other blocks are masked out.
+ */
+template<class ForcePolicy, class MaskGatherChooser>
+countertype32
+static vcp_inline calcDistLookupBlocks (const size_t & i_center_idx, const size_t & soa2_num_centers,
+		vcp_lookupOrMask_single* const soa2_center_dist_lookup, const vcp_real_calc* const soa2_m_r_x, const vcp_real_calc* const soa2_m_r_y, const vcp_real_calc* const soa2_m_r_z,
+		const RealCalcVec & cutoffRadiusSquareD, const std::vector<size_t>& blocks, const RealCalcVec m1_r_x, const RealCalcVec m1_r_y, const RealCalcVec m1_r_z) {
+
+	const size_t initJ = ForcePolicy :: InitJ(i_center_idx);
+	const MaskCalcVec initJ_mask = ForcePolicy :: InitJ_Mask(i_center_idx);
+	const size_t end_j = vcp_floor_to_vec_size(soa2_num_centers);
+	const MaskCalcVec remainderMask = vcp_simd_getRemainderMask(soa2_num_centers);
+
+	MaskGatherChooser mgc(soa2_center_dist_lookup, initJ);
+	mgc.clearCalcDistLookup(initJ, vcp_ceil_to_vec_size(soa2_num_centers));
+
+	for (const size_t j : blocks) {
+		if (j < initJ) {
+			continue;
+		}
+		MaskCalcVec j_mask = (j == initJ) ? initJ_mask : MaskCalcVec::ones();
+		mgc.seek(j);
+
+		RealCalcVec m2_r_x, m2_r_y, m2_r_z;
+		if (j < end_j) {
+			m2_r_x = RealCalcVec::aligned_load(soa2_m_r_x + j);
+			m2_r_y = RealCalcVec::aligned_load(soa2_m_r_y + j);
+			m2_r_z = RealCalcVec::aligned_load(soa2_m_r_z + j);
+		} else {
+			m2_r_x = RealCalcVec::aligned_load_mask(soa2_m_r_x + j, remainderMask);
+			m2_r_y = RealCalcVec::aligned_load_mask(soa2_m_r_y + j, remainderMask);
+			m2_r_z = RealCalcVec::aligned_load_mask(soa2_m_r_z + j, remainderMask);
+		}
+
+		const RealCalcVec m_dx = m1_r_x - m2_r_x;
+		const RealCalcVec m_dy = m1_r_y - m2_r_y;
+		const RealCalcVec m_dz = m1_r_z - m2_r_z;
+
+		const RealCalcVec m_r2 = RealCalcVec::scal_prod(m_dx, m_dy, m_dz, m_dx, m_dy, m_dz);
+
+		MaskCalcVec forceMask = ForcePolicy::GetForceMask(m_r2, cutoffRadiusSquareD, j_mask);
+		if (j >= end_j) {
+			forceMask = remainderMask and forceMask;
+		}
+		mgc.storeCalcDistLookup(j, forceMask);
+	}
+
+	return mgc.getCount();
+}
+
 #endif /* SIMD_VECTORIZEDCELLPROCESSORHELPERS_H */
@@ -13,6 +13,8 @@ class LinkedCellsTest;
 #include "parallel/DomainDecomposition.h"
 #endif
 #include "particleContainer/adapter/CellProcessor.h"
+#include <cmath>
+#include <map>
 #include <vector>
 
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
@@ -362,6 +364,345 @@ void LinkedCellsTest::testTraversalMethods() {
 	delete container;
 }
 
+void LinkedCellsTest::testInnerOuterTraversals() {
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	auto* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, 5.));
+	int* boxWidthInNumCells = container->getBoxWidthInNumCells();
+	int haloWidthInNumCells = container->getHaloWidthNumCells();
+	size_t numCells = static_cast<size_t>(boxWidthInNumCells[0] + 2 * haloWidthInNumCells)
+			* (boxWidthInNumCells[1] + 2 * haloWidthInNumCells) * (boxWidthInNumCells[2] + 2 * haloWidthInNumCells);
+	CellProcessorStub cpStub(numCells);
+
+	// creates all traversals
+	CellProcessorStub initStub(numCells);
+	container->traverseCells(initStub);
+	using Tuner = TraversalTuner<ParticleCell>;
+	auto& tuner = *container->_traversalTuner;
+	auto* reference = tuner._traversals[Tuner::C08].first;
+	ASSERT_TRUE(not tuner._traversals[Tuner::NT].first->supportsInnerOuterTraversal());
+	ASSERT_TRUE(not tuner._traversals[Tuner::C08ES].first->supportsInnerOuterTraversal());
+
+	for (auto name : {Tuner::C08, Tuner::C04, Tuner::SLICED, Tuner::C08WS}) {
+		auto* traversal = tuner._traversals[name].first;
+		ASSERT_TRUE(traversal->supportsInnerOuterTraversal());
+		cpStub.inverseSign();
+		reference->traverseCellPairs(cpStub);
+		cpStub.inverseSign();
+		for (unsigned stage = 0; stage < 3; ++stage) {
+			traversal->traverseCellPairsInner(cpStub, stage, 3);
+		}
+		traversal->traverseCellPairsOuter(cpStub);
+		cpStub.checkZero();
+	}
+	delete container;
+}
+
+void LinkedCellsTest::testTraversalAutoTuning() {
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	auto* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, 5.));
+	int* boxWidthInNumCells = container->getBoxWidthInNumCells();
+	int haloWidthInNumCells = container->getHaloWidthNumCells();
+	size_t numCells = static_cast<size_t>(boxWidthInNumCells[0] + 2 * haloWidthInNumCells)
+			* (boxWidthInNumCells[1] + 2 * haloWidthInNumCells) * (boxWidthInNumCells[2] + 2 * haloWidthInNumCells);
+	CellProcessorStub cpStub(numCells);
+
+	auto& tuner = *container->_traversalTuner;
+	tuner._autoTune = true;
+	tuner._tuningSamples = 1;
+
+	// only the force calculation of the simulation is tuned
+	container->traverseCells(cpStub);
+	cpStub.inverseSign();
+	container->traverseCells(cpStub);
+	cpStub.inverseSign();
+	ASSERT_TRUE(not tuner._tuning);
+	ASSERT_EQUAL(0ul, tuner._numForceCalculations);
+
+	// the first force traversal starts tuning and times the first candidate
+	tuner.tuneAndTraverseCellPairs(cpStub);
+	ASSERT_TRUE(tuner._tuning);
+	const auto candidates = tuner._candidates;
+	ASSERT_TRUE(not candidates.empty());
+	auto* firstTraversal = tuner._traversals[candidates[0]].first;
+
+	// every candidate has to process the same cells and cell pairs as the first one
+	for (size_t i = 1; i < candidates.size(); ++i) {
+		ASSERT_EQUAL(candidates[i], tuner.getSelectedTraversal());
+		cpStub.inverseSign();
+		tuner.tuneAndTraverseCellPairs(cpStub);
+		cpStub.checkZero();
+		cpStub.inverseSign();
+		firstTraversal->traverseCellPairs(cpStub);
+	}
+
+	ASSERT_TRUE(not tuner._tuning);
+	ASSERT_TRUE(std::find(candidates.begin(), candidates.end(), tuner.getSelectedTraversal()) != candidates.end());
+	unsigned long numParticles = container->getNumberOfParticles(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+#ifdef ENABLE_MPI
+	MPI_Allreduce(MPI_IN_PLACE, &numParticles, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+#endif
+	ASSERT_EQUAL(numParticles, tuner._tunedNumParticles);
+
+	// a changed number of particles is only noticed by the next check
+	tuner._tunedNumParticles = 1;
+	for (unsigned i = 1; i < tuner._retuneInterval; ++i) {
+		tuner.tuneAndTraverseCellPairs(cpStub);
+		ASSERT_TRUE(not tuner._tuning);
+	}
+	tuner.tuneAndTraverseCellPairs(cpStub);
+	ASSERT_TRUE(tuner._tuning);
+	delete container;
+}
+
+void LinkedCellsTest::testTraversalAutoTuningInnerOuter() {
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	auto* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, 5.));
+	int* boxWidthInNumCells = container->getBoxWidthInNumCells();
+	int haloWidthInNumCells = container->getHaloWidthNumCells();
+	size_t numCells = static_cast<size_t>(boxWidthInNumCells[0] + 2 * haloWidthInNumCells)
+			* (boxWidthInNumCells[1] + 2 * haloWidthInNumCells) * (boxWidthInNumCells[2] + 2 * haloWidthInNumCells);
+	CellProcessorStub cpStub(numCells);
+
+	// creates all traversals
+	container->traverseCells(cpStub);
+	cpStub.inverseSign();
+	container->traverseCells(cpStub);
+	cpStub.inverseSign();
+
+	using Tuner = TraversalTuner<ParticleCell>;
+	auto& tuner = *container->_traversalTuner;
+	tuner._autoTune = true;
+	tuner._tuningSamples = 2;
+
+	const auto overlappingStep = [&]() {
+		for (unsigned stage = 0; stage < 3; ++stage) {
+			container->traversePartialInnermostCells(cpStub, stage, 3);
+		}
+		container->traverseNonInnermostCells(cpStub);
+	};
+
+	overlappingStep();
+	ASSERT_TRUE(tuner._tuning);
+	const auto candidates = tuner._candidates;
+	ASSERT_TRUE(not candidates.empty());
+	for (auto name : candidates) {
+		ASSERT_TRUE(name != Tuner::ORIGINAL and name != Tuner::QSCHED);
+		ASSERT_TRUE(tuner._traversals[name].first->supportsInnerOuterTraversal());
+	}
+	ASSERT_EQUAL(candidates[0], tuner.getSelectedTraversal());
+	auto* firstTraversal = tuner._traversals[candidates[0]].first;
+
+	// the first sample of the first candidate has been taken, the selected traversal only changes between steps
+	for (size_t step = 1; step < 2 * candidates.size(); ++step) {
+		ASSERT_TRUE(tuner._tuning);
+		ASSERT_EQUAL(candidates[step / 2], tuner.getSelectedTraversal());
+		cpStub.inverseSign();
+		overlappingStep();
+		cpStub.checkZero();
+		cpStub.inverseSign();
+		firstTraversal->traverseCellPairs(cpStub);
+	}
+
+	ASSERT_TRUE(not tuner._tuning);
+	ASSERT_TRUE(std::find(candidates.begin(), candidates.end(), tuner.getSelectedTraversal()) != candidates.end());
+	for (double time : tuner._candidateTimes) {
+		ASSERT_TRUE(time < std::numeric_limits<double>::max());
+	}
+	delete container;
+}
+
+void LinkedCellsTest::testMeasuredCellCosts() {
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	const double cutoff = 5.;
+	auto* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff));
+	VectorizedCellProcessor cellProcessor(*_domain, cutoff, cutoff);
+
+	if (not container->setMeasureCellCosts(true)) {
+		// no time stamp counter on this architecture
+		delete container;
+		return;
+	}
+	container->traverseCells(cellProcessor);
+
+	std::vector<std::array<double, 3>> cellCenters;
+	std::vector<double> cellCycles;
+	container->getMeasuredCellCosts(cellCenters, cellCycles);
+	ASSERT_EQUAL(cellCenters.size(), cellCycles.size());
+	ASSERT_TRUE(not cellCycles.empty());
+	for (size_t i = 0; i < cellCenters.size(); ++i) {
+		ASSERT_TRUE(cellCycles[i] > 0.);
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_TRUE(cellCenters[i][d] > container->_haloBoundingBoxMin[d]);
+			ASSERT_TRUE(cellCenters[i][d] < container->_haloBoundingBoxMax[d]);
+		}
+	}
+
+	// the measurements are reset when they are read
+	container->getMeasuredCellCosts(cellCenters, cellCycles);
+	ASSERT_TRUE(cellCycles.empty());
+
+	// only the C08 based traversals measure
+	ASSERT_TRUE(container->measuresCellCosts());
+	container->_traversalTuner->selectedTraversal = TraversalTuner<ParticleCell>::ORIGINAL;
+	ASSERT_TRUE(not container->measuresCellCosts());
+	delete container;
+}
+
+void LinkedCellsTest::testVerletLists() {
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	const double cutoff = 5.;
+	auto* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff));
+	VectorizedCellProcessor cellProcessor(*_domain, cutoff, cutoff);
+
+	// reference without Verlet lists
+	container->traverseCells(cellProcessor);
+	std::map<unsigned long, std::array<double, 3>> referenceForces;
+	for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+		referenceForces[m->getID()] = {m->F(0), m->F(1), m->F(2)};
+	}
+	const double referenceUpot = _domain->getLocalUpot();
+	const double referenceVirial = _domain->getLocalVirial();
+
+	// first traversal builds the lists, the following ones reuse them
+	container->_verletSkin = 0.5;
+	for (int traversal = 0; traversal < 3; ++traversal) {
+		container->updateMoleculeCaches();
+		container->traverseCells(cellProcessor);
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->calcFM();
+			for (int d = 0; d < 3; ++d) {
+				const double reference = referenceForces[m->getID()][d];
+				ASSERT_DOUBLES_EQUAL(reference, m->F(d), 1e-10 * std::max(1.0, std::abs(reference)));
+			}
+		}
+		ASSERT_DOUBLES_EQUAL(referenceUpot, _domain->getLocalUpot(), 1e-10 * std::max(1.0, std::abs(referenceUpot)));
+		ASSERT_DOUBLES_EQUAL(referenceVirial, _domain->getLocalVirial(), 1e-10 * std::max(1.0, std::abs(referenceVirial)));
+	}
+	delete container;
+}
+
+void LinkedCellsTest::testVerletListsMovingMolecules() {
+	// the cutoff is larger than the local domains of several processes
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LinkedCellsTest::testVerletListsMovingMolecules() only runs on 1 process" << std::endl;
+		return;
+	}
+
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	// large cutoff, so that the molecules of this dilute system interact
+	const double cutoff = 35.;
+	const double skin = 2.;
+	auto* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff));
+	auto* reference = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff));
+	VectorizedCellProcessor cellProcessor(*_domain, cutoff, cutoff);
+	container->_verletSkin = skin;
+	// rebuild only because of the displacement
+	container->_verletRebuildFrequency = 0;
+
+	// every molecule moves by 0.3 * skin per step in its own direction
+	auto move = [skin](LinkedCells* c) {
+		for (auto m = c->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			const double id = static_cast<double>(m->getID());
+			const double direction[3] = {std::sin(id), std::cos(1.3 * id), std::sin(0.7 * id + 1.0)};
+			const double length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+			for (int d = 0; d < 3; ++d) {
+				m->setr(d, m->r(d) + 0.3 * skin * direction[d] / length);
+			}
+		}
+		c->update();
+	};
+
+	int numReused = 0, numRebuilt = 0;
+	for (int step = 0; step < 6; ++step) {
+		if (step > 0) {
+			move(container);
+			move(reference);
+		}
+
+		reference->updateMoleculeCaches();
+		reference->traverseCells(cellProcessor);
+		std::map<unsigned long, std::array<double, 3>> referenceForces;
+		for (auto m = reference->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			m->calcFM();
+			referenceForces[m->getID()] = {m->F(0), m->F(1), m->F(2)};
+		}
+		const double referenceUpot = _domain->getLocalUpot();
+		const double referenceVirial = _domain->getLocalVirial();
+
+		const unsigned traversalsBefore = container->_traversalsSinceVerletRebuild;
+		container->updateMoleculeCaches();
+		container->traverseCells(cellProcessor);
+		if (step > 1) {
+			if (container->_traversalsSinceVerletRebuild > traversalsBefore) {
+				++numReused;
+			} else {
+				++numRebuilt;
+			}
+		}
+
+		size_t numMolecules = 0;
+		for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			m->calcFM();
+			ASSERT_EQUAL(static_cast<size_t>(1), referenceForces.count(m->getID()));
+			for (int d = 0; d < 3; ++d) {
+				const double expected = referenceForces[m->getID()][d];
+				ASSERT_DOUBLES_EQUAL(expected, m->F(d), 1e-10 * std::max(1.0, std::abs(expected)));
+			}
+			++numMolecules;
+		}
+		ASSERT_EQUAL(referenceForces.size(), numMolecules);
+		ASSERT_DOUBLES_EQUAL(referenceUpot, _domain->getLocalUpot(), 1e-10 * std::max(1.0, std::abs(referenceUpot)));
+		ASSERT_DOUBLES_EQUAL(referenceVirial, _domain->getLocalVirial(), 1e-10 * std::max(1.0, std::abs(referenceVirial)));
+	}
+	// displacement per step 0.3 * skin: the lists are reused once and rebuilt in the following step
+	ASSERT_TRUE(numReused > 0);
+	ASSERT_TRUE(numRebuilt > 0);
+	delete reference;
+	delete container;
+}
+
+void LinkedCellsTest::testGetEnergies() {
+	// the cutoff is larger than the local domains of several processes
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "LinkedCellsTest::testGetEnergies() only runs on 1 process" << std::endl;
+		return;
+	}
+
+	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
+	// large cutoff, so that the molecules of this dilute system interact
+	const double cutoff = 35.;
+	auto* container = dynamic_cast<LinkedCells*>(initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff));
+	VectorizedCellProcessor cellProcessor(*_domain, cutoff, cutoff);
+	ParticlePairs2PotForceAdapter particlePairsHandler(*_domain);
+	particlePairsHandler.init();
+
+	// molecules of the container (deletion trials) and shifted copies with new ids (insertion trials)
+	std::vector<Molecule> testMolecules;
+	unsigned long nextID = 1000000;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		testMolecules.push_back(*m);
+		Molecule shifted = *m;
+		for (int d = 0; d < 3; ++d) {
+			const double boxMin = container->getBoundingBoxMin(d);
+			const double boxLength = container->getBoundingBoxMax(d) - boxMin;
+			shifted.setr(d, boxMin + std::fmod(m->r(d) - boxMin + 0.37 * cutoff, boxLength));
+		}
+		shifted.setid(nextID++);
+		testMolecules.push_back(shifted);
+	}
+
+	std::vector<double> energies;
+	container->getEnergies(&particlePairsHandler, testMolecules, energies, cellProcessor);
+	ASSERT_EQUAL(testMolecules.size(), energies.size());
+	for (size_t i = 0; i < testMolecules.size(); ++i) {
+		Molecule testMolecule = testMolecules[i];
+		const double reference = container->getEnergy(&particlePairsHandler, &testMolecule, cellProcessor);
+		ASSERT_DOUBLES_EQUAL(reference, energies[i], 1e-10 * std::max(1.0, std::abs(reference)));
+	}
+	delete container;
+}
+
 //void LinkedCellsTest::testHalfShell() {
 //	//TODO: ___Extract to separate test class
 //	//------------------------------------------------------------
@@ -461,6 +802,10 @@ void LinkedCellsTest::testFullShellMPIDirect() {
 	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::C08, 1, "direct", "fs");
 }
 
+void LinkedCellsTest::testWorkStealingMPIDirectPP() {
+	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::C08WS, 1, "direct-pp", "fs");
+}
+
 void LinkedCellsTest::testHalfShellMPIIndirect() {
 //	doForceComparisonTest("simple-lj.inp", TraversalTuner < ParticleCell > ::traversalNames::HS, 1, "indirect", "hs");
 	doForceComparisonTest("simple-lj-tiny.inp", TraversalTuner < ParticleCell > ::traversalNames::HS, 1, "indirect", "hs");
@@ -23,6 +23,10 @@ class LinkedCellsTest: public ParticleContainerTest {
 	TEST_METHOD(testUpdateAndDeleteOuterParticles8Particles);
 	TEST_METHOD(testMoleculeBeginNextEndDeleteCurrent);
 	TEST_METHOD(testTraversalMethods);
+	TEST_METHOD(testInnerOuterTraversals);
+	TEST_METHOD(testTraversalAutoTuning);
+	TEST_METHOD(testTraversalAutoTuningInnerOuter);
+	TEST_METHOD(testMeasuredCellCosts);
 
 	TEST_METHOD(testRegionIterator);
 	TEST_METHOD(testRegionIteratorFile);
@@ -30,8 +34,13 @@ class LinkedCellsTest: public ParticleContainerTest {
 	TEST_METHOD(testCellBorderAndFlagManager);
 
 #ifndef ENABLE_REDUCED_MEMORY_MODE
+	TEST_METHOD(testVerletLists);
+	TEST_METHOD(testVerletListsMovingMolecules);
+	TEST_METHOD(testGetEnergies);
+
 	TEST_METHOD(testFullShellMPIDirectPP);
 	TEST_METHOD(testFullShellMPIDirect);
+	TEST_METHOD(testWorkStealingMPIDirectPP);
 
 	TEST_METHOD(testHalfShellMPIDirectPP);
 	TEST_METHOD(testHalfShellMPIDirect);
@@ -80,6 +89,32 @@ public:
 	void testUpdateAndDeleteOuterParticles8Particles();
 	void testMoleculeBeginNextEndDeleteCurrent();
 	void testTraversalMethods();
+	/**
+	 * The inner and outer parts of all full shell traversals supporting them have to process the same cell pairs as
+	 * the full C08 traversal.
+	 */
+	void testInnerOuterTraversals();
+	void testTraversalAutoTuning();
+
+	/**
+	 * Auto-tuning has to advance through all candidates and finish, if the forces are calculated by the
+	 * overlapping inner/outer traversals.
+	 */
+	void testTraversalAutoTuningInnerOuter();
+	void testMeasuredCellCosts();
+	/**
+	 * Forces and potential with Verlet lists (built and reused) have to match those without lists.
+	 */
+	void testVerletLists();
+	/**
+	 * Molecules are moved in every step, so that the lists are reused while the displacement is below half the skin
+	 * and rebuilt afterwards. Forces and potential have to match those of a container without lists in every step.
+	 */
+	void testVerletListsMovingMolecules();
+	/**
+	 * The batched energies of test molecules have to match the energies of the single molecules.
+	 */
+	void testGetEnergies();
 	void testRegionIterator();
 	void testRegionIteratorFile();
 	void testGetHaloBoundaryParticlesDirection();
@@ -88,6 +123,7 @@ public:
 
 	void testFullShellMPIDirectPP();
 	void testFullShellMPIDirect();
+	void testWorkStealingMPIDirectPP();
 
 	void testHalfShellMPIDirectPP();
 	void testHalfShellMPIDirect();
@@ -10,6 +10,7 @@
 #include "Simulation.h"
 #include "particleContainer/ParticleContainer.h"
 #include "parallel/DomainDecompBase.h"
+#include "parallel/PluginReduction.h"
 #include "molecules/Molecule.h"
 #include "utils/FileUtils.h"
 #include "utils/xmlfileUnits.h"
@@ -1309,45 +1310,56 @@ void SampleRegion::sampleFieldYR(Molecule* molecule, unsigned long simstep)
 	}
 }
 
-void SampleRegion::calcGlobalValuesProfiles(DomainDecompBase* domainDecomp, Domain* domain)
+void SampleRegion::addReductionProfiles(PluginReduction& reduction)
 {
-	if(not _SamplingEnabledProfiles)
-		return;
-
-	// perform reduce operation, process further calculations
-#ifdef ENABLE_MPI
-
 	// Scalar quantities
 	// [direction all|+|-][component][position]
-	MPI_Reduce( _nNumMoleculesLocal.data(), _nNumMoleculesGlobal.data(), _nNumValsScalar, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _nRotDOFLocal.data(),       _nRotDOFGlobal.data(),       _nNumValsScalar, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _d2EkinRotLocal.data(),     _d2EkinRotGlobal.data(),     _nNumValsScalar, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	reduction.add(_nNumMoleculesLocal.data(), _nNumMoleculesGlobal.data(), _nNumValsScalar);
+	reduction.add(_nRotDOFLocal.data(),       _nRotDOFGlobal.data(),       _nNumValsScalar);
+	reduction.add(_d2EkinRotLocal.data(),     _d2EkinRotGlobal.data(),     _nNumValsScalar);
 
 	// Vector quantities
 	// [dimension x|y|z][direction all|+|-][component][position]
-	MPI_Reduce( _dVelocityLocal.data(),        _dVelocityGlobal.data(),        _nNumValsVector, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _dSquaredVelocityLocal.data(), _dSquaredVelocityGlobal.data(), _nNumValsVector, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _dForceLocal.data(),           _dForceGlobal.data(),           _nNumValsVector, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _dVirialLocal.data(),          _dVirialGlobal.data(),               _nNumValsVector, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+	reduction.add(_dVelocityLocal.data(),        _dVelocityGlobal.data(),        _nNumValsVector);
+	reduction.add(_dSquaredVelocityLocal.data(), _dSquaredVelocityGlobal.data(), _nNumValsVector);
+	reduction.add(_dForceLocal.data(),           _dForceGlobal.data(),           _nNumValsVector);
+	reduction.add(_dVirialLocal.data(),          _dVirialGlobal.data(),          _nNumValsVector);
+}
+
+void SampleRegion::addReductionVDF(PluginReduction& reduction)
+{
+	// positive y-direction
+	reduction.add(_VDF_pjy_abs_local.data(), _VDF_pjy_abs_global.data(), _numValsVDF);
 
-#else
+	reduction.add(_VDF_pjy_pvx_local.data(), _VDF_pjy_pvx_global.data(), _numValsVDF);
+	reduction.add(_VDF_pjy_pvy_local.data(), _VDF_pjy_pvy_global.data(), _numValsVDF);
+	reduction.add(_VDF_pjy_pvz_local.data(), _VDF_pjy_pvz_global.data(), _numValsVDF);
+
+	reduction.add(_VDF_pjy_nvx_local.data(), _VDF_pjy_nvx_global.data(), _numValsVDF);
+	reduction.add(_VDF_pjy_nvz_local.data(), _VDF_pjy_nvz_global.data(), _numValsVDF);
+
+	// negative y-direction
+	reduction.add(_VDF_njy_abs_local.data(), _VDF_njy_abs_global.data(), _numValsVDF);
+
+	reduction.add(_VDF_njy_pvx_local.data(), _VDF_njy_pvx_global.data(), _numValsVDF);
+	reduction.add(_VDF_njy_pvz_local.data(), _VDF_njy_pvz_global.data(), _numValsVDF);
+
+	reduction.add(_VDF_njy_nvx_local.data(), _VDF_njy_nvx_global.data(), _numValsVDF);
+	reduction.add(_VDF_njy_nvy_local.data(), _VDF_njy_nvy_global.data(), _numValsVDF);
+	reduction.add(_VDF_njy_nvz_local.data(), _VDF_njy_nvz_global.data(), _numValsVDF);
+}
+
+void SampleRegion::addReductionFieldYR(PluginReduction& reduction)
+{
 	// Scalar quantities
-	for(unsigned int i = 0; i < _nNumValsScalar; ++i)
-	{
-		_nNumMoleculesGlobal[i] = _nNumMoleculesLocal[i];
-		_nRotDOFGlobal[i]       = _nRotDOFLocal[i];
-		_d2EkinRotGlobal[i]     = _d2EkinRotLocal[i];
-	}
+	// [dimension x|y|z][component][positionR][positionY]
+	reduction.add(_nNumMoleculesFieldYRLocal.data(), _nNumMoleculesFieldYRGlobal.data(), _nNumValsFieldYR);
+}
 
-	// Vector quantities
-	for(unsigned int i = 0; i < _nNumValsVector; ++i)
-	{
-		_dVelocityGlobal[i]        = _dVelocityLocal[i];
-		_dSquaredVelocityGlobal[i] = _dSquaredVelocityLocal[i];
-		_dForceGlobal[i]           = _dForceLocal[i];
-		_dVirialGlobal[i]          = _dVirialLocal[i];
-	}
-#endif
+void SampleRegion::calcGlobalValuesProfiles(DomainDecompBase* domainDecomp, Domain* domain)
+{
+	if(not _SamplingEnabledProfiles)
+		return;
 
 	int rank = domainDecomp->getRank();
 	//  int numprocs = domainDecomp->getNumProcs();
@@ -1467,74 +1479,11 @@ void SampleRegion::calcGlobalValuesProfiles(DomainDecompBase* domainDecomp, Doma
 }
 
 
-void SampleRegion::calcGlobalValuesVDF()
-{
-	if(not _SamplingEnabledVDF)
-		return;
-
-#ifdef ENABLE_MPI
-
-	// positive y-direction
-	MPI_Reduce( _VDF_pjy_abs_local.data(), _VDF_pjy_abs_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-
-	MPI_Reduce( _VDF_pjy_pvx_local.data(), _VDF_pjy_pvx_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _VDF_pjy_pvy_local.data(), _VDF_pjy_pvy_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _VDF_pjy_pvz_local.data(), _VDF_pjy_pvz_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-
-	MPI_Reduce( _VDF_pjy_nvx_local.data(), _VDF_pjy_nvx_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _VDF_pjy_nvz_local.data(), _VDF_pjy_nvz_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-
-
-	// negative y-direction
-	MPI_Reduce( _VDF_njy_abs_local.data(), _VDF_njy_abs_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-
-	MPI_Reduce( _VDF_njy_pvx_local.data(), _VDF_njy_pvx_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _VDF_njy_pvz_local.data(), _VDF_njy_pvz_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-
-	MPI_Reduce( _VDF_njy_nvx_local.data(), _VDF_njy_nvx_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _VDF_njy_nvy_local.data(), _VDF_njy_nvy_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-	MPI_Reduce( _VDF_njy_nvz_local.data(), _VDF_njy_nvz_global.data(), _numValsVDF, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-
-#else
-	for(uint32_t vi=0; vi<_numValsVDF; ++vi)
-	{
-		_VDF_pjy_abs_global[vi] = _VDF_pjy_abs_local[vi];
-		_VDF_pjy_pvx_global[vi] = _VDF_pjy_pvx_local[vi];
-		_VDF_pjy_pvy_global[vi] = _VDF_pjy_pvy_local[vi];
-		_VDF_pjy_pvz_global[vi] = _VDF_pjy_pvz_local[vi];
-		_VDF_pjy_nvx_global[vi] = _VDF_pjy_nvx_local[vi];
-		_VDF_pjy_nvz_global[vi] = _VDF_pjy_nvz_local[vi];
-
-		_VDF_njy_abs_global[vi] = _VDF_njy_abs_local[vi];
-		_VDF_njy_pvx_global[vi] = _VDF_njy_pvx_local[vi];
-		_VDF_njy_pvz_global[vi] = _VDF_njy_pvz_local[vi];
-		_VDF_njy_nvx_global[vi] = _VDF_njy_nvx_local[vi];
-		_VDF_njy_nvy_global[vi] = _VDF_njy_nvy_local[vi];
-		_VDF_njy_nvz_global[vi] = _VDF_njy_nvz_local[vi];
-	}
-#endif
-}
-
 void SampleRegion::calcGlobalValuesFieldYR(DomainDecompBase* domainDecomp, Domain* domain)
 {
 	if(not _SamplingEnabledFieldYR)
 		return;
 
-	// perform reduce operation, process further calculations
-#ifdef ENABLE_MPI
-
-	// Scalar quantities
-	// [dimension x|y|z][component][positionR][positionY]
-	MPI_Reduce( _nNumMoleculesFieldYRLocal.data(), _nNumMoleculesFieldYRGlobal.data(), _nNumValsFieldYR, MPI_UNSIGNED_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
-
-#else
-	// Scalar quantities
-	for(unsigned int i = 0; i < _nNumValsFieldYR; ++i)
-	{
-		_nNumMoleculesFieldYRGlobal[i] = _nNumMoleculesFieldYRLocal[i];
-	}
-#endif
-
 	int rank = domainDecomp->getRank();
 	//  int numprocs = domainDecomp->getNumProcs();
 
@@ -1572,11 +1521,19 @@ void SampleRegion::writeDataProfiles(DomainDecompBase* domainDecomp, unsigned lo
 	if( simstep == global_simulation->getNumInitTimesteps() ) // do not write data directly after (re)start
 		return;
 
-	// calc global values
-	this->calcGlobalValuesProfiles(domainDecomp, domain);
+	// reduce local values, the files are written once the reduction of all plugins has been completed
+	PluginReduction& reduction = global_simulation->getPluginReduction();
+	this->addReductionProfiles(reduction);
+	reduction.onCompletion([this, domainDecomp, simstep, domain]() { this->writeGlobalDataProfiles(domainDecomp, simstep, domain); });
 
 	// reset local values
 	this->resetLocalValuesProfiles();
+}
+
+void SampleRegion::writeGlobalDataProfiles(DomainDecompBase* domainDecomp, unsigned long simstep, Domain* domain)
+{
+	// calc global values
+	this->calcGlobalValuesProfiles(domainDecomp, domain);
 
 	// writing .dat-files
 	std::stringstream filenamestream_scal[3];
@@ -1751,12 +1708,17 @@ void SampleRegion::writeDataVDF(DomainDecompBase* domainDecomp, unsigned long si
 	if( simstep == global_simulation->getNumInitTimesteps() ) // do not write data directly after (re)start
 		return;
 
-	// calc global values
-	this->calcGlobalValuesVDF();  // calculate global velocity distribution sums
+	// reduce local values, the files are written once the reduction of all plugins has been completed
+	PluginReduction& reduction = global_simulation->getPluginReduction();
+	this->addReductionVDF(reduction);
+	reduction.onCompletion([this, domainDecomp, simstep]() { this->writeGlobalDataVDF(domainDecomp, simstep); });
 
 	// reset local values
 	this->resetLocalValuesVDF();
+}
 
+void SampleRegion::writeGlobalDataVDF(DomainDecompBase* domainDecomp, unsigned long simstep)
+{
 #ifdef ENABLE_MPI
 	int rank = domainDecomp->getRank();
 	// int numprocs = domainDecomp->getNumProcs();
@@ -1876,11 +1838,19 @@ void SampleRegion::writeDataFieldYR(DomainDecompBase* domainDecomp, unsigned lon
 	if( simstep == global_simulation->getNumInitTimesteps() ) // do not write data directly after (re)start
 		return;
 
-	// calc global values
-	this->calcGlobalValuesFieldYR(domainDecomp, domain);
+	// reduce local values, the files are written once the reduction of all plugins has been completed
+	PluginReduction& reduction = global_simulation->getPluginReduction();
+	this->addReductionFieldYR(reduction);
+	reduction.onCompletion([this, domainDecomp, simstep, domain]() { this->writeGlobalDataFieldYR(domainDecomp, simstep, domain); });
 
 	// reset local values
 	this->resetLocalValuesFieldYR();
+}
+
+void SampleRegion::writeGlobalDataFieldYR(DomainDecompBase* domainDecomp, unsigned long simstep, Domain* domain)
+{
+	// calc global values
+	this->calcGlobalValuesFieldYR(domainDecomp, domain);
 
 #ifdef ENABLE_MPI
 	int rank = domainDecomp->getRank();
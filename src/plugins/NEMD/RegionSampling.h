@@ -46,6 +46,7 @@ class DistControl;
 class XMLfileUnits;
 class Domain;
 class DomainDecompBase;
+class PluginReduction;
 class RegionSampling;
 
 class SampleRegion : public CuboidRegionObs
@@ -94,12 +95,16 @@ public:
 	void sampleVDF(Molecule* molecule, int nDimension, unsigned long simstep);
 	void sampleFieldYR(Molecule* molecule, unsigned long simstep);
 
-	// calc global values
+	// register local values for the aggregated reduction of all plugins
+	void addReductionProfiles(PluginReduction& reduction);
+	void addReductionVDF(PluginReduction& reduction);
+	void addReductionFieldYR(PluginReduction& reduction);
+
+	// calc global values from the reduced values
 	void calcGlobalValuesProfiles(DomainDecompBase* domainDecomp, Domain* domain);
-	void calcGlobalValuesVDF();
 	void calcGlobalValuesFieldYR(DomainDecompBase* domainDecomp, Domain* domain);
 
-	// output
+	// output: reduce the local values, the files are written once the reduction has been completed
 	void writeDataProfiles(DomainDecompBase* domainDecomp, unsigned long simstep, Domain* domain);
 	void writeDataVDF(DomainDecompBase* domainDecomp, unsigned long simstep);
 	void writeDataFieldYR(DomainDecompBase* domainDecomp, unsigned long simstep, Domain* domain);
@@ -107,6 +112,11 @@ public:
 	void updateSlabParameters();
 
 private:
+	// write files from the reduced values
+	void writeGlobalDataProfiles(DomainDecompBase* domainDecomp, unsigned long simstep, Domain* domain);
+	void writeGlobalDataVDF(DomainDecompBase* domainDecomp, unsigned long simstep);
+	void writeGlobalDataFieldYR(DomainDecompBase* domainDecomp, unsigned long simstep, Domain* domain);
+
 	// reset local values
 	void resetLocalValuesProfiles();
 	void resetOutputDataProfiles();
@@ -14,9 +14,11 @@
 #include "utils/String_utils.h"
 
 // Output plugins
+#include "io/BlockedCheckpointWriter.h"
 #include "io/CavityWriter.h"
 #include "io/CheckpointWriter.h"
 #include "io/CommunicationPartnerWriter.h"
+#include "io/CompressedTrajectoryWriter.h"
 #include "io/DecompWriter.h"
 #include "io/EnergyLogWriter.h"
 #include "io/FlopRateWriter.h"
@@ -88,10 +90,12 @@ void PluginFactory<PluginBase>::registerDefaultPlugins() {
 #ifdef ENABLE_ADIOS2
 	REGISTER_PLUGIN(Adios2Writer);
 #endif
+	REGISTER_PLUGIN(BlockedCheckpointWriter);
 	REGISTER_PLUGIN(COMaligner);
 	REGISTER_PLUGIN(CavityWriter);
 	REGISTER_PLUGIN(CheckpointWriter);
 	REGISTER_PLUGIN(CommunicationPartnerWriter);
+	REGISTER_PLUGIN(CompressedTrajectoryWriter);
 	REGISTER_PLUGIN(DecompWriter);
 	REGISTER_PLUGIN(DirectedPM);
 	REGISTER_PLUGIN(Dropaccelerator);
@@ -3,6 +3,7 @@
 //
 
 #include "SpatialProfile.h"
+#include "Simulation.h"
 #include "plugins/profiles/ProfileBase.h"
 #include "plugins/profiles/DensityProfile.h"
 #include "plugins/profiles/Velocity3dProfile.h"
@@ -212,11 +213,15 @@ void SpatialProfile::init(ParticleContainer* particleContainer, DomainDecompBase
 	samplInfo.universalCentre[1] = 0;
 	samplInfo.universalCentre[2] = 0.5 * samplInfo.globalLength[2];
 
+	samplInfo.numBins = _uIDs;
+
 	Log::global_log->info() << "[SpatialProfile] profile init" << std::endl;
 	// Init profiles with sampling information and reset maps
+	for (unsigned i = 0; i < _profiles.size(); i++) {
+		_profiles[i]->init(samplInfo);
+	}
 	for (unsigned long uID = 0; uID < _uIDs; uID++) {
 		for (unsigned i = 0; i < _profiles.size(); i++) {
-			_profiles[i]->init(samplInfo);
 			_profiles[i]->reset(uID);
 		}
 	}
@@ -237,10 +242,12 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 
 	unsigned xun, yun, zun;
 	if ((simstep >= _initStatistics) && (simstep % _profileRecordingTimesteps == 0)) {
-		long uID;
-
-		// Loop over all particles and bin them with uIDs
+		// Loop over all particles and bin them with uIDs, the profiles accumulate thread-privately
+		#if defined(_OPENMP)
+		#pragma omp parallel
+		#endif
 		for (auto thismol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); thismol.isValid(); ++thismol) {
+			long uID;
 
 			if ((_profiledCompString != "all") && (thismol->componentid() == _profiledComp-1)) {
 
@@ -287,36 +294,26 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 		// COLLECTIVE COMMUNICATION
 		Log::global_log->info() << "[SpatialProfile] uIDs: " << _uIDs << " acc. Data: " << _accumulatedDatasets << "\n";
 
-		// Initialize Communication with number of bins * number of total comms needed per bin by all profiles.
-		domainDecomp->collCommInit(_comms * _uIDs);
-
-		// Append Communications
-		for (unsigned long uID = 0; uID < _uIDs; uID++) {
-			for (unsigned i = 0; i < _profiles.size(); i++) {
-				_profiles[i]->collectAppend(domainDecomp, uID);
-			}
+		// Register all profiles for the aggregated reduction of all plugins
+		PluginReduction& reduction = global_simulation->getPluginReduction();
+		for (unsigned i = 0; i < _profiles.size(); i++) {
+			_profiles[i]->collectAppend(reduction);
 		}
 
-		// Reduction Communication to get global values
-		domainDecomp->collCommAllreduceSum();
-
-		// Write global values in all bins in all profiles
-		for (unsigned long uID = 0; uID < _uIDs; uID++) {
+		// Write global values in all bins in all profiles and initialize output from rank 0 process,
+		// once the reduction has been completed in the next time step
+		const long accumulatedDatasets = _accumulatedDatasets;
+		reduction.onCompletion([this, mpi_rank, simstep, accumulatedDatasets]() {
 			for (unsigned i = 0; i < _profiles.size(); i++) {
-				_profiles[i]->collectRetrieve(domainDecomp, uID);
+				_profiles[i]->collectRetrieve();
 			}
-		}
-
-		// Finalize Communication
-		domainDecomp->collCommFinalize();
-
-		// Initialize Output from rank 0 process
-		if (mpi_rank == 0) {
-			Log::global_log->info() << "[SpatialProfile] Writing profile output" << std::endl;
-			for (unsigned i = 0; i < _profiles.size(); i++) {
-				_profiles[i]->output(_outputPrefix + "_" + std::to_string(simstep), _accumulatedDatasets);
+			if (mpi_rank == 0) {
+				Log::global_log->info() << "[SpatialProfile] Writing profile output" << std::endl;
+				for (unsigned i = 0; i < _profiles.size(); i++) {
+					_profiles[i]->output(_outputPrefix + "_" + std::to_string(simstep), accumulatedDatasets);
+				}
 			}
-		}
+		});
 
 		// Reset profile arrays for next recording frame.
 		for (unsigned long uID = 0; uID < _uIDs; uID++) {
@@ -414,6 +411,5 @@ long SpatialProfile::getCylUID(ParticleIterator& thismol) {
 void SpatialProfile::addProfile(ProfileBase* profile) {
 	Log::global_log->info() << "[SpatialProfile] Profile added: \n";
 	_profiles.push_back(profile);
-	_comms += profile->comms();
 }
 
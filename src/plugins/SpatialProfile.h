@@ -128,7 +128,6 @@ private:
 	unsigned long _uIDs; //!< Total number of unique IDs with the selected Grid. This is the number of total bins in the Sampling grid.
 
 	std::vector<ProfileBase*> _profiles; // vector holding all enabled profiles
-	int _comms = 0; // total number of communications per bin needed by all profiles.
 
 	// Needed for XML check for enabled profiles.
 	bool _ALL = false;
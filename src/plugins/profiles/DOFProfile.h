@@ -7,6 +7,7 @@
 
 
 #include "ProfileBase.h"
+#include "utils/BinnedAccumulator.h"
 #include "plugins/SpatialProfile.h"
 
 /**
@@ -15,21 +16,26 @@
 class DOFProfile final : public ProfileBase {
 public:
     ~DOFProfile() final = default;
+    void init(SamplingInformation& samplingInformation) final {
+        ProfileBase::init(samplingInformation);
+        _localProfile.resize(samplingInformation.numBins);
+    }
     void record(Molecule &mol, unsigned long uID) final  {
-        _localProfile[uID] += 3.0 + (long double) (mol.component()->getRotationalDegreesOfFreedom());
+        _localProfile.add(uID, 3.0 + (long double) (mol.component()->getRotationalDegreesOfFreedom()));
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendInt(_localProfile[uID]);
+    void collectAppend(PluginReduction& reduction) final {
+        appendBins(reduction, _localProfile, _reducedProfile);
     }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetInt();
+    void collectRetrieve() final {
+        for (unsigned long uID = 0; uID < _samplInfo.numBins; uID++) {
+            _globalProfile[uID] = _reducedProfile[uID];
+        }
     }
     void output(std::string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0;
+        _localProfile.reset(uID);
         _globalProfile[uID] = 0;
     }
-    int comms() final {return 1;}
 
     int getGlobalDOF(unsigned long uid) const {
     	return _globalProfile.at(uid);
@@ -37,9 +43,11 @@ public:
 
 private:
     // Local 1D Profile
-    std::map<unsigned, int> _localProfile;
+    BinnedAccumulator<int> _localProfile;
     // Global 1D Profile
     std::map<unsigned, int> _globalProfile;
+    // Global 1D Profile as sent with the reduction
+    std::vector<int> _reducedProfile;
 
     void writeDataEntry(unsigned long uID, std::ofstream &outfile) const final;
 };
@@ -6,6 +6,7 @@
 #define MARDYN_KINETICPROFILE_H
 
 #include "ProfileBase.h"
+#include "utils/BinnedAccumulator.h"
 #include "plugins/SpatialProfile.h"
 
 /**
@@ -14,24 +15,29 @@
 class KineticProfile final : public ProfileBase {
 public:
     ~KineticProfile() final = default;
+    void init(SamplingInformation& samplingInformation) final {
+        ProfileBase::init(samplingInformation);
+        _localProfile.resize(samplingInformation.numBins);
+    }
     void record(Molecule &mol, unsigned long uID) final  {
         double mv2 = 0.0;
         double Iw2 = 0.0;
         mol.calculate_mv2_Iw2(mv2, Iw2);
-        _localProfile[uID] += mv2 + Iw2;
+        _localProfile.add(uID, mv2 + Iw2);
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendDouble(_localProfile[uID]);
+    void collectAppend(PluginReduction& reduction) final {
+        appendBins(reduction, _localProfile, _reducedProfile);
     }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetDouble();
+    void collectRetrieve() final {
+        for (unsigned long uID = 0; uID < _samplInfo.numBins; uID++) {
+            _globalProfile[uID] = _reducedProfile[uID];
+        }
     }
     void output(std::string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
+        _localProfile.reset(uID);
         _globalProfile[uID] = 0.0;
     }
-    int comms() final {return 1;}
 
     double getGlobalKineticEnergy(unsigned long uid) const {
     	return _globalProfile.at(uid);
@@ -39,9 +45,11 @@ public:
 
 private:
     // Local 1D Profile
-    std::map<unsigned, double> _localProfile;
+    BinnedAccumulator<double> _localProfile;
     // Global 1D Profile
     std::map<unsigned, double> _globalProfile;
+    // Global 1D Profile as sent with the reduction
+    std::vector<double> _reducedProfile;
 
     void writeDataEntry(unsigned long uID, std::ofstream &outfile) const final;
 
@@ -7,6 +7,9 @@
 
 #include "../../Domain.h"
 #include "../../parallel/DomainDecompBase.h"
+#include "../../parallel/PluginReduction.h"
+#include "../../utils/BinnedAccumulator.h"
+#include "../../utils/Logger.h"
 
 class SpatialProfile;
 
@@ -18,6 +21,7 @@ struct SamplingInformation {
 	double universalCentre[3]; // Centre coords for cylinder system
 	unsigned long globalNumMolecules; // number of molecules in system
 	unsigned long numMolFixRegion; // number of molecules in Fix Region
+	unsigned long numBins; // number of bins (uIDs) of the sampling grid
 	bool cylinder; // Cartesian or Cylinder output
 };
 
@@ -26,8 +30,8 @@ struct SamplingInformation {
  * The major steps for all profiles are <b>recording</b> the profile data, <b>communication</b>, writing the <b>output file</b>
  * and <b>resetting</b> everything for the next recording period. Each of these steps has a function associated with it that
  * needs to be implemented by all profiles inheriting this class to be able to work with KartesianProfile.
- * KartesianProfile also needs to know the number of items added to the communication per
- * Molecule. So a DensityProfile should return 1 via Profile::comms(). A Velocity3dProfile should return 3. <br>
+ * The communication is done by the PluginReduction of the simulation, so the output is written one time step later,
+ * once the reduction has been completed. <br>
  * A very simple <b>example</b> of how to use this class is the DensityProfile.
  *
  */
@@ -44,25 +48,23 @@ public:
 	virtual void init(SamplingInformation& samplingInformation) { _samplInfo = samplingInformation; };
 
 	/** @brief The recording step defines what kind of data needs to be recorded for a single molecule with a corresponding uID.
+	 *
+	 * Called concurrently by all OpenMP threads, so the local profile has to be thread-safe (see BinnedAccumulator).
 	 *
 	 * @param mol Reference to Molecule, needed to extract info such as velocity or Virial.
 	 * @param uID uID of molecule in sampling grid, needed to put data in right spot in the profile arrays.
 	 */
 	virtual void record(Molecule& mol, unsigned long uID) = 0;
 
-	/** @brief Append all necessary communication per bin to the DomainDecomposition. Append from e.g. _localProfile.
+	/** @brief Register the local values of all bins for the reduction. Append from e.g. _localProfile.
 	 *
-	 * @param domainDecomp DomainDecomposition handling the communication.
-	 * @param uID uID of molecule in sampling grid, needed to put data in right spot in the profile arrays.
+	 * @param reduction Aggregated reduction of all plugins handling the communication.
 	 */
-	virtual void collectAppend(DomainDecompBase* domainDecomp, unsigned long uID) = 0;
+	virtual void collectAppend(PluginReduction& reduction) = 0;
 
-	/** @brief Get global values after AllReduceSum per bin. Write to e.g. _globalProfile.
-	 *
-	 * @param domainDecomp DomainDecomposition handling the communication.
-	 * @param uID uID of molecule in sampling grid, needed to put data in right spot in the profile arrays.
+	/** @brief Get global values after the reduction has been completed. Write to e.g. _globalProfile.
 	 */
-	virtual void collectRetrieve(DomainDecompBase* domainDecomp, unsigned long uID) = 0;
+	virtual void collectRetrieve() = 0;
 
 	/** @brief Whatever is necessary to output for this profile.
 	 *
@@ -79,13 +81,6 @@ public:
 	 */
 	virtual void reset(unsigned long uID) = 0;
 
-	/** @brief 1D profiles like a number density profile should return 1 here. 3D profiles that have 3 entries per bin
-	 * that need to be communicated would need to return 3. Adjust as needed. Same number as commAppends in collectAppend.
-	 *
-	 * @return Number of nedded communications per bin so the communicator can be setup correctly.
-	 */
-	virtual int comms() = 0;
-
 protected:
 	// output file prefix
 	std::string _profilePrefix;
@@ -100,6 +95,23 @@ protected:
 	 */
 	virtual void writeDataEntry(unsigned long uID, std::ofstream& outfile) const = 0;
 
+	/** @brief Register the sums over all threads of all bins of local for the reduction.
+	 *
+	 * @param reduction Aggregated reduction of all plugins.
+	 * @param local Thread-private local profile.
+	 * @param reduced Receives the global values (layout: uID * numComponents + component), once the reduction is completed.
+	 */
+	template <typename T>
+	static void appendBins(PluginReduction& reduction, const BinnedAccumulator<T>& local, std::vector<T>& reduced) {
+		if (local.getNumDiscarded() > 0) {
+			Log::global_log->warning() << "[SpatialProfile] " << local.getNumDiscarded()
+									   << " values outside of the sampling grid have been discarded so far." << std::endl;
+		}
+		reduced.assign(local.getNumBins() * local.getNumComponents(), T());
+		local.reduceInto(reduced);
+		reduction.add(reduced.data(), reduced.data(), reduced.size());
+	}
+
 	/**@brief Matrix writing routine to avoid code duplication
 	 *
 	 * @param outfile opened filestream from Profile
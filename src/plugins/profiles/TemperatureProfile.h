@@ -6,6 +6,7 @@
 #define MARDYN_TEMPERATUREPROFILE_H
 
 #include "ProfileBase.h"
+#include "utils/BinnedAccumulator.h"
 #include "plugins/SpatialProfile.h"
 
 class DOFProfile;
@@ -20,30 +21,37 @@ public:
 			_dofProfile(dofProf), _kineticProfile(kinProf), _localProfile(), _globalProfile() {
 	}
     ~TemperatureProfile() final = default;
+    void init(SamplingInformation& samplingInformation) final {
+        ProfileBase::init(samplingInformation);
+        _localProfile.resize(samplingInformation.numBins);
+    }
     void record(Molecule &mol, unsigned long uID) final  {
-        _localProfile[uID] += 1;
+        _localProfile.add(uID, 1);
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendLongDouble(_localProfile[uID]);
+    void collectAppend(PluginReduction& reduction) final {
+        appendBins(reduction, _localProfile, _reducedProfile);
     }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetLongDouble();
+    void collectRetrieve() final {
+        for (unsigned long uID = 0; uID < _samplInfo.numBins; uID++) {
+            _globalProfile[uID] = _reducedProfile[uID];
+        }
     }
     void output(std::string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
+        _localProfile.reset(uID);
         _globalProfile[uID] = 0.0;
     }
-    int comms() final {return 1;}
 
 private:
     DOFProfile * _dofProfile;
     KineticProfile * _kineticProfile;
 
     // Local 1D Profile
-    std::map<unsigned, long double> _localProfile;
+    BinnedAccumulator<long double> _localProfile;
     // Global 1D Profile
     std::map<unsigned, long double> _globalProfile;
+    // Global 1D Profile as sent with the reduction
+    std::vector<long double> _reducedProfile;
 
     void writeDataEntry(unsigned long uID, std::ofstream &outfile) const final;
 };
@@ -6,6 +6,7 @@
 #define MARDYN_TRUNK_VELOCITYPROFILE_H
 
 #include "ProfileBase.h"
+#include "utils/BinnedAccumulator.h"
 #include "plugins/SpatialProfile.h"
 
 #include <array>
@@ -18,41 +19,45 @@ class DensityProfile;
 class Velocity3dProfile final : public ProfileBase {
 public:
 	Velocity3dProfile(DensityProfile * densProf) :
-			_densityProfile(densProf), _local3dProfile(), _global3dProfile() {
+			_densityProfile(densProf), _local3dProfile(0, 3), _global3dProfile() {
 	}
     ~Velocity3dProfile() final = default;
+    void init(SamplingInformation& samplingInformation) final {
+        ProfileBase::init(samplingInformation);
+        _local3dProfile.resize(samplingInformation.numBins);
+    }
     void record(Molecule &mol, unsigned long uID) final  {
         for(unsigned short d = 0; d < 3; d++){
-            _local3dProfile[uID][d] += mol.v(d);
+            _local3dProfile.add(uID, d, mol.v(d));
         }
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        for(unsigned short d = 0; d < 3; d++){
-            domainDecomp->collCommAppendDouble(_local3dProfile[uID][d]);
-        }
+    void collectAppend(PluginReduction& reduction) final {
+        appendBins(reduction, _local3dProfile, _reduced3dProfile);
     }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        for(unsigned short d = 0; d < 3; d++){
-            _global3dProfile[uID][d] = domainDecomp->collCommGetDouble();
+    void collectRetrieve() final {
+        for (unsigned long uID = 0; uID < _samplInfo.numBins; uID++) {
+            for (unsigned short d = 0; d < 3; d++) {
+                _global3dProfile[uID][d] = _reduced3dProfile[uID * 3 + d];
+            }
         }
     }
     void output(std::string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
+        _local3dProfile.reset(uID);
         for(unsigned d = 0; d < 3; d++){
-            _local3dProfile[uID][d] = 0.0;
             _global3dProfile[uID][d] = 0.0;
         }
     }
-    // set correct number of communications needed for this profile
-    int comms() final {return 3;}
 
 private:
     DensityProfile * _densityProfile;
 
     // Local 3D Profile
-    std::map<unsigned, std::array<double,3>> _local3dProfile;
+    BinnedAccumulator<double> _local3dProfile;
     // Global 3D Profile
     std::map<unsigned, std::array<double,3>> _global3dProfile;
+    // Global 3D Profile as sent with the reduction (layout: uID * 3 + d)
+    std::vector<double> _reduced3dProfile;
 
     void writeDataEntry(unsigned long uID, std::ofstream &outfile) const final;
 };
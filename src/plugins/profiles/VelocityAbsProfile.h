@@ -6,6 +6,7 @@
 #define MARDYN_TRUNK_VELOCITYABSPROFILE_H
 
 #include "ProfileBase.h"
+#include "utils/BinnedAccumulator.h"
 #include "plugins/SpatialProfile.h"
 
 class DensityProfile;
@@ -19,6 +20,10 @@ public:
 			_densityProfile(dens), _localProfile(), _globalProfile() {
 	}
     ~VelocityAbsProfile() final = default;
+    void init(SamplingInformation& samplingInformation) final {
+        ProfileBase::init(samplingInformation);
+        _localProfile.resize(samplingInformation.numBins);
+    }
     void record(Molecule& mol, unsigned long uID) final  {
         double absV = 0.0;
         double v;
@@ -27,29 +32,31 @@ public:
             absV += v*v;
         }
         absV = sqrt(absV);
-        _localProfile[uID] += absV;
+        _localProfile.add(uID, absV);
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendDouble(_localProfile[uID]);
+    void collectAppend(PluginReduction& reduction) final {
+        appendBins(reduction, _localProfile, _reducedProfile);
     }
-    void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        _globalProfile[uID] = domainDecomp->collCommGetDouble();
+    void collectRetrieve() final {
+        for (unsigned long uID = 0; uID < _samplInfo.numBins; uID++) {
+            _globalProfile[uID] = _reducedProfile[uID];
+        }
     }
     void output(std::string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
+        _localProfile.reset(uID);
         _globalProfile[uID] = 0.0;
     }
-    // set correct number of communications needed for this profile
-    int comms() final {return 1;}
 
 private:
     DensityProfile * _densityProfile;
 
     // Local 1D Profile
-    std::map<unsigned, double> _localProfile;
+    BinnedAccumulator<double> _localProfile;
     // Global 1D Profile
     std::map<unsigned, double> _globalProfile;
+    // Global 1D Profile as sent with the reduction
+    std::vector<double> _reducedProfile;
 
     void writeDataEntry(unsigned long uID, std::ofstream &outfile) const final;
 };
@@ -10,6 +10,12 @@
 #include "../FixRegion.h"
 #include "Simulation.h"
 
+void Virial2DProfile::collectAppend(PluginReduction& reduction) {
+	// Get current temperature from 0 thermostat -> temperature of all molecules even if not under thermostat control
+	_globalTemperature = global_simulation->getDomain()->getCurrentTemperature(0);
+	appendBins(reduction, _local3dProfile, _reduced3dProfile);
+}
+
 void Virial2DProfile::output(std::string prefix, long unsigned accumulatedDatasets) {
 
 	Log::global_log->info() << "[VirialProfile2D] output" << std::endl;
@@ -37,8 +43,8 @@ void Virial2DProfile::output(std::string prefix, long unsigned accumulatedDatase
 void Virial2DProfile::writeDataEntry(unsigned long uID, std::ofstream &outfile) const {
 
 
-	// calculate global temperature
-	double globalTemperature = global_simulation->getDomain()->getCurrentTemperature(0);
+	// global temperature, taken when the profile was collected
+	double globalTemperature = _globalTemperature;
 
 	//calculate global temperature if fixedRegion is applied
 	unsigned long numMolFixRegion = _samplInfo.numMolFixRegion;
@@ -7,6 +7,12 @@
 #include "DensityProfile.h"
 #include "Simulation.h"
 
+void VirialProfile::collectAppend(PluginReduction& reduction) {
+	// Get current temperature from 0 thermostat -> temperature of all molecules even if not under thermostat control
+	_globalTemperature = global_simulation->getDomain()->getCurrentTemperature(0);
+	appendBins(reduction, _local3dProfile, _reduced3dProfile);
+}
+
 void VirialProfile::output(std::string prefix, long unsigned accumulatedDatasets) {
 
 	Log::global_log->info() << "[VirialProfile] output" << std::endl;
@@ -40,8 +46,8 @@ void VirialProfile::output(std::string prefix, long unsigned accumulatedDatasets
 		// V = height * X * Z
 		layerVolume = layerHeight * _samplInfo.globalLength[0] * _samplInfo.globalLength[2];
 	}
-	// Get current temperature from 0 thermostat -> temperature of all molecules even if not under thermostat control
-	double globalTemperature = global_simulation->getDomain()->getCurrentTemperature(0);
+	// Temperature of all molecules, taken when the profile was collected
+	double globalTemperature = _globalTemperature;
 
 	// Pressure increases with "Depth" in Y
 	// Calculate Pressures on layer, then write 1D output
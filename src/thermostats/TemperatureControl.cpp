@@ -50,7 +50,7 @@ ControlRegionT::ControlRegionT(TemperatureControl* const parent)
 	  _nuAndersen(0.0),
 	  _timestep(0.0),
 	  _nuDt(0.0),
-	  _rand(Random()),
+	  _rand(),
 	  _bIsObserver(false) {
 	// ID
 	_nID = ++_nStaticID;
@@ -166,6 +166,11 @@ void ControlRegionT::readXML(XMLfileUnits& xmlconfig) {
 			xmlconfig.getNodeValue("settings/nu", _nuAndersen);
 			_timestep = global_simulation->getIntegrator()->getTimestepLength();
 			_nuDt = _nuAndersen * _timestep;
+			uint64_t seed = _rand.getSeed();
+			xmlconfig.getNodeValue("settings/seed", seed);
+			_rand.setSeed(seed);
+			Log::global_log->info() << "[TemperatureControl] REGION: Andersen nu = " << _nuAndersen << ", seed = " << seed
+									<< std::endl;
 		} else {
 			std::ostringstream error_message;
 			error_message << "[TemperatureControl] REGION: Invalid 'method' param: " << methods << std::endl;
@@ -364,7 +369,7 @@ void ControlRegionT::MeasureKineticEnergy(Molecule* mol, DomainDecompBase* /*dom
 	localTV._numRotationalDOF += mol->component()->getRotationalDegreesOfFreedom();
 }
 
-void ControlRegionT::ControlTemperature(Molecule* mol) {
+void ControlRegionT::ControlTemperature(Molecule* mol, unsigned long simstep) {
 	// check componentID
 	if (mol->componentid() + 1 != _nTargetComponentID &&
 		0 != _nTargetComponentID)  // program intern componentID starts with 0
@@ -409,13 +414,18 @@ void ControlRegionT::ControlTemperature(Molecule* mol) {
 
 		mol->scale_D(Dcorr);
 	} else if (_localMethod == Andersen) {
+		// the random numbers only depend on (step, molecule, region), so the molecules can be processed in any order
+		// by any thread or process
+		const unsigned long id = mol->getID();
+		const uint32_t firstStream = 4 * _nID;
 		double stdDevTrans, stdDevRot;
-		if (_rand.rnd() < _nuDt) {
+		if (_rand.uniform(simstep, id, firstStream)[0] < _nuDt) {
 			stdDevTrans = sqrt(_dTargetTemperature / mol->mass());
 			for (unsigned short d = 0; d < 3; d++) {
 				stdDevRot = sqrt(_dTargetTemperature * mol->getI(d));
-				mol->setv(d, _rand.gaussDeviate(stdDevTrans));
-				mol->setD(d, _rand.gaussDeviate(stdDevRot));
+				const std::array<double, 2> deviates = _rand.gauss(simstep, id, firstStream + 1 + d);
+				mol->setv(d, deviates[0] * stdDevTrans);
+				mol->setD(d, deviates[1] * stdDevRot);
 			}
 		}
 	} else {
@@ -682,7 +692,7 @@ void TemperatureControl::ControlTemperature(Molecule* mol, unsigned long simstep
 	if (simstep <= this->GetStart() || simstep > this->GetStop()) return;
 
 	for (auto&& reg : _vecControlRegions) {
-		reg->ControlTemperature(mol);
+		reg->ControlTemperature(mol, simstep);
 	}
 }
 
@@ -18,7 +18,7 @@
 #include "plugins/NEMD/DistControl.h"
 #include "utils/CommVar.h"
 #include "utils/ObserverBase.h"
-#include "utils/Random.h"
+#include "utils/CounterBasedRandom.h"
 #include "utils/Region.h"
 
 class DistControl;
@@ -68,6 +68,9 @@ public:
 							<exponent>DOUBLE</exponent>          <!-- Damping exponent of thermostat -->
 							<directions>xyz</directions>         <!-- Translational degrees of freedom to be considered
 	 for thermostating: x|y|z|xy|xz|yz|xyz -->
+							<nu>DOUBLE</nu>                      <!-- method Andersen: collision frequency -->
+							<seed>UNSIGNED_LONG</seed>           <!-- method Andersen: seed of the collisions, default
+	 8624 -->
 						</settings>
 						<writefreq>5000</writefreq>         <!-- Log thermostat scaling factors betaTrans and betaRot
 	 --> <fileprefix>betalog</fileprefix>    <!-- Prefix of log file -->
@@ -85,7 +88,7 @@ public:
 	void VelocityScalingInit(XMLfileUnits& xmlconfig, std::string strDirections);
 	void CalcGlobalValues(DomainDecompBase* domainDecomp);
 	void MeasureKineticEnergy(Molecule* mol, DomainDecompBase* domainDecomp);
-	void ControlTemperature(Molecule* mol);
+	void ControlTemperature(Molecule* mol, unsigned long simstep);
 	void ResetLocalValues();
 
 	// beta log file
@@ -139,7 +142,8 @@ private:
 	double _nuAndersen;
 	double _timestep;
 	double _nuDt;
-	Random _rand;
+	//! shared by all threads, the Andersen collisions are drawn per (step, molecule, region)
+	CounterBasedRandom _rand;
 
 	bool _bIsObserver;
 
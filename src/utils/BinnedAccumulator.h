@@ -0,0 +1,156 @@
+#ifndef BINNEDACCUMULATOR_H
+#define BINNEDACCUMULATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "WrapOpenMP.h"
+#include "utils/mardyn_assert.h"
+
+/** Thread-private accumulation of values into bins.
+ *
+ * Every OpenMP thread adds into its own copy of the bins, so add() needs neither atomics nor locks and can be
+ * called from within a parallel region. The copies are summed up when the values are read with sum() or
+ * reduceInto(), which must not be called concurrently with add().
+ * Each bin holds numComponents values of type T.
+ *
+ * The copies are split into chunks of binsPerChunk bins, which are allocated on the first add() of a thread into
+ * one of their bins. A thread which only touches a part of the bins therefore only stores this part, so the memory
+ * does not grow with numBins * numThreads for the usual spatially sorted traversals.
+ */
+template <typename T>
+class BinnedAccumulator {
+public:
+	//! number of bins allocated at once by a thread
+	static constexpr size_t binsPerChunk = 64;
+
+	/** Constructor
+	 * @param[in]  numBins        Number of bins.
+	 * @param[in]  numComponents  Number of values per bin.
+	 */
+	BinnedAccumulator(size_t numBins = 0, size_t numComponents = 1) : _numBins(0), _numComponents(numComponents) {
+		resize(numBins);
+	}
+
+	/** Set the number of bins and zero all of them.
+	 * Releases all chunks and prepares the chunk tables for the currently available OpenMP threads.
+	 */
+	void resize(size_t numBins) {
+		_numBins = numBins;
+		const size_t numChunks = (_numBins + binsPerChunk - 1) / binsPerChunk;
+		_threadChunks.resize(mardyn_get_max_threads());
+		for (auto& chunks : _threadChunks) {
+			chunks.clear();
+			chunks.resize(numChunks);
+		}
+		_threadDiscarded.assign(_threadChunks.size(), 0);
+	}
+
+	size_t getNumBins() const { return _numBins; }
+
+	size_t getNumComponents() const { return _numComponents; }
+
+	/** Add value to a component of a bin in the copy of the calling thread.
+	 * Values for bins or components out of range are discarded and counted (see getNumDiscarded()).
+	 */
+	void add(size_t bin, size_t component, T value) {
+		const size_t thread = mardyn_get_thread_num();
+		mardyn_assert(thread < _threadChunks.size());
+		if (bin >= _numBins or component >= _numComponents) {
+			++_threadDiscarded[thread];
+			return;
+		}
+		std::vector<T>& chunk = _threadChunks[thread][bin / binsPerChunk];
+		if (chunk.empty()) {
+			chunk.assign(binsPerChunk * _numComponents, T());
+		}
+		chunk[(bin % binsPerChunk) * _numComponents + component] += value;
+	}
+
+	/** Add value to the first component of a bin in the copy of the calling thread. */
+	void add(size_t bin, T value) {
+		add(bin, 0, value);
+	}
+
+	/** @return Sum over all threads of a component of a bin. */
+	T sum(size_t bin, size_t component = 0) const {
+		mardyn_assert(bin < _numBins and component < _numComponents);
+		T result = T();
+		for (const auto& chunks : _threadChunks) {
+			const std::vector<T>& chunk = chunks[bin / binsPerChunk];
+			if (not chunk.empty()) {
+				result += chunk[(bin % binsPerChunk) * _numComponents + component];
+			}
+		}
+		return result;
+	}
+
+	/** Add the sums over all threads of all bins to target (layout: bin * numComponents + component). */
+	void reduceInto(std::vector<T>& target) const {
+		mardyn_assert(target.size() >= _numBins * _numComponents);
+		for (const auto& chunks : _threadChunks) {
+			for (size_t c = 0; c < chunks.size(); ++c) {
+				if (chunks[c].empty()) {
+					continue;
+				}
+				const size_t offset = c * binsPerChunk * _numComponents;
+				const size_t length = std::min(chunks[c].size(), _numBins * _numComponents - offset);
+				for (size_t i = 0; i < length; ++i) {
+					target[offset + i] += chunks[c][i];
+				}
+			}
+		}
+	}
+
+	/** Zero all components of a bin. */
+	void reset(size_t bin) {
+		mardyn_assert(bin < _numBins);
+		for (auto& chunks : _threadChunks) {
+			std::vector<T>& chunk = chunks[bin / binsPerChunk];
+			if (not chunk.empty()) {
+				std::fill_n(chunk.begin() + (bin % binsPerChunk) * _numComponents, _numComponents, T());
+			}
+		}
+	}
+
+	/** Zero all bins and the number of discarded values. The chunks stay allocated for the next accumulation. */
+	void reset() {
+		for (auto& chunks : _threadChunks) {
+			for (auto& chunk : chunks) {
+				std::fill(chunk.begin(), chunk.end(), T());
+			}
+		}
+		std::fill(_threadDiscarded.begin(), _threadDiscarded.end(), 0);
+	}
+
+	/** @return Number of values passed to add() for a bin or component out of range since the last reset(). */
+	size_t getNumDiscarded() const {
+		size_t result = 0;
+		for (size_t discarded : _threadDiscarded) {
+			result += discarded;
+		}
+		return result;
+	}
+
+	/** @return Number of bins allocated over all threads. */
+	size_t getNumAllocatedBins() const {
+		size_t result = 0;
+		for (const auto& chunks : _threadChunks) {
+			for (const auto& chunk : chunks) {
+				result += chunk.size() / _numComponents;
+			}
+		}
+		return result;
+	}
+
+private:
+	size_t _numBins;
+	size_t _numComponents;
+	//! per thread: chunks of binsPerChunk bins, empty until the thread adds to one of their bins
+	std::vector<std::vector<std::vector<T>>> _threadChunks;
+	//! per thread: number of values discarded by add()
+	std::vector<size_t> _threadDiscarded;
+};
+
+#endif /* BINNEDACCUMULATOR_H */
@@ -0,0 +1,148 @@
+/*
+ * BlockCompression.h
+ *
+ * Lossless compression of blocks of fixed-size binary records.
+ * The bytes of the records are first transposed ("shuffled"), such that byte i of all records is stored
+ * contiguously. For spatially sorted molecules, the high order bytes of ids, positions and velocities vary little
+ * between neighbouring records, so the shuffled planes contain long runs, which are then run-length encoded.
+ */
+
+#ifndef SRC_UTILS_BLOCKCOMPRESSION_H_
+#define SRC_UTILS_BLOCKCOMPRESSION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BlockCompression {
+
+enum Method : std::uint32_t {
+	NONE = 0,
+	SHUFFLE_RLE = 1
+};
+
+//! @brief Transposes numRecords records of recordSize bytes into recordSize planes of numRecords bytes.
+inline void shuffle(const char* in, size_t numRecords, size_t recordSize, char* out) {
+	for (size_t r = 0; r < numRecords; ++r) {
+		for (size_t b = 0; b < recordSize; ++b) {
+			out[b * numRecords + r] = in[r * recordSize + b];
+		}
+	}
+}
+
+//! @brief Inverse of shuffle.
+inline void unshuffle(const char* in, size_t numRecords, size_t recordSize, char* out) {
+	for (size_t b = 0; b < recordSize; ++b) {
+		for (size_t r = 0; r < numRecords; ++r) {
+			out[r * recordSize + b] = in[b * numRecords + r];
+		}
+	}
+}
+
+/**
+ * @brief Run-length encoding in the style of PackBits.
+ * @details A control byte c < 128 is followed by c + 1 literal bytes, a control byte c >= 128 by one byte which is
+ * repeated c - 125 times (3 to 130 times).
+ */
+inline void rleEncode(const unsigned char* in, size_t size, std::vector<char>& out) {
+	size_t i = 0;
+	while (i < size) {
+		size_t run = 1;
+		while (i + run < size and run < 130 and in[i + run] == in[i]) {
+			++run;
+		}
+		if (run >= 3) {
+			out.push_back(static_cast<char>(run + 125));
+			out.push_back(static_cast<char>(in[i]));
+			i += run;
+			continue;
+		}
+		// literals up to the next run of at least three bytes
+		const size_t start = i;
+		while (i < size and i - start < 128) {
+			if (i + 2 < size and in[i] == in[i + 1] and in[i] == in[i + 2]) {
+				break;
+			}
+			++i;
+		}
+		out.push_back(static_cast<char>(i - start - 1));
+		out.insert(out.end(), in + start, in + i);
+	}
+}
+
+//! @return false, if in is not a valid encoding of exactly size bytes
+inline bool rleDecode(const unsigned char* in, size_t inSize, size_t size, char* out) {
+	size_t i = 0;
+	size_t o = 0;
+	while (i < inSize) {
+		const unsigned control = in[i++];
+		if (control < 128) {
+			const size_t length = control + 1;
+			if (i + length > inSize or o + length > size) {
+				return false;
+			}
+			for (size_t k = 0; k < length; ++k) {
+				out[o++] = static_cast<char>(in[i++]);
+			}
+		} else {
+			const size_t length = control - 125;
+			if (i >= inSize or o + length > size) {
+				return false;
+			}
+			for (size_t k = 0; k < length; ++k) {
+				out[o++] = static_cast<char>(in[i]);
+			}
+			++i;
+		}
+	}
+	return o == size;
+}
+
+/**
+ * @brief Appends the compressed form of numRecords records of recordSize bytes to out.
+ * @return The method that was used. If compression does not reduce the size, the records are appended unchanged.
+ */
+inline Method compress(const char* records, size_t numRecords, size_t recordSize, std::vector<char>& out) {
+	const size_t size = numRecords * recordSize;
+	std::vector<char> shuffled(size);
+	shuffle(records, numRecords, recordSize, shuffled.data());
+
+	const size_t begin = out.size();
+	rleEncode(reinterpret_cast<const unsigned char*>(shuffled.data()), size, out);
+	if (out.size() - begin < size) {
+		return SHUFFLE_RLE;
+	}
+	out.resize(begin);
+	out.insert(out.end(), records, records + size);
+	return NONE;
+}
+
+/**
+ * @brief Restores numRecords records of recordSize bytes.
+ * @param out Has to hold numRecords * recordSize bytes.
+ * @return false, if the data is corrupted
+ */
+inline bool decompress(Method method, const char* in, size_t inSize, size_t numRecords, size_t recordSize, char* out) {
+	const size_t size = numRecords * recordSize;
+	if (method == NONE) {
+		if (inSize != size) {
+			return false;
+		}
+		std::copy(in, in + size, out);
+		return true;
+	}
+	if (method != SHUFFLE_RLE) {
+		return false;
+	}
+	std::vector<char> shuffled(size);
+	if (not rleDecode(reinterpret_cast<const unsigned char*>(in), inSize, size, shuffled.data())) {
+		return false;
+	}
+	unshuffle(shuffled.data(), numRecords, recordSize, out);
+	return true;
+}
+
+} /* namespace BlockCompression */
+
+#endif /* SRC_UTILS_BLOCKCOMPRESSION_H_ */
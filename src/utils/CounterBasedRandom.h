@@ -0,0 +1,136 @@
+/*
+ * CounterBasedRandom.h
+ *
+ * Counter-based random number generator (Philox4x32-10, Salmon et al., "Parallel random numbers: as easy as
+ * 1, 2, 3", SC'11). The random numbers are a pure function of (seed, step, molecule id, stream), so they do not
+ * depend on the order in which molecules are visited, nor on the number of threads or processes.
+ */
+
+#ifndef SRC_UTILS_COUNTERBASEDRANDOM_H_
+#define SRC_UTILS_COUNTERBASEDRANDOM_H_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Stateless random number service for stochastic methods acting on single molecules (thermostats, insertions, ...).
+ *
+ * Each call returns one block of random numbers for the key (step, id, stream), where id is usually the molecule id
+ * and stream separates different uses within one step. The same key always gives the same numbers, so the class
+ * can be shared by all threads without synchronization. Methods needing more than two numbers per molecule and step
+ * use several streams.
+ *
+ * Usage inside a loop over molecules:
+ * @code
+ *   if (rng.uniform(simstep, mol->getID(), 0)[0] < probability) {
+ *       const std::array<double, 2> g = rng.gauss(simstep, mol->getID(), 1);
+ *       ...
+ *   }
+ * @endcode
+ */
+class CounterBasedRandom {
+public:
+	using Counter = std::array<uint32_t, 4>;
+	using Key = std::array<uint32_t, 2>;
+
+	explicit CounterBasedRandom(uint64_t seed = 8624) : _seed(seed) {}
+
+	uint64_t getSeed() const { return _seed; }
+	void setSeed(uint64_t seed) { _seed = seed; }
+
+	//! @return four independent 32 bit random numbers for the key (step, id, stream)
+	Counter block(uint64_t step, uint64_t id, uint32_t stream) const {
+		Counter bits;
+		blockImpl(step, id, stream, bits[0], bits[1], bits[2], bits[3]);
+		return bits;
+	}
+
+	//! @return two independent uniformly distributed numbers in (0, 1)
+	std::array<double, 2> uniform(uint64_t step, uint64_t id, uint32_t stream) const {
+		const Counter bits = block(step, id, stream);
+		return {toUniform(bits[0], bits[1]), toUniform(bits[2], bits[3])};
+	}
+
+	//! @return two independent standard normal deviates (Box-Muller transformation of uniform())
+	std::array<double, 2> gauss(uint64_t step, uint64_t id, uint32_t stream) const {
+		const std::array<double, 2> u = uniform(step, id, stream);
+		const double radius = std::sqrt(-2.0 * std::log(u[0]));
+		const double angle = 2.0 * M_PI * u[1];
+		return {radius * std::cos(angle), radius * std::sin(angle)};
+	}
+
+	/**
+	 * @brief Batched version of uniform() for many ids, vectorized across the ids.
+	 * @details values[i] is the first number of uniform(step, ids[i], stream).
+	 */
+	void uniform(uint64_t step, const unsigned long* ids, size_t count, uint32_t stream, double* values) const {
+		#pragma omp simd
+		for (size_t i = 0; i < count; ++i) {
+			uint32_t bits0, bits1, bits2, bits3;
+			blockImpl(step, ids[i], stream, bits0, bits1, bits2, bits3);
+			values[i] = toUniform(bits0, bits1);
+		}
+	}
+
+	/**
+	 * @brief Batched version of gauss() for many ids.
+	 * @details values[i] is the first number of gauss(step, ids[i], stream). The loop is not vectorized, because
+	 * vector versions of log and cos may round differently than the scalar ones used by gauss().
+	 */
+	void gauss(uint64_t step, const unsigned long* ids, size_t count, uint32_t stream, double* values) const {
+		for (size_t i = 0; i < count; ++i) {
+			uint32_t bits0, bits1, bits2, bits3;
+			blockImpl(step, ids[i], stream, bits0, bits1, bits2, bits3);
+			const double radius = std::sqrt(-2.0 * std::log(toUniform(bits0, bits1)));
+			values[i] = radius * std::cos(2.0 * M_PI * toUniform(bits2, bits3));
+		}
+	}
+
+	//! @brief Philox4x32 bijection with 10 rounds.
+	static Counter philox(Counter counter, Key key) {
+		philoxRounds(counter[0], counter[1], counter[2], counter[3], key[0], key[1]);
+		return counter;
+	}
+
+	//! @return uniformly distributed number in (0, 1) with 53 random bits
+	static double toUniform(uint32_t high, uint32_t low) {
+		const uint64_t bits = ((static_cast<uint64_t>(high) << 32) | low) >> 11;
+		return (static_cast<double>(bits) + 0.5) * 0x1p-53;
+	}
+
+private:
+	// the state is kept in scalars, so that the batched uniform loop is vectorized
+	void blockImpl(uint64_t step, uint64_t id, uint32_t stream, uint32_t& c0, uint32_t& c1, uint32_t& c2,
+				   uint32_t& c3) const {
+		c0 = static_cast<uint32_t>(id);
+		c1 = static_cast<uint32_t>(id >> 32);
+		c2 = static_cast<uint32_t>(step);
+		c3 = stream;
+		// the upper half of the step is folded into the key
+		philoxRounds(c0, c1, c2, c3, static_cast<uint32_t>(_seed),
+					 static_cast<uint32_t>(_seed >> 32) ^ static_cast<uint32_t>(step >> 32));
+	}
+
+	static void philoxRounds(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t k0, uint32_t k1) {
+		for (int round = 0; round < 10; ++round) {
+			if (round > 0) {
+				k0 += 0x9E3779B9u;
+				k1 += 0xBB67AE85u;
+			}
+			const uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+			const uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+			const uint32_t next0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+			const uint32_t next2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+			c1 = static_cast<uint32_t>(product1);
+			c3 = static_cast<uint32_t>(product0);
+			c0 = next0;
+			c2 = next2;
+		}
+	}
+
+	uint64_t _seed;
+};
+
+#endif /* SRC_UTILS_COUNTERBASEDRANDOM_H_ */
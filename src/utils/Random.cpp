@@ -9,6 +9,8 @@ void Random::init(int seed) {
 	this->iy = seed ^ (int) 777755555;
 	// Calculate normalization factor
 	this->am = 2.0 / (1.0 + (unsigned) ((int) -1));
+	this->_gaussSpare = 0.0;
+	this->_hasGaussSpare = false;
 }
 
 float Random::rnd() {
@@ -35,12 +37,10 @@ float Random::rnd() {
 double Random::gaussDeviate(double stdDeviation) {
 	/** Method generates a gaussian distributed deviate with mean = 0 and the specified standard deviation
 	 * borrowed from "Numerical Recipes in C++" by W.H. Press et al., Cambridge University Press*/
-	static bool iset = true;// flag decides wheter or not the reserve is returned
-	static double gset; // normal distributed deviate as a reserve for next call --> speed up
 	double fac, rsq, v1, v2;
 
-	//if(randFlag < 0) iset = true; // every 2nd time the reserve value is returned
-	if (iset) {
+	// every 2nd time the reserve value is returned
+	if (not _hasGaussSpare) {
 		do {
 			v1 = 2.0 * this->rnd() - 1.0;
 			v2 = 2.0 * this->rnd() - 1.0;
@@ -52,12 +52,12 @@ double Random::gaussDeviate(double stdDeviation) {
 
 		/* perform transformation from a standard normal distributed random number v1*fac
 		 *to a normal distributed number with specified standrard deviation (mean is 0) by multiplying the stdandard deviation*/
-		gset = v1 * fac * stdDeviation;
-		iset = false;
+		_gaussSpare = v1 * fac * stdDeviation;
+		_hasGaussSpare = true;
 		return v2 * fac * stdDeviation;
 	} else {
-		iset = true;
-		return gset;
+		_hasGaussSpare = false;
+		return _gaussSpare;
 	}
 }
 
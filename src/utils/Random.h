@@ -34,6 +34,10 @@ public:
 private:
 	int ix, iy;
 	float am;
+
+	//! normal distributed deviate kept as a reserve for the next call of gaussDeviate()
+	double _gaussSpare;
+	bool _hasGaussSpare;
 };
 
 #endif
@@ -0,0 +1,96 @@
+/*
+ * SpaceFillingCurve.h
+ *
+ * Keys of the Morton (Z-order) and Hilbert space-filling curves in 3D.
+ * Sorting points by these keys improves the spatial locality of their memory layout.
+ */
+
+#ifndef SRC_UTILS_SPACEFILLINGCURVE_H_
+#define SRC_UTILS_SPACEFILLINGCURVE_H_
+
+#include <cstdint>
+#include <string>
+
+namespace SpaceFillingCurve {
+
+enum class CurveType {
+	NONE,
+	MORTON,
+	HILBERT
+};
+
+//! maximal number of bits per coordinate, such that a key fits into 64 bit
+const unsigned maxBits = 21;
+
+inline CurveType curveTypeFromString(const std::string& name) {
+	if (name == "morton") {
+		return CurveType::MORTON;
+	} else if (name == "hilbert") {
+		return CurveType::HILBERT;
+	}
+	return CurveType::NONE;
+}
+
+//! @brief Insert two zero bits between each of the lower 21 bits of x.
+inline uint64_t spreadBits(uint64_t x) {
+	x &= 0x1fffff;
+	x = (x | x << 32) & 0x1f00000000ffffULL;
+	x = (x | x << 16) & 0x1f0000ff0000ffULL;
+	x = (x | x << 8) & 0x100f00f00f00f00fULL;
+	x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+	x = (x | x << 2) & 0x1249249249249249ULL;
+	return x;
+}
+
+//! @brief Morton key of the integer coordinates (x, y, z), each in [0, 2^maxBits).
+inline uint64_t mortonKey(uint32_t x, uint32_t y, uint32_t z) {
+	return spreadBits(z) << 2 | spreadBits(y) << 1 | spreadBits(x);
+}
+
+/**
+ * @brief Hilbert key of the integer coordinates (x, y, z), each in [0, 2^bits).
+ * @details Uses the transposition algorithm of J. Skilling, "Programming the Hilbert curve",
+ * AIP Conf. Proc. 707 (2004). Consecutive keys belong to neighbouring grid points.
+ */
+inline uint64_t hilbertKey(uint32_t x, uint32_t y, uint32_t z, unsigned bits) {
+	uint32_t X[3] = {x, y, z};
+	const uint32_t M = 1u << (bits - 1);
+
+	// inverse undo excess work
+	for (uint32_t Q = M; Q > 1; Q >>= 1) {
+		const uint32_t P = Q - 1;
+		for (int i = 0; i < 3; ++i) {
+			if (X[i] & Q) {
+				X[0] ^= P;
+			} else {
+				const uint32_t t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+	// Gray encode
+	X[1] ^= X[0];
+	X[2] ^= X[1];
+	uint32_t t = 0;
+	for (uint32_t Q = M; Q > 1; Q >>= 1) {
+		if (X[2] & Q) {
+			t ^= Q - 1;
+		}
+	}
+	for (int i = 0; i < 3; ++i) {
+		X[i] ^= t;
+	}
+
+	// the transposed key is interleaved with X[0] holding the most significant bit of each triple
+	return spreadBits(X[0]) << 2 | spreadBits(X[1]) << 1 | spreadBits(X[2]);
+}
+
+inline uint64_t key(CurveType type, uint32_t x, uint32_t y, uint32_t z, unsigned bits) {
+	return type == CurveType::HILBERT ? hilbertKey(x, y, z, bits) : mortonKey(x, y, z);
+}
+
+} /* namespace SpaceFillingCurve */
+
+#endif /* SRC_UTILS_SPACEFILLINGCURVE_H_ */
@@ -0,0 +1,257 @@
+/*
+ * TrajectoryCodec.h
+ *
+ * Lossless entropy coding of quantized molecule positions for compressed trajectories.
+ * The molecules are sorted along a space-filling curve, then ids, component ids and the quantized positions are
+ * delta encoded against the preceding molecule, zigzag mapped and stored as variable length integers (7 bits per
+ * byte). Neighbouring molecules have small position differences, so most bytes are small and the byte stream is
+ * finally compressed with a canonical Huffman code.
+ *
+ * The header only depends on the standard library, so it can also be used by the tools.
+ */
+
+#ifndef SRC_UTILS_TRAJECTORYCODEC_H_
+#define SRC_UTILS_TRAJECTORYCODEC_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace TrajectoryCodec {
+
+//! one molecule of a trajectory frame with quantized position
+struct Record {
+	std::uint64_t id;
+	std::uint32_t componentId;
+	std::int64_t position[3];
+};
+
+//! maximal length of the Huffman codes, the lengths are stored with 4 bits each
+const unsigned maxCodeLength = 15;
+//! size of the stored code length table
+const size_t codeTableSize = 128;
+
+inline std::uint64_t zigzagEncode(std::int64_t v) {
+	return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+}
+
+inline std::int64_t zigzagDecode(std::uint64_t v) {
+	return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+}
+
+inline void writeVarint(std::uint64_t v, std::vector<unsigned char>& out) {
+	while (v >= 0x80) {
+		out.push_back(static_cast<unsigned char>(v | 0x80));
+		v >>= 7;
+	}
+	out.push_back(static_cast<unsigned char>(v));
+}
+
+//! @return false, if the data ends before the end of the integer
+inline bool readVarint(const unsigned char* in, size_t size, size_t& pos, std::uint64_t& v) {
+	v = 0;
+	for (unsigned shift = 0; shift < 64; shift += 7) {
+		if (pos >= size) {
+			return false;
+		}
+		const unsigned char byte = in[pos++];
+		v |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+		if (byte < 0x80) {
+			return true;
+		}
+	}
+	return false;
+}
+
+//! @brief Appends the delta encoded records to out.
+inline void encodeRecords(const std::vector<Record>& records, std::vector<unsigned char>& out) {
+	Record previous{};
+	for (const auto& record : records) {
+		writeVarint(zigzagEncode(static_cast<std::int64_t>(record.id - previous.id)), out);
+		writeVarint(record.componentId, out);
+		for (int d = 0; d < 3; ++d) {
+			writeVarint(zigzagEncode(record.position[d] - previous.position[d]), out);
+		}
+		previous = record;
+	}
+}
+
+//! @return false, if in does not contain exactly numRecords records
+inline bool decodeRecords(const unsigned char* in, size_t size, size_t numRecords, std::vector<Record>& records) {
+	records.resize(numRecords);
+	Record previous{};
+	size_t pos = 0;
+	std::uint64_t v;
+	for (auto& record : records) {
+		if (not readVarint(in, size, pos, v)) {
+			return false;
+		}
+		record.id = previous.id + static_cast<std::uint64_t>(zigzagDecode(v));
+		if (not readVarint(in, size, pos, v)) {
+			return false;
+		}
+		record.componentId = static_cast<std::uint32_t>(v);
+		for (int d = 0; d < 3; ++d) {
+			if (not readVarint(in, size, pos, v)) {
+				return false;
+			}
+			record.position[d] = previous.position[d] + zigzagDecode(v);
+		}
+		previous = record;
+	}
+	return pos == size;
+}
+
+/**
+ * @brief Huffman code lengths of the byte values in in, limited to maxCodeLength.
+ * @details If the optimal code is too long, the frequencies are halved until it fits. Unused byte values get length
+ * zero, a single used value gets length one.
+ */
+inline std::vector<unsigned> huffmanCodeLengths(const unsigned char* in, size_t size) {
+	std::vector<std::uint64_t> frequencies(256, 0);
+	for (size_t i = 0; i < size; ++i) {
+		++frequencies[in[i]];
+	}
+	std::vector<unsigned> lengths(256, 0);
+	while (true) {
+		// nodes 0-255 are the leaves, parents are appended
+		std::vector<int> parent(256, -1);
+		using Node = std::pair<std::uint64_t, int>;
+		std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
+		for (int s = 0; s < 256; ++s) {
+			if (frequencies[s] > 0) {
+				queue.emplace(frequencies[s], s);
+			}
+		}
+		if (queue.size() == 1) {
+			lengths[queue.top().second] = 1;
+			return lengths;
+		}
+		while (queue.size() > 1) {
+			const Node a = queue.top();
+			queue.pop();
+			const Node b = queue.top();
+			queue.pop();
+			const int node = static_cast<int>(parent.size());
+			parent.push_back(-1);
+			parent[a.second] = node;
+			parent[b.second] = node;
+			queue.emplace(a.first + b.first, node);
+		}
+		unsigned longest = 0;
+		for (int s = 0; s < 256; ++s) {
+			lengths[s] = 0;
+			for (int n = s; frequencies[s] > 0 and parent[n] != -1; n = parent[n]) {
+				++lengths[s];
+			}
+			longest = std::max(longest, lengths[s]);
+		}
+		if (longest <= maxCodeLength) {
+			return lengths;
+		}
+		for (auto& f : frequencies) {
+			f = f > 0 ? f / 2 + 1 : 0;
+		}
+	}
+}
+
+//! @brief Byte values sorted by code length and value, the order of the canonical code.
+inline std::vector<int> canonicalOrder(const std::vector<unsigned>& lengths) {
+	std::vector<int> symbols;
+	for (int s = 0; s < 256; ++s) {
+		if (lengths[s] > 0) {
+			symbols.push_back(s);
+		}
+	}
+	std::stable_sort(symbols.begin(), symbols.end(), [&lengths](int a, int b) { return lengths[a] < lengths[b]; });
+	return symbols;
+}
+
+/**
+ * @brief Appends the canonical Huffman encoding of size bytes to out.
+ * @details The code length table (codeTableSize bytes) is followed by the code words, most significant bit first,
+ * padded with zero bits to full bytes.
+ */
+inline void huffmanEncode(const unsigned char* in, size_t size, std::vector<char>& out) {
+	const std::vector<unsigned> lengths = huffmanCodeLengths(in, size);
+	for (size_t i = 0; i < codeTableSize; ++i) {
+		out.push_back(static_cast<char>(lengths[2 * i] << 4 | lengths[2 * i + 1]));
+	}
+	std::vector<std::uint32_t> codes(256, 0);
+	std::uint32_t code = 0;
+	unsigned length = 0;
+	for (int s : canonicalOrder(lengths)) {
+		code <<= lengths[s] - length;
+		length = lengths[s];
+		codes[s] = code++;
+	}
+	std::uint64_t buffer = 0;
+	unsigned bits = 0;
+	for (size_t i = 0; i < size; ++i) {
+		buffer = buffer << lengths[in[i]] | codes[in[i]];
+		bits += lengths[in[i]];
+		while (bits >= 8) {
+			bits -= 8;
+			out.push_back(static_cast<char>(buffer >> bits));
+		}
+	}
+	if (bits > 0) {
+		out.push_back(static_cast<char>(buffer << (8 - bits)));
+	}
+}
+
+//! @return false, if in is not a valid encoding of exactly size bytes
+inline bool huffmanDecode(const unsigned char* in, size_t inSize, size_t size, std::vector<unsigned char>& out) {
+	if (inSize < codeTableSize) {
+		return false;
+	}
+	std::vector<unsigned> lengths(256);
+	for (size_t i = 0; i < codeTableSize; ++i) {
+		lengths[2 * i] = in[i] >> 4;
+		lengths[2 * i + 1] = in[i] & 0xf;
+	}
+	const std::vector<int> symbols = canonicalOrder(lengths);
+	// number of codes, first code and index of the first symbol per length
+	std::vector<std::uint32_t> count(maxCodeLength + 1, 0), first(maxCodeLength + 1, 0), index(maxCodeLength + 1, 0);
+	for (int s : symbols) {
+		++count[lengths[s]];
+	}
+	std::uint32_t code = 0;
+	std::uint32_t symbolIndex = 0;
+	for (unsigned l = 1; l <= maxCodeLength; ++l) {
+		code = (code + count[l - 1]) << 1;
+		first[l] = code;
+		index[l] = symbolIndex;
+		symbolIndex += count[l];
+	}
+
+	out.resize(size);
+	size_t bitPos = 0;
+	const size_t numBits = (inSize - codeTableSize) * 8;
+	const unsigned char* data = in + codeTableSize;
+	for (size_t o = 0; o < size; ++o) {
+		code = 0;
+		unsigned l = 0;
+		while (true) {
+			if (bitPos >= numBits or l == maxCodeLength) {
+				return false;
+			}
+			code = code << 1 | ((data[bitPos / 8] >> (7 - bitPos % 8)) & 1);
+			++bitPos;
+			++l;
+			if (code - first[l] < count[l]) {
+				out[o] = static_cast<unsigned char>(symbols[index[l] + code - first[l]]);
+				break;
+			}
+		}
+	}
+	return (numBits - bitPos) < 8;
+}
+
+} /* namespace TrajectoryCodec */
+
+#endif /* SRC_UTILS_TRAJECTORYCODEC_H_ */
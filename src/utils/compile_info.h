@@ -8,6 +8,17 @@
 
 #define MAX_INFO_STRING_LENGTH 1024
 
+#if (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__)) and not defined(__INTEL_COMPILER)
+/**
+ * Functions with this attribute are compiled without AVX (and everything based on it), regardless of
+ * VECTOR_INSTRUCTIONS, so that they can run on any x86 CPU.
+ */
+#define MARDYN_BASELINE_ISA __attribute__((target("no-avx")))
+#define MARDYN_EARLY_CPU_CHECK
+#else
+#define MARDYN_BASELINE_ISA
+#endif
+
 
 
 int get_compiler_info(char *info_str) {
@@ -135,6 +146,7 @@ void get_precision_info(char *info_str) {
 #endif
 }
 
+MARDYN_BASELINE_ISA
 void get_intrinsics_info(char *info_str) {
 #if VCP_VEC_TYPE==VCP_NOVEC
 	sprintf(info_str, "%s", "none");
@@ -155,6 +167,85 @@ void get_intrinsics_info(char *info_str) {
 #endif
 }
 
+/**
+ * @brief Check the vector extensions of the CPU we are running on against the intrinsics the
+ * vectorized kernels were compiled for.
+ * @details The kernels exist for the compiled intrinsics only (VECTOR_INSTRUCTIONS), there is no
+ * dispatch to kernels for other vector extensions at runtime. The check only replaces the illegal
+ * instruction on an unsupported CPU by an error message.
+ * @param info_str receives the widest vector extension supported by the CPU
+ * @return -1 if the compiled intrinsics are not supported by the CPU, 1 if the CPU supports wider
+ *         vectors than compiled for, 0 otherwise (or if the CPU cannot be queried)
+ */
+MARDYN_BASELINE_ISA
+int check_cpu_intrinsics(char *info_str) {
+#if (defined(__GNUC__) or defined(__clang__)) and (defined(__x86_64__) or defined(__i386__))
+	__builtin_cpu_init();
+	int cpuLevel = 0;
+	if (__builtin_cpu_supports("avx512f")) {
+		cpuLevel = 4;
+		sprintf(info_str, "%s", "AVX512F");
+	} else if (__builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma")) {
+		cpuLevel = 3;
+		sprintf(info_str, "%s", "AVX2");
+	} else if (__builtin_cpu_supports("avx")) {
+		cpuLevel = 2;
+		sprintf(info_str, "%s", "AVX");
+	} else if (__builtin_cpu_supports("sse3")) {
+		cpuLevel = 1;
+		sprintf(info_str, "%s", "SSE3");
+	} else {
+		sprintf(info_str, "%s", "none");
+	}
+
+#if VCP_VEC_TYPE==VCP_VEC_SSE3
+	const int compiledLevel = 1;
+#elif VCP_VEC_TYPE==VCP_VEC_AVX
+	const int compiledLevel = 2;
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2
+	const int compiledLevel = 3;
+#elif VCP_VEC_TYPE==VCP_VEC_KNL or VCP_VEC_TYPE==VCP_VEC_KNL_GATHER
+	const int compiledLevel = 4;
+#if defined(__AVX512ER__)
+	// the KNL kernels use the AVX-512ER approximations, which only compilers still supporting KNL can generate
+	if (not __builtin_cpu_supports("avx512er")) {
+		return -1;
+	}
+#endif
+#elif VCP_VEC_TYPE==VCP_VEC_AVX512F or VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER
+	const int compiledLevel = 4;
+#else
+	const int compiledLevel = 0;
+#endif
+	if (cpuLevel < compiledLevel) {
+		return -1;
+	}
+	return cpuLevel > compiledLevel ? 1 : 0;
+#else
+	sprintf(info_str, "%s", "unknown");
+	return 0;
+#endif
+}
+
+#ifdef MARDYN_EARLY_CPU_CHECK
+/**
+ * @brief Exit with an error message, if the CPU does not support the compiled intrinsics.
+ * @details Runs as constructor with the highest user priority, i.e. before the static initializers of all
+ * translation units and before main, which may already execute instructions of the compiled vector extension.
+ */
+__attribute__((constructor(101))) MARDYN_BASELINE_ISA
+void exit_on_unsupported_cpu_intrinsics() {
+	char cpu_str[MAX_INFO_STRING_LENGTH];
+	if (check_cpu_intrinsics(cpu_str) < 0) {
+		char compiled_str[MAX_INFO_STRING_LENGTH];
+		get_intrinsics_info(compiled_str);
+		fprintf(stderr, "This executable was compiled for %s intrinsics, which this CPU (%s) does not support. "
+				"Please use an executable configured with a matching VECTOR_INSTRUCTIONS.\n", compiled_str, cpu_str);
+		exit(EXIT_FAILURE);
+	}
+}
+#endif
+
 void get_rmm_normal_info(char *info_str) {
 #if defined(ENABLE_REDUCED_MEMORY_MODE)
 	sprintf(info_str, "%s", "reduced memory mode (RMM). Not all features work in this mode.");
@@ -65,7 +65,7 @@ class ParticleContainerToBasisWrapper : public ParticleContainer {
 	unsigned long getNumberOfParticles(ParticleIterator::Type /* t */ = ParticleIterator::ALL_CELLS) override { return _basis.numMolecules(); }
 
 	double getBoundingBoxMin(int dimension) const override {
-		double min[3] = {std::numeric_limits<double>::min(), std::numeric_limits<double>::min(), std::numeric_limits<double>::min()};
+		double min[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
 		return min[dimension];
 	}
 
@@ -0,0 +1,109 @@
+/*
+ * BinnedAccumulatorTest.cpp
+ */
+
+#include "BinnedAccumulatorTest.h"
+#include "../BinnedAccumulator.h"
+
+#include <vector>
+
+TEST_SUITE_REGISTRATION(BinnedAccumulatorTest);
+
+void BinnedAccumulatorTest::testParallelAccumulation() {
+	const size_t numBins = 7;
+	const long numValues = 10000;
+	BinnedAccumulator<double> accumulator(numBins, 2);
+
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static, 13)
+	#endif
+	for (long i = 0; i < numValues; ++i) {
+		accumulator.add(i % numBins, 0, 1.0);
+		accumulator.add(i % numBins, 1, static_cast<double>(i));
+	}
+
+	std::vector<double> reduced(2 * numBins, 0.0);
+	accumulator.reduceInto(reduced);
+	for (size_t bin = 0; bin < numBins; ++bin) {
+		double expectedCount = 0.0;
+		double expectedSum = 0.0;
+		for (long i = bin; i < numValues; i += numBins) {
+			expectedCount += 1.0;
+			expectedSum += static_cast<double>(i);
+		}
+		ASSERT_DOUBLES_EQUAL(expectedCount, accumulator.sum(bin, 0), 1e-12);
+		ASSERT_DOUBLES_EQUAL(expectedSum, accumulator.sum(bin, 1), 1e-12);
+		ASSERT_DOUBLES_EQUAL(expectedCount, reduced[2 * bin], 1e-12);
+		ASSERT_DOUBLES_EQUAL(expectedSum, reduced[2 * bin + 1], 1e-12);
+	}
+}
+
+void BinnedAccumulatorTest::testReset() {
+	BinnedAccumulator<int> accumulator(3);
+	accumulator.add(0, 1);
+	accumulator.add(1, 2);
+	accumulator.add(2, 3);
+
+	accumulator.reset(1);
+	ASSERT_EQUAL(accumulator.sum(0), 1);
+	ASSERT_EQUAL(accumulator.sum(1), 0);
+	ASSERT_EQUAL(accumulator.sum(2), 3);
+
+	accumulator.reset();
+	for (size_t bin = 0; bin < accumulator.getNumBins(); ++bin) {
+		ASSERT_EQUAL(accumulator.sum(bin), 0);
+	}
+}
+
+void BinnedAccumulatorTest::testSparseAllocation() {
+	const size_t binsPerChunk = BinnedAccumulator<double>::binsPerChunk;
+	const size_t numBins = 100 * binsPerChunk;
+	BinnedAccumulator<double> accumulator(numBins, 3);
+	ASSERT_EQUAL(accumulator.getNumAllocatedBins(), static_cast<size_t>(0));
+
+	// every thread touches a contiguous range of two chunks
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		const size_t first = mardyn_get_thread_num() * 2 * binsPerChunk;
+		for (size_t bin = first; bin < first + 2 * binsPerChunk; ++bin) {
+			accumulator.add(bin, 2, 1.0);
+		}
+	}
+	const size_t numThreads = mardyn_get_max_threads();
+	ASSERT_EQUAL(accumulator.getNumAllocatedBins(), numThreads * 2 * binsPerChunk);
+
+	std::vector<double> reduced(3 * numBins, 0.0);
+	accumulator.reduceInto(reduced);
+	for (size_t bin = 0; bin < numBins; ++bin) {
+		const double expected = bin < numThreads * 2 * binsPerChunk ? 1.0 : 0.0;
+		ASSERT_DOUBLES_EQUAL(expected, accumulator.sum(bin, 2), 0.0);
+		ASSERT_DOUBLES_EQUAL(0.0, reduced[3 * bin], 0.0);
+		ASSERT_DOUBLES_EQUAL(expected, reduced[3 * bin + 2], 0.0);
+	}
+
+	// a partial last chunk must not write past the end of the target
+	BinnedAccumulator<double> partial(binsPerChunk + 1);
+	partial.add(binsPerChunk, 5.0);
+	std::vector<double> partialReduced(binsPerChunk + 1, 0.0);
+	partial.reduceInto(partialReduced);
+	ASSERT_DOUBLES_EQUAL(5.0, partialReduced.back(), 0.0);
+}
+
+void BinnedAccumulatorTest::testOutOfRange() {
+	BinnedAccumulator<int> accumulator(4, 2);
+	accumulator.add(4, 0, 1);
+	accumulator.add(1000, 1, 1);
+	accumulator.add(0, 2, 1);
+	accumulator.add(3, 1, 7);
+	ASSERT_EQUAL(accumulator.getNumDiscarded(), static_cast<size_t>(3));
+	for (size_t bin = 0; bin < 3; ++bin) {
+		ASSERT_EQUAL(accumulator.sum(bin, 0), 0);
+		ASSERT_EQUAL(accumulator.sum(bin, 1), 0);
+	}
+	ASSERT_EQUAL(accumulator.sum(3, 1), 7);
+
+	accumulator.reset();
+	ASSERT_EQUAL(accumulator.getNumDiscarded(), static_cast<size_t>(0));
+}
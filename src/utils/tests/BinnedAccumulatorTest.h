@@ -0,0 +1,31 @@
+/*
+ * BinnedAccumulatorTest.h
+ */
+
+#ifndef SRC_UTILS_TESTS_BINNEDACCUMULATORTEST_H_
+#define SRC_UTILS_TESTS_BINNEDACCUMULATORTEST_H_
+
+#include "../Testing.h"
+
+/**
+ * \brief Test the thread-private accumulation and reduction of BinnedAccumulator.
+ */
+class BinnedAccumulatorTest: public utils::Test {
+	TEST_SUITE(BinnedAccumulatorTest);
+	TEST_METHOD(testParallelAccumulation);
+	TEST_METHOD(testReset);
+	TEST_METHOD(testSparseAllocation);
+	TEST_METHOD(testOutOfRange);
+	TEST_SUITE_END();
+
+public:
+	BinnedAccumulatorTest() {}
+	virtual ~BinnedAccumulatorTest() {}
+
+	void testParallelAccumulation();
+	void testReset();
+	void testSparseAllocation();
+	void testOutOfRange();
+};
+
+#endif /* SRC_UTILS_TESTS_BINNEDACCUMULATORTEST_H_ */
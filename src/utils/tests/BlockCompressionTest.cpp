@@ -0,0 +1,59 @@
+/*
+ * BlockCompressionTest.cpp
+ */
+
+#include "BlockCompressionTest.h"
+#include "../BlockCompression.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(BlockCompressionTest);
+
+void BlockCompressionTest::testRoundTrip() {
+	const size_t numRecords = 1000;
+	const size_t recordSize = 8 + 3 * 8;
+	std::vector<char> records(numRecords * recordSize);
+	for (size_t i = 0; i < numRecords; ++i) {
+		const std::uint64_t id = 5000 + i;
+		const double r[3] = {10. + 1e-3 * i, 20. + 2e-3 * i, 30.};
+		std::memcpy(&records[i * recordSize], &id, 8);
+		std::memcpy(&records[i * recordSize + 8], r, 3 * 8);
+	}
+
+	std::vector<char> compressed(3, 'x');
+	const auto method = BlockCompression::compress(records.data(), numRecords, recordSize, compressed);
+	ASSERT_EQUAL(static_cast<int>(method), static_cast<int>(BlockCompression::SHUFFLE_RLE));
+	ASSERT_TRUE(compressed.size() - 3 < records.size());
+
+	std::vector<char> restored(records.size());
+	ASSERT_TRUE(BlockCompression::decompress(method, compressed.data() + 3, compressed.size() - 3, numRecords,
+											 recordSize, restored.data()));
+	ASSERT_TRUE(restored == records);
+
+	// truncated data is detected
+	ASSERT_TRUE(not BlockCompression::decompress(method, compressed.data() + 3, compressed.size() - 4, numRecords,
+												 recordSize, restored.data()));
+}
+
+void BlockCompressionTest::testIncompressible() {
+	const size_t numRecords = 100;
+	const size_t recordSize = 16;
+	std::vector<char> records(numRecords * recordSize);
+	srand(42);
+	for (char& c : records) {
+		c = static_cast<char>(rand());
+	}
+
+	std::vector<char> compressed;
+	const auto method = BlockCompression::compress(records.data(), numRecords, recordSize, compressed);
+	ASSERT_EQUAL(static_cast<int>(method), static_cast<int>(BlockCompression::NONE));
+	ASSERT_TRUE(compressed == records);
+
+	std::vector<char> restored(records.size());
+	ASSERT_TRUE(BlockCompression::decompress(method, compressed.data(), compressed.size(), numRecords, recordSize,
+											 restored.data()));
+	ASSERT_TRUE(restored == records);
+}
@@ -0,0 +1,29 @@
+/*
+ * BlockCompressionTest.h
+ */
+
+#ifndef SRC_UTILS_TESTS_BLOCKCOMPRESSIONTEST_H_
+#define SRC_UTILS_TESTS_BLOCKCOMPRESSIONTEST_H_
+
+#include "../Testing.h"
+
+/**
+ * \brief Test that blocks of records are restored exactly after compression.
+ */
+class BlockCompressionTest: public utils::Test {
+	TEST_SUITE(BlockCompressionTest);
+	TEST_METHOD(testRoundTrip);
+	TEST_METHOD(testIncompressible);
+	TEST_SUITE_END();
+
+public:
+	BlockCompressionTest() {}
+	virtual ~BlockCompressionTest() {}
+
+	//! records with slowly varying doubles compress and are restored exactly
+	void testRoundTrip();
+	//! random bytes are stored unchanged
+	void testIncompressible();
+};
+
+#endif /* SRC_UTILS_TESTS_BLOCKCOMPRESSIONTEST_H_ */
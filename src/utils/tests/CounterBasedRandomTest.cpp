@@ -0,0 +1,85 @@
+/*
+ * CounterBasedRandomTest.cpp
+ */
+
+#include "CounterBasedRandomTest.h"
+#include "../CounterBasedRandom.h"
+
+#include <cmath>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(CounterBasedRandomTest);
+
+void CounterBasedRandomTest::testKnownAnswers() {
+	using Counter = CounterBasedRandom::Counter;
+	const Counter zero = CounterBasedRandom::philox({0u, 0u, 0u, 0u}, {0u, 0u});
+	const Counter expectedZero = {0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u};
+	const Counter ones = CounterBasedRandom::philox({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu},
+													{0xffffffffu, 0xffffffffu});
+	const Counter expectedOnes = {0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu};
+	const Counter pi = CounterBasedRandom::philox({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+												  {0xa4093822u, 0x299f31d0u});
+	const Counter expectedPi = {0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u};
+	for (int i = 0; i < 4; ++i) {
+		ASSERT_EQUAL(expectedZero[i], zero[i]);
+		ASSERT_EQUAL(expectedOnes[i], ones[i]);
+		ASSERT_EQUAL(expectedPi[i], pi[i]);
+	}
+}
+
+void CounterBasedRandomTest::testBatchAndOrder() {
+	const CounterBasedRandom rng(42);
+	const unsigned long step = 17;
+	const int numIds = 1000;
+	std::vector<unsigned long> ids(numIds);
+	for (int i = 0; i < numIds; ++i) {
+		ids[i] = 7 * i + 3;
+	}
+	std::vector<double> uniform(numIds), gauss(numIds);
+	rng.uniform(step, ids.data(), ids.size(), 2, uniform.data());
+	rng.gauss(step, ids.data(), ids.size(), 3, gauss.data());
+
+	// scalar calls in reverse order, distributed over the threads
+	std::vector<double> scalarUniform(numIds), scalarGauss(numIds);
+	#if defined(_OPENMP)
+	#pragma omp parallel for
+	#endif
+	for (int i = numIds - 1; i >= 0; --i) {
+		scalarUniform[i] = rng.uniform(step, ids[i], 2)[0];
+		scalarGauss[i] = rng.gauss(step, ids[i], 3)[0];
+	}
+	for (int i = 0; i < numIds; ++i) {
+		ASSERT_EQUAL(uniform[i], scalarUniform[i]);
+		ASSERT_EQUAL(gauss[i], scalarGauss[i]);
+	}
+
+	// different steps, streams and seeds give different numbers
+	ASSERT_TRUE(rng.uniform(step, ids[0], 2)[0] != rng.uniform(step + 1, ids[0], 2)[0]);
+	ASSERT_TRUE(rng.uniform(step, ids[0], 2)[0] != rng.uniform(step, ids[0], 3)[0]);
+	ASSERT_TRUE(rng.uniform(step, ids[0], 2)[0] != CounterBasedRandom(43).uniform(step, ids[0], 2)[0]);
+}
+
+void CounterBasedRandomTest::testDistributions() {
+	const CounterBasedRandom rng;
+	const int numSamples = 100000;
+	double uniformSum = 0., uniformSquareSum = 0.;
+	double gaussSum = 0., gaussSquareSum = 0.;
+	for (int i = 0; i < numSamples; ++i) {
+		const auto u = rng.uniform(0, i, 0);
+		const auto g = rng.gauss(0, i, 1);
+		for (int k = 0; k < 2; ++k) {
+			ASSERT_TRUE(u[k] > 0.);
+			ASSERT_TRUE(u[k] < 1.);
+			uniformSum += u[k];
+			uniformSquareSum += u[k] * u[k];
+			gaussSum += g[k];
+			gaussSquareSum += g[k] * g[k];
+		}
+	}
+	const double n = 2. * numSamples;
+	// the tolerances are about five standard errors
+	ASSERT_DOUBLES_EQUAL(0.5, uniformSum / n, 0.004);
+	ASSERT_DOUBLES_EQUAL(1. / 12., uniformSquareSum / n - std::pow(uniformSum / n, 2), 0.002);
+	ASSERT_DOUBLES_EQUAL(0., gaussSum / n, 0.012);
+	ASSERT_DOUBLES_EQUAL(1., gaussSquareSum / n - std::pow(gaussSum / n, 2), 0.016);
+}
@@ -0,0 +1,32 @@
+/*
+ * CounterBasedRandomTest.h
+ */
+
+#ifndef SRC_UTILS_TESTS_COUNTERBASEDRANDOMTEST_H_
+#define SRC_UTILS_TESTS_COUNTERBASEDRANDOMTEST_H_
+
+#include "../Testing.h"
+
+/**
+ * \brief Test the Philox generator against reference values and the independence of the evaluation order.
+ */
+class CounterBasedRandomTest: public utils::Test {
+	TEST_SUITE(CounterBasedRandomTest);
+	TEST_METHOD(testKnownAnswers);
+	TEST_METHOD(testBatchAndOrder);
+	TEST_METHOD(testDistributions);
+	TEST_SUITE_END();
+
+public:
+	CounterBasedRandomTest() {}
+	virtual ~CounterBasedRandomTest() {}
+
+	//! Philox4x32-10 has to reproduce the known answer vectors of Random123
+	void testKnownAnswers();
+	//! batched and scalar calls give the same numbers, independent of the order and the thread
+	void testBatchAndOrder();
+	//! uniform numbers are in (0, 1), mean and variance of both distributions are plausible
+	void testDistributions();
+};
+
+#endif /* SRC_UTILS_TESTS_COUNTERBASEDRANDOMTEST_H_ */
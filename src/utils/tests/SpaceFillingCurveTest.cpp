@@ -0,0 +1,45 @@
+/*
+ * SpaceFillingCurveTest.cpp
+ */
+
+#include "SpaceFillingCurveTest.h"
+#include "../SpaceFillingCurve.h"
+
+#include <cstdlib>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(SpaceFillingCurveTest);
+
+void SpaceFillingCurveTest::testMortonKey() {
+	ASSERT_EQUAL(SpaceFillingCurve::mortonKey(0, 0, 0), static_cast<uint64_t>(0));
+	ASSERT_EQUAL(SpaceFillingCurve::mortonKey(1, 0, 0), static_cast<uint64_t>(1));
+	ASSERT_EQUAL(SpaceFillingCurve::mortonKey(0, 1, 0), static_cast<uint64_t>(2));
+	ASSERT_EQUAL(SpaceFillingCurve::mortonKey(0, 0, 1), static_cast<uint64_t>(4));
+	ASSERT_EQUAL(SpaceFillingCurve::mortonKey(1, 2, 4), static_cast<uint64_t>(0x111));
+	const uint32_t maxCoord = (1u << SpaceFillingCurve::maxBits) - 1;
+	ASSERT_EQUAL(SpaceFillingCurve::mortonKey(maxCoord, maxCoord, maxCoord), (static_cast<uint64_t>(1) << 63) - 1);
+}
+
+void SpaceFillingCurveTest::testHilbertKey() {
+	const unsigned bits = 3;
+	const int n = 1 << bits;
+	std::vector<int> pointOfKey(n * n * n, -1);
+
+	for (int x = 0; x < n; ++x) {
+		for (int y = 0; y < n; ++y) {
+			for (int z = 0; z < n; ++z) {
+				const uint64_t key = SpaceFillingCurve::hilbertKey(x, y, z, bits);
+				ASSERT_TRUE(key < pointOfKey.size());
+				ASSERT_EQUAL(pointOfKey[key], -1);
+				pointOfKey[key] = (z * n + y) * n + x;
+			}
+		}
+	}
+
+	for (size_t key = 1; key < pointOfKey.size(); ++key) {
+		const int a = pointOfKey[key - 1];
+		const int b = pointOfKey[key];
+		const int distance = std::abs(a % n - b % n) + std::abs(a / n % n - b / n % n) + std::abs(a / (n * n) - b / (n * n));
+		ASSERT_EQUAL(distance, 1);
+	}
+}
@@ -0,0 +1,28 @@
+/*
+ * SpaceFillingCurveTest.h
+ */
+
+#ifndef SRC_UTILS_TESTS_SPACEFILLINGCURVETEST_H_
+#define SRC_UTILS_TESTS_SPACEFILLINGCURVETEST_H_
+
+#include "../Testing.h"
+
+/**
+ * \brief Test the keys of the Morton and Hilbert curves.
+ */
+class SpaceFillingCurveTest: public utils::Test {
+	TEST_SUITE(SpaceFillingCurveTest);
+	TEST_METHOD(testMortonKey);
+	TEST_METHOD(testHilbertKey);
+	TEST_SUITE_END();
+
+public:
+	SpaceFillingCurveTest() {}
+	virtual ~SpaceFillingCurveTest() {}
+
+	void testMortonKey();
+	//! every grid point gets a unique key and consecutive keys belong to neighbouring grid points
+	void testHilbertKey();
+};
+
+#endif /* SRC_UTILS_TESTS_SPACEFILLINGCURVETEST_H_ */
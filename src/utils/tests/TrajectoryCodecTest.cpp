@@ -0,0 +1,98 @@
+/*
+ * TrajectoryCodecTest.cpp
+ */
+
+#include "TrajectoryCodecTest.h"
+#include "../TrajectoryCodec.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+TEST_SUITE_REGISTRATION(TrajectoryCodecTest);
+
+void TrajectoryCodecTest::testVarint() {
+	const std::vector<std::int64_t> values = {0, 1, -1, 63, -64, 64, 1000000, -1000000,
+											  std::numeric_limits<std::int64_t>::max(),
+											  std::numeric_limits<std::int64_t>::min()};
+	std::vector<unsigned char> bytes;
+	for (auto v : values) {
+		TrajectoryCodec::writeVarint(TrajectoryCodec::zigzagEncode(v), bytes);
+	}
+	// small values need a single byte
+	ASSERT_EQUAL(bytes[0], static_cast<unsigned char>(0));
+	ASSERT_EQUAL(bytes[1], static_cast<unsigned char>(2));
+	ASSERT_EQUAL(bytes[2], static_cast<unsigned char>(1));
+
+	size_t pos = 0;
+	for (auto v : values) {
+		std::uint64_t read;
+		ASSERT_TRUE(TrajectoryCodec::readVarint(bytes.data(), bytes.size(), pos, read));
+		ASSERT_EQUAL(TrajectoryCodec::zigzagDecode(read), v);
+	}
+	ASSERT_EQUAL(pos, bytes.size());
+	std::uint64_t read;
+	ASSERT_TRUE(not TrajectoryCodec::readVarint(bytes.data(), bytes.size(), pos, read));
+}
+
+void TrajectoryCodecTest::testHuffman() {
+	srand(42);
+	for (int distribution = 0; distribution < 3; ++distribution) {
+		std::vector<unsigned char> data(10000);
+		for (auto& c : data) {
+			switch (distribution) {
+				case 0:  // geometric, like small deltas
+					c = 0;
+					while (c < 255 and rand() % 2 == 0) {
+						++c;
+					}
+					break;
+				case 1:
+					c = static_cast<unsigned char>(rand());
+					break;
+				default:
+					c = 7;
+			}
+		}
+		std::vector<char> encoded;
+		TrajectoryCodec::huffmanEncode(data.data(), data.size(), encoded);
+		if (distribution != 1) {
+			ASSERT_TRUE(encoded.size() < data.size() / 2);
+		}
+		std::vector<unsigned char> decoded;
+		ASSERT_TRUE(TrajectoryCodec::huffmanDecode(reinterpret_cast<const unsigned char*>(encoded.data()),
+												   encoded.size(), data.size(), decoded));
+		ASSERT_TRUE(decoded == data);
+
+		// truncated data is detected
+		ASSERT_TRUE(not TrajectoryCodec::huffmanDecode(reinterpret_cast<const unsigned char*>(encoded.data()),
+													   encoded.size() - 2, data.size(), decoded));
+	}
+}
+
+void TrajectoryCodecTest::testRecords() {
+	std::vector<TrajectoryCodec::Record> records(500);
+	for (size_t i = 0; i < records.size(); ++i) {
+		records[i].id = 1000 + 3 * i;
+		records[i].componentId = i % 2;
+		records[i].position[0] = 1 << 20;
+		records[i].position[1] = 100 * static_cast<std::int64_t>(i);
+		records[i].position[2] = -static_cast<std::int64_t>(i);
+	}
+	std::vector<unsigned char> raw;
+	TrajectoryCodec::encodeRecords(records, raw);
+	// apart from the first record, all deltas fit into 1 or 2 bytes
+	ASSERT_TRUE(raw.size() < 8 * records.size());
+
+	std::vector<TrajectoryCodec::Record> decoded;
+	ASSERT_TRUE(TrajectoryCodec::decodeRecords(raw.data(), raw.size(), records.size(), decoded));
+	for (size_t i = 0; i < records.size(); ++i) {
+		ASSERT_EQUAL(decoded[i].id, records[i].id);
+		ASSERT_EQUAL(decoded[i].componentId, records[i].componentId);
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_EQUAL(decoded[i].position[d], records[i].position[d]);
+		}
+	}
+	ASSERT_TRUE(not TrajectoryCodec::decodeRecords(raw.data(), raw.size(), records.size() + 1, decoded));
+}
@@ -0,0 +1,32 @@
+/*
+ * TrajectoryCodecTest.h
+ */
+
+#ifndef SRC_UTILS_TESTS_TRAJECTORYCODECTEST_H_
+#define SRC_UTILS_TESTS_TRAJECTORYCODECTEST_H_
+
+#include "../Testing.h"
+
+/**
+ * \brief Test the delta and Huffman coding of compressed trajectories.
+ */
+class TrajectoryCodecTest: public utils::Test {
+	TEST_SUITE(TrajectoryCodecTest);
+	TEST_METHOD(testVarint);
+	TEST_METHOD(testHuffman);
+	TEST_METHOD(testRecords);
+	TEST_SUITE_END();
+
+public:
+	TrajectoryCodecTest() {}
+	virtual ~TrajectoryCodecTest() {}
+
+	//! zigzag mapped variable length integers are restored, also the extreme values
+	void testVarint();
+	//! skewed and uniform byte distributions are restored, skewed ones are compressed
+	void testHuffman();
+	//! delta encoded records of neighbouring molecules are restored and are small
+	void testRecords();
+};
+
+#endif /* SRC_UTILS_TESTS_TRAJECTORYCODECTEST_H_ */
@@ -0,0 +1,79 @@
+/*
+ * main.cpp
+ *
+ * Converts the compressed trajectories of the CompressedTrajectoryWriter (*.ctrj) to text.
+ *
+ * Usage: trajectory-decompress [-i] INPUT.ctrj [OUTPUT]
+ *
+ * Every frame is written in the XYZ format: the number of molecules, a comment line with the simulation step and
+ * time, then one line "componentId x y z" per molecule, with component ids counted from 1 as in the phase space
+ * files. With -i, the molecule id is written as an additional first column. Without OUTPUT, the text goes to stdout.
+ * The positions have the precision of the quantization grid stored in the file, which is reported on stderr.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#include "io/CompressedTrajectoryReader.h"
+
+int main(int argc, char** argv) {
+	bool writeIds = false;
+	int arg = 1;
+	if (arg < argc and std::strcmp(argv[arg], "-i") == 0) {
+		writeIds = true;
+		++arg;
+	}
+	if (arg >= argc or argc - arg > 2) {
+		std::cerr << "Usage: " << argv[0] << " [-i] INPUT.ctrj [OUTPUT]" << std::endl;
+		return 1;
+	}
+
+	CompressedTrajectoryReader reader;
+	if (not reader.open(argv[arg])) {
+		std::cerr << reader.getError() << std::endl;
+		return 1;
+	}
+	std::ofstream outputFile;
+	if (argc - arg == 2) {
+		outputFile.open(argv[arg + 1]);
+		if (not outputFile) {
+			std::cerr << "Could not open " << argv[arg + 1] << std::endl;
+			return 1;
+		}
+	}
+	std::ostream& out = outputFile.is_open() ? outputFile : std::cout;
+
+	const auto& header = reader.getHeader();
+	std::cerr << "Box " << header.globalLength[0] << " x " << header.globalLength[1] << " x "
+			  << header.globalLength[2] << ", position precision";
+	for (int d = 0; d < 3; ++d) {
+		std::cerr << " " << header.cellLength[d] / static_cast<double>(1ul << header.precisionBits);
+	}
+	std::cerr << std::endl;
+
+	out << std::setprecision(std::numeric_limits<double>::digits10);
+	CompressedTrajectoryReader::Frame frame;
+	unsigned long numFrames = 0;
+	while (reader.readFrame(frame)) {
+		out << frame.molecules.size() << "\n";
+		out << "simstep " << frame.simstep << " time " << frame.time << "\n";
+		for (const auto& molecule : frame.molecules) {
+			if (writeIds) {
+				out << molecule.id << " ";
+			}
+			out << molecule.componentId + 1 << " " << molecule.r[0] << " " << molecule.r[1] << " " << molecule.r[2]
+				<< "\n";
+		}
+		++numFrames;
+	}
+	if (not reader.getError().empty()) {
+		std::cerr << reader.getError() << std::endl;
+		return 1;
+	}
+	std::cerr << "Converted " << numFrames << " frames" << std::endl;
+	return 0;
+}